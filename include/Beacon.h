@@ -4,7 +4,14 @@
 #include "FSM.h"
 #include "Scheduler.h"
 #include "JTEncode.h"
+#include "WSPRPipeline.h"
+#include "ModeDescriptor.h"
 #include "Si5351Intf.h"
+#include "LatestValue.h"
+#include "EventQueue.h"
+#include "Housekeeping.h"
+#include "StartupGraph.h"
+#include <atomic>
 #include <ctime>
 
 class Beacon {
@@ -20,6 +27,18 @@ public:
         char band[8];
         uint32_t frequency;
         bool valid;
+        int messageType;  // WSPR message type (1, 2 or 3) of the next frame
+    };
+
+    // Main loop event counts, and how long events waited to be handled
+    struct EventLoopStats {
+        uint32_t posted;
+        uint32_t dropped;        // posted to a full queue
+        uint32_t maxDepth;
+        uint32_t handled;
+        uint32_t maxLatencyUs;
+        uint64_t totalLatencyUs;
+        uint32_t wakeups;        // main loop passes, for events or housekeeping
     };
 
     explicit Beacon(AppContext* ctx);
@@ -28,17 +47,63 @@ public:
     void run();
     void stop();
     
-    // Calibration mode support
-    void setCalibrationMode(bool enabled);
+    // Calibration mode support. Starting puts CLK0 on freqHz; like every
+    // input from another task, it takes effect on the main loop.
+    void setCalibrationMode(bool enabled, uint32_t freqHz = 0);
     bool isCalibrationMode() const;
     
     // Si5351 access for calibration
     Si5351Intf* getSi5351() const { return ctx ? ctx->si5351 : nullptr; }
     
-    // Next transmission prediction for footer display
+    // Calibration fine-tuning. The web handlers post setpoints and return;
+    // the main loop applies only the newest of each, without a PLL reset.
+    void postCalibrationFrequency(double freqHz);
+    void postCalibrationPreview(int32_t ppb);
+    
+    // Next transmission prediction for footer display. Any task; reads the
+    // snapshot the main loop last published.
     NextTransmissionInfo getNextTransmissionInfo() const;
+    
+    EventLoopStats getEventLoopStats() const;
+    
+    // Startup phases, timed from the start of the startup graph, and how
+    // long after that the first transmission began (-1 until it has)
+    int getStartupTimeline(StartupGraph::Timing* out, int max) const;
+    int64_t getFirstTransmissionUs() const { return firstTransmissionUs.load(std::memory_order_relaxed); }
 
 private:
+    // Inputs from the scheduler timer, the modulation task and the web
+    // server. They are queued and handled one at a time by the main loop,
+    // which owns all beacon state.
+    struct Event {
+        enum class Type : uint8_t {
+            SchedulerWake,      // value is a Scheduler::Wake
+            TransmissionStart,
+            TransmissionEnd,
+            Symbol,             // value is the symbol index
+            SettingsChanged,
+            CalibrationStart,   // value is the CLK0 frequency in Hz
+            CalibrationStop,
+            Calibration,        // a setpoint is waiting in a mailbox
+            Stop
+        };
+        Type type;
+        uint32_t value;
+        uint32_t run;           // modulation run of a Symbol event, or scheduler generation
+        int64_t postedUs;
+    };
+    
+    static constexpr uint32_t EVENT_POSTED_BIT = 1 << 0;
+    static constexpr int64_t TIME_SYNC_PERIOD_US = 3600LL * 1000000;
+    static constexpr int64_t TIME_SYNC_RETRY_US = 60LL * 1000000;
+    static constexpr int64_t TIME_SYNC_SLACK_US = 5LL * 60 * 1000000;   // an hourly sync may wait for another wakeup
+    static constexpr int STARTUP_STACK_SIZE = 8192;
+    
+    bool post(Event::Type type, uint32_t value = 0, uint32_t run = 0);
+    void drainEvents();
+    void handleEvent(const Event& event);
+    void applyCalibrationMode(bool enabled, uint32_t freqHz);
+    void applyCalibration();
     
     void onStateChanged(FSM::NetworkState networkState, FSM::TransmissionState txState);
     void onTransmissionStart();
@@ -47,10 +112,10 @@ private:
     
     void startTransmission();
     void endTransmission();
-    void syncTime();
-    void periodicTimeSync();
+    bool syncTime();
     
     // WSPR modulation methods
+    void encodeWSPRFrames();
     void startWSPRModulation();
     void stopWSPRModulation();
     void modulateSymbol(int symbolIndex);
@@ -61,12 +126,18 @@ private:
     
     // Orchestration phases
     void waitForPlatformServices();
-    void loadAndValidateSettings();
     void initializeBeaconCore();
-    void startNetworkServices();
-    void startTransmissionScheduler();
     void mainOperationLoop();
     
+    // Startup graph nodes
+    void loadAndValidateSettings();
+    void initializeHardware();
+    void startWebServer();
+    void bringUpNetwork();
+    void enterReadyState();
+    void startTransmissionScheduler();
+    void logStartupTimeline();
+    
     // Band selection methods
     void initializeCurrentBand();
     void selectNextBand();
@@ -76,6 +147,8 @@ private:
     int getEnabledBandCount();
     
     // Next transmission prediction helpers
+    NextTransmissionInfo predictNextTransmission() const;
+    void publishNextTransmission();
     bool isBandEnabledForHour(const char* band, int hour) const;
     const char* predictNextBand(time_t futureTime) const;
     
@@ -91,7 +164,7 @@ private:
     FSM fsm;
     Scheduler scheduler;
     
-    bool running;
+    std::atomic<bool> running;
     time_t lastTimeSync;
     int timezoneOffset;  // Hours offset from UTC (-12 to +12)
     
@@ -107,11 +180,52 @@ private:
     bool usedBands[sizeof(BAND_NAMES) / sizeof(BAND_NAMES[0])];  // For tracking used bands in random mode
     bool firstTransmission;  // Track if this is the first transmission after initialization
     
-    // WSPR modulation state
-    WSPREncoder wsprEncoder;
+    // WSPR modulation state. Frames are packed two bits per symbol, encoded
+    // once per settings change (or baked into flash by fixed-identity builds)
+    // and alternated between transmissions (e.g. Type 1 then Type 3).
+    // Modulation only sees activeFrame, a mode-independent view. FST4W
+    // sends the same messages, so it follows the same rotation and encodes
+    // each frame as it is sent. toneTable holds the RF frequency of every
+    // tone, computed once per transmission from the mode.
+    WSPRFrameSet runtimeFrames;
+    const WSPRFrameSet* wsprFrames;
+    int nextWSPRFrame;
+    const ModeDescriptor* mode;
+    FST4WEncoder fst4wEncoder;
+    SymbolFrame activeFrame;
     int currentSymbolIndex;
     uint32_t baseFrequency;
+    double toneTable[ModeMaxTones];
     bool modulationActive;
+    uint32_t modulationRun;     // symbols queued by an earlier run are dropped
+    
+    // Calibration setpoints waiting for the main loop
+    LatestValue<double> calibrationFrequency;
+    LatestValue<int32_t> calibrationPreview;
+    
+    // The next transmission as predicted at publishedAt (UTC seconds), so
+    // the web server never reads the frames or band the loop is changing
+    struct PublishedNextTransmission {
+        NextTransmissionInfo info;
+        int64_t publishedAt;
+    };
+    LatestValue<PublishedNextTransmission> nextTransmission;
+    
+    // Main loop input and its statistics
+    EventQueue<Event, 64> events;
+    std::atomic<uint32_t> eventsHandled;
+    std::atomic<uint32_t> maxEventLatencyUs;
+    std::atomic<uint64_t> totalEventLatencyUs;
+    std::atomic<uint32_t> loopWakeups;
+    uint32_t droppedLogged;
+    Housekeeping housekeeping;   // main loop maintenance deadlines
+    
+    // Startup. linkUp is set by the network node and read only by the
+    // nodes that depend on it.
+    StartupGraph startup;
+    bool wantStation;            // try WiFi before falling back to AP
+    bool linkUp;                 // connected to WiFi as a station
+    std::atomic<int64_t> firstTransmissionUs;
     
     static constexpr const char* DEFAULT_SETTINGS_JSON = 
         "{"
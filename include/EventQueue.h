@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Bounded lock-free multi-producer, single-consumer queue.
+ *
+ * Any number of tasks or threads push; one consumer pops. Each slot
+ * carries a sequence number that says whether it is free for the producer
+ * at a given position or full for the consumer, so producers only contend
+ * on one compare-and-swap of the tail and never block or allocate. A push
+ * to a full queue fails at once and is counted rather than waiting.
+ *
+ * Values are copied in and out, so T should be a small trivially copyable
+ * struct. Capacity must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class EventQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  EventQueue() : head(0), tail(0), posted(0), dropped(0), maxDepth(0) {
+    for (size_t i = 0; i < Capacity; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Any thread. False, and counted as dropped, when the queue is full.
+  bool push(const T& value) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &slots[pos & (Capacity - 1)];
+      const intptr_t diff = (intptr_t) slot->sequence.load(std::memory_order_acquire) - (intptr_t) pos;
+      if (diff == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = value;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    posted.fetch_add(1, std::memory_order_relaxed);
+
+    // Depth as this producer saw it, for the high-water mark
+    const uint32_t depth = (uint32_t) (pos + 1 - head.load(std::memory_order_relaxed));
+    uint32_t seen = maxDepth.load(std::memory_order_relaxed);
+    while (depth > seen && !maxDepth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {}
+    return true;
+  }
+
+  // The consumer only. False when nothing is waiting.
+  bool pop(T& value) {
+    const size_t pos = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos & (Capacity - 1)];
+    if ((intptr_t) slot.sequence.load(std::memory_order_acquire) - (intptr_t) (pos + 1) < 0) return false;
+    value = slot.value;
+    slot.sequence.store(pos + Capacity, std::memory_order_release);
+    head.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Events waiting; a snapshot while producers are pushing
+  size_t size() const {
+    return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+  uint32_t getPosted() const { return posted.load(std::memory_order_relaxed); }
+  uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+  uint32_t getMaxDepth() const { return maxDepth.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Slot slots[Capacity];
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+  std::atomic<uint32_t> posted;
+  std::atomic<uint32_t> dropped;
+  std::atomic<uint32_t> maxDepth;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+/**
+ * Deadlines for the main loop's periodic maintenance.
+ *
+ * Each action has a period on the monotonic clock. The loop sleeps until
+ * waitMs() runs out unless an event arrives first, then runDue() runs what
+ * is due, so an idle loop wakes only when there is maintenance to do. An
+ * action that returns false is retried after its retry interval rather
+ * than a full period (e.g. an SNTP request that could not be sent).
+ * Slack works as TimerIntf::setSlack does: an action may run up to slackUs
+ * late, so it rides along with a wakeup the loop makes anyway.
+ */
+class Housekeeping {
+public:
+  typedef std::function<bool()> Action;
+  static constexpr int MaxActions = 4;
+  static constexpr uint32_t Forever = 0xFFFFFFFF;   // as EventGroupIntf::waitBits takes it
+
+  Housekeeping() : count(0) {}
+
+  // Run action first at firstUs, then every periodUs, each time up to
+  // slackUs late. False when full.
+  bool add(const Action& action, int64_t periodUs, int64_t retryUs, int64_t firstUs, int64_t slackUs = 0) {
+    if (count == MaxActions) return false;
+    entries[count++] = {action, periodUs, retryUs, slackUs, firstUs};
+    return true;
+  }
+
+  // Latest the loop may wake: the earliest deadline plus its slack, or
+  // INT64_MAX with nothing to do
+  int64_t nextDeadlineUs() const {
+    int64_t next = INT64_MAX;
+    for (int i = 0; i < count; ++i) {
+      const int64_t latestUs = entries[i].deadlineUs + entries[i].slackUs;
+      if (latestUs < next) next = latestUs;
+    }
+    return next;
+  }
+
+  // Milliseconds from nowUs to the next deadline, rounded up so the wait
+  // never ends just short of it; Forever with nothing to do
+  uint32_t waitMs(int64_t nowUs) const {
+    const int64_t next = nextDeadlineUs();
+    if (next == INT64_MAX) return Forever;
+    if (next <= nowUs) return 0;
+    const int64_t ms = (next - nowUs + 999) / 1000;
+    return ms >= Forever ? Forever - 1 : (uint32_t) ms;
+  }
+
+  // Run every action due at nowUs, slack or not, and set its next deadline
+  // from nowUs. Returns how many ran.
+  int runDue(int64_t nowUs) {
+    int ran = 0;
+    for (int i = 0; i < count; ++i) {
+      Entry& e = entries[i];
+      if (e.deadlineUs > nowUs) continue;
+      e.deadlineUs = nowUs + (e.action() ? e.periodUs : e.retryUs);
+      ++ran;
+    }
+    return ran;
+  }
+
+private:
+  struct Entry {
+    Action action;
+    int64_t periodUs;
+    int64_t retryUs;
+    int64_t slackUs;
+    int64_t deadlineUs;
+  };
+
+  Entry entries[MaxActions];
+  int count;
+};
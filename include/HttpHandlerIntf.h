@@ -91,8 +91,10 @@ public:
     HttpHandlerResult handleApiCalibrationStart(HttpRequestIntf* request, HttpResponseIntf* response);
     HttpHandlerResult handleApiCalibrationStop(HttpRequestIntf* request, HttpResponseIntf* response);
     HttpHandlerResult handleApiCalibrationAdjust(HttpRequestIntf* request, HttpResponseIntf* response);
+    HttpHandlerResult handleApiCalibrationPreview(HttpRequestIntf* request, HttpResponseIntf* response);
     HttpHandlerResult handleApiCalibrationCorrection(HttpRequestIntf* request, HttpResponseIntf* response);
     HttpHandlerResult handleApiWSPREncode(HttpRequestIntf* request, HttpResponseIntf* response);
+    HttpHandlerResult handleApiWSPREncodeBatch(HttpRequestIntf* request, HttpResponseIntf* response);
     
     // Utility methods
     static std::string formatTimeISO(int64_t unixTime);
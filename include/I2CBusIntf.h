@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Abstract interface for an I2C master bus.
+ * Each write() is one transaction: start, device address, the bytes, stop.
+ * Register devices take the first byte as the register address and
+ * auto-increment through the rest.
+ * Host implementation: counts transactions, bytes and bus time.
+ * Target implementation: wraps the ESP-IDF i2c_master driver.
+ */
+class I2CBusIntf {
+public:
+  virtual ~I2CBusIntf() {}
+
+  // Returns true if the device acknowledged every byte
+  virtual bool write(uint8_t addr, const uint8_t* data, size_t len) = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Latest-value-wins mailbox.
+ *
+ * Producers post() setpoints as fast as they arrive and each replaces the
+ * one before it; the consumer take()s only the newest, so a burst of posts
+ * between two takes costs one hardware update. Used for calibration, where
+ * the web page posts on every slider move. post() says when the mailbox
+ * was empty, so the consumer is woken once per burst rather than per post.
+ * get() reads the newest value without taking it, for a snapshot one task
+ * publishes and others read.
+ */
+template <typename T>
+class LatestValue {
+public:
+  // True if nothing was pending, so the consumer has to be told
+  bool post(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const bool wasEmpty = !pending;
+    if (pending) ++superseded;
+    latest = value;
+    pending = true;
+    ++posted;
+    return wasEmpty;
+  }
+
+  // The newest value posted since the last take, if any
+  bool take(T& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!pending) return false;
+    value = latest;
+    pending = false;
+    return true;
+  }
+
+  // The newest value posted, taken or not, for readers that only look
+  T get() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return latest;
+  }
+
+  // Drops a value not yet taken
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending = false;
+  }
+
+  uint32_t getPosted() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return posted;
+  }
+
+  // Posts replaced before they were taken
+  uint32_t getSuperseded() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return superseded;
+  }
+
+private:
+  mutable std::mutex mutex;
+  T latest{};
+  bool pending = false;
+  uint32_t posted = 0;
+  uint32_t superseded = 0;
+};
@@ -5,6 +5,9 @@
 #include "LoggerIntf.h"
 #include "RandomIntf.h"
 #include "TimeIntf.h"
+#include "ModeDescriptor.h"
+#include <atomic>
+#include <cstdint>
 #include <ctime>
 #include <functional>
 
@@ -12,12 +15,31 @@ class Scheduler {
 public:
     using TransmissionCallback = std::function<void()>;
 
+    // What a scheduler timer fired for
+    enum class Wake : uint8_t {
+        Slot,               // a slot boundary: roll for a transmission
+        TransmissionEnd
+    };
+
+    // Runs on the timer task with the wake and the generation it fired in;
+    // it should only hand both to the owner's thread, which passes them to
+    // handleWake()
+    using WakeCallback = std::function<void(Wake wake, uint32_t generation)>;
+
     explicit Scheduler(TimerIntf* timer, SettingsIntf* settings, LoggerIntf* logger = nullptr, RandomIntf* random = nullptr, TimeIntf* time = nullptr);
     ~Scheduler();
 
     void setTransmissionStartCallback(TransmissionCallback callback);
     void setTransmissionEndCallback(TransmissionCallback callback);
 
+    // Without a wake callback the timers call handleWake() themselves, on
+    // the timer task
+    void setWakeCallback(WakeCallback callback);
+
+    // On the thread that owns the scheduler. A transmission end from before
+    // the last start, stop or cancel is ignored.
+    void handleWake(Wake wake, uint32_t generation);
+
     void start();
     void stop();
     void cancelCurrentTransmission();
@@ -25,6 +47,12 @@ public:
     bool isTransmissionInProgress() const;
     bool isValidTransmissionTime() const;
     
+    // Slot period, start offset and transmission length all come from the
+    // mode; WSPR until set. Takes effect from the next slot.
+    void setMode(const ModeDescriptor* mode);
+    const ModeDescriptor* getMode() const;
+    double getTransmissionDurationSec() const;
+
     void setCalibrationMode(bool enabled);
     bool isCalibrationMode() const;
     
@@ -35,11 +63,16 @@ public:
     // considering txPct, band schedules, and enabled bands
     int getSecondsUntilNextActualTransmission() const;
 
-    static constexpr double WSPR_TRANSMISSION_DURATION_SEC = 110.592;
+    static constexpr double WSPR_TRANSMISSION_DURATION_SEC = wsprMode.durationSec();
     static constexpr int WSPR_START_OFFSET_SEC = 1;  // Not used in new implementation
+    static constexpr int OPPORTUNITY_WINDOW_SEC = 2; // A slot's first seconds may still start it
 
 private:
+    void wake(Wake wake);
     void checkTransmissionOpportunity();
+    void armNextSlot();
+    int secondsIntoSlot(time_t t) const;
+    time_t utcNowSec() const;
     void startTransmission();
     void onTransmissionEnd();
     bool isBandEnabledForCurrentHour() const;
@@ -55,14 +88,17 @@ private:
     RandomIntf* random;
     TimeIntf* time;
     
-    TimerIntf::Timer* schedulerTimer;
+    TimerIntf::Timer* schedulerTimer;        // one-shot, re-armed for each slot boundary
     TimerIntf::Timer* transmissionEndTimer;
     
     TransmissionCallback onTransmissionStartCallback;
     TransmissionCallback onTransmissionEndCallback;
+    WakeCallback onWakeCallback;
+    std::atomic<uint32_t> generation;        // bumped by start, stop and cancel; read by the timers
     
     bool transmissionInProgress;
     bool schedulerActive;
-    bool waitingForNextOpportunity;
+    time_t lastOpportunitySlot;              // start of the slot last rolled for, or -1
     bool calibrationMode;
+    const ModeDescriptor* mode;
 };
\ No newline at end of file
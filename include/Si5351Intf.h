@@ -11,9 +11,23 @@ public:
   virtual void enableOutput(int channel, bool enable) = 0;
   virtual void reset() = 0;
   virtual void setCalibration(int32_t correction) = 0;
+
+  // Calibration fine-tuning. Both keep the PLL that setFrequency() locked
+  // and move only the output's fractional divider, so the output does not
+  // glitch. fineTune() moves the channel to freqHz; previewCorrection()
+  // shows what a crystal correction of ppb would do to the current
+  // frequency without changing the calibration; setFrequency() and
+  // setCalibration() end the preview. Without a locked PLL fineTune() falls
+  // back to setFrequency().
+  virtual void fineTune(int channel, double freqHz) = 0;
+  virtual void previewCorrection(int channel, int32_t ppb) = 0;
   
-  // Smooth frequency transition methods for WSPR
-  virtual void setupChannelSmooth(int channel, double baseFreqHz, const double* wspr_freqs) = 0;
+  // Smooth frequency transition methods for WSPR. setupChannelSmooth()
+  // takes the toneCount tone frequencies of a transmission (up to four) and
+  // precomputes their register values; selectChannelTone() then switches to
+  // tone 0..toneCount-1 with a single register burst.
+  virtual void setupChannelSmooth(int channel, double baseFreqHz, const double* toneFreqs, int toneCount) = 0;
+  virtual void selectChannelTone(int channel, int tone) = 0;
   virtual void updateChannelFrequency(int channel, double newFreqHz) = 0;
   virtual void updateChannelFrequencyMinimal(int channel, double newFreqHz) = 0;
 };
\ No newline at end of file
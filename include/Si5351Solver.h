@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Exact-integer Si5351 frequency solver.
+ *
+ * Targets are in millihertz and the crystal correction in parts per
+ * billion, so nothing is rounded to whole hertz. The chip divides by
+ * (P1 + 512 + P2/P3) / 128 in both the PLL feedback and the output
+ * multisynth, so any ratio n / (128 c) with c up to 2^20-1 can be set. The
+ * solver finds the best such n / c by continued fractions (the
+ * Stern-Brocot best approximation with a bounded denominator).
+ *
+ * Two layouts are tried and the one with the smaller error wins:
+ *   - an integer output divider (4, 6 or 8-2048, integer mode when even)
+ *     with a fractional PLL, sampled across the 600-900 MHz VCO range
+ *   - an integer PLL with a fractional output divider
+ * Outputs below ~293 kHz also use the R divider.
+ *
+ * Everything is 64-bit integer arithmetic with no 128-bit types, so it
+ * runs on the ESP32. The error is exact: achieved minus target
+ * frequency, in nanohertz, for the corrected crystal.
+ */
+struct Si5351Params {
+  uint32_t p1;
+  uint32_t p2;
+  uint32_t p3;
+};
+
+struct Si5351Solution {
+  bool ok = false;
+  Si5351Params pll = {};        // feedback multisynth, PLL = crystal * (P1 + 512 + P2/P3) / 128
+  Si5351Params ms = {};         // output multisynth
+  uint8_t msDivBy4 = 0;         // 3 when the output divides by exactly 4
+  bool msInteger = false;       // even integer output divider: integer mode
+  uint8_t rDivLog2 = 0;         // output R divider, 1 << rDivLog2
+  int64_t errorNanoHz = 0;      // achieved - target
+};
+
+class Si5351Solver {
+public:
+  static constexpr uint32_t MaxDenominator = 1048575;
+  static constexpr uint64_t MinVcoNanoHz = 600000000ULL * 1000000000ULL;
+  static constexpr uint64_t MaxVcoNanoHz = 900000000ULL * 1000000000ULL;
+  static constexpr int MaxDividerCandidates = 16;
+
+  // Best n/c with c <= maxDen for 128 * num / den. den must be below
+  // 2^57 so 128 * den fits.
+  static void bestRational128(uint64_t num, uint64_t den, uint32_t maxDen, uint64_t& n, uint32_t& c) {
+    // First term: 128 * num / den without the 128 * num overflow
+    const uint64_t whole = num / den, rem = num % den;
+    uint64_t a = 128 * whole + (128 * rem) / den;
+    uint64_t p = den, q = (128 * rem) % den;
+
+    // Convergents h/k, starting from h_-2/k_-2 = 0/1 and h_-1/k_-1 = 1/0
+    uint64_t h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+    while (true) {
+      const uint64_t k2 = a * k1 + k0;
+      if (k2 > maxDen) {
+        // The best bounded approximation is this convergent or the
+        // semiconvergent with the largest denominator that fits. The
+        // complete quotient is a + q/p, so the semiconvergent is closer
+        // when 2t > a, or 2t == a and k1 q < k0 p.
+        const uint64_t t = k1 ? (maxDen - k0) / k1 : 0;
+        if (2 * t > a || (2 * t == a && t > 0 && productLess(q, (uint32_t) k1, p, (uint32_t) k0))) {
+          h1 = t * h1 + h0;
+          k1 = t * k1 + k0;
+        }
+        break;
+      }
+      const uint64_t h2 = a * h1 + h0;
+      h0 = h1; h1 = h2;
+      k0 = k1; k1 = k2;
+      if (q == 0) break;
+
+      a = p / q;
+      const uint64_t r = p - a * q;
+      p = q;
+      q = r;
+    }
+    n = h1;
+    c = (uint32_t) k1;
+  }
+
+  static Si5351Solution solve(uint64_t targetMilliHz, uint32_t xtalHz, int32_t correctionPpb) {
+    Si5351Solution best;
+    if (targetMilliHz == 0 || xtalHz == 0 || correctionPpb <= -1000000000) return best;
+
+    // Crystal and target in nanohertz
+    const uint64_t xtal = (uint64_t) xtalHz * (uint64_t) (1000000000LL + correctionPpb);
+    const uint64_t target = targetMilliHz * 1000000;
+    if (targetMilliHz > 200000000000ULL || xtal >= (1ULL << 57)) return best;
+
+    // R divider so the output multisynth stays at or below 2048
+    uint8_t rDivLog2 = 0;
+    while (rDivLog2 < 7 && (target << rDivLog2) < MinVcoNanoHz / 2048) ++rDivLog2;
+    const uint64_t fR = target << rDivLog2;
+    if (fR < MinVcoNanoHz / 2048) return best;
+
+    // Integer output divider, fractional PLL
+    uint64_t dMin = (MinVcoNanoHz + fR - 1) / fR, dMax = MaxVcoNanoHz / fR;
+    if (dMax > 2048) dMax = 2048;
+    const uint64_t span = dMax >= dMin ? dMax - dMin : 0;
+    const uint64_t step = span / MaxDividerCandidates + 1;
+    for (uint64_t d = dMax; d >= dMin && d >= 4; d = d > step ? d - step : 0) {
+      if (d == 5 || d == 7) continue;
+      const uint64_t vco = fR * d;
+
+      uint64_t n;
+      uint32_t c;
+      bestRational128(vco, xtal, MaxDenominator, n, c);
+      if (n < 128ULL * 15 * c || n > 128ULL * 90 * c) continue;
+
+      // Xtal * n / (128 c) - vco, over d R; the numerator is small even
+      // though its terms wrap
+      const int64_t num = (int64_t) (xtal * n - 128 * (uint64_t) c * vco);
+      const int64_t error = num / (int64_t) (128 * (uint64_t) c * d << rDivLog2);
+
+      Si5351Solution s;
+      s.ok = true;
+      s.pll = {(uint32_t) (n / c - 512), (uint32_t) (n % c), c};
+      s.ms = d == 4 ? Si5351Params{0, 0, 1} : Si5351Params{(uint32_t) (128 * d - 512), 0, 1};
+      s.msDivBy4 = d == 4 ? 3 : 0;
+      s.msInteger = (d & 1) == 0;
+      s.rDivLog2 = rDivLog2;
+      s.errorNanoHz = error;
+      if (!best.ok || magnitude(error) < magnitude(best.errorNanoHz)) best = s;
+      if (error == 0) break;
+    }
+
+    // Integer PLL, fractional output divider
+    if (fR * 8 < MaxVcoNanoHz) {
+      for (uint64_t m = (MinVcoNanoHz + xtal - 1) / xtal; m * xtal <= MaxVcoNanoHz && m <= 90; ++m) {
+        if (best.ok && best.errorNanoHz == 0) break;
+        if (m < 15) continue;
+        const uint64_t vco = xtal * m;
+
+        uint64_t n;
+        uint32_t c;
+        bestRational128(vco, fR, MaxDenominator, n, c);
+        if (n <= 128ULL * 8 * c || n > 128ULL * 2048 * c) continue;
+
+        // 128 c vco / (n R) - target
+        const int64_t num = (int64_t) (128 * (uint64_t) c * vco - n * fR);
+        const int64_t error = num / (int64_t) (n << rDivLog2);
+
+        if (best.ok && magnitude(error) >= magnitude(best.errorNanoHz)) continue;
+        best.ok = true;
+        best.pll = {(uint32_t) (128 * m - 512), 0, 1};
+        best.ms = {(uint32_t) (n / c - 512), (uint32_t) (n % c), c};
+        best.msDivBy4 = 0;
+        best.msInteger = false;
+        best.rDivLog2 = rDivLog2;
+        best.errorNanoHz = error;
+      }
+    }
+
+    return best;
+  }
+
+  // A small move of a solved output that keeps its PLL locked: the output
+  // multisynth's fraction is re-solved against locked's PLL, so only the
+  // eight MS bytes change and no PLL reset is needed. Outputs dividing by
+  // 4 or 6 (2 m) have no fractional divider, so their PLL fraction moves
+  // instead. Fails when the new divider falls outside the chip's range.
+  static Si5351Solution retune(uint64_t targetMilliHz, uint32_t xtalHz, int32_t correctionPpb,
+                               const Si5351Solution& locked) {
+    Si5351Solution s = locked;
+    s.ok = false;
+    if (!locked.ok || targetMilliHz == 0 || correctionPpb <= -1000000000) return s;
+
+    const uint64_t xtal = (uint64_t) xtalHz * (uint64_t) (1000000000LL + correctionPpb);
+    const uint64_t fR = (targetMilliHz * 1000000) << locked.rDivLog2;
+    if (targetMilliHz > 200000000000ULL || xtal >= (1ULL << 57)) return s;
+
+    const uint32_t msWhole = (locked.ms.p1 + 512) / 128;
+    if (locked.msDivBy4 || (msWhole < 8 && locked.ms.p2 == 0)) {
+      const uint64_t d = locked.msDivBy4 ? 4 : msWhole;
+      if (fR * d < MinVcoNanoHz || fR * d > MaxVcoNanoHz) return s;
+      uint64_t n;
+      uint32_t c;
+      bestRational128(fR * d, xtal, MaxDenominator, n, c);
+      if (n < 128ULL * 15 * c || n > 128ULL * 90 * c) return s;
+      s.pll = {(uint32_t) (n / c - 512), (uint32_t) (n % c), c};
+      s.errorNanoHz = (int64_t) (xtal * n - 128 * (uint64_t) c * fR * d) / (int64_t) (128 * (uint64_t) c * d << s.rDivLog2);
+      s.ok = true;
+      return s;
+    }
+
+    // VCO of the locked PLL, crystal * (P1 + 512 + P2/P3) / 128, in
+    // nanohertz; split so no product overflows
+    const uint64_t whole = (locked.pll.p1 + 512) / 128;
+    const uint64_t fracNum = (uint64_t) ((locked.pll.p1 + 512) % 128) * locked.pll.p3 + locked.pll.p2;
+    const uint64_t fracDen = 128 * (uint64_t) locked.pll.p3;
+    const uint64_t vco = xtal * whole + (xtal / fracDen) * fracNum + (xtal % fracDen) * fracNum / fracDen;
+
+    uint64_t n;
+    uint32_t c;
+    bestRational128(vco, fR, MaxDenominator, n, c);
+    if (n < 128ULL * 8 * c || n > 128ULL * 2048 * c) return s;
+    s.ms = {(uint32_t) (n / c - 512), (uint32_t) (n % c), c};
+    s.msInteger = false;
+    s.errorNanoHz = (int64_t) (128 * (uint64_t) c * vco - n * fR) / (int64_t) (n << s.rDivLog2);
+    s.ok = true;
+    return s;
+  }
+
+  // The eight register bytes of a multisynth (26-33 for PLL A, 42-49 for
+  // MS0), ready for one burst write
+  static void registers(const Si5351Params& p, uint8_t divBy4, uint8_t rDivLog2, uint8_t out[8]) {
+    out[0] = (uint8_t) (p.p3 >> 8);
+    out[1] = (uint8_t) p.p3;
+    out[2] = (uint8_t) (((p.p1 >> 16) & 0x3) | ((divBy4 & 0x3) << 2) | ((rDivLog2 & 0x7) << 4));
+    out[3] = (uint8_t) (p.p1 >> 8);
+    out[4] = (uint8_t) p.p1;
+    out[5] = (uint8_t) (((p.p3 >> 12) & 0xF0) | ((p.p2 >> 16) & 0xF));
+    out[6] = (uint8_t) (p.p2 >> 8);
+    out[7] = (uint8_t) p.p2;
+  }
+
+private:
+  static uint64_t magnitude(int64_t v) { return v < 0 ? (uint64_t) -v : (uint64_t) v; }
+
+  // a * b < c * d, with the products held as two 64-bit halves
+  static bool productLess(uint64_t a, uint32_t b, uint64_t c, uint32_t d) {
+    uint64_t aHi, aLo, cHi, cLo;
+    multiply(a, b, aHi, aLo);
+    multiply(c, d, cHi, cLo);
+    return aHi < cHi || (aHi == cHi && aLo < cLo);
+  }
+
+  static void multiply(uint64_t a, uint32_t b, uint64_t& hi, uint64_t& lo) {
+    const uint64_t low = (a & 0xFFFFFFFF) * b, high = (a >> 32) * b;
+    lo = low + (high << 32);
+    hi = (high >> 32) + (lo < low);
+  }
+};
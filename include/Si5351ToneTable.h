@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Si5351 multisynth settings for every tone of one transmission.
+ *
+ * compute() runs once before the first symbol. The PLL is run in integer
+ * mode as close to 900 MHz as the crystal allows. Each tone gets its own
+ * divider P1 + P2/P3 with P3 at the 20-bit maximum. That steps the output
+ * by f / (128 * P3 * divider): under 0.004 Hz at 10 m, 0.0002 Hz at 160 m.
+ * Frequencies are doubles, so tone spacings like 12000/8192 Hz are kept
+ * exactly.
+ *
+ * Each tone keeps its eight MS register bytes (42-49 for CLK0) ready to
+ * send. Only bytes from burstStart on differ between tones, so changing
+ * tone is one burst write of those bytes.
+ */
+struct Si5351ToneTable {
+  static constexpr int MaxTones = 4;
+  static constexpr double MaxPllHz = 900000000.0;
+  static constexpr uint32_t Denominator = 1048575;   // P3
+
+  struct Tone {
+    uint32_t p1;
+    uint32_t p2;
+    uint8_t regs[8];
+  };
+
+  double pllHz = 0;
+  double scale = 1.0;          // correction applied to every tone
+  uint8_t pllMult = 0;         // integer PLL: crystal * pllMult
+  uint8_t rDivLog2 = 0;        // output R divider, 1 << rDivLog2
+  uint8_t burstStart = 8;      // first register that differs between tones
+  int toneCount = 0;
+  Tone tones[MaxTones] = {};
+
+  // Correction is in the units Si5351Intf::setCalibration() takes: a tone
+  // is programmed as hz - hz * correction / 1e8. Returns false if a tone
+  // cannot be reached with a fractional multisynth (above ~112 MHz).
+  bool compute(uint32_t xtalHz, int32_t correction, const double* toneHz, int count) {
+    toneCount = 0;
+    if (count < 1 || count > MaxTones || xtalHz == 0) return false;
+
+    uint32_t mult = (uint32_t) (MaxPllHz / xtalHz);
+    if (mult < 15) mult = 15;
+    if (mult > 90) mult = 90;
+    pllMult = (uint8_t) mult;
+    pllHz = (double) xtalHz * mult;
+
+    scale = 1.0 - correction / 1e8;
+    double lowest = toneHz[0];
+    for (int i = 1; i < count; ++i) lowest = toneHz[i] < lowest ? toneHz[i] : lowest;
+    if (!(lowest > 0)) return false;
+
+    // Low bands divide further in the R divider to keep the multisynth
+    // below 2048
+    rDivLog2 = 0;
+    while (rDivLog2 < 7 && pllHz / (lowest * scale * (1 << rDivLog2)) >= 2048.0) ++rDivLog2;
+
+    for (int i = 0; i < count; ++i) {
+      const double ratio128 = 128.0 * pllHz / (toneHz[i] * scale * (1 << rDivLog2));
+      if (!(ratio128 > 128.0 * 8 && ratio128 < 128.0 * 2048)) return false;
+
+      const double whole = std::floor(ratio128);
+      Tone& t = tones[i];
+      t.p1 = (uint32_t) whole - 512;
+      t.p2 = (uint32_t) std::lround((ratio128 - whole) * Denominator);
+      if (t.p2 >= Denominator) {
+        ++t.p1;
+        t.p2 = 0;
+      }
+
+      t.regs[0] = (uint8_t) (Denominator >> 8);
+      t.regs[1] = (uint8_t) Denominator;
+      t.regs[2] = (uint8_t) (((t.p1 >> 16) & 0x3) | (rDivLog2 << 4));
+      t.regs[3] = (uint8_t) (t.p1 >> 8);
+      t.regs[4] = (uint8_t) t.p1;
+      t.regs[5] = (uint8_t) (((Denominator >> 12) & 0xF0) | ((t.p2 >> 16) & 0xF));
+      t.regs[6] = (uint8_t) (t.p2 >> 8);
+      t.regs[7] = (uint8_t) t.p2;
+    }
+
+    burstStart = 8;
+    for (int r = 0; r < 8 && burstStart == 8; ++r) {
+      for (int i = 1; i < count; ++i) {
+        if (tones[i].regs[r] != tones[0].regs[r]) {
+          burstStart = (uint8_t) r;
+          break;
+        }
+      }
+    }
+
+    toneCount = count;
+    return true;
+  }
+
+  // Output frequency for a tone with the crystal exactly on its nominal
+  // frequency, i.e. the tone as programmed
+  double toneHz(int tone) const {
+    const Tone& t = tones[tone];
+    return 128.0 * pllHz / (t.p1 + 512 + (double) t.p2 / Denominator) / (1 << rDivLog2);
+  }
+
+  // Tone closest to hz, as passed to compute()
+  int nearestTone(double hz) const {
+    int best = 0;
+    hz *= scale;
+    for (int i = 1; i < toneCount; ++i) {
+      if (std::fabs(toneHz(i) - hz) < std::fabs(toneHz(best) - hz)) best = i;
+    }
+    return best;
+  }
+};
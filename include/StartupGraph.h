@@ -0,0 +1,165 @@
+#pragma once
+
+#include "TaskIntf.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+
+/**
+ * Startup phases as a dependency graph.
+ *
+ * Each node is an action and the earlier nodes it must follow. run() starts
+ * every node on its own control-class task as soon as all its dependencies
+ * have finished, so independent phases (e.g. hardware init and WiFi)
+ * overlap, and returns once every node is done. A node that throws fails,
+ * and so does everything after it, without running. Because dependencies
+ * must already have been added, the graph cannot have a cycle.
+ *
+ * Each node's start and end are kept as a timeline in microseconds from
+ * the start of run(), readable from any task while startup is under way.
+ */
+class StartupGraph {
+public:
+  typedef std::function<void()> Action;
+  typedef std::function<int64_t()> Clock;    // monotonic microseconds
+  static constexpr int MaxNodes = 10;
+
+  struct Timing {
+    const char* name;
+    int64_t startUs;    // from the start of run(); -1 until the node starts
+    int64_t endUs;      // -1 until it finishes
+    bool failed;        // threw, or was skipped because a dependency failed
+  };
+
+  StartupGraph() : count(0), startUs(0) {}
+
+  // Returns the node's id, or -1 when full or a dependency is not an
+  // earlier node
+  int add(const char* name, const Action& action, std::initializer_list<int> after = {}) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == MaxNodes) return -1;
+    uint32_t deps = 0;
+    for (int id : after) {
+      if (id < 0 || id >= count) return -1;
+      deps |= 1u << id;
+    }
+    nodes[count] = {action, deps, State::Waiting, {name, -1, -1, false}};
+    return count++;
+  }
+
+  // Run the graph, one task per node. Blocks until every node has finished
+  // or been skipped; false if any failed.
+  bool run(TaskIntf* tasks, const Clock& clock, int stackSize = 8192) {
+    TaskIntf::Task* handles[MaxNodes] = {};
+    bool ok = true;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      now = clock;
+      startUs = now();
+      int finished = 0;
+      while (finished < count) {
+        // Skipping a node may skip its dependents, so scan until nothing
+        // changes before waiting
+        bool changed = true;
+        while (changed) {
+          changed = false;
+          for (int i = 0; i < count; ++i) {
+            Node& node = nodes[i];
+            if (node.state != State::Waiting) continue;
+            if (node.deps & failedMask()) {
+              node.state = State::Done;
+              node.timing.failed = true;
+              ++finished;
+              changed = true;
+            } else if ((node.deps & doneMask()) == node.deps) {
+              node.state = State::Running;
+              node.timing.startUs = now() - startUs;
+              handles[i] = tasks->start(node.timing.name, TaskIntf::Class::Control, [this, i]() { this->runNode(i); },
+                                        stackSize);
+              if (!handles[i]) {
+                node.state = State::Done;
+                node.timing.endUs = node.timing.startUs;
+                node.timing.failed = true;
+                ++finished;
+                changed = true;
+              }
+            }
+          }
+        }
+        if (finished == count) break;
+        nodeDone.wait(lock);
+        finished = 0;
+        for (int i = 0; i < count; ++i) finished += nodes[i].state == State::Done;
+      }
+      ok = failedMask() == 0;
+    }
+
+    for (int i = 0; i < MaxNodes; ++i) {
+      if (handles[i]) tasks->destroy(handles[i]);
+    }
+    return ok;
+  }
+
+  // Copy up to max timings into out; returns how many
+  int getTimeline(Timing* out, int max) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    int n = 0;
+    for (; n < count && n < max; ++n) out[n] = nodes[n].timing;
+    return n;
+  }
+
+  // Microseconds since run() started, on its clock; -1 before that
+  int64_t elapsedUs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return now ? now() - startUs : -1;
+  }
+
+private:
+  enum class State : uint8_t { Waiting, Running, Done };
+
+  struct Node {
+    Action action;
+    uint32_t deps;      // bit per earlier node
+    State state;
+    Timing timing;
+  };
+
+  void runNode(int i) {
+    bool ok = true;
+    try {
+      nodes[i].action();
+    } catch (...) {
+      ok = false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    nodes[i].timing.endUs = now() - startUs;
+    nodes[i].timing.failed = !ok;
+    nodes[i].state = State::Done;
+    nodeDone.notify_all();
+  }
+
+  uint32_t doneMask() const {
+    uint32_t mask = 0;
+    for (int i = 0; i < count; ++i) {
+      if (nodes[i].state == State::Done && !nodes[i].timing.failed) mask |= 1u << i;
+    }
+    return mask;
+  }
+
+  uint32_t failedMask() const {
+    uint32_t mask = 0;
+    for (int i = 0; i < count; ++i) {
+      if (nodes[i].state == State::Done && nodes[i].timing.failed) mask |= 1u << i;
+    }
+    return mask;
+  }
+
+  Node nodes[MaxNodes];
+  int count;
+  Clock now;
+  int64_t startUs;
+  mutable std::mutex mutex;
+  std::condition_variable nodeDone;
+};
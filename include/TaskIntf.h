@@ -9,6 +9,24 @@ public:
     virtual ~Task() {}
   };
 
+  // Execution classes, most time-critical first. Each platform maps a class
+  // to a core and a priority, keeping timing-critical work away from the
+  // web server and logging.
+  enum class Class {
+    RtModulation,   // symbol timing
+    Control,        // beacon startup and control
+    Network,        // WiFi, HTTP
+    Background      // logging, housekeeping
+  };
+
+  // Where a task actually runs, which may be less than its class asked for
+  // (e.g. a host process not permitted real-time scheduling)
+  struct Placement {
+    int core;         // the core it is pinned to, or -1 for any
+    int priority;     // on the platform's scale; higher runs first
+    bool realtime;    // preempts ordinary work
+  };
+
   virtual ~TaskIntf() {}
 
   // Start a new task/thread, returns a Task object pointer
@@ -17,6 +35,13 @@ public:
   // Overload to support std::function, if desired
   virtual Task *start(const char *name, const std::function<void()> &func, int stackSize = 4096, int priority = 1) = 0;
 
+  // Start a task placed by its execution class
+  virtual Task *start(const char *name, Class cls, const std::function<void()> &func, int stackSize = 4096) = 0;
+
+  // Effective placement of a running task, or of the calling task when
+  // task is null
+  virtual Placement getPlacement(Task *task) = 0;
+
   // Stop a running task
   virtual void stop(Task *task) = 0;
 
@@ -25,4 +50,14 @@ public:
 
   // Destroy task object and release resources
   virtual void destroy(Task *task) = 0;
-};
\ No newline at end of file
+
+  static const char *className(Class cls) {
+    switch (cls) {
+      case Class::RtModulation: return "rt-modulation";
+      case Class::Control:      return "control";
+      case Class::Network:      return "network";
+      case Class::Background:   return "background";
+    }
+    return "unknown";
+  }
+};
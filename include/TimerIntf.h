@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <ctime>
+#include <cstdint>
 
 // Abstract timer interface and timer object for cross-platform use.
 
@@ -12,6 +13,10 @@ public:
     virtual ~Timer() {}
   };
 
+  // The clock an absolute deadline is on: microseconds since boot, or
+  // microseconds of UTC since the Unix epoch, which SNTP or setTime() may step
+  enum class Clock { Monotonic, Utc };
+
   virtual ~TimerIntf() {}
 
   // Create a one-shot timer (fires after timeout, once)
@@ -23,6 +28,19 @@ public:
   // Start the timer; timeoutMs is in milliseconds
   virtual void start(Timer *timer, unsigned int timeoutMs) = 0;
 
+  // Start the timer to fire at deadlineUs on clock; a deadline already past
+  // fires at once. A UTC deadline is re-armed when the wall clock steps, so
+  // it still fires at that wall-clock instant. A periodic timer then repeats
+  // every periodMs after the deadline.
+  virtual void startAt(Timer *timer, int64_t deadlineUs, Clock clock, unsigned int periodMs = 0) = 0;
+
+  // Let the timer fire up to slackMs after each deadline so it can share a
+  // wakeup with other timers; 0, the default, fires as close as possible
+  virtual void setSlack(Timer *timer, unsigned int slackMs) = 0;
+
+  // Current time on clock, in microseconds
+  virtual int64_t nowUs(Clock clock) = 0;
+
   // Stop the timer if running
   virtual void stop(Timer *timer) = 0;
 
@@ -40,4 +58,16 @@ public:
   
   // Get current time (for testing/mocking)
   virtual time_t getCurrentTime() = 0;
+
+protected:
+  // A deadline moved later, by at most slackMs, onto a grid of the largest
+  // power-of-two milliseconds within the slack. Timers with slack then land
+  // on shared grid points and fire in one wakeup.
+  static int64_t coalesceUs(int64_t deadlineUs, unsigned int slackMs) {
+    if (slackMs == 0) return deadlineUs;
+    int64_t gridUs = 1000;
+    while (gridUs * 2 <= (int64_t) slackMs * 1000) gridUs *= 2;
+    const int64_t rem = deadlineUs % gridUs;
+    return rem == 0 ? deadlineUs : deadlineUs + (rem > 0 ? gridUs - rem : -rem);
+  }
 };
\ No newline at end of file
@@ -15,13 +15,15 @@ public:
     virtual ~WSPRModulatorIntf() = default;
     
     /**
-     * Start WSPR modulation with precise 683ms symbol timing
+     * Start modulation with precise symbol timing
      * 
      * @param symbolCallback Function called for each symbol (0-161)
      * @param totalSymbols Total number of symbols to transmit (162 for WSPR)
+     * @param symbolPeriodMs Symbol period (683ms for WSPR, longer for FST4W)
      * @return true if modulation started successfully
      */
-    virtual bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols) = 0;
+    virtual bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols,
+                                 int symbolPeriodMs) = 0;
     
     /**
      * Stop WSPR modulation and clean up resources
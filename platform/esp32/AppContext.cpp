@@ -30,7 +30,7 @@ AppContext::AppContext() {
   timer = new Timer();
   task = new Task();
   eventGroup = new EventGroup();
-  wsprModulator = new WSPRModulator();
+  wsprModulator = new WSPRModulator(task);
 }
 
 AppContext::~AppContext() {
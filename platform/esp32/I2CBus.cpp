@@ -0,0 +1,58 @@
+#include "I2CBus.h"
+#include "driver/i2c_master.h"
+#include "esp_log.h"
+
+static const char *TAG = "I2CBus";
+
+I2CBus::I2CBus(uint8_t sdaPin, uint8_t sclPin, uint32_t sclHz)
+  : busHandle(nullptr), devCount(0), sclHz(sclHz) {
+  i2c_master_bus_config_t busConfig = {
+    .i2c_port = I2C_NUM_0,
+    .sda_io_num = (gpio_num_t)sdaPin,
+    .scl_io_num = (gpio_num_t)sclPin,
+    .clk_source = I2C_CLK_SRC_DEFAULT,
+    .glitch_ignore_cnt = 7,
+    .intr_priority = 0,
+    .trans_queue_depth = 0,
+    .flags = {
+      .enable_internal_pullup = true,
+      .allow_pd = false
+    }
+  };
+  ESP_LOGI(TAG, "i2c_new_master_bus sdaPin=%u, sclPin=%u", sdaPin, sclPin);
+  ESP_ERROR_CHECK(i2c_new_master_bus(&busConfig, (i2c_master_bus_handle_t*)&busHandle));
+}
+
+I2CBus::~I2CBus() {
+  for (int i = 0; i < devCount; i++) {
+    i2c_master_bus_rm_device((i2c_master_dev_handle_t)devHandle[i]);
+  }
+  if (busHandle) {
+    i2c_del_master_bus((i2c_master_bus_handle_t)busHandle);
+  }
+}
+
+bool I2CBus::write(uint8_t addr, const uint8_t* data, size_t len) {
+  int dev = 0;
+  while (dev < devCount && devAddr[dev] != addr) dev++;
+
+  if (dev == devCount) {
+    if (devCount == maxDevices) return false;
+    i2c_device_config_t devConfig = {
+      .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+      .device_address = addr,
+      .scl_speed_hz = sclHz,
+      .scl_wait_us = 0,
+      .flags = 0,
+    };
+    ESP_LOGI(TAG, "i2c_master_bus_add_device addr=%02X", (int) addr);
+    if (i2c_master_bus_add_device((i2c_master_bus_handle_t)busHandle, &devConfig,
+                                  (i2c_master_dev_handle_t*)&devHandle[dev]) != ESP_OK) {
+      return false;
+    }
+    devAddr[dev] = addr;
+    devCount++;
+  }
+
+  return i2c_master_transmit((i2c_master_dev_handle_t)devHandle[dev], data, len, -1) == ESP_OK;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "I2CBusIntf.h"
+
+class I2CBus : public I2CBusIntf {
+public:
+  I2CBus(uint8_t sdaPin, uint8_t sclPin, uint32_t sclHz = 100000);
+  ~I2CBus() override;
+
+  bool write(uint8_t addr, const uint8_t* data, size_t len) override;
+
+private:
+  static const int maxDevices = 4;
+
+  void* busHandle;                  // i2c_master_bus_handle_t
+  void* devHandle[maxDevices];      // i2c_master_dev_handle_t, added on first use
+  uint8_t devAddr[maxDevices];
+  int devCount;
+  uint32_t sclHz;
+};
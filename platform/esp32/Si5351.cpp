@@ -1,5 +1,7 @@
 #include "Si5351.h"
 #include "../../target-esp32/components/si5351/include/si5351.h"
+#include "I2CBus.h"
+#include <cmath>
 #include <stdexcept>
 #ifdef ESP_PLATFORM
 #include "sdkconfig.h"
@@ -8,11 +10,13 @@
 static const char *TAG = "Si5351Platform";
 
 Si5351Wrapper::Si5351Wrapper(LoggerIntf* logger) 
-  : logger(logger), hardware(nullptr), initialized(false) {
+  : logger(logger), hardware(nullptr), bus(nullptr), initialized(false), correction(0), toneCount(0), solvedTones(false),
+    previewing(false), previewPpb(0) {
   // Initialize tracking arrays
   for (int i = 0; i < 3; i++) {
     currentFrequency[i] = 0.0;
     outputEnabled[i] = false;
+    locked[i] = false;
   }
   
   if (logger) {
@@ -28,6 +32,8 @@ Si5351Wrapper::~Si5351Wrapper() {
     delete static_cast<Si5351*>(hardware);
     hardware = nullptr;
   }
+  delete bus;
+  bus = nullptr;
 }
 
 void Si5351Wrapper::init() {
@@ -49,7 +55,8 @@ void Si5351Wrapper::init() {
   }
   
   // Create the actual hardware instance using Kconfig values
-  hardware = new Si5351(i2cAddr, sdaPin, sclPin, 0); // 0 correction for now
+  bus = new I2CBus(sdaPin, sclPin);
+  hardware = new Si5351(bus, i2cAddr, 0); // 0 correction for now
   
   if (logger) {
     logger->logInfo(TAG, "Si5351 hardware created successfully");
@@ -86,6 +93,8 @@ void Si5351Wrapper::setFrequency(int channel, double freqHz) {
   // Store the new frequency
   double previousFreq = currentFrequency[channel];
   currentFrequency[channel] = freqHz;
+  locked[channel] = false;
+  previewing = false;
   
   if (logger) {
     logger->logDebug(TAG, "Setting CLK%d frequency: %.6f MHz (was %.6f MHz)", 
@@ -110,9 +119,26 @@ void Si5351Wrapper::setFrequency(int channel, double freqHz) {
     }
   }
   
-  // Use the appropriate setup method based on channel
+  // Solve in millihertz with the correction in ppb (correction is in
+  // units of 10 ppb); CLK0 runs from PLL A, CLK2 from PLL B
   Si5351* hw = static_cast<Si5351*>(hardware);
-  if (channel == 0) {
+  Si5351Solution solution;
+  if (channel != 1 && solve(freqHz, solution)) {
+    uint8_t pllRegs[8], msRegs[8];
+    Si5351Solver::registers(solution.pll, 0, 0, pllRegs);
+    Si5351Solver::registers(solution.ms, solution.msDivBy4, solution.rDivLog2, msRegs);
+    hw->setupCLKRegisters(channel, channel == 0 ? Si5351::PLL::A : Si5351::PLL::B, pllRegs, msRegs,
+                          solution.msInteger, Si5351::DriveStrength::MA_8);
+    lockedSolution[channel] = solution;
+    locked[channel] = true;
+    if (logger) {
+      logger->logDebug(TAG, "CLK%d: Target=%.6f MHz, PLL P1=%lu P2=%lu P3=%lu, MS P1=%lu P2=%lu P3=%lu R=%d, error %.6f Hz",
+                       channel, freqHz / 1000000.0,
+                       (unsigned long) solution.pll.p1, (unsigned long) solution.pll.p2, (unsigned long) solution.pll.p3,
+                       (unsigned long) solution.ms.p1, (unsigned long) solution.ms.p2, (unsigned long) solution.ms.p3,
+                       1 << solution.rDivLog2, solution.errorNanoHz / 1e9);
+    }
+  } else if (channel == 0) {
     hw->setupCLK0((int32_t)freqHz, Si5351::DriveStrength::MA_8); // ~10.7 dBm
     logFrequencyCalculation(channel, freqHz, "PLL A");
   } else if (channel == 2) {
@@ -197,12 +223,16 @@ void Si5351Wrapper::reset() {
   for (int i = 0; i < 3; i++) {
     currentFrequency[i] = 0.0;
     outputEnabled[i] = false;
+    locked[i] = false;
   }
+  previewing = false;
   
   if (hardware) {
     delete static_cast<Si5351*>(hardware);
     hardware = nullptr;
   }
+  delete bus;
+  bus = nullptr;
   
   initialized = false;
   
@@ -247,13 +277,71 @@ void Si5351Wrapper::setCalibration(int32_t correction) {
 
   Si5351* si5351 = static_cast<Si5351*>(hardware);
   si5351->setCorrection(correction);
+  this->correction = correction;
+  previewing = false;
 
   if (logger) {
     logger->logInfo(TAG, "Si5351 calibration applied successfully");
   }
 }
 
-void Si5351Wrapper::setupChannelSmooth(int channel, double baseFreqHz, const double* wspr_freqs) {
+void Si5351Wrapper::fineTune(int channel, double freqHz) {
+  if (!initialized || !hardware) {
+    if (logger) {
+      logger->logError(TAG, "fineTune called but Si5351 not initialized");
+    }
+    return;
+  }
+  if (channel < 0 || channel > 2) return;
+
+  // A preview stays in effect until it is applied or dropped
+  if (retune(channel, freqHz, previewing ? previewPpb : correction * 10)) {
+    currentFrequency[channel] = freqHz;
+    return;
+  }
+  if (logger) {
+    logger->logDebug(TAG, "CLK%d: %.3f Hz is out of reach of the locked PLL, relocking", channel, freqHz);
+  }
+  setFrequency(channel, freqHz);
+}
+
+void Si5351Wrapper::previewCorrection(int channel, int32_t ppb) {
+  if (!initialized || !hardware || channel < 0 || channel > 2) return;
+
+  if (!retune(channel, currentFrequency[channel], ppb)) {
+    if (logger) {
+      logger->logWarn(TAG, "CLK%d: cannot preview %ld ppb without a locked PLL", channel, (long) ppb);
+    }
+    return;
+  }
+  previewing = true;
+  previewPpb = ppb;
+}
+
+// Moves a locked channel to freqHz for a crystal correction of ppb with
+// one burst of whichever divider is fractional; the PLL is not reset
+bool Si5351Wrapper::retune(int channel, double freqHz, int32_t ppb) {
+  if (!locked[channel] || !(freqHz > 0)) return false;
+
+  const Si5351Solution& lockedNow = lockedSolution[channel];
+  const Si5351Solution s = Si5351Solver::retune((uint64_t) llround(freqHz * 1000.0), CONFIG_SI5351_CRYSTAL_FREQ,
+                                                ppb, lockedNow);
+  if (!s.ok) return false;
+
+  Si5351* hw = static_cast<Si5351*>(hardware);
+  uint8_t regs[8];
+  if (s.ms.p1 != lockedNow.ms.p1 || s.ms.p2 != lockedNow.ms.p2 || s.ms.p3 != lockedNow.ms.p3) {
+    Si5351Solver::registers(s.ms, s.msDivBy4, s.rDivLog2, regs);
+    hw->writeMultisynthRegisters(channel, regs);
+  } else {
+    Si5351Solver::registers(s.pll, 0, 0, regs);
+    hw->writePLLRegisters(channel == 0 ? Si5351::PLL::A : Si5351::PLL::B, regs);
+  }
+  lockedSolution[channel] = s;
+  return true;
+}
+
+void Si5351Wrapper::setupChannelSmooth(int channel, double baseFreqHz, const double* toneFreqs, int count) {
   if (!initialized || !hardware) {
     if (logger) {
       logger->logError(TAG, "setupChannelSmooth called but Si5351 not initialized");
@@ -268,27 +356,79 @@ void Si5351Wrapper::setupChannelSmooth(int channel, double baseFreqHz, const dou
     return;
   }
   
+  if (toneFreqs && (count < 1 || count > Si5351ToneTable::MaxTones)) {
+    if (logger) {
+      logger->logError(TAG, "setupChannelSmooth: %d tones, at most %d supported", count, Si5351ToneTable::MaxTones);
+    }
+    return;
+  }
+  
   if (logger) {
     logger->logInfo(TAG, "Setting up smooth WSPR frequency transitions on CLK%d", channel);
     logger->logInfo(TAG, "Base frequency: %.6f MHz", baseFreqHz / 1000000.0);
-    if (wspr_freqs) {
-      logger->logInfo(TAG, "WSPR frequencies: [%.6f, %.6f, %.6f, %.6f] MHz", 
-                      wspr_freqs[0]/1000000.0, wspr_freqs[1]/1000000.0, 
-                      wspr_freqs[2]/1000000.0, wspr_freqs[3]/1000000.0);
+    if (toneFreqs) {
+      logger->logInfo(TAG, "%d tone frequencies: %.6f to %.6f MHz", count,
+                      toneFreqs[0]/1000000.0, toneFreqs[count - 1]/1000000.0);
     }
   }
   
-  // Convert to Hz for the hardware layer
+  Si5351* si5351 = static_cast<Si5351*>(hardware);
+  toneCount = 0;
+  locked[channel] = false;
+  solvedTones = false;
+  if (toneFreqs) {
+    for (int i = 0; i < count; i++) {
+      toneFrequency[i] = toneFreqs[i];
+    }
+    toneCount = count;
+  }
+  
+  // Precompute the multisynth registers of every tone from the exact
+  // frequencies, so each symbol is one burst write
+  if (toneFreqs && toneTable.compute(CONFIG_SI5351_CRYSTAL_FREQ, correction, toneFreqs, count)) {
+    int first = toneTable.nearestTone(baseFreqHz);
+    si5351->setupCLK0Tone(toneTable.pllMult, toneTable.tones[first].regs, Si5351::DriveStrength::MA_8);
+    currentFrequency[channel] = toneFreqs[first];
+    
+    if (logger) {
+      logger->logInfo(TAG, "CLK%d tone table: PLL %.0f MHz, R=%d, burst of %d register(s) per symbol",
+                      channel, toneTable.pllHz / 1000000.0, 1 << toneTable.rDivLog2, 8 - toneTable.burstStart);
+    }
+    return;
+  }
+  
+  // Out of fractional multisynth range (2 m): an integer output divider
+  // with a fractional PLL per tone, so each symbol is one burst of the PLL
+  // registers
+  toneTable.toneCount = 0;
+  if (toneFreqs && solveTones(toneFreqs, count)) {
+    int first = 0;
+    for (int i = 1; i < count; i++) {
+      if (std::fabs(toneFreqs[i] - baseFreqHz) < std::fabs(toneFreqs[first] - baseFreqHz)) first = i;
+    }
+    uint8_t msRegs[8];
+    const Si5351Solution& s = toneSolution[first];
+    Si5351Solver::registers(s.ms, s.msDivBy4, s.rDivLog2, msRegs);
+    si5351->setupCLKRegisters(0, Si5351::PLL::A, tonePllRegs[first], msRegs, s.msInteger, Si5351::DriveStrength::MA_8);
+    currentFrequency[channel] = toneFreqs[first];
+    
+    if (logger) {
+      logger->logInfo(TAG, "CLK%d tone PLLs: output divider fixed, one PLL burst per symbol", channel);
+    }
+    return;
+  }
+  
+  // Fall back to whole-Hz setup
+  solvedTones = false;
   int32_t baseFreqHzInt = (int32_t)baseFreqHz;
-  int32_t wspr_freqs_hz[4];
-  if (wspr_freqs) {
-    for (int i = 0; i < 4; i++) {
-      wspr_freqs_hz[i] = (int32_t)wspr_freqs[i];
+  int32_t toneFreqsHz[Si5351ToneTable::MaxTones] = {};
+  if (toneFreqs) {
+    for (int i = 0; i < count; i++) {
+      toneFreqsHz[i] = (int32_t)toneFreqs[i];
     }
   }
   
-  Si5351* si5351 = static_cast<Si5351*>(hardware);
-  si5351->setupCLK0Smooth(baseFreqHzInt, wspr_freqs ? wspr_freqs_hz : nullptr, Si5351::DriveStrength::MA_8);
+  si5351->setupCLK0Smooth(baseFreqHzInt, toneFreqs ? toneFreqsHz : nullptr, Si5351::DriveStrength::MA_8);
   
   // Store the base frequency
   currentFrequency[channel] = baseFreqHz;
@@ -298,6 +438,34 @@ void Si5351Wrapper::setupChannelSmooth(int channel, double baseFreqHz, const dou
   }
 }
 
+void Si5351Wrapper::selectChannelTone(int channel, int tone) {
+  if (!initialized || !hardware || channel != 0 || tone < 0 || tone >= toneCount) {
+    if (logger) {
+      logger->logError(TAG, "selectChannelTone: no tone %d set up for CLK%d", tone, channel);
+    }
+    return;
+  }
+  
+  if (tone >= toneTable.toneCount && solvedTones) {
+    // Solved tone PLLs: one burst, no PLL reset
+    static_cast<Si5351*>(hardware)->writePLLRegisters(Si5351::PLL::A, tonePllRegs[tone]);
+    currentFrequency[channel] = toneFrequency[tone];
+    return;
+  }
+  
+  if (tone >= toneTable.toneCount) {
+    // No table or solved tones: whole-Hz update
+    updateChannelFrequencyMinimal(channel, toneFrequency[tone]);
+    return;
+  }
+  
+  // Table lookup and one burst of the registers that differ between tones
+  const Si5351ToneTable::Tone& t = toneTable.tones[tone];
+  static_cast<Si5351*>(hardware)->writeCLK0Multisynth(t.regs + toneTable.burstStart, toneTable.burstStart,
+                                                      8 - toneTable.burstStart);
+  currentFrequency[channel] = toneFrequency[tone];
+}
+
 void Si5351Wrapper::updateChannelFrequency(int channel, double newFreqHz) {
   if (!initialized || !hardware) {
     if (logger) {
@@ -323,6 +491,7 @@ void Si5351Wrapper::updateChannelFrequency(int channel, double newFreqHz) {
   
   Si5351* si5351 = static_cast<Si5351*>(hardware);
   si5351->updateCLK0Frequency(newFreqHzInt);
+  locked[channel] = false;
   
   // Update stored frequency
   currentFrequency[channel] = newFreqHz;
@@ -352,11 +521,20 @@ void Si5351Wrapper::updateChannelFrequencyMinimal(int channel, double newFreqHz)
                      channel, currentFrequency[channel] / 1000000.0, newFreqHz / 1000000.0);
   }
   
+  // One of the precomputed tones is a table lookup
+  for (int i = 0; i < toneTable.toneCount; i++) {
+    if (toneFrequency[i] == newFreqHz) {
+      selectChannelTone(channel, i);
+      return;
+    }
+  }
+  
   // Convert to Hz for the hardware layer
   int32_t newFreqHzInt = (int32_t)newFreqHz;
   
   Si5351* si5351 = static_cast<Si5351*>(hardware);
   si5351->updateCLK0FrequencyMinimal(newFreqHzInt);
+  locked[channel] = false;
   
   // Update stored frequency
   currentFrequency[channel] = newFreqHz;
@@ -364,4 +542,24 @@ void Si5351Wrapper::updateChannelFrequencyMinimal(int channel, double newFreqHz)
   if (logger) {
     logger->logDebug(TAG, "CLK%d frequency updated glitch-free (disable-update-enable with phase reset)", channel);
   }
-}
\ No newline at end of file
+}
+
+bool Si5351Wrapper::solve(double freqHz, Si5351Solution& solution) const {
+  if (!(freqHz > 0)) return false;
+  solution = Si5351Solver::solve((uint64_t) llround(freqHz * 1000.0), CONFIG_SI5351_CRYSTAL_FREQ, correction * 10);
+  return solution.ok;
+}
+
+bool Si5351Wrapper::solveTones(const double* freqs, int count) {
+  // Every tone must share the output divider so only the PLL changes
+  for (int i = 0; i < count; i++) {
+    Si5351Solution& s = toneSolution[i];
+    if (!solve(freqs[i], s) || s.ms.p2 != 0 || s.ms.p1 != toneSolution[0].ms.p1 ||
+        s.msDivBy4 != toneSolution[0].msDivBy4 || s.rDivLog2 != toneSolution[0].rDivLog2) {
+      return false;
+    }
+    Si5351Solver::registers(s.pll, 0, 0, tonePllRegs[i]);
+  }
+  solvedTones = true;
+  return true;
+}
@@ -2,6 +2,9 @@
 
 #include "Si5351Intf.h"
 #include "LoggerIntf.h"
+#include "Si5351ToneTable.h"
+#include "Si5351Solver.h"
+#include "I2CBusIntf.h"
 
 class Si5351Wrapper : public Si5351Intf {
 public:
@@ -13,19 +16,37 @@ public:
   void enableOutput(int channel, bool enable) override;
   void reset() override;
   void setCalibration(int32_t correction) override;
+  void fineTune(int channel, double freqHz) override;
+  void previewCorrection(int channel, int32_t ppb) override;
   
   // Smooth frequency transition methods for WSPR
-  void setupChannelSmooth(int channel, double baseFreqHz, const double* wspr_freqs) override;
+  void setupChannelSmooth(int channel, double baseFreqHz, const double* toneFreqs, int count) override;
+  void selectChannelTone(int channel, int tone) override;
   void updateChannelFrequency(int channel, double newFreqHz) override;
   void updateChannelFrequencyMinimal(int channel, double newFreqHz) override;
 
 private:
   LoggerIntf* logger;
   void* hardware;  // Opaque pointer to the actual Si5351 hardware implementation
+  I2CBusIntf* bus;  // owned; the hardware writes through it
   bool initialized;
   double currentFrequency[3];  // Track frequencies for channels 0, 1, 2
   bool outputEnabled[3];       // Track output enable state
+  int32_t correction;
+  Si5351ToneTable toneTable;   // CLK0 tones of the current transmission
+  double toneFrequency[Si5351ToneTable::MaxTones];
+  int toneCount;
+  Si5351Solution toneSolution[Si5351ToneTable::MaxTones];   // tones beyond the table
+  uint8_t tonePllRegs[Si5351ToneTable::MaxTones][8];
+  bool solvedTones;
+  Si5351Solution lockedSolution[3];   // last setFrequency() solution per channel
+  bool locked[3];
+  bool previewing;
+  int32_t previewPpb;
   
+  bool solve(double freqHz, Si5351Solution& solution) const;
+  bool solveTones(const double* freqs, int count);
+  bool retune(int channel, double freqHz, int32_t ppb);
   void logRegisterWrite(int reg, int value, const char* description);
   void logFrequencyCalculation(int channel, double freqHz, const char* pllInfo);
 };
\ No newline at end of file
@@ -76,6 +76,62 @@ TaskIntf::Task *Task::start(const char *name, const std::function<void()> &func,
   }
 }
 
+TaskIntf::Placement Task::placementFor(Class cls) {
+#if CONFIG_FREERTOS_UNICORE
+  const int appCore = 0;
+#else
+  const int appCore = 1;
+#endif
+  switch (cls) {
+    case Class::RtModulation: return {appCore, RtModulationPriority, true};
+    case Class::Control:      return {appCore, ControlPriority, false};
+    case Class::Network:      return {0, NetworkPriority, false};
+    case Class::Background:   return {-1, BackgroundPriority, false};
+  }
+  return {-1, BackgroundPriority, false};
+}
+
+TaskIntf::Task *Task::start(const char *name, Class cls, const std::function<void()> &func, int stackSize) {
+  auto* impl = new TaskImpl(name);
+  auto* wrapper = new TaskWrapper{func};
+  impl->placement_ = placementFor(cls);
+  
+  BaseType_t result = xTaskCreatePinnedToCore(
+    taskFunctionWrapper,
+    name,
+    stackSize,
+    wrapper,
+    impl->placement_.priority,
+    &impl->handle_,
+    impl->placement_.core < 0 ? tskNO_AFFINITY : impl->placement_.core
+  );
+  
+  if (result == pdPASS) {
+    ESP_LOGI(TAG, "Task %s: %s, core %d, priority %d", name, className(cls), impl->placement_.core,
+             impl->placement_.priority);
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_[impl] = impl;
+    return impl;
+  } else {
+    delete wrapper;
+    delete impl;
+    ESP_LOGE(TAG, "Failed to create task %s", name);
+    return nullptr;
+  }
+}
+
+TaskIntf::Placement Task::getPlacement(TaskIntf::Task *task) {
+  if (!task) {
+    const BaseType_t core = xTaskGetCoreID(NULL);
+    const int priority = (int) uxTaskPriorityGet(NULL);
+    return {core == tskNO_AFFINITY ? -1 : (int) core, priority, priority >= RtModulationPriority};
+  }
+  
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tasks_.find(task);
+  return it != tasks_.end() ? it->second->placement_ : Placement{-1, 0, false};
+}
+
 void Task::stop(TaskIntf::Task *task) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = tasks_.find(task);
@@ -11,10 +11,11 @@ class Task : public TaskIntf {
 public:
   class TaskImpl : public TaskIntf::Task {
   public:
-    TaskImpl(const std::string& name) : name_(name), handle_(nullptr) {}
+    TaskImpl(const std::string& name) : name_(name), handle_(nullptr), placement_{-1, 0, false} {}
     
     std::string name_;
     TaskHandle_t handle_;
+    Placement placement_;
   };
 
   Task();
@@ -26,6 +27,14 @@ public:
   // Overload to support std::function, if desired
   TaskIntf::Task *start(const char *name, const std::function<void()> &func, int stackSize = 4096, int priority = 1) override;
 
+  // Start a task pinned and prioritized by its class. WiFi and lwIP live on
+  // core 0, so rt-modulation and control run on core 1, network beside the
+  // WiFi stack on core 0, and background on whichever core is free.
+  TaskIntf::Task *start(const char *name, Class cls, const std::function<void()> &func, int stackSize = 4096) override;
+
+  // Placement as created; for the calling task, as FreeRTOS reports it
+  Placement getPlacement(TaskIntf::Task *task) override;
+
   // Stop a running task
   void stop(TaskIntf::Task *task) override;
 
@@ -35,7 +44,14 @@ public:
   // Destroy task object and release resources
   void destroy(TaskIntf::Task *task) override;
 
+  static constexpr int RtModulationPriority = 20;   // below WiFi (23), above lwIP (18)
+  static constexpr int ControlPriority = 8;
+  static constexpr int NetworkPriority = 5;         // as the HTTP server
+  static constexpr int BackgroundPriority = 1;
+
 private:
+  static Placement placementFor(Class cls);
+
   std::mutex mutex_;
   std::map<TaskIntf::Task*, TaskImpl*> tasks_;
   
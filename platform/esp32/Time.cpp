@@ -1,4 +1,5 @@
 #include "Time.h"
+#include "Timer.h"
 #include "esp_sntp.h"
 #include "esp_log.h"
 #include <sys/time.h>
@@ -29,6 +30,7 @@ bool Time::setTime(int64_t unixTime) {
   
   if (settimeofday(&tv, nullptr) == 0) {
     ESP_LOGI(TAG, "System time set to: %lld", (long long)unixTime);
+    Timer::wallClockSet();
     return true;
   }
   
@@ -106,6 +108,9 @@ int64_t Time::getStartTime() {
 }
 
 void Time::sntpTimeSyncNotificationCallback(struct timeval *tv) {
+  // SNTP has just set the clock
+  Timer::wallClockSet();
+  
   if (instance && tv) {
     ESP_LOGI(TAG, "SNTP time synchronized: %lld", (long long)tv->tv_sec);
     instance->timeSynced.store(true);
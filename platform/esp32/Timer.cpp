@@ -1,13 +1,39 @@
 #include "Timer.h"
 #include "esp_log.h"
 #include "esp_sntp.h"
+#include <sys/time.h>
 
 static const char* TAG = "Timer";
 
-Timer::Timer() {}
+static int64_t utcNowUs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return (int64_t) tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+Timer* Timer::instance = nullptr;
+
+Timer::Timer() : dispatcher_(nullptr), armedUs_(0) {
+  instance = this;
+  esp_timer_create_args_t args = {};
+  args.callback = dispatchCallback;
+  args.arg = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "TimerDeadlines";
+  if (esp_timer_create(&args, &dispatcher_) != ESP_OK) {
+    ESP_LOGE(TAG, "esp_timer_create failed for deadline dispatcher");
+  }
+}
 
 Timer::~Timer() {
+  if (instance == this) {
+    instance = nullptr;
+  }
   // Simple cleanup without complex locking
+  if (dispatcher_ != nullptr) {
+    esp_timer_stop(dispatcher_);
+    esp_timer_delete(dispatcher_);
+  }
   for (auto& pair : timers_) {
     if (pair.second->handle_ != nullptr) {
       xTimerStop(pair.second->handle_, 0);
@@ -28,7 +54,7 @@ void Timer::timerCallback(TimerHandle_t xTimer) {
 }
 
 TimerIntf::Timer *Timer::createOneShot(const std::function<void()> &callback) {
-  auto* impl = new TimerImpl(callback);
+  auto* impl = new TimerImpl(callback, false);
   
   impl->handle_ = xTimerCreate(
     "OneShotTimer",
@@ -39,7 +65,7 @@ TimerIntf::Timer *Timer::createOneShot(const std::function<void()> &callback) {
   );
   
   if (impl->handle_ != nullptr) {
-    // Simplified tracking without mutex - just keep reference for cleanup
+    std::lock_guard<std::mutex> lock(mutex_);
     timers_[impl] = impl;
     return impl;
   } else {
@@ -49,7 +75,7 @@ TimerIntf::Timer *Timer::createOneShot(const std::function<void()> &callback) {
 }
 
 TimerIntf::Timer *Timer::createPeriodic(const std::function<void()> &callback) {
-  auto* impl = new TimerImpl(callback);
+  auto* impl = new TimerImpl(callback, true);
   
   impl->handle_ = xTimerCreate(
     "PeriodicTimer",
@@ -60,7 +86,7 @@ TimerIntf::Timer *Timer::createPeriodic(const std::function<void()> &callback) {
   );
   
   if (impl->handle_ != nullptr) {
-    // Simplified tracking without mutex - just keep reference for cleanup
+    std::lock_guard<std::mutex> lock(mutex_);
     timers_[impl] = impl;
     return impl;
   } else {
@@ -73,6 +99,16 @@ TimerIntf::Timer *Timer::createPeriodic(const std::function<void()> &callback) {
 void Timer::start(TimerIntf::Timer *timer, unsigned int timeoutMs) {
   auto* impl = static_cast<TimerImpl*>(timer);
   if (impl && impl->handle_ != nullptr) {
+    if (impl->slackMs_ > 0) {
+      // Only a deadline can be rounded onto the slack grid
+      startAt(timer, esp_timer_get_time() + (int64_t) timeoutMs * 1000, Clock::Monotonic,
+              impl->isPeriodic_ ? timeoutMs : 0);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      unschedule(impl);
+    }
     xTimerChangePeriod(impl->handle_, pdMS_TO_TICKS(timeoutMs), 0);
     xTimerStart(impl->handle_, 0);
   } else {
@@ -80,10 +116,48 @@ void Timer::start(TimerIntf::Timer *timer, unsigned int timeoutMs) {
   }
 }
 
+void Timer::startAt(TimerIntf::Timer *timer, int64_t deadlineUs, Clock clock, unsigned int periodMs) {
+  auto* impl = static_cast<TimerImpl*>(timer);
+  if (!impl || impl->handle_ == nullptr) {
+    ESP_LOGE(TAG, "Timer startAt failed: impl=%p", impl);
+    return;
+  }
+  xTimerStop(impl->handle_, 0);
+  
+  std::lock_guard<std::mutex> lock(mutex_);
+  unschedule(impl);
+  impl->clock_ = clock;
+  impl->periodUs_ = (int64_t) (impl->isPeriodic_ && periodMs == 0 ? 1 : periodMs) * 1000;
+  impl->running_ = true;
+  impl->usedDeadline_ = true;
+  if (clock == Clock::Utc) {
+    impl->nextUtcUs_ = deadlineUs;
+    impl->dueUs_ = deadlineUs - (utcNowUs() - esp_timer_get_time());
+  } else {
+    impl->dueUs_ = deadlineUs;
+  }
+  schedule(impl);
+  armDispatcher();
+}
+
+void Timer::setSlack(TimerIntf::Timer *timer, unsigned int slackMs) {
+  auto* impl = static_cast<TimerImpl*>(timer);
+  if (impl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    impl->slackMs_ = slackMs;
+  }
+}
+
+int64_t Timer::nowUs(Clock clock) {
+  return clock == Clock::Utc ? utcNowUs() : esp_timer_get_time();
+}
+
 void Timer::stop(TimerIntf::Timer *timer) {
   auto* impl = static_cast<TimerImpl*>(timer);
   if (impl && impl->handle_ != nullptr) {
     xTimerStop(impl->handle_, 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    unschedule(impl);
   }
 }
 
@@ -94,9 +168,129 @@ void Timer::destroy(TimerIntf::Timer *timer) {
       xTimerStop(impl->handle_, 0);
       xTimerDelete(impl->handle_, 0);
     }
-    // Remove from tracking map
-    timers_.erase(timer);
-    delete impl;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      unschedule(impl);
+      timers_.erase(timer);
+    }
+    
+    // A deadline callback may already be queued to the timer task; freeing
+    // there, behind it, is safe. If the queue is full it is leaked instead.
+    if (!impl->usedDeadline_) {
+      delete impl;
+    } else if (xTimerPendFunctionCall(freeImpl, impl, 0, 0) != pdPASS) {
+      ESP_LOGW(TAG, "Timer queue full, timer %p not freed", impl);
+    }
+  }
+}
+
+// With mutex_ held: queue impl at its due time, rounded up by its slack
+void Timer::schedule(TimerImpl *impl) {
+  if (impl->queued_) {
+    deadlines_.erase(impl->entry_);
+  }
+  impl->entry_ = deadlines_.emplace(coalesceUs(impl->dueUs_, impl->slackMs_), impl);
+  impl->queued_ = true;
+}
+
+// With mutex_ held: cancel the deadline and anything of it already queued to run
+void Timer::unschedule(TimerImpl *impl) {
+  ++impl->generation_;
+  impl->running_ = false;
+  if (impl->queued_) {
+    deadlines_.erase(impl->entry_);
+    impl->queued_ = false;
+  }
+}
+
+// With mutex_ held: the one esp_timer fires for the earliest deadline
+void Timer::armDispatcher() {
+  if (deadlines_.empty()) {
+    return;   // a spurious wakeup finds nothing due
+  }
+  const int64_t fireUs = deadlines_.begin()->first;
+  if (fireUs == armedUs_ && esp_timer_is_active(dispatcher_)) {
+    return;
+  }
+  const int64_t delayUs = fireUs - esp_timer_get_time();
+  esp_timer_stop(dispatcher_);
+  esp_timer_start_once(dispatcher_, delayUs > 0 ? delayUs : 0);
+  armedUs_ = fireUs;
+}
+
+void Timer::dispatchCallback(void *arg) {
+  static_cast<Timer*>(arg)->dispatch();
+}
+
+void Timer::dispatch() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int64_t now = esp_timer_get_time();
+  
+  // Everything due now is handed to the timer task in one wakeup
+  while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+    TimerImpl* impl = deadlines_.begin()->second;
+    deadlines_.erase(deadlines_.begin());
+    impl->queued_ = false;
+    const uint32_t generation = impl->generation_;
+    
+    if (impl->isPeriodic_) {
+      // Next period from this deadline, not from now, so nothing drifts;
+      // periods already missed are skipped
+      do {
+        impl->dueUs_ += impl->periodUs_;
+        impl->nextUtcUs_ += impl->periodUs_;
+      } while (impl->dueUs_ <= now);
+      schedule(impl);
+    } else {
+      impl->running_ = false;
+    }
+    
+    if (xTimerPendFunctionCall(runDeadline, impl, generation, 0) != pdPASS) {
+      ESP_LOGW(TAG, "Timer queue full, deadline skipped");
+    }
+  }
+  armDispatcher();
+}
+
+void Timer::runDeadline(void *param, uint32_t generation) {
+  // Runs in the timer task, like the FreeRTOS timer callbacks
+  TimerImpl* impl = static_cast<TimerImpl*>(param);
+  if (impl->generation_ == generation && impl->callback_) {
+    impl->callback_();
+  }
+}
+
+void Timer::freeImpl(void *param, uint32_t unused) {
+  delete static_cast<TimerImpl*>(param);
+}
+
+void Timer::wallClockSet() {
+  if (instance) {
+    instance->rebaseUtcDeadlines();
+  }
+}
+
+void Timer::sntpSyncCallback(struct timeval *tv) {
+  (void) tv;
+  wallClockSet();
+}
+
+// A UTC deadline waits on esp_timer_get_time(), so a wall clock that was
+// just set moves every one of them to the same wall-clock instant
+void Timer::rebaseUtcDeadlines() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int64_t offset = utcNowUs() - esp_timer_get_time();
+  bool moved = false;
+  for (auto& pair : timers_) {
+    TimerImpl* impl = pair.second;
+    if (impl->running_ && impl->clock_ == Clock::Utc) {
+      impl->dueUs_ = impl->nextUtcUs_ - offset;
+      schedule(impl);
+      moved = true;
+    }
+  }
+  if (moved) {
+    armDispatcher();
   }
 }
 
@@ -127,9 +321,11 @@ void Timer::syncTime() {
     // Just trigger a sync request without reinitializing
     esp_sntp_restart();
   } else {
-    // First time initialization
+    // First time initialization; Time::syncTime() replaces the notification
+    // with its own, which calls wallClockSet() too
     esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
     esp_sntp_setservername(0, "pool.ntp.org");
+    esp_sntp_set_time_sync_notification_cb(sntpSyncCallback);
     esp_sntp_init();
   }
   // Avoid logging in timer context - ESP_LOGI(TAG, "SNTP time sync initiated");
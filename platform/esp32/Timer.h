@@ -3,17 +3,40 @@
 #include "TimerIntf.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
+#include "esp_timer.h"
+#include <sys/time.h>
+#include <atomic>
 #include <map>
 #include <mutex>
 
+// Relative timers without slack run on FreeRTOS software timers. Absolute
+// deadlines and timers with slack sit in one map ordered by fire time on
+// esp_timer_get_time(), served by a single esp_timer, so deadlines rounded
+// onto the same slack grid point fire in one wakeup. Either way callbacks
+// run in the FreeRTOS timer task. UTC deadlines are re-armed from the SNTP
+// sync notification and from setTime(), which call wallClockSet().
 class Timer : public TimerIntf {
 public:
   class TimerImpl : public TimerIntf::Timer {
   public:
-    TimerImpl(const std::function<void()> &callback) : callback_(callback), handle_(nullptr) {}
+    TimerImpl(const std::function<void()> &callback, bool isPeriodic)
+      : callback_(callback), handle_(nullptr), isPeriodic_(isPeriodic), running_(false), queued_(false),
+        usedDeadline_(false), clock_(Clock::Monotonic), slackMs_(0), periodUs_(0), dueUs_(0), nextUtcUs_(0),
+        generation_(0) {}
     
     std::function<void()> callback_;
     TimerHandle_t handle_;
+    bool isPeriodic_;
+    bool running_;                  // on a deadline
+    bool queued_;                   // entry_ is in deadlines_
+    bool usedDeadline_;             // a deadline callback may be queued to the timer task
+    Clock clock_;
+    unsigned int slackMs_;
+    int64_t periodUs_;
+    int64_t dueUs_;                 // pending deadline on esp_timer_get_time()
+    int64_t nextUtcUs_;             // the same deadline on the UTC clock
+    std::multimap<int64_t, TimerImpl*>::iterator entry_;
+    std::atomic<uint32_t> generation_;   // bumped by start() and stop(); older deadlines are stale
   };
 
   Timer();
@@ -28,6 +51,15 @@ public:
   // Start the timer; timeoutMs is in milliseconds
   void start(TimerIntf::Timer *timer, unsigned int timeoutMs) override;
 
+  // Start the timer at an absolute deadline on the monotonic or UTC clock
+  void startAt(TimerIntf::Timer *timer, int64_t deadlineUs, Clock clock, unsigned int periodMs = 0) override;
+
+  // Let the timer fire up to slackMs late to share a wakeup
+  void setSlack(TimerIntf::Timer *timer, unsigned int slackMs) override;
+
+  // esp_timer_get_time() or gettimeofday(), in microseconds
+  int64_t nowUs(Clock clock) override;
+
   // Stop the timer if running
   void stop(TimerIntf::Timer *timer) override;
 
@@ -46,9 +78,29 @@ public:
   // Get current time (for testing/mocking)
   time_t getCurrentTime() override;
 
+  // Call after the wall clock is set, so UTC deadlines keep their wall-clock
+  // instant. Time calls it from the SNTP notification and from setTime().
+  static void wallClockSet();
+
 private:
+  static void sntpSyncCallback(struct timeval *tv);
+  static Timer* instance;
+
   static void timerCallback(TimerHandle_t xTimer);
+  static void dispatchCallback(void *arg);
+  static void runDeadline(void *param, uint32_t generation);
+  static void freeImpl(void *param, uint32_t unused);
+
+  void schedule(TimerImpl *impl);
+  void unschedule(TimerImpl *impl);
+  void armDispatcher();
+  void dispatch();
+  void rebaseUtcDeadlines();
   
-  // Simple tracking for cleanup only - no complex synchronization needed
+  // Guards timers_, deadlines_ and the deadline state of every TimerImpl
+  std::mutex mutex_;
   std::map<TimerIntf::Timer*, TimerImpl*> timers_;
+  std::multimap<int64_t, TimerImpl*> deadlines_;
+  esp_timer_handle_t dispatcher_;
+  int64_t armedUs_;               // fire time the dispatcher is armed for
 };
\ No newline at end of file
@@ -3,41 +3,55 @@
 
 static const char* TAG = "WSPRModulator";
 
-WSPRModulator::WSPRModulator() 
-    : taskHandle(nullptr),
-      totalSymbols(0),
+WSPRModulator::WSPRModulator(TaskIntf* tasks) 
+    : tasks(tasks),
+      task(nullptr),
+      run(0),
       currentSymbolIndex(-1),
-      modulationActive(false)
+      modulationActive(false),
+      rtTask(nullptr),
+      taskExited(xSemaphoreCreateBinary())
 {
 }
 
 WSPRModulator::~WSPRModulator() {
     stopModulation();
+    vSemaphoreDelete(taskExited);
 }
 
-bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>& callback, int symbols) {
+bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>& callback, int symbols, int periodMs) {
     if (modulationActive) {
         ESP_LOGW(TAG, "Modulation already active");
         return false;
     }
+    if (!tasks) {
+        ESP_LOGE(TAG, "Task interface not available");
+        return false;
+    }
     
-    symbolCallback = callback;
-    totalSymbols = symbols;
     currentSymbolIndex = 0;
     modulationActive = true;
+    const uint32_t thisRun = ++run;
     
-    // Create FreeRTOS task for precise timing
-    BaseType_t result = xTaskCreate(
-        modulationTask,               // Task function
-        "wspr_mod",                   // Task name
-        4096,                         // Stack size (4KB)
-        this,                         // Parameter (pass this pointer)
-        10,                           // Priority (higher than normal)
-        &taskHandle                   // Task handle storage
-    );
+    // The task gets its own copy of everything it uses, so a stop and a new
+    // start while it sleeps cannot change it underneath
+    task = tasks->start("wspr_mod", TaskIntf::Class::RtModulation, [this, thisRun, callback, symbols, periodMs]() {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            rtTask = xTaskGetCurrentTaskHandle();
+        }
+        this->modulationLoop(thisRun, callback, symbols, periodMs);
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            rtTask = nullptr;
+        }
+        xSemaphoreGive(taskExited);
+    }, 4096);
     
-    if (result == pdPASS) {
-        ESP_LOGI(TAG, "WSPR modulation task created (683ms symbol period)");
+    if (task) {
+        const TaskIntf::Placement placement = tasks->getPlacement(task);
+        ESP_LOGI(TAG, "WSPR modulation task created (%dms symbol period, core %d, priority %d)", periodMs,
+                 placement.core, placement.priority);
         return true;
     } else {
         ESP_LOGE(TAG, "Failed to create WSPR modulation task");
@@ -50,11 +64,23 @@ void WSPRModulator::stopModulation() {
     if (!modulationActive) return;
     
     modulationActive = false;
+    ++run;
     
-    // Delete the FreeRTOS task if it exists
-    if (taskHandle) {
-        vTaskDelete(taskHandle);
-        taskHandle = nullptr;
+    // Wake the task from its symbol wait and wait for it to see the run has
+    // ended, so no symbol callback follows a stop. It may not have recorded
+    // its handle yet, hence the retries. The callback itself may stop, and
+    // must not wait for its own task.
+    if (task) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(taskMutex);
+                if (rtTask == xTaskGetCurrentTaskHandle()) break;
+                if (rtTask) xTaskNotifyGive(rtTask);
+            }
+            if (xSemaphoreTake(taskExited, pdMS_TO_TICKS(10)) == pdTRUE) break;
+        }
+        tasks->destroy(task);
+        task = nullptr;
     }
     
     currentSymbolIndex = -1;
@@ -69,32 +95,36 @@ int WSPRModulator::getCurrentSymbolIndex() const {
     return currentSymbolIndex;
 }
 
-void WSPRModulator::modulationTask(void* param) {
-    WSPRModulator* modulator = static_cast<WSPRModulator*>(param);
-    
+void WSPRModulator::modulationLoop(uint32_t thisRun, const std::function<void(int)>& symbolCallback, int totalSymbols,
+                                   int symbolPeriodMs) {
     // Get the starting time for accurate periodic wakeup
     TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xPeriod = pdMS_TO_TICKS(683); // 683ms per WSPR symbol
+    const TickType_t xPeriod = pdMS_TO_TICKS(symbolPeriodMs); // 683ms per WSPR symbol
     
     // Call callback for symbol 0 immediately
-    if (modulator->symbolCallback && modulator->currentSymbolIndex == 0) {
-        modulator->symbolCallback(0);
+    if (symbolCallback) {
+        symbolCallback(0);
     }
     
-    while (modulator->modulationActive && modulator->currentSymbolIndex < modulator->totalSymbols - 1) {
-        // Wait until next symbol period
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
+    for (int symbolIndex = 1; symbolIndex < totalSymbols; symbolIndex++) {
+        // Wait until next symbol period, as vTaskDelayUntil does, unless
+        // stopModulation() notifies first
+        xLastWakeTime += xPeriod;
+        for (;;) {
+            const TickType_t remaining = xLastWakeTime - xTaskGetTickCount();
+            if (run != thisRun || remaining == 0 || remaining > xPeriod) break;
+            ulTaskNotifyTake(pdTRUE, remaining);
+        }
         
-        // Move to next symbol
-        modulator->currentSymbolIndex = modulator->currentSymbolIndex + 1;
+        // Stopped, or restarted for another transmission, while asleep
+        if (run != thisRun) {
+            return;
+        }
         
-        // Call the callback for the next symbol
-        if (modulator->symbolCallback && modulator->currentSymbolIndex < modulator->totalSymbols) {
-            modulator->symbolCallback(modulator->currentSymbolIndex);
+        // Move to next symbol and call the callback for it
+        currentSymbolIndex = symbolIndex;
+        if (symbolCallback) {
+            symbolCallback(symbolIndex);
         }
     }
-    
-    // Task cleanup - set handle to nullptr before deleting
-    modulator->taskHandle = nullptr;
-    vTaskDelete(NULL); // Delete this task
-}
\ No newline at end of file
+}
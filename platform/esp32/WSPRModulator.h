@@ -1,34 +1,50 @@
 #pragma once
 
 #include "WSPRModulatorIntf.h"
+#include "TaskIntf.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <atomic>
 #include <functional>
+#include <mutex>
 
 /**
  * ESP32 FreeRTOS-based WSPR modulator implementation
  * 
- * Uses a dedicated FreeRTOS task with precise vTaskDelayUntil timing
- * to achieve accurate 683ms symbol intervals required by WSPR protocol.
+ * Uses an rt-modulation task (see TaskIntf), pinned away from the WiFi
+ * stack, with precise vTaskDelayUntil timing to achieve the accurate
+ * symbol intervals (683ms for WSPR) the modes require.
  */
 class WSPRModulator : public WSPRModulatorIntf {
 public:
-    WSPRModulator();
+    explicit WSPRModulator(TaskIntf* tasks);
     ~WSPRModulator() override;
     
-    bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols) override;
+    bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols,
+                         int symbolPeriodMs) override;
     void stopModulation() override;
     bool isModulationActive() const override;
     int getCurrentSymbolIndex() const override;
     
 private:
-    // FreeRTOS task function
-    static void modulationTask(void* param);
+    // One transmission's symbol clock. Stopping does not kill the task; it
+    // wakes it from its symbol wait, and the task returns once its run is no
+    // longer current.
+    void modulationLoop(uint32_t run, const std::function<void(int)>& symbolCallback, int totalSymbols,
+                        int symbolPeriodMs);
     
     // Task state
-    TaskHandle_t taskHandle;
-    std::function<void(int)> symbolCallback;
-    int totalSymbols;
-    volatile int currentSymbolIndex;
-    volatile bool modulationActive;
-};
\ No newline at end of file
+    TaskIntf* tasks;
+    TaskIntf::Task* task;
+    std::atomic<uint32_t> run;          // bumped by every start and stop
+    std::atomic<int> currentSymbolIndex;
+    std::atomic<bool> modulationActive;
+    
+    // The running task's handle, for stopModulation() to notify; cleared
+    // under the mutex before the task exits, so a notify never reaches a
+    // deleted task
+    std::mutex taskMutex;
+    TaskHandle_t rtTask;
+    SemaphoreHandle_t taskExited;       // given as each task leaves modulationLoop
+};
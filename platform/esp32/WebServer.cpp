@@ -32,31 +32,11 @@ static const char *TAG = "WebServer";
 #define MIN(a,b) ((a) < (b) ? (a) : (b))
 #endif
 
-// Global beacon state for status API
-static struct {
-  const char* networkState = "BOOTING";
-  const char* transmissionState = "IDLE";
-  const char* currentBand = "20m";
-  int currentFrequency = 14097100;
-  bool isTransmitting = false;
-} g_beaconState;
 static const char *SPIFFS_BASE_PATH = "/spiffs";
 
-WebServer *WebServer::instanceForApi = nullptr;
-static std::unique_ptr<ESP32HttpEndpointHandler> g_endpointHandler = nullptr;
-
-// Function to update beacon state from outside (legacy - calls member function)
-void updateBeaconState(const char* netState, const char* txState, const char* band, int frequency) {
-  if (WebServer::instanceForApi) {
-    WebServer::instanceForApi->updateBeaconState(netState, txState, band, static_cast<uint32_t>(frequency));
-  }
-}
-
-
 WebServer::WebServer(SettingsIntf *settings, TimeIntf *time)
-  : server(nullptr), settings(settings), time(time), scheduler(nullptr), beacon(nullptr) {
-  instanceForApi = this;
-  g_endpointHandler = std::make_unique<ESP32HttpEndpointHandler>(settings, time);
+  : server(nullptr), settings(settings), time(time), scheduler(nullptr), beacon(nullptr),
+    endpointHandler(std::make_unique<ESP32HttpEndpointHandler>(settings, time)) {
 }
 
 WebServer::~WebServer() {
@@ -65,34 +45,28 @@ WebServer::~WebServer() {
 
 void WebServer::setSettingsChangedCallback(const std::function<void()> &cb) {
   settingsChangedCallback = cb;
-  if (g_endpointHandler) {
-    g_endpointHandler->setSettingsChangedCallback(cb);
+  if (endpointHandler) {
+    endpointHandler->setSettingsChangedCallback(cb);
   }
 }
 
 void WebServer::setScheduler(Scheduler* sched) {
   scheduler = sched;
-  if (g_endpointHandler) {
-    g_endpointHandler->setScheduler(sched);
+  if (endpointHandler) {
+    endpointHandler->setScheduler(sched);
   }
 }
 
 void WebServer::setBeacon(Beacon* beaconInstance) {
   beacon = beaconInstance;
-  if (g_endpointHandler) {
-    g_endpointHandler->setBeacon(beaconInstance);
+  if (endpointHandler) {
+    endpointHandler->setBeacon(beaconInstance);
   }
 }
 
 void WebServer::updateBeaconState(const char* netState, const char* txState, const char* band, uint32_t frequency) {
-  g_beaconState.networkState = netState;
-  g_beaconState.transmissionState = txState;
-  g_beaconState.currentBand = band;
-  g_beaconState.currentFrequency = frequency;
-  g_beaconState.isTransmitting = (strcmp(txState, "TRANSMITTING") == 0);
-  
-  if (g_endpointHandler) {
-    g_endpointHandler->updateBeaconState(netState, txState, band, frequency);
+  if (endpointHandler) {
+    endpointHandler->updateBeaconState(netState, txState, band, frequency);
   }
 }
 
@@ -120,6 +94,11 @@ esp_err_t WebServer::setContentTypeFromFile(httpd_req_t *req, const char *filena
   return httpd_resp_set_type(req, "text/plain");
 }
 
+ESP32HttpEndpointHandler *WebServer::endpointHandlerFor(httpd_req_t *req) {
+  WebServer *self = static_cast<WebServer *>(req->user_ctx);
+  return self ? self->endpointHandler.get() : nullptr;
+}
+
 esp_err_t WebServer::rootGetHandler(httpd_req_t *req) {
   httpd_resp_set_status(req, "307 Temporary Redirect");
   httpd_resp_set_hdr(req, "Location", "/index.html");
@@ -178,7 +157,8 @@ esp_err_t WebServer::fileGetHandler(httpd_req_t *req) {
 }
 
 esp_err_t WebServer::apiSettingsGetHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -187,14 +167,15 @@ esp_err_t WebServer::apiSettingsGetHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiSettings(&request, &response);
+  HttpHandlerResult result = handler->handleApiSettings(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiSettingsPostHandler(httpd_req_t *req) {
   ESP_LOGI(TAG, "*** POST REQUEST RECEIVED *** apiSettingsPostHandler: Settings save requested");
   
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -203,12 +184,13 @@ esp_err_t WebServer::apiSettingsPostHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiSettings(&request, &response);
+  HttpHandlerResult result = handler->handleApiSettings(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiStatusGetHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -217,7 +199,7 @@ esp_err_t WebServer::apiStatusGetHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiStatus(&request, &response);
+  HttpHandlerResult result = handler->handleApiStatus(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
@@ -235,7 +217,8 @@ std::string formatTimeISO(int64_t unixTime) {
 }
 
 esp_err_t WebServer::apiTimeGetHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -244,12 +227,13 @@ esp_err_t WebServer::apiTimeGetHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiTime(&request, &response);
+  HttpHandlerResult result = handler->handleApiTime(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiTimeSyncHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -258,7 +242,7 @@ esp_err_t WebServer::apiTimeSyncHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiTimeSync(&request, &response);
+  HttpHandlerResult result = handler->handleApiTimeSync(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
@@ -268,7 +252,8 @@ esp_err_t WebServer::apiLiveStatusHandler(httpd_req_t *req) {
 }
 
 esp_err_t WebServer::apiWifiScanHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -277,7 +262,7 @@ esp_err_t WebServer::apiWifiScanHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiWifiScan(&request, &response);
+  HttpHandlerResult result = handler->handleApiWifiScan(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
@@ -298,7 +283,8 @@ esp_err_t WebServer::captivePortalHandler(httpd_req_t *req) {
 }
 
 esp_err_t WebServer::apiCalibrationStartHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -307,12 +293,13 @@ esp_err_t WebServer::apiCalibrationStartHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiCalibrationStart(&request, &response);
+  HttpHandlerResult result = handler->handleApiCalibrationStart(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiCalibrationStopHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -321,12 +308,13 @@ esp_err_t WebServer::apiCalibrationStopHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiCalibrationStop(&request, &response);
+  HttpHandlerResult result = handler->handleApiCalibrationStop(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiCalibrationAdjustHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -335,12 +323,28 @@ esp_err_t WebServer::apiCalibrationAdjustHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiCalibrationAdjust(&request, &response);
+  HttpHandlerResult result = handler->handleApiCalibrationAdjust(&request, &response);
+  return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t WebServer::apiCalibrationPreviewHandler(httpd_req_t *req) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
+    ESP_LOGE(TAG, "Endpoint handler not initialized");
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+  
+  ESP32HttpRequest request(req);
+  ESP32HttpResponse response(req);
+  
+  HttpHandlerResult result = handler->handleApiCalibrationPreview(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t WebServer::apiCalibrationCorrectionHandler(httpd_req_t *req) {
-  if (!g_endpointHandler) {
+  ESP32HttpEndpointHandler *handler = endpointHandlerFor(req);
+  if (!handler) {
     ESP_LOGE(TAG, "Endpoint handler not initialized");
     httpd_resp_send_500(req);
     return ESP_FAIL;
@@ -349,7 +353,7 @@ esp_err_t WebServer::apiCalibrationCorrectionHandler(httpd_req_t *req) {
   ESP32HttpRequest request(req);
   ESP32HttpResponse response(req);
   
-  HttpHandlerResult result = g_endpointHandler->handleApiCalibrationCorrection(&request, &response);
+  HttpHandlerResult result = handler->handleApiCalibrationCorrection(&request, &response);
   return (result == HttpHandlerResult::OK) ? ESP_OK : ESP_FAIL;
 }
 
@@ -461,6 +465,14 @@ void WebServer::start() {
   };
   httpd_register_uri_handler(server, &apiCalibrationAdjust);
 
+  const httpd_uri_t apiCalibrationPreview = {
+    .uri = "/api/calibration/preview",
+    .method = HTTP_POST,
+    .handler = apiCalibrationPreviewHandler,
+    .user_ctx = this
+  };
+  httpd_register_uri_handler(server, &apiCalibrationPreview);
+
   const httpd_uri_t apiCalibrationCorrection = {
     .uri = "/api/calibration/correction",
     .method = HTTP_POST,
@@ -5,17 +5,16 @@
 #include "TimeIntf.h"
 #include "Scheduler.h"
 #include <functional>
+#include <memory>
 #include "esp_http_server.h"
 
 // Forward declaration to avoid circular dependency
 class Beacon;
+class ESP32HttpEndpointHandler;
 
-// Function to update beacon state for status API
-void updateBeaconState(const char* netState, const char* txState, const char* band, int frequency);
-
+// All server state belongs to the instance; handlers find it through the
+// user_ctx of the URI they were registered for
 class WebServer : public WebServerIntf {
-  friend void updateBeaconState(const char* netState, const char* txState, const char* band, int frequency);
-  
 public:
   WebServer(SettingsIntf *settings, TimeIntf *time);
   ~WebServer() override;
@@ -42,9 +41,11 @@ private:
   static esp_err_t apiCalibrationStartHandler(httpd_req_t *req);
   static esp_err_t apiCalibrationStopHandler(httpd_req_t *req);
   static esp_err_t apiCalibrationAdjustHandler(httpd_req_t *req);
+  static esp_err_t apiCalibrationPreviewHandler(httpd_req_t *req);
   static esp_err_t apiCalibrationCorrectionHandler(httpd_req_t *req);
   static esp_err_t captivePortalHandler(httpd_req_t *req);
   static esp_err_t setContentTypeFromFile(httpd_req_t *req, const char *filename);
+  static ESP32HttpEndpointHandler *endpointHandlerFor(httpd_req_t *req);
 
   httpd_handle_t server;
   SettingsIntf *settings;
@@ -52,5 +53,5 @@ private:
   Scheduler *scheduler;
   Beacon *beacon;
   std::function<void()> settingsChangedCallback;
-  static WebServer *instanceForApi;
+  std::unique_ptr<ESP32HttpEndpointHandler> endpointHandler;
 };
\ No newline at end of file
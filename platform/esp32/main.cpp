@@ -9,6 +9,11 @@
 
 extern "C" void app_main(void) {
   static AppContext ctx;
-  Beacon beacon(&ctx);
-  beacon.run();
+  static Beacon beacon(&ctx);
+
+  // The main loop applies every symbol, so it runs as control on the core
+  // WiFi does not use rather than in the main task on core 0
+  if (!ctx.task->start("beacon", TaskIntf::Class::Control, []() { beacon.run(); }, 8192)) {
+    beacon.run();
+  }
 }
@@ -11,6 +11,8 @@
 #include "Task.h"
 #include "EventGroup.h"
 #include "WSPRModulator.h"
+#include "SymbolRenderer.h"
+#include <cstdlib>
 
 AppContext::AppContext() {
   logger = new Logger();
@@ -25,9 +27,18 @@ AppContext::AppContext() {
   task = new Task();
   eventGroup = new EventGroup();
   wsprModulator = new WSPRModulator(timer);
+
+  // WSPR_RENDER_WAV=<file> renders transmissions to 12 kHz audio,
+  // WSPR_RENDER_IQ=<file> to complex baseband
+  symbolOutput = nullptr;
+  SymbolRenderer::Options renderOptions;
+  const char* renderPath = getenv("WSPR_RENDER_WAV");
+  if (!renderPath && (renderPath = getenv("WSPR_RENDER_IQ"))) renderOptions.format = SymbolRenderer::IQ;
+  if (renderPath) symbolOutput = new SymbolRenderer(renderPath, renderOptions);
 }
 
 AppContext::~AppContext() {
+  delete symbolOutput;
   delete wsprModulator;
   delete eventGroup;
   delete task;
@@ -1,6 +1,6 @@
 #include "EventGroup.h"
 
-EventGroup::EventGroup() : bits_(0) {}
+EventGroup::EventGroup() : bits_(0), wakeups_(0), created_(std::chrono::steady_clock::now()) {}
 
 EventGroup::~EventGroup() {}
 
@@ -25,6 +25,7 @@ uint32_t EventGroup::waitBits(uint32_t bitsToWaitFor, bool clearOnExit, bool wai
   }
   
   uint32_t result = bits_ & bitsToWaitFor;
+  wakeups_++;
   
   if (success && clearOnExit) {
     bits_ &= ~bitsToWaitFor;
@@ -49,4 +50,14 @@ uint32_t EventGroup::clearBits(uint32_t bitsToClear) {
 uint32_t EventGroup::getBits() const {
   std::lock_guard<std::mutex> lock(mutex_);
   return bits_;
-}
\ No newline at end of file
+}
+
+uint64_t EventGroup::getWakeups() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return wakeups_;
+}
+
+double EventGroup::getWakeupsPerHour() const {
+  const double hours = std::chrono::duration<double>(std::chrono::steady_clock::now() - created_).count() / 3600;
+  return hours > 0 ? getWakeups() / hours : 0;
+}
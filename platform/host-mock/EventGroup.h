@@ -22,8 +22,15 @@ public:
   // Get current value.
   uint32_t getBits() const override;
 
+  // Returns from waitBits(), and their rate since construction, to see how
+  // often a task sleeping on this group wakes
+  uint64_t getWakeups() const;
+  double getWakeupsPerHour() const;
+
 private:
   mutable std::mutex mutex_;
   std::condition_variable cv_;
   uint32_t bits_;
+  uint64_t wakeups_;
+  std::chrono::steady_clock::time_point created_;
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "I2CBus.h"
+#include <cstring>
+
+I2CBus::I2CBus(uint32_t sclHz) : sclHz(sclHz), timeUs(0), deviceCount(0) {
+  memset(registers, 0, sizeof(registers));
+  resetStats();
+}
+
+I2CBus::~I2CBus() {}
+
+bool I2CBus::write(uint8_t addr, const uint8_t* data, size_t len) {
+  transactions++;
+  bytes += len;
+  // Nine clocks per byte with its ACK, plus about one each for start and stop
+  const double us = (9.0 * (len + 1) + 2) * 1e6 / sclHz;
+  busTimeUs += us;
+  timeUs += us;
+
+  if (deviceCount > 0) {
+    int dev = 0;
+    while (dev < deviceCount && deviceAddr[dev] != addr) dev++;
+    if (dev == deviceCount) return false;
+    devices[dev]->write(data, len, timeUs);
+  }
+
+  for (size_t i = 1; i < len; i++) {
+    registers[(uint8_t) (data[0] + i - 1)] = data[i];
+  }
+  return true;
+}
+
+void I2CBus::attach(uint8_t addr, I2CDevice* device) {
+  if (deviceCount == maxDevices) return;
+  devices[deviceCount] = device;
+  deviceAddr[deviceCount] = addr;
+  deviceCount++;
+}
+
+void I2CBus::resetStats() {
+  transactions = 0;
+  bytes = 0;
+  busTimeUs = 0;
+}
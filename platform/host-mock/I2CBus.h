@@ -0,0 +1,48 @@
+#pragma once
+
+#include "I2CBusIntf.h"
+
+// A simulated device on the host bus
+class I2CDevice {
+public:
+  virtual ~I2CDevice() {}
+
+  // One transaction to the device's address, ending at timeUs
+  virtual void write(const uint8_t* data, size_t len, double timeUs) = 0;
+};
+
+// Host I2C bus. It counts the traffic and keeps the register image the
+// writes would leave in a register device (first byte the address,
+// auto-increment after it). With no device attached every write succeeds;
+// otherwise writes go to the device at their address and others NACK.
+// Time is simulated: each transaction advances it by its bus time.
+class I2CBus : public I2CBusIntf {
+public:
+  I2CBus(uint32_t sclHz = 100000);
+  ~I2CBus() override;
+
+  bool write(uint8_t addr, const uint8_t* data, size_t len) override;
+
+  void attach(uint8_t addr, I2CDevice* device);
+  double getTimeUs() const { return timeUs; }
+  void advanceUs(double us) { timeUs += us; }
+
+  void resetStats();
+  uint64_t getTransactions() const { return transactions; }
+  uint64_t getBytes() const { return bytes; }          // after the address byte
+  double getBusTimeUs() const { return busTimeUs; }    // start, address, data with ACKs, stop
+  const uint8_t* getRegisters() const { return registers; }
+
+private:
+  uint32_t sclHz;
+  uint64_t transactions;
+  uint64_t bytes;
+  double busTimeUs;
+  double timeUs;
+  uint8_t registers[256];
+
+  static const int maxDevices = 4;
+  I2CDevice* devices[maxDevices];
+  uint8_t deviceAddr[maxDevices];
+  int deviceCount;
+};
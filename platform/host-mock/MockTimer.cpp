@@ -39,6 +39,7 @@ TimerIntf::Timer* MockTimer::createOneShot(const std::function<void()>& callback
     event->triggerTime = 0;
     event->active = false;
     event->oneShot = true;
+    event->periodSeconds = 0;
     event->id = timerId++;
     
     timers.push_back(std::move(event));
@@ -58,6 +59,7 @@ TimerIntf::Timer* MockTimer::createPeriodic(const std::function<void()>& callbac
     event->triggerTime = 0;
     event->active = false;
     event->oneShot = false;
+    event->periodSeconds = 0;
     event->id = timerId++;
     
     timers.push_back(std::move(event));
@@ -71,6 +73,7 @@ void MockTimer::start(Timer* timer, unsigned int timeoutMs) {
     if (!event) return;
     
     event->triggerTime = mockCurrentTime + (timeoutMs / 1000);
+    event->periodSeconds = 0;
     event->active = true;
     
     std::ostringstream oss;
@@ -79,6 +82,42 @@ void MockTimer::start(Timer* timer, unsigned int timeoutMs) {
     logActivity(oss.str());
 }
 
+void MockTimer::startAt(Timer* timer, int64_t deadlineUs, Clock clock, unsigned int periodMs) {
+    auto event = findTimerEvent(timer);
+    if (!event) return;
+    
+    // Both clocks are mock time here; round the deadline and the period up
+    // to whole seconds
+    event->triggerTime = (time_t) ((deadlineUs + 999999) / 1000000);
+    event->periodSeconds = (int) ((periodMs + 999) / 1000);
+    event->active = true;
+    
+    std::ostringstream oss;
+    oss << "Started timer ID " << event->id << " at "
+        << (clock == Clock::Utc ? "UTC " : "monotonic ") << deadlineUs << "us (trigger at T+"
+        << (event->triggerTime - mockCurrentTime) << "s";
+    if (event->periodSeconds > 0) {
+        oss << ", every " << event->periodSeconds << "s";
+    }
+    oss << ")";
+    logActivity(oss.str());
+}
+
+void MockTimer::setSlack(Timer* timer, unsigned int slackMs) {
+    auto event = findTimerEvent(timer);
+    if (!event) return;
+    
+    // Mock time moves in whole seconds, so there is nothing to coalesce
+    std::ostringstream oss;
+    oss << "Timer ID " << event->id << " slack " << slackMs << "ms";
+    logActivity(oss.str());
+}
+
+int64_t MockTimer::nowUs(Clock clock) {
+    (void) clock;  // Both clocks are mock time
+    return (int64_t) mockCurrentTime * 1000000;
+}
+
 void MockTimer::stop(Timer* timer) {
     auto event = findTimerEvent(timer);
     if (!event) return;
@@ -182,7 +221,14 @@ void MockTimer::processTimers() {
                 << " at mock time " << mockCurrentTime;
             logActivity(oss.str());
             
-            event->active = false;
+            if (event->periodSeconds > 0) {
+                // Next period from this deadline; periods already missed are skipped
+                do {
+                    event->triggerTime += event->periodSeconds;
+                } while (event->triggerTime <= mockCurrentTime);
+            } else {
+                event->active = false;
+            }
             if (event->callback) {
                 event->callback();
             }
@@ -14,6 +14,7 @@ public:
         time_t triggerTime;
         bool active;
         bool oneShot;
+        int periodSeconds;      // startAt() repeat, 0 to fire once
         int id;
     };
 
@@ -23,6 +24,9 @@ public:
     Timer* createOneShot(const std::function<void()>& callback) override;
     Timer* createPeriodic(const std::function<void()>& callback) override;
     void start(Timer* timer, unsigned int timeoutMs) override;
+    void startAt(Timer* timer, int64_t deadlineUs, Clock clock, unsigned int periodMs = 0) override;
+    void setSlack(Timer* timer, unsigned int slackMs) override;
+    int64_t nowUs(Clock clock) override;
     void stop(Timer* timer) override;
     void destroy(Timer* timer) override;
     void delayMs(int timeoutMs) override;
@@ -2,7 +2,10 @@
 #include <stdio.h>
 #include <string.h>
 
-Si5351::Si5351() {
+// Crystal the tone table is computed for, as on the usual 25 MHz boards
+static constexpr uint32_t MockCrystalHz = 25000000;
+
+Si5351::Si5351() : verbose(true), correction(0), previewPpb(0) {
   for (int i = 0; i < 3; i++) {
     freq[i] = 0.0;
     outputEnabled[i] = false;
@@ -44,23 +47,71 @@ void Si5351::reset() {
 
 void Si5351::setCalibration(int32_t correction) {
   printf("[Si5351HostMock] setCalibration correction=%d mPPM\n", correction);
+  this->correction = correction;
+}
+
+void Si5351::fineTune(int channel, double freqHz) {
+  if (channel < 0 || channel >= 3) {
+    printf("[Si5351HostMock] fineTune invalid channel %d\n", channel);
+    return;
+  }
+  freq[channel] = freqHz;
+  if (verbose) printf("[Si5351HostMock] fineTune channel=%d freq=%.3f Hz (multisynth only)\n", channel, freqHz);
+}
+
+void Si5351::previewCorrection(int channel, int32_t ppb) {
+  if (channel < 0 || channel >= 3) {
+    printf("[Si5351HostMock] previewCorrection invalid channel %d\n", channel);
+    return;
+  }
+  previewPpb = ppb;
+  if (verbose) printf("[Si5351HostMock] previewCorrection channel=%d %d ppb\n", channel, ppb);
 }
 
-void Si5351::setupChannelSmooth(int channel, double baseFreqHz, const double* wspr_freqs) {
+void Si5351::setupChannelSmooth(int channel, double baseFreqHz, const double* toneFreqs, int toneCount) {
   if (channel < 0 || channel >= 3) {
     printf("[Si5351HostMock] setupChannelSmooth invalid channel %d\n", channel);
     return;
   }
+  if (toneFreqs && (toneCount < 1 || toneCount > Si5351ToneTable::MaxTones)) {
+    printf("[Si5351HostMock] setupChannelSmooth: %d tones, at most %d supported\n", toneCount,
+           Si5351ToneTable::MaxTones);
+    return;
+  }
   
   freq[channel] = baseFreqHz;
-  printf("[Si5351HostMock] setupChannelSmooth channel=%d baseFreq=%.6f Hz\n", channel, baseFreqHz);
+  if (verbose) printf("[Si5351HostMock] setupChannelSmooth channel=%d baseFreq=%.6f Hz\n", channel, baseFreqHz);
   
-  if (wspr_freqs) {
-    printf("[Si5351HostMock] WSPR frequencies: [%.6f, %.6f, %.6f, %.6f] Hz\n", 
-           wspr_freqs[0], wspr_freqs[1], wspr_freqs[2], wspr_freqs[3]);
+  if (toneFreqs && verbose) {
+    printf("[Si5351HostMock] %d tone frequencies: %.6f to %.6f Hz\n", toneCount, toneFreqs[0],
+           toneFreqs[toneCount - 1]);
   }
   
-  printf("[Si5351HostMock] Channel %d configured for smooth WSPR frequency transitions\n", channel);
+  // Same register values the ESP32 driver would write; the frequency is
+  // what they synthesize
+  toneTable.toneCount = 0;
+  if (channel == 0 && toneFreqs && toneTable.compute(MockCrystalHz, correction, toneFreqs, toneCount)) {
+    freq[channel] = toneTable.toneHz(toneTable.nearestTone(baseFreqHz));
+    if (verbose) {
+      printf("[Si5351HostMock] Tone table: PLL %.0f Hz, R=%d, %d register(s) per tone change\n",
+             toneTable.pllHz, 1 << toneTable.rDivLog2, 8 - toneTable.burstStart);
+    }
+  }
+  
+  if (verbose) printf("[Si5351HostMock] Channel %d configured for smooth WSPR frequency transitions\n", channel);
+}
+
+void Si5351::selectChannelTone(int channel, int tone) {
+  if (channel != 0 || tone < 0 || tone >= toneTable.toneCount) {
+    printf("[Si5351HostMock] selectChannelTone no tone %d on channel %d\n", tone, channel);
+    return;
+  }
+  
+  freq[channel] = toneTable.toneHz(tone);
+  if (verbose) {
+    printf("[Si5351HostMock] Tone %d: burst of regs %d-49 -> %.6f Hz\n", tone, 42 + toneTable.burstStart,
+           freq[channel]);
+  }
 }
 
 void Si5351::updateChannelFrequency(int channel, double newFreqHz) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Si5351Intf.h"
+#include "Si5351ToneTable.h"
 #include <stdio.h>
 
 class Si5351 : public Si5351Intf {
@@ -13,16 +14,26 @@ public:
   void enableOutput(int channel, bool enable) override;
   void reset() override;
   void setCalibration(int32_t correction) override;
+  void fineTune(int channel, double freqHz) override;
+  void previewCorrection(int channel, int32_t ppb) override;
   
   // Smooth frequency transition methods for WSPR
-  void setupChannelSmooth(int channel, double baseFreqHz, const double* wspr_freqs) override;
+  void setupChannelSmooth(int channel, double baseFreqHz, const double* toneFreqs, int toneCount) override;
+  void selectChannelTone(int channel, int tone) override;
   void updateChannelFrequency(int channel, double newFreqHz) override;
   void updateChannelFrequencyMinimal(int channel, double newFreqHz) override;
 
   // For testing/logging purposes
   void printState();
+  void setVerbose(bool on) { verbose = on; }
+  double getFrequency(int channel) const { return freq[channel]; }
+  const Si5351ToneTable& getToneTable() const { return toneTable; }
 
 private:
   double freq[3];
   bool outputEnabled[3];
+  bool verbose;
+  int32_t correction;
+  int32_t previewPpb;
+  Si5351ToneTable toneTable;   // channel 0 tones, as the ESP32 driver programs them
 };
\ No newline at end of file
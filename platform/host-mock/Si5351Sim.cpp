@@ -0,0 +1,186 @@
+#include "Si5351Sim.h"
+#include <algorithm>
+#include <cstring>
+
+typedef unsigned __int128 Wide;
+
+static Wide gcd(Wide a, Wide b) {
+  while (b != 0) {
+    const Wide t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// P1, P2, P3 of the eight parameter bytes at base
+static void params(const uint8_t* r, uint32_t& p1, uint32_t& p2, uint32_t& p3) {
+  p3 = ((uint32_t) (r[5] & 0xF0) << 12) | ((uint32_t) r[0] << 8) | r[1];
+  p1 = ((uint32_t) (r[2] & 0x3) << 16) | ((uint32_t) r[3] << 8) | r[4];
+  p2 = ((uint32_t) (r[5] & 0xF) << 16) | ((uint32_t) r[6] << 8) | r[7];
+}
+
+Si5351Sim::Si5351Sim(uint32_t xtalHz, int32_t xtalErrorPpb) : xtalHz(xtalHz), xtalErrorPpb(xtalErrorPpb) {
+  memset(registers, 0, sizeof(registers));
+  for (int clk = 0; clk < 8; clk++) registers[16 + clk] = 0x80;   // powered down at reset
+  for (int clk = 0; clk < 3; clk++) {
+    enabled[clk] = false;
+    enabledAtClear[clk] = false;
+    valid[clk] = false;
+  }
+}
+
+void Si5351Sim::setCrystal(uint32_t xtalHz, int32_t xtalErrorPpb) {
+  this->xtalHz = xtalHz;
+  this->xtalErrorPpb = xtalErrorPpb;
+}
+
+void Si5351Sim::write(const uint8_t* data, size_t len, double timeUs) {
+  if (len < 2) return;   // a bare register address only sets the read pointer
+
+  for (size_t i = 1; i < len; i++) {
+    const uint8_t reg = (uint8_t) (data[0] + i - 1);
+    registers[reg] = data[i];
+
+    // PLL reset bits clear themselves
+    if (reg == 177) {
+      if (data[i] & (1 << 5)) events.push_back({timeUs, Si5351SimEvent::PllReset, 0, {}, "PLL A"});
+      if (data[i] & (1 << 7)) events.push_back({timeUs, Si5351SimEvent::PllReset, 1, {}, "PLL B"});
+      registers[177] = 0;
+    }
+  }
+  update(timeUs);
+}
+
+void Si5351Sim::clearEvents() {
+  events.clear();
+  for (int clk = 0; clk < 3; clk++) {
+    enabledAtClear[clk] = enabled[clk];
+    freqAtClear[clk] = valid[clk] ? freq[clk] : Si5351SimFrequency();
+  }
+}
+
+bool Si5351Sim::decode(int clk, Si5351SimFrequency& f, std::string& why) const {
+  const uint8_t ctrl = registers[16 + clk];
+  if ((ctrl & 0x0C) != 0x0C) {
+    why = "not sourced from its multisynth";
+    return false;
+  }
+
+  uint32_t p1, p2, p3;
+  params(registers + ((ctrl & (1 << 5)) ? 34 : 26), p1, p2, p3);
+  if (p3 == 0 || p2 >= p3) {
+    why = "PLL P2/P3 invalid";
+    return false;
+  }
+  // PLL = xtal * pllNum / (128 P3), 15-90 times the crystal, 600-900 MHz
+  const Wide xtal = (Wide) xtalHz * (uint64_t) (1000000000LL + xtalErrorPpb);   // Hz * 1e9
+  const Wide pllNum = (Wide) p3 * (p1 + 512) + p2;
+  const Wide pllDen = (Wide) 128 * p3;
+  if (pllNum < 15 * pllDen || pllNum > 90 * pllDen) {
+    why = "PLL multiplier outside 15-90";
+    return false;
+  }
+  const Wide vcoNum = xtal * pllNum, vcoDen = pllDen * 1000000000;
+  if (vcoNum < (Wide) 600000000 * vcoDen || vcoNum > (Wide) 900000000 * vcoDen) {
+    why = "VCO outside 600-900 MHz";
+    return false;
+  }
+
+  const uint8_t* ms = registers + 42 + 8 * clk;
+  params(ms, p1, p2, p3);
+  const bool integerMode = (ctrl & (1 << 6)) != 0;
+  Wide msNum, msDen;
+  if (((ms[2] >> 2) & 0x3) == 0x3) {
+    msNum = 4;
+    msDen = 1;
+  } else {
+    if (p3 == 0 || p2 >= p3) {
+      why = "multisynth P2/P3 invalid";
+      return false;
+    }
+    msNum = (Wide) p3 * (p1 + 512) + p2;
+    msDen = (Wide) 128 * p3;
+    const bool even = p2 == 0 && (p1 + 512) % 256 == 0;
+    if (integerMode && !even) {
+      why = "integer mode with a fractional or odd divider";
+      return false;
+    }
+    if (msNum != 6 * msDen && (msNum < 8 * msDen || msNum > 2048 * msDen)) {
+      why = "multisynth divider not 4, 6 or 8-2048";
+      return false;
+    }
+  }
+
+  // f = vco / ms / R
+  f.num = vcoNum * msDen;
+  f.den = vcoDen * msNum << ((ms[2] >> 4) & 0x7);
+  const Wide g = gcd(f.num, f.den);
+  f.num /= g;
+  f.den /= g;
+  return true;
+}
+
+void Si5351Sim::update(double timeUs) {
+  for (int clk = 0; clk < 3; clk++) {
+    Si5351SimFrequency f;
+    std::string why;
+    const bool ok = decode(clk, f, why);
+    const bool on = !(registers[3] & (1 << clk)) && !(registers[16 + clk] & 0x80);
+
+    if (ok && (!valid[clk] || f != freq[clk])) {
+      events.push_back({timeUs, Si5351SimEvent::Frequency, clk, f, ""});
+    }
+    if (!ok && on && (valid[clk] || !enabled[clk] || why != invalidReason[clk])) {
+      events.push_back({timeUs, Si5351SimEvent::Invalid, clk, {}, why});
+    }
+    if (on != enabled[clk]) {
+      events.push_back({timeUs, on ? Si5351SimEvent::Enabled : Si5351SimEvent::Disabled, clk, {}, ""});
+    }
+
+    valid[clk] = ok;
+    if (ok) freq[clk] = f;
+    invalidReason[clk] = ok ? "" : why;
+    enabled[clk] = on;
+  }
+}
+
+double Si5351Sim::glitchUs(int clk, double fromUs, double toUs, double settleUs) const {
+  // Disabled and PLL reset windows, merged and clipped to the range
+  std::vector<std::pair<double, double>> windows;
+  const int pll = (registers[16 + clk] & (1 << 5)) ? 1 : 0;
+  double disabledSince = 0;
+  bool on = enabledAtClear[clk];
+  for (const Si5351SimEvent& e : events) {
+    if (e.kind == Si5351SimEvent::PllReset && e.clk == pll) {
+      windows.push_back({e.timeUs, e.timeUs + settleUs});
+    } else if (e.clk == clk && e.kind == Si5351SimEvent::Enabled) {
+      windows.push_back({disabledSince, e.timeUs});
+      on = true;
+    } else if (e.clk == clk && e.kind == Si5351SimEvent::Disabled) {
+      disabledSince = e.timeUs;
+      on = false;
+    }
+  }
+  if (!on) windows.push_back({disabledSince, toUs});
+
+  std::sort(windows.begin(), windows.end());
+  double total = 0, end = fromUs;
+  for (const std::pair<double, double>& w : windows) {
+    const double a = std::max(w.first, end), b = std::min(w.second, toUs);
+    if (b > a) {
+      total += b - a;
+      end = b;
+    }
+  }
+  return total;
+}
+
+Si5351SimFrequency Si5351Sim::frequencyAt(int clk, double timeUs) const {
+  Si5351SimFrequency f = freqAtClear[clk];
+  for (const Si5351SimEvent& e : events) {
+    if (e.timeUs > timeUs) break;
+    if (e.clk == clk && e.kind == Si5351SimEvent::Frequency) f = e.freq;
+  }
+  return f;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "I2CBus.h"
+#include <string>
+#include <vector>
+
+// Exact output frequency: num / den Hz
+struct Si5351SimFrequency {
+  unsigned __int128 num = 0;
+  unsigned __int128 den = 1;
+
+  double hz() const { return (double) num / (double) den; }
+  // Truncated; the remainder is scaled in steps so it cannot overflow
+  uint64_t nanoHz() const {
+    unsigned __int128 whole = num / den, rem = num % den;
+    for (int i = 0; i < 3; i++) {
+      rem *= 1000;
+      whole = whole * 1000 + rem / den;
+      rem %= den;
+    }
+    return (uint64_t) whole;
+  }
+  bool operator==(const Si5351SimFrequency& o) const { return num == o.num && den == o.den; }
+  bool operator!=(const Si5351SimFrequency& o) const { return !(*this == o); }
+};
+
+struct Si5351SimEvent {
+  enum Kind {
+    Frequency,   // clk's output changed to freq
+    Enabled,     // clk's output started
+    Disabled,    // clk's output stopped
+    PllReset,    // PLL clk (0 = A, 1 = B) was reset; its outputs glitch
+    Invalid,     // clk's registers are outside what the chip supports
+  };
+
+  double timeUs;
+  Kind kind;
+  int clk;
+  Si5351SimFrequency freq;
+  std::string detail;
+};
+
+// Register-level Si5351 on the host I2C bus. Writes land in the 256
+// registers as on the chip; after each transaction CLK0-2 are decoded
+// from the PLL (26-41), multisynth (42-65), control (16-18) and output
+// enable (3) registers into exact frequencies, and every change is logged
+// with the bus time it happened at. The crystal can be given an error so
+// calibration can be exercised.
+class Si5351Sim : public I2CDevice {
+public:
+  explicit Si5351Sim(uint32_t xtalHz = 25000000, int32_t xtalErrorPpb = 0);
+
+  void write(const uint8_t* data, size_t len, double timeUs) override;
+
+  void setCrystal(uint32_t xtalHz, int32_t xtalErrorPpb);
+  const uint8_t* getRegisters() const { return registers; }
+
+  // Current state of CLK0-2
+  bool isEnabled(int clk) const { return enabled[clk]; }
+  bool isValid(int clk) const { return valid[clk]; }
+  Si5351SimFrequency getFrequency(int clk) const { return freq[clk]; }
+
+  const std::vector<Si5351SimEvent>& getEvents() const { return events; }
+  void clearEvents();
+
+  // Time clk spent disabled or glitching (after a PLL reset, until
+  // settleUs later) between fromUs and toUs
+  double glitchUs(int clk, double fromUs, double toUs, double settleUs = 0) const;
+
+  // clk's frequency at timeUs, from the event log
+  Si5351SimFrequency frequencyAt(int clk, double timeUs) const;
+
+private:
+  uint8_t registers[256];
+  uint32_t xtalHz;
+  int32_t xtalErrorPpb;
+
+  bool enabled[3];
+  bool enabledAtClear[3];   // output state and frequency when the log starts
+  bool valid[3];
+  Si5351SimFrequency freq[3];
+  Si5351SimFrequency freqAtClear[3];
+  std::string invalidReason[3];
+  std::vector<Si5351SimEvent> events;
+
+  bool decode(int clk, Si5351SimFrequency& f, std::string& why) const;
+  void update(double timeUs);
+};
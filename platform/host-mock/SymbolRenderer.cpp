@@ -0,0 +1,221 @@
+#include "SymbolRenderer.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// Eight oscillator lanes; GCC lowers this to SSE2 pairs or one AVX register
+typedef float v8f __attribute__((vector_size(32)));
+
+static constexpr int Lanes = 8;
+
+// Lane phasors are recomputed from the accumulator this often, so rounding
+// in the rotation never builds up
+static constexpr int ResyncFrames = 512;
+
+static constexpr double TurnRadians = 6.283185307179586 / 4294967296.0;
+
+static int64_t steadyClockUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void putLE(uint8_t* p, uint32_t v, int bytes) {
+  for (int i = 0; i < bytes; ++i) p[i] = (uint8_t) (v >> (8 * i));
+}
+
+SymbolRenderer::SymbolRenderer(const std::string& path, const Options& opts, Clock clk)
+  : options(opts),
+    clock(clk ? clk : Clock(steadyClockUs)),
+    file(nullptr),
+    channels(opts.format == IQ ? 2 : 1),
+    phase(0),
+    phaseStep(0),
+    streaming(false),
+    startUs(0),
+    symbolStartUs(0),
+    frames(0),
+    leadInFrames(0),
+    symbols(0),
+    maxJitterMs(0),
+    sumSquaredJitterMs(0)
+{
+  file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    std::cout << "SymbolRenderer: Cannot open " << path << std::endl;
+    return;
+  }
+  writeHeader();
+}
+
+SymbolRenderer::~SymbolRenderer() {
+  if (streaming) endSymbolStream();
+  if (file) {
+    writeHeader();
+    std::fclose(file);
+  }
+}
+
+void SymbolRenderer::startSymbolStream(int firstSymbol) {
+  if (!file || streaming) return;
+
+  leadInFrames = (uint64_t) llround(options.leadInSec * options.sampleRate);
+  writeSilence(leadInFrames);
+  setTone(firstSymbol);
+  streaming = true;
+  symbols = 0;
+  maxJitterMs = 0;
+  sumSquaredJitterMs = 0;
+}
+
+void SymbolRenderer::outputSymbol(int symbolIndex, int symbolValue) {
+  if (!file || !streaming) return;
+
+  const int64_t now = clock();
+  if (symbolIndex == 0) {
+    startUs = now;
+  } else {
+    // The previous symbol ends now: render it and note how far off its
+    // length was
+    const int64_t frameAt = (now - startUs) * options.sampleRate / 1000000;
+    const uint64_t end = leadInFrames + (uint64_t) (frameAt > 0 ? frameAt : 0);
+    if (end > frames) renderFrames(end - frames);
+
+    const double jitterMs = (now - symbolStartUs) / 1000.0 - options.symbolPeriodMs;
+    maxJitterMs = std::fmax(maxJitterMs, std::fabs(jitterMs));
+    sumSquaredJitterMs += jitterMs * jitterMs;
+    ++symbols;
+  }
+
+  symbolStartUs = now;
+  setTone(symbolValue);
+}
+
+void SymbolRenderer::endSymbolStream() {
+  if (!file || !streaming) return;
+  finish();
+}
+
+void SymbolRenderer::outputSymbolArray(const uint8_t* symbols, int count) {
+  // The stream is rendered from outputSymbol() as it is transmitted
+  (void) symbols;
+  (void) count;
+}
+
+SymbolRenderer::TimingStats SymbolRenderer::timingStats() const {
+  TimingStats stats;
+  stats.symbols = symbols;
+  stats.maxJitterMs = maxJitterMs;
+  stats.rmsJitterMs = symbols ? std::sqrt(sumSquaredJitterMs / symbols) : 0;
+  return stats;
+}
+
+void SymbolRenderer::render(float* out, int count) {
+  const v8f amplitude = {options.amplitude, options.amplitude, options.amplitude, options.amplitude,
+                         options.amplitude, options.amplitude, options.amplitude, options.amplitude};
+  const float c8 = (float) std::cos((uint32_t) (phaseStep * Lanes) * TurnRadians);
+  const float s8 = (float) std::sin((uint32_t) (phaseStep * Lanes) * TurnRadians);
+
+  for (int base = 0; base < count; base += ResyncFrames) {
+    const int n = count - base < ResyncFrames ? count - base : ResyncFrames;
+
+    v8f re, im;
+    for (int k = 0; k < Lanes; ++k) {
+      const double a = (uint32_t) (phase + phaseStep * k) * TurnRadians;
+      re[k] = (float) std::cos(a);
+      im[k] = (float) std::sin(a);
+    }
+
+    for (int i = 0; i < n; i += Lanes) {
+      const v8f outRe = re * amplitude, outIm = im * amplitude;
+      const int lanes = n - i < Lanes ? n - i : Lanes;
+      float* p = out + (size_t) (base + i) * channels;
+
+      if (channels == 1) {
+        if (lanes == Lanes) memcpy(p, &outRe, sizeof(outRe));
+        else for (int k = 0; k < lanes; ++k) p[k] = outRe[k];
+      } else {
+        for (int k = 0; k < lanes; ++k) {
+          p[2 * k] = outRe[k];
+          p[2 * k + 1] = outIm[k];
+        }
+      }
+
+      // Advance every lane by eight samples
+      const v8f r = re * c8 - im * s8;
+      im = re * s8 + im * c8;
+      re = r;
+    }
+
+    phase += phaseStep * (uint32_t) n;
+  }
+}
+
+void SymbolRenderer::setTone(int tone) {
+  const double hz = options.centerHz + (tone - (options.toneCount - 1) / 2.0) * options.toneSpacingHz;
+  phaseStep = (uint32_t) (int64_t) llround(hz / options.sampleRate * 4294967296.0);
+}
+
+void SymbolRenderer::renderFrames(uint64_t count) {
+  while (count > 0) {
+    const int n = count < BufferFrames ? (int) count : BufferFrames;
+    render(renderBuffer, n);
+
+    for (int i = 0; i < n * channels; ++i) {
+      float v = renderBuffer[i] * 32767.0f;
+      v = v > 32767.0f ? 32767.0f : v < -32767.0f ? -32767.0f : v;
+      writeBuffer[i] = (int16_t) lrintf(v);
+    }
+
+    std::fwrite(writeBuffer, sizeof(int16_t) * channels, n, file);
+    frames += n;
+    count -= n;
+  }
+}
+
+void SymbolRenderer::writeSilence(uint64_t count) {
+  memset(writeBuffer, 0, sizeof(writeBuffer));
+  while (count > 0) {
+    const int n = count < BufferFrames ? (int) count : BufferFrames;
+    std::fwrite(writeBuffer, sizeof(int16_t) * channels, n, file);
+    frames += n;
+    count -= n;
+  }
+}
+
+void SymbolRenderer::finish() {
+  // The last symbol runs until the stream ends, unless the end came so late
+  // that it was not the transmitter stopping
+  int64_t endUs = clock();
+  const int64_t nominalUs = (int64_t) llround(options.symbolPeriodMs * 1000.0);
+  if (endUs - symbolStartUs > 2 * nominalUs || endUs <= symbolStartUs) endUs = symbolStartUs + nominalUs;
+
+  const uint64_t end = leadInFrames + (uint64_t) ((endUs - startUs) * options.sampleRate / 1000000);
+  if (end > frames) renderFrames(end - frames);
+  writeSilence((uint64_t) llround(options.leadOutSec * options.sampleRate));
+  streaming = false;
+  std::fflush(file);
+}
+
+void SymbolRenderer::writeHeader() {
+  // 44-byte canonical PCM WAV header; sizes are patched on close
+  const uint32_t dataBytes = (uint32_t) (frames * channels * sizeof(int16_t));
+  uint8_t h[44];
+  memcpy(h, "RIFF", 4);
+  putLE(h + 4, 36 + dataBytes, 4);
+  memcpy(h + 8, "WAVEfmt ", 8);
+  putLE(h + 16, 16, 4);
+  putLE(h + 20, 1, 2);                               // PCM
+  putLE(h + 22, channels, 2);
+  putLE(h + 24, options.sampleRate, 4);
+  putLE(h + 28, options.sampleRate * channels * 2, 4);
+  putLE(h + 32, channels * 2, 2);
+  putLE(h + 34, 16, 2);
+  memcpy(h + 36, "data", 4);
+  putLE(h + 40, dataBytes, 4);
+
+  const long at = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  std::fwrite(h, 1, sizeof(h), file);
+  if (at > (long) sizeof(h)) std::fseek(file, at, SEEK_SET);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SymbolOutputIntf.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+/**
+ * SymbolOutputIntf backend that renders the transmitted symbol stream to a
+ * WAV file, so host-mock output can be inspected or fed to a real decoder.
+ *
+ * AUDIO writes 16-bit mono audio, tones centred on centerHz, as wsprd and
+ * WSJT-X read it. IQ writes 16-bit stereo complex baseband (I left, Q right)
+ * with the tones centred centerHz from zero.
+ *
+ * Each symbol lasts from its outputSymbol() call to the next one, timed by
+ * the clock, so whatever jitter the modulator had ends up in the file. The
+ * oscillator keeps one phase accumulator across tone changes, so the signal
+ * is phase-continuous as the Si5351 output is. Audio is rendered as each
+ * symbol ends and written through a fixed buffer, so memory use does not
+ * depend on the frame length.
+ */
+class SymbolRenderer : public SymbolOutputIntf {
+public:
+  enum Format : uint8_t { AUDIO, IQ };
+
+  struct Options {
+    Format format = AUDIO;
+    int sampleRate = 12000;
+    double centerHz = 1500.0;                       // midpoint of the tone set
+    double toneSpacingHz = 12000.0 / 8192.0;        // WSPR
+    int toneCount = 4;
+    double symbolPeriodMs = 8192000.0 / 12000.0;    // nominal, for the last symbol and jitter
+    float amplitude = 0.5f;                         // of full scale
+    double leadInSec = 1.0;                         // silence before the first symbol
+    double leadOutSec = 1.0;                        // and after the last
+  };
+
+  // Monotonic microseconds; the default is std::chrono::steady_clock
+  using Clock = std::function<int64_t()>;
+
+  struct TimingStats {
+    int symbols;
+    double maxJitterMs;                             // worst |measured - nominal| period
+    double rmsJitterMs;
+  };
+
+  SymbolRenderer(const std::string& path, const Options& options, Clock clock = Clock());
+  ~SymbolRenderer() override;
+
+  void startSymbolStream(int firstSymbol) override;
+  void outputSymbol(int symbolIndex, int symbolValue) override;
+  void endSymbolStream() override;
+  void outputSymbolArray(const uint8_t* symbols, int count) override;
+
+  bool isOpen() const { return file != nullptr; }
+  uint64_t framesWritten() const { return frames; }
+  TimingStats timingStats() const;
+
+  // Renders count frames of the current tone into out (interleaved I/Q
+  // for IQ), advancing the phase. Public for the benchmark.
+  void render(float* out, int count);
+
+private:
+  static constexpr int BufferFrames = 2048;
+
+  void setTone(int tone);
+  void renderFrames(uint64_t count);
+  void writeSilence(uint64_t count);
+  void writeHeader();
+  void finish();
+
+  Options options;
+  Clock clock;
+  std::FILE* file;
+  int channels;
+
+  // Phase accumulator: a full turn is 2^32, as in a DDS
+  uint32_t phase;
+  uint32_t phaseStep;
+
+  bool streaming;
+  int64_t startUs;                                  // clock at symbol 0
+  int64_t symbolStartUs;
+  uint64_t frames;                                  // frames written, lead-in included
+  uint64_t leadInFrames;
+
+  int symbols;
+  double maxJitterMs;
+  double sumSquaredJitterMs;
+
+  float renderBuffer[2 * BufferFrames];
+  int16_t writeBuffer[2 * BufferFrames];
+};
@@ -1,5 +1,13 @@
 #include "Task.h"
 #include <iostream>
+#include <future>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 Task::Task() {}
 
@@ -18,6 +26,8 @@ Task::~Task() {
 }
 
 TaskIntf::Task *Task::start(const char *name, void (*taskFunc)(void *), void *arg, int stackSize, int priority) {
+  (void) stackSize;  // host threads size their own stacks
+  (void) priority;
   auto* impl = new TaskImpl(name);
   
   std::lock_guard<std::mutex> lock(mutex_);
@@ -33,6 +43,8 @@ TaskIntf::Task *Task::start(const char *name, void (*taskFunc)(void *), void *ar
 }
 
 TaskIntf::Task *Task::start(const char *name, const std::function<void()> &func, int stackSize, int priority) {
+  (void) stackSize;  // host threads size their own stacks
+  (void) priority;
   auto* impl = new TaskImpl(name);
   
   std::lock_guard<std::mutex> lock(mutex_);
@@ -47,6 +59,105 @@ TaskIntf::Task *Task::start(const char *name, const std::function<void()> &func,
   return impl;
 }
 
+TaskIntf::Task *Task::start(const char *name, Class cls, const std::function<void()> &func, int stackSize) {
+  (void) stackSize;  // host threads size their own stacks; cls sets the rest
+  auto* impl = new TaskImpl(name);
+  std::promise<Placement> placed;
+  std::future<Placement> placement = placed.get_future();
+  
+  impl->running_ = true;
+  impl->thread_ = std::thread([impl, cls, func, placed = std::move(placed)]() mutable {
+    placed.set_value(place(cls));
+    func();
+    impl->running_ = false;
+  });
+  
+  // The class has taken effect before the caller hears about the task
+  impl->placement_ = placement.get();
+  
+  std::lock_guard<std::mutex> lock(mutex_);
+  tasks_[impl] = impl;
+  return impl;
+}
+
+#ifdef __linux__
+static Task::Placement currentPlacement() {
+  Task::Placement placement = {-1, 0, false};
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 && CPU_COUNT(&cpus) == 1) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpus)) placement.core = cpu;
+    }
+  }
+  
+  int policy;
+  sched_param param;
+  if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && (policy == SCHED_FIFO || policy == SCHED_RR)) {
+    placement.priority = param.sched_priority;
+    placement.realtime = true;
+  } else {
+    // Ordinary threads rank by niceness
+    placement.priority = -getpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid));
+  }
+  return placement;
+}
+#endif
+
+Task::Placement Task::place(Class cls) {
+#ifdef __linux__
+  // With more than one CPU, the last one the process may use is left to
+  // rt-modulation and every other class is kept off it
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(getpid(), sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 1) {
+    int rtCpu = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) rtCpu = cpu;
+    }
+    cpu_set_t cpus = allowed;
+    if (cls == Class::RtModulation) {
+      CPU_ZERO(&cpus);
+      CPU_SET(rtCpu, &cpus);
+    } else {
+      CPU_CLR(rtCpu, &cpus);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }
+  
+  if (cls == Class::RtModulation || cls == Class::Control) {
+    sched_param param = {};
+    param.sched_priority = cls == Class::RtModulation ? RtModulationPriority : ControlPriority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+      static std::atomic<bool> warned(false);
+      if (!warned.exchange(true)) {
+        std::cout << "Task: SCHED_FIFO not permitted, " << className(cls)
+                  << " threads run with ordinary scheduling" << std::endl;
+      }
+    }
+  } else if (cls == Class::Background) {
+    setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), BackgroundNice);
+  }
+  return currentPlacement();
+#else
+  return {-1, 0, false};
+#endif
+}
+
+Task::Placement Task::getPlacement(TaskIntf::Task *task) {
+  if (!task) {
+#ifdef __linux__
+    return currentPlacement();
+#else
+    return {-1, 0, false};
+#endif
+  }
+  
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tasks_.find(task);
+  return it != tasks_.end() ? it->second->placement_ : Placement{-1, 0, false};
+}
+
 void Task::stop(TaskIntf::Task *task) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = tasks_.find(task);
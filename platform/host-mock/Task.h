@@ -11,11 +11,12 @@ class Task : public TaskIntf {
 public:
   class TaskImpl : public TaskIntf::Task {
   public:
-    TaskImpl(const std::string& name) : name_(name), running_(false) {}
+    TaskImpl(const std::string& name) : name_(name), running_(false), placement_{-1, 0, false} {}
     
     std::string name_;
     std::atomic<bool> running_;
     std::thread thread_;
+    Placement placement_;
   };
 
   Task();
@@ -27,6 +28,16 @@ public:
   // Overload to support std::function, if desired
   TaskIntf::Task *start(const char *name, const std::function<void()> &func, int stackSize = 4096, int priority = 1) override;
 
+  // Start a thread placed by its class. On Linux, rt-modulation gets the
+  // last allowed CPU to itself and SCHED_FIFO, control gets SCHED_FIFO at a
+  // lower priority, and the other classes share the remaining CPUs, with
+  // background niced. Real-time scheduling needs CAP_SYS_NICE or an
+  // RLIMIT_RTPRIO; without it those classes run as ordinary threads.
+  TaskIntf::Task *start(const char *name, Class cls, const std::function<void()> &func, int stackSize = 4096) override;
+
+  // Placement as the thread applied it
+  Placement getPlacement(TaskIntf::Task *task) override;
+
   // Stop a running task
   void stop(TaskIntf::Task *task) override;
 
@@ -36,7 +47,14 @@ public:
   // Destroy task object and release resources
   void destroy(TaskIntf::Task *task) override;
 
+  static constexpr int RtModulationPriority = 80;   // SCHED_FIFO, 1-99
+  static constexpr int ControlPriority = 40;
+  static constexpr int BackgroundNice = 10;
+
 private:
+  // Apply cls to the calling thread and return what took effect
+  static Placement place(Class cls);
+
   std::mutex mutex_;
   std::map<TaskIntf::Task*, TaskImpl*> tasks_;
 };
\ No newline at end of file
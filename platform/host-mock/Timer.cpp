@@ -1,85 +1,152 @@
 #include "Timer.h"
 #include <iostream>
 #include <ctime>
+#include <cstdlib>
 
-Timer::Timer() {}
+Timer::Timer(int workers)
+  : utcDeadlines_(0), utcOffsetUs_(0), utcStepUs_(0), shutdown_(false), fired_(0), overruns_(0), wakeups_(0) {
+  utcOffsetUs_ = nowUs(Clock::Utc) - nowUs(Clock::Monotonic);
+  dispatcher_ = std::thread([this]() { dispatch(); });
+  for (int i = 0; i < (workers > 0 ? workers : 1); i++) {
+    workers_.emplace_back([this]() { work(); });
+  }
+}
 
 Timer::~Timer() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  // Clean up any remaining timers
-  for (auto& pair : timers_) {
-    if (pair.second->running_) {
-      pair.second->running_ = false;
-      if (pair.second->thread_.joinable()) {
-        pair.second->thread_.join();
-      }
-    }
-    delete pair.second;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> jobLock(jobMutex_);
+    shutdown_ = true;
+  }
+  wake_.notify_all();
+  jobReady_.notify_all();
+  dispatcher_.join();
+  for (auto& worker : workers_) {
+    worker.join();
   }
 }
 
 TimerIntf::Timer *Timer::createOneShot(const std::function<void()> &callback) {
-  auto* impl = new TimerImpl(callback, false); // One-shot
+  auto impl = std::make_shared<TimerImpl>(callback, false); // One-shot
   std::lock_guard<std::mutex> lock(mutex_);
-  timers_[impl] = impl;
-  return impl;
+  timers_[impl.get()] = impl;
+  return impl.get();
 }
 
 TimerIntf::Timer *Timer::createPeriodic(const std::function<void()> &callback) {
-  auto* impl = new TimerImpl(callback, true); // Periodic
+  auto impl = std::make_shared<TimerImpl>(callback, true); // Periodic
   std::lock_guard<std::mutex> lock(mutex_);
-  timers_[impl] = impl;
-  return impl;
+  timers_[impl.get()] = impl;
+  return impl.get();
 }
 
 void Timer::start(TimerIntf::Timer *timer, unsigned int timeoutMs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = timers_.find(timer);
+  if (it == timers_.end()) {
+    return;
+  }
+  
+  // Restarting only makes the old deadline stale; nothing waits for it
+  auto& impl = it->second;
+  impl->period_ = std::chrono::milliseconds(impl->isPeriodic_ && timeoutMs == 0 ? 1 : timeoutMs);
+  impl->clock_ = Clock::Monotonic;
+  impl->running_ = true;
+  ++impl->generation_;
+  arm(impl, std::chrono::steady_clock::now() + impl->period_, 0);
+}
+
+void Timer::startAt(TimerIntf::Timer *timer, int64_t deadlineUs, Clock clock, unsigned int periodMs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = timers_.find(timer);
+  if (it == timers_.end()) {
+    return;
+  }
+
+  auto& impl = it->second;
+  impl->period_ = std::chrono::milliseconds(impl->isPeriodic_ && periodMs == 0 ? 1 : periodMs);
+  impl->clock_ = clock;
+  impl->running_ = true;
+  ++impl->generation_;
+  if (clock == Clock::Utc) {
+    // Held as a steady_clock time until the wall clock steps
+    arm(impl, std::chrono::steady_clock::now() + std::chrono::microseconds(deadlineUs - nowUs(Clock::Utc)),
+        deadlineUs);
+  } else {
+    arm(impl, std::chrono::steady_clock::time_point(std::chrono::microseconds(deadlineUs)), 0);
+  }
+}
+
+void Timer::setSlack(TimerIntf::Timer *timer, unsigned int slackMs) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = timers_.find(timer);
   if (it != timers_.end()) {
-    auto* impl = it->second;
-    
-    // Stop any existing thread
-    if (impl->running_) {
-      impl->running_ = false;
-      if (impl->thread_.joinable()) {
-        impl->thread_.join();
-      }
+    it->second->slackMs_ = slackMs;
+  }
+}
+
+int64_t Timer::nowUs(Clock clock) {
+  if (clock == Clock::Utc) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count() + utcStepUs_;
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Timer::stepUtc(int64_t deltaUs) {
+  utcStepUs_ += deltaUs;
+  std::lock_guard<std::mutex> lock(mutex_);
+  wake_.notify_one();
+}
+
+// With mutex_ held
+void Timer::arm(const std::shared_ptr<TimerImpl> &impl, std::chrono::steady_clock::time_point due, int64_t utcUs) {
+  const auto when = coalesce(due, impl->slackMs_);
+  bool earliest = deadlines_.empty() || when < deadlines_.top().when;
+  deadlines_.push({when, due, impl->clock_, utcUs, impl->generation_, impl->utcEpoch_, impl});
+  if (impl->clock_ == Clock::Utc) {
+    impl->nextUtcUs_ = utcUs;
+    // The first UTC deadline makes the dispatcher start watching for steps
+    if (++utcDeadlines_ == 1) {
+      earliest = true;
     }
-    
-    // Start new timer thread
-    impl->running_ = true;
-    impl->thread_ = std::thread([impl, timeoutMs]() {
-      if (impl->isPeriodic_) {
-        // Periodic timer - keep firing until stopped with accurate timing
-        auto nextWakeTime = std::chrono::steady_clock::now();
-        while (impl->running_) {
-          nextWakeTime += std::chrono::milliseconds(timeoutMs);
-          std::this_thread::sleep_until(nextWakeTime);
-          if (impl->running_) {
-            impl->callback_();
-          }
-        }
-      } else {
-        // One-shot timer - fire once
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
-        if (impl->running_) {
-          impl->callback_();
-          impl->running_ = false;
-        }
-      }
-    });
+  }
+  if (earliest) {
+    wake_.notify_one();
   }
 }
 
+// With mutex_ held: every running UTC timer again, for the same wall-clock
+// deadline on the stepped clock
+void Timer::rearmUtc() {
+  const auto now = std::chrono::steady_clock::now();
+  const int64_t utcNow = nowUs(Clock::Utc);
+  for (auto& pair : timers_) {
+    auto& impl = pair.second;
+    if (!impl->running_ || impl->clock_ != Clock::Utc) {
+      continue;
+    }
+    ++impl->utcEpoch_;
+    arm(impl, now + std::chrono::microseconds(impl->nextUtcUs_ - utcNow), impl->nextUtcUs_);
+  }
+}
+
+std::chrono::steady_clock::time_point Timer::coalesce(std::chrono::steady_clock::time_point due,
+                                                      unsigned int slackMs) {
+  if (slackMs == 0) {
+    return due;
+  }
+  const int64_t dueUs = std::chrono::duration_cast<std::chrono::microseconds>(due.time_since_epoch()).count();
+  return std::chrono::steady_clock::time_point(std::chrono::microseconds(coalesceUs(dueUs, slackMs)));
+}
+
 void Timer::stop(TimerIntf::Timer *timer) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = timers_.find(timer);
   if (it != timers_.end()) {
-    auto* impl = it->second;
-    impl->running_ = false;
-    if (impl->thread_.joinable()) {
-      impl->thread_.join();
-    }
+    it->second->running_ = false;
+    ++it->second->generation_;
   }
 }
 
@@ -87,15 +154,123 @@ void Timer::destroy(TimerIntf::Timer *timer) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = timers_.find(timer);
   if (it != timers_.end()) {
-    auto* impl = it->second;
-    if (impl->running_) {
-      impl->running_ = false;
-      if (impl->thread_.joinable()) {
-        impl->thread_.join();
+    // Freed when the last heap entry or queued callback lets go of it
+    it->second->running_ = false;
+    ++it->second->generation_;
+    timers_.erase(it);
+  }
+}
+
+void Timer::dispatch() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::vector<Deadline> due;
+  while (!shutdown_) {
+    // A stepped wall clock moves every UTC deadline with it
+    const int64_t utcOffset = nowUs(Clock::Utc) - nowUs(Clock::Monotonic);
+    if (std::llabs(utcOffset - utcOffsetUs_) > StepToleranceUs) {
+      utcOffsetUs_ = utcOffset;
+      if (utcDeadlines_ > 0) {
+        rearmUtc();
       }
     }
-    delete impl;
-    timers_.erase(it);
+
+    if (deadlines_.empty()) {
+      wake_.wait(lock);
+      continue;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    auto next = deadlines_.top().when;
+    if (next > now) {
+      if (utcDeadlines_ > 0) {
+        next = std::min(next, now + std::chrono::milliseconds(UtcCheckMs));
+      }
+      wake_.wait_until(lock, next);
+      continue;
+    }
+    
+    // Everything due now goes to the workers in one batch
+    while (!deadlines_.empty() && deadlines_.top().when <= now) {
+      Deadline d = deadlines_.top();
+      deadlines_.pop();
+      if (d.clock == Clock::Utc) {
+        utcDeadlines_--;
+      }
+      TimerImpl* impl = d.timer.get();
+      if (d.generation != impl->generation_ || d.utcEpoch != impl->utcEpoch_) {
+        continue;
+      }
+      
+      if (impl->isPeriodic_) {
+        // Next period from this deadline, not from now, so nothing drifts;
+        // periods already missed are skipped
+        const int64_t periodUs = std::chrono::duration_cast<std::chrono::microseconds>(impl->period_).count();
+        Deadline again = d;
+        again.due += impl->period_;
+        again.utcUs += periodUs;
+        while (again.due <= now) {
+          again.due += impl->period_;
+          again.utcUs += periodUs;
+          overruns_++;
+        }
+        again.when = coalesce(again.due, impl->slackMs_);
+        if (again.clock == Clock::Utc) {
+          impl->nextUtcUs_ = again.utcUs;
+          utcDeadlines_++;
+        }
+        deadlines_.push(again);
+      } else {
+        impl->running_ = false;
+      }
+      
+      // Only a periodic firing is dropped while its callback is busy; a
+      // one-shot re-armed from its own callback still has to run
+      if (impl->isPeriodic_ && impl->busy_.exchange(true)) {
+        overruns_++;
+        continue;
+      }
+      due.push_back(std::move(d));
+    }
+    if (due.empty()) {
+      continue;
+    }
+    wakeups_++;
+    
+    {
+      std::lock_guard<std::mutex> jobLock(jobMutex_);
+      for (auto& d : due) {
+        jobs_.push_back(std::move(d));
+      }
+    }
+    if (due.size() == 1) {
+      jobReady_.notify_one();
+    } else {
+      jobReady_.notify_all();
+    }
+    due.clear();
+  }
+}
+
+void Timer::work() {
+  std::unique_lock<std::mutex> lock(jobMutex_);
+  while (true) {
+    jobReady_.wait(lock, [this]() { return shutdown_ || !jobs_.empty(); });
+    if (shutdown_) {
+      return;
+    }
+    Deadline job = jobs_.front();
+    jobs_.pop_front();
+    lock.unlock();
+    
+    // Stopped or restarted since it was queued: the callback is stale
+    if (job.generation == job.timer->generation_) {
+      job.timer->callback_();
+      fired_++;
+    }
+    if (job.timer->isPeriodic_) {
+      job.timer->busy_ = false;
+    }
+    job.timer.reset();
+    lock.lock();
   }
 }
 
@@ -126,5 +301,6 @@ void Timer::syncTime() {
 }
 
 time_t Timer::getCurrentTime() {
-  return time(nullptr);
-}
\ No newline at end of file
+  // The same stepped clock UTC deadlines are on
+  return (time_t) (nowUs(Clock::Utc) / 1000000);
+}
@@ -2,41 +2,75 @@
 
 #include "TimerIntf.h"
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <map>
+#include <queue>
+#include <vector>
 
+// One dispatcher thread keeps every running timer in a min-heap of
+// absolute steady_clock deadlines and hands due callbacks to a small
+// worker pool, so start(), stop() and destroy() never wait on a callback.
+// Periodic timers fire at start + n * period without drift; a periodic
+// callback still running when its timer is due again is skipped and counted
+// as an overrun rather than queued behind itself. One-shots are always
+// queued, so one can re-arm itself from its callback. UTC deadlines are held as
+// steady_clock times and re-armed when the dispatcher sees the wall clock
+// step; deadlines with slack are rounded onto a shared grid so they fire
+// together.
 class Timer : public TimerIntf {
 public:
   class TimerImpl : public TimerIntf::Timer {
   public:
-    TimerImpl(const std::function<void()> &callback, bool isPeriodic = false) 
-      : callback_(callback), running_(false), isPeriodic_(isPeriodic) {}
-    
+    TimerImpl(const std::function<void()> &callback, bool isPeriodic = false)
+      : callback_(callback), running_(false), busy_(false), isPeriodic_(isPeriodic), generation_(0),
+        period_(0), clock_(Clock::Monotonic), slackMs_(0), utcEpoch_(0), nextUtcUs_(0) {}
+
     std::function<void()> callback_;
     std::atomic<bool> running_;
-    std::thread thread_;
+    std::atomic<bool> busy_;     // periodic callback queued or executing
     bool isPeriodic_;
+    std::atomic<uint64_t> generation_;   // bumped by start() and stop(); older entries are stale
+    std::chrono::steady_clock::duration period_;
+    Clock clock_;                // of the last start() or startAt()
+    unsigned int slackMs_;
+    uint64_t utcEpoch_;          // bumped when a clock step re-arms the timer
+    int64_t nextUtcUs_;          // pending UTC deadline
   };
 
-  Timer();
+  explicit Timer(int workers = 4);
   ~Timer();
 
   // Create a one-shot timer (fires after timeout, once)
   TimerIntf::Timer *createOneShot(const std::function<void()> &callback) override;
-  
+
   // Create a periodic timer (fires repeatedly at interval)
   TimerIntf::Timer *createPeriodic(const std::function<void()> &callback) override;
 
   // Start the timer; timeoutMs is in milliseconds
   void start(TimerIntf::Timer *timer, unsigned int timeoutMs) override;
 
-  // Stop the timer if running
+  // Start the timer at an absolute deadline on the monotonic or UTC clock
+  void startAt(TimerIntf::Timer *timer, int64_t deadlineUs, Clock clock, unsigned int periodMs = 0) override;
+
+  // Let the timer fire up to slackMs late to share a wakeup
+  void setSlack(TimerIntf::Timer *timer, unsigned int slackMs) override;
+
+  // steady_clock or system_clock, plus any stepUtc(), in microseconds
+  int64_t nowUs(Clock clock) override;
+
+  // Step the UTC clock this timer sees, as SNTP or setTime() would
+  void stepUtc(int64_t deltaUs);
+
+  // Stop the timer if running; a callback already executing finishes
   void stop(TimerIntf::Timer *timer) override;
 
-  // Destroy and free the timer object
+  // Destroy and free the timer object once no callback holds it
   void destroy(TimerIntf::Timer *timer) override;
 
   // Optional: delay for specified milliseconds
@@ -47,11 +81,57 @@ public:
 
   // Optional: sync time (e.g., SNTP)
   void syncTime() override;
-  
-  // Get current time (returns system time for host-mock)
+
+  // Get current time: system time plus any stepUtc(), as nowUs(Clock::Utc)
   time_t getCurrentTime() override;
 
+  // Callbacks run and firings skipped because the previous one was busy
+  uint64_t getFired() const { return fired_; }
+  uint64_t getOverruns() const { return overruns_; }
+
+  // Dispatcher passes that fired at least one callback
+  uint64_t getWakeups() const { return wakeups_; }
+
+  // A UTC step smaller than this is drift, not a step
+  static constexpr int64_t StepToleranceUs = 1000;
+
+  // How often the dispatcher looks for a UTC step while UTC deadlines wait
+  static constexpr int UtcCheckMs = 250;
+
 private:
+  struct Deadline {
+    std::chrono::steady_clock::time_point when;   // due, plus any slack
+    std::chrono::steady_clock::time_point due;
+    Clock clock;
+    int64_t utcUs;                                // due on the UTC clock
+    uint64_t generation;
+    uint64_t utcEpoch;
+    std::shared_ptr<TimerImpl> timer;
+    bool operator>(const Deadline &o) const { return when > o.when; }
+  };
+
+  void arm(const std::shared_ptr<TimerImpl> &impl, std::chrono::steady_clock::time_point due, int64_t utcUs);
+  void rearmUtc();
+  std::chrono::steady_clock::time_point coalesce(std::chrono::steady_clock::time_point due, unsigned int slackMs);
+  void dispatch();
+  void work();
+
   std::mutex mutex_;
-  std::map<TimerIntf::Timer*, TimerImpl*> timers_;
-};
\ No newline at end of file
+  std::condition_variable wake_;
+  std::map<TimerIntf::Timer*, std::shared_ptr<TimerImpl>> timers_;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+  size_t utcDeadlines_;          // UTC entries in the heap, stale ones included
+  int64_t utcOffsetUs_;          // UTC minus steady_clock when last checked
+  std::atomic<int64_t> utcStepUs_;
+
+  std::mutex jobMutex_;
+  std::condition_variable jobReady_;
+  std::deque<Deadline> jobs_;
+
+  bool shutdown_;
+  std::thread dispatcher_;
+  std::vector<std::thread> workers_;
+  std::atomic<uint64_t> fired_;
+  std::atomic<uint64_t> overruns_;
+  std::atomic<uint64_t> wakeups_;
+};
@@ -5,6 +5,7 @@ WSPRModulator::WSPRModulator(TimerIntf* timerIntf)
     : timer(timerIntf),
       modulationTimer(nullptr),
       totalSymbols(0),
+      symbolPeriodMs(0),
       currentSymbolIndex(-1),
       modulationActive(false)
 {
@@ -14,7 +15,7 @@ WSPRModulator::~WSPRModulator() {
     stopModulation();
 }
 
-bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>& callback, int symbols) {
+bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>& callback, int symbols, int periodMs) {
     if (modulationActive) {
         std::cout << "WSPRModulator: Modulation already active" << std::endl;
         return false;
@@ -27,6 +28,7 @@ bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>&
     
     symbolCallback = callback;
     totalSymbols = symbols;
+    symbolPeriodMs = periodMs;
     currentSymbolIndex = 0;
     modulationActive = true;
     
@@ -41,8 +43,8 @@ bool WSPRModulator::startModulation(const std::function<void(int symbolIndex)>&
     });
     
     if (modulationTimer) {
-        timer->start(modulationTimer, 683); // 683ms per WSPR symbol
-        std::cout << "WSPRModulator: WSPR symbol timer started (683ms intervals)" << std::endl;
+        timer->start(modulationTimer, symbolPeriodMs); // 683ms per WSPR symbol
+        std::cout << "WSPRModulator: Symbol timer started (" << symbolPeriodMs << "ms intervals)" << std::endl;
         return true;
     } else {
         std::cout << "WSPRModulator: Failed to create modulation timer" << std::endl;
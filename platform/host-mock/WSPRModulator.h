@@ -7,15 +7,16 @@
 /**
  * Host-mock timer-based WSPR modulator implementation
  * 
- * Uses the TimerIntf periodic timer to achieve 683ms symbol intervals
- * for WSPR protocol compliance during testing.
+ * Uses the TimerIntf periodic timer to achieve the mode's symbol intervals
+ * (683ms for WSPR) during testing.
  */
 class WSPRModulator : public WSPRModulatorIntf {
 public:
     WSPRModulator(TimerIntf* timer);
     ~WSPRModulator() override;
     
-    bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols) override;
+    bool startModulation(const std::function<void(int symbolIndex)>& symbolCallback, int totalSymbols,
+                         int symbolPeriodMs) override;
     void stopModulation() override;
     bool isModulationActive() const override;
     int getCurrentSymbolIndex() const override;
@@ -31,6 +32,7 @@ private:
     // State
     std::function<void(int)> symbolCallback;
     int totalSymbols;
+    int symbolPeriodMs;
     int currentSymbolIndex;
     bool modulationActive;
 };
\ No newline at end of file
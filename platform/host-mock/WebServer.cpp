@@ -3,6 +3,7 @@
 #include "cJSON.h"
 #include <iostream>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <filesystem>
 #include <unistd.h>
@@ -44,8 +45,8 @@ std::string findWebDirectory() {
   return "../web";
 }
 
-WebServer::WebServer(SettingsIntf *settings)
-  : settings(settings), scheduler(nullptr), beacon(nullptr), running(false) {}
+WebServer::WebServer(SettingsIntf *settings, int port)
+  : settings(settings), port(port), scheduler(nullptr), beacon(nullptr), running(false) {}
 
 WebServer::~WebServer() {
   stop();
@@ -71,9 +72,11 @@ void WebServer::updateBeaconState(const char* networkState, const char* transmis
 
 void WebServer::start() {
   if (running) return;
+  if (serverThread.joinable()) serverThread.join();
   running = true;
+  server = std::make_unique<httplib::Server>();
   serverThread = std::thread([this]() {
-    httplib::Server svr;
+    httplib::Server &svr = *server;
 
     svr.Get("/api/settings", [this](const httplib::Request &, httplib::Response &res) {
       char *jsonStr = settings->toJsonString();
@@ -102,18 +105,21 @@ void WebServer::start() {
     std::string webDir = findWebDirectory();
     svr.set_mount_point("/", webDir);
 
-    std::cout << "[WebServerMock] Listening on http://localhost:8080" << std::endl;
-    svr.listen("0.0.0.0", 8080);
+    std::cout << "[WebServerMock] Listening on http://localhost:" << port << std::endl;
+    svr.listen("0.0.0.0", port);
     running = false;
   });
+
+  // Wait for the accept loop (or a failed listen) so stop() always ends it
+  while (running && !server->is_running()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
 }
 
 void WebServer::stop() {
-  if (running) {
-    running = false;
-    // No direct stop in cpp-httplib, so thread will exit when server is killed externally
-    if (serverThread.joinable()) {
-      serverThread.detach();
-    }
+  running = false;
+  if (server) server->stop();
+  if (serverThread.joinable()) {
+    serverThread.join();
   }
 }
\ No newline at end of file
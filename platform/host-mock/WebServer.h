@@ -2,16 +2,19 @@
 
 #include "WebServerIntf.h"
 #include "SettingsIntf.h"
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <thread>
 
 // Forward declarations
 class Scheduler;
 class Beacon;
+namespace httplib { class Server; }
 
 class WebServer : public WebServerIntf {
 public:
-  WebServer(SettingsIntf *settings);
+  WebServer(SettingsIntf *settings, int port = 8080);
   ~WebServer() override;
 
   void start() override;
@@ -23,9 +26,11 @@ public:
 
 private:
   SettingsIntf *settings;
+  int port;
+  std::unique_ptr<httplib::Server> server;
   Scheduler* scheduler;
   Beacon* beacon;
   std::function<void()> settingsChangedCallback;
   std::thread serverThread;
-  bool running;
+  std::atomic<bool> running;
 };
\ No newline at end of file
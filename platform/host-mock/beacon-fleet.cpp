@@ -0,0 +1,148 @@
+#include "test-server.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include "httplib.h"
+
+// Launches many simulated beacons in this one process, one web server per
+// port, and reports what each costs in memory. Every beacon gets its own
+// callsign through its API, and reading them all back checks that no state
+// leaks between instances.
+
+static void printUsage(const char* programName) {
+  std::cout << "WSPR Beacon Host Fleet\n\n";
+  std::cout << "Usage: " << programName << " [options]\n\n";
+  std::cout << "Options:\n";
+  std::cout << "  --count <n>               Number of beacons (default: 200)\n";
+  std::cout << "  --base-port <port>        Port of the first beacon; the rest follow (default: 18000)\n";
+  std::cout << "  --threads <n>             Request threads per beacon (default: 1)\n";
+  std::cout << "  --mock-data <file>        Path to mock data JSON file (default: mock-data.txt)\n";
+  std::cout << "  --time-scale <n>          Time acceleration factor (default: 1.0)\n";
+  std::cout << "  --hold <seconds>          Keep serving this long after the report (default: 0)\n";
+  std::cout << "  --help, -h                Show this help message\n";
+}
+
+// Resident set size in KiB
+static long residentKb() {
+  std::ifstream statm("/proc/self/statm");
+  long pages = 0, resident = 0;
+  statm >> pages >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static long threadCount() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) return std::stol(line.substr(8));
+  }
+  return -1;
+}
+
+static std::string callsignFor(int i) {
+  char call[16];
+  std::snprintf(call, sizeof(call), "F%dABC", i);
+  return call;
+}
+
+int main(int argc, char** argv) {
+  int count = 200;
+  int basePort = 18000;
+  int holdSeconds = 0;
+  TestServer::Options options;
+  options.threads = 1;
+  options.logVerbosity = "*.none";
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    try {
+      if (arg == "--count" && i + 1 < argc) {
+        count = std::stoi(argv[++i]);
+      } else if (arg == "--base-port" && i + 1 < argc) {
+        basePort = std::stoi(argv[++i]);
+      } else if (arg == "--threads" && i + 1 < argc) {
+        options.threads = std::stoi(argv[++i]);
+      } else if (arg == "--mock-data" && i + 1 < argc) {
+        options.mockDataFile = argv[++i];
+      } else if (arg == "--time-scale" && i + 1 < argc) {
+        options.timeScale = std::stod(argv[++i]);
+      } else if (arg == "--hold" && i + 1 < argc) {
+        holdSeconds = std::stoi(argv[++i]);
+      } else if (arg == "--help" || arg == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      } else {
+        std::cerr << "Error: Unknown option: " << arg << "\n\n";
+        printUsage(argv[0]);
+        return 1;
+      }
+    } catch (const std::exception&) {
+      std::cerr << "Error: Invalid value for " << arg << "\n\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (count < 1 || basePort < 1 || basePort + count - 1 > 65535 || options.threads < 1) {
+    std::cerr << "Error: Need at least one beacon, one thread each, and ports within 1-65535" << std::endl;
+    return 1;
+  }
+
+  const long baseKb = residentKb();
+  const long baseThreads = threadCount();
+
+  std::vector<std::unique_ptr<TestServer>> fleet;
+  fleet.reserve(count);
+  int failed = 0;
+  for (int i = 0; i < count; i++) {
+    options.port = basePort + i;
+    std::unique_ptr<TestServer> beacon(new TestServer(options));
+    if (beacon->start()) {
+      fleet.push_back(std::move(beacon));
+    } else {
+      std::cerr << "Beacon on port " << options.port << " did not start" << std::endl;
+      ++failed;
+    }
+  }
+  const int started = static_cast<int>(fleet.size());
+  const long startedKb = residentKb();
+
+  // Give every beacon its own callsign, then read them all back
+  int distinct = 0;
+  for (int i = 0; i < started; i++) {
+    httplib::Client client("127.0.0.1", fleet[i]->getPort());
+    const std::string body = "{\"call\":\"" + callsignFor(i) + "\"}";
+    client.Post("/api/settings", body, "application/json");
+  }
+  for (int i = 0; i < started; i++) {
+    httplib::Client client("127.0.0.1", fleet[i]->getPort());
+    auto res = client.Get("/api/settings");
+    if (res && res->status == 200 && res->body.find("\"" + callsignFor(i) + "\"") != std::string::npos) ++distinct;
+  }
+  const long servedKb = residentKb();
+
+  std::printf("Beacons:           %d started, %d failed, ports %d-%d\n", started, failed, basePort,
+              basePort + count - 1);
+  std::printf("Threads:           %ld (%ld before)\n", threadCount(), baseThreads);
+  if (started > 0) {
+    std::printf("Memory at start:   %ld KiB total, %.1f KiB per beacon\n", startedKb - baseKb,
+                double(startedKb - baseKb) / started);
+    std::printf("Memory after API:  %ld KiB total, %.1f KiB per beacon\n", servedKb - baseKb,
+                double(servedKb - baseKb) / started);
+  }
+  std::printf("Isolated settings: %d of %d beacons report their own callsign\n", distinct, started);
+
+  if (holdSeconds > 0) {
+    std::cout << "Serving for " << holdSeconds << " s" << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(holdSeconds));
+  }
+
+  for (auto& beacon : fleet) beacon->stop();
+  return (failed == 0 && distinct == started) ? 0 : 1;
+}
@@ -277,6 +277,18 @@ void startTestServerShared(int port, const std::string& mockDataFile, double tim
     }
   });
 
+  svr.Post("/api/wspr/encode/batch", [](const httplib::Request &req, httplib::Response &res) {
+    HostMockHttpRequest request(req);
+    HostMockHttpResponse response(res);
+    
+    HttpHandlerResult result = g_endpointHandler->handleApiWSPREncodeBatch(&request, &response);
+    if (result == HttpHandlerResult::OK) {
+      g_logger->logApiRequest("POST", "/api/wspr/encode/batch", res.status, "shared handler");
+    } else {
+      g_logger->logApiRequest("POST", "/api/wspr/encode/batch", res.status, "error");
+    }
+  });
+
   // Serve static files - dynamically find web directory
   std::string webDir = findWebDirectoryForTestServer();
   svr.set_mount_point("/", webDir);
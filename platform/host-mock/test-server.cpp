@@ -1,5 +1,6 @@
 #include "test-server.h"
 #include "Time.h"
+#include "HttpHandlerIntf.h"
 #include "../../include/BeaconLogger.h"
 #include "JTEncode.h"
 #include "cJSON.h"
@@ -14,6 +15,7 @@
 #include <iomanip>
 #include <chrono>
 #include <mutex>
+#include <vector>
 #ifdef _WIN32
 #include <winsock2.h>
 #else
@@ -21,24 +23,16 @@
 #endif
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 #include "httplib.h"
+#include "HostMockHttpWrappers.h"
 
 namespace fs = std::filesystem;
 
-// Global variables
-
-static std::atomic<bool> running{true};
-static Time timeInterface;
-static double g_timeScale = 1.0;
-static std::chrono::steady_clock::time_point g_serverStartTime;
-static int64_t g_mockStartTime;
-static std::unique_ptr<BeaconLogger> g_logger;
-
 // Get current mock time based on time scale
-static int64_t getMockTime() {
+int64_t TestServer::getMockTime() const {
   auto now = std::chrono::steady_clock::now();
-  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - g_serverStartTime).count();
-  int64_t scaledElapsed = static_cast<int64_t>(elapsed * g_timeScale);
-  return g_mockStartTime + (scaledElapsed / 1000);  // Convert to seconds
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - serverStartTime).count();
+  int64_t scaledElapsed = static_cast<int64_t>(elapsed * options.timeScale);
+  return mockStartTime + (scaledElapsed / 1000);  // Convert to seconds
 }
 
 static std::string readFile(const std::string &path) {
@@ -68,9 +62,7 @@ static std::string formatTimeISO(int64_t unixTime) {
   return oss.str();
 }
 
-static cJSON* settings = nullptr;
-
-static void initializeDefaultSettings() {
+void TestServer::initializeDefaultSettings() {
   if (settings) {
     cJSON_Delete(settings);
   }
@@ -104,20 +96,18 @@ static void initializeDefaultSettings() {
   cJSON_AddItemToObject(settings, "bands", bands);
 }
 
-static cJSON* status = nullptr;
-
-static bool loadMockData(const std::string& mockDataFile) {
+bool TestServer::loadMockData(const std::string& mockDataFile) {
   try {
-    g_logger->logSystemVerbose("Attempting to load mock data", "file=" + mockDataFile, "");
+    logger->logSystemVerbose("Attempting to load mock data", "file=" + mockDataFile, "");
     std::string mockDataContent = readFile(mockDataFile);
     if (mockDataContent.empty()) {
-      g_logger->logBasic("ERROR", "Mock data file not found or empty", "file=" + mockDataFile);
+      logger->logBasic("ERROR", "Mock data file not found or empty", "file=" + mockDataFile);
       return false;
     }
     
     cJSON* mockData = cJSON_Parse(mockDataContent.c_str());
     if (!mockData) {
-      g_logger->logBasic("ERROR", "Mock data JSON parsing failed", "file=" + mockDataFile);
+      logger->logBasic("ERROR", "Mock data JSON parsing failed", "file=" + mockDataFile);
       return false;
     }
     
@@ -160,24 +150,24 @@ static bool loadMockData(const std::string& mockDataFile) {
       if (i > 0) fieldList += ", ";
       fieldList += updatedFields[i];
     }
-    g_logger->logSystemEvent("Settings updated from mock data", "fields_updated=" + std::to_string(settingsUpdated) + ", fields=[" + fieldList + "]");
+    logger->logSystemEvent("Settings updated from mock data", "fields_updated=" + std::to_string(settingsUpdated) + ", fields=[" + fieldList + "]");
     
     // Always set resetTime to current startup time
     std::string resetTime = formatTimeISO(timeInterface.getStartTime());
     cJSON_DeleteItemFromObject(status, "resetTime");
     cJSON_AddStringToObject(status, "resetTime", resetTime.c_str());
     
-    g_logger->logSystemEvent("Mock data loaded successfully", "file=" + mockDataFile + ", size=" + std::to_string(mockDataContent.size()) + " bytes");
+    logger->logSystemEvent("Mock data loaded successfully", "file=" + mockDataFile + ", size=" + std::to_string(mockDataContent.size()) + " bytes");
     
     cJSON_Delete(mockData);
     return true;
   } catch (const std::exception& e) {
-    g_logger->logBasic("ERROR", "Mock data parsing failed", "file=" + mockDataFile + ", error=" + std::string(e.what()));
+    logger->logBasic("ERROR", "Mock data parsing failed", "file=" + mockDataFile + ", error=" + std::string(e.what()));
     return false;
   }
 }
 
-static void initializeDefaultStatus() {
+void TestServer::initializeDefaultStatus() {
   // Fallback default status if mock data loading fails
   if (status) {
     cJSON_Delete(status);
@@ -234,7 +224,7 @@ static int getIntValue(cJSON* obj, const char* key, int defaultValue = 0) {
   return defaultValue;
 }
 
-static void updateStatusFromSettings() {
+void TestServer::updateStatusFromSettings() {
   // Copy values from settings to status
   cJSON* callItem = cJSON_GetObjectItem(settings, "call");
   if (callItem) {
@@ -284,7 +274,7 @@ static void updateStatusFromSettings() {
     
     // Simulate connected clients (varying over time)
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_serverStartTime).count();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - serverStartTime).count();
     int clientCount = (elapsed / 30) % 4; // 0-3 clients, changes every 30 seconds
     cJSON_DeleteItemFromObject(status, "clientCount");
     cJSON_AddNumberToObject(status, "clientCount", clientCount);
@@ -319,7 +309,7 @@ static void updateStatusFromSettings() {
   }
 }
 
-std::string findWebDirectoryForTestServer() {
+static std::string findWebDirectoryForTestServer() {
   // Get the executable path
   char exePath[PATH_MAX];
   ssize_t len = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
@@ -353,60 +343,114 @@ std::string findWebDirectoryForTestServer() {
   return "../../web";
 }
 
-void startTestServer(int port, const std::string& mockDataFile, double timeScale, const std::string& logFile, const std::string& logVerbosity) {
+TestServer::TestServer(const Options& options)
+  : options(options), listenReturned(false), lastNextTx(-1), settings(nullptr), status(nullptr) {
   // Initialize logger with verbosity configuration
-  g_logger = std::make_unique<BeaconLogger>(logFile);
+  logger = std::make_unique<BeaconLogger>(options.logFile);
   
-  if (!logVerbosity.empty()) {
-    g_logger->parseVerbosityString(logVerbosity);
+  if (!options.logVerbosity.empty()) {
+    logger->parseVerbosityString(options.logVerbosity);
   }
   
   // Log initial configuration
-  g_logger->logSystemEvent("Logger configuration", g_logger->getConfigurationSummary());
+  logger->logSystemEvent("Logger configuration", logger->getConfigurationSummary());
   
-  // Initialize time scale
-  g_timeScale = timeScale;
-  g_serverStartTime = std::chrono::steady_clock::now();
-  g_mockStartTime = timeInterface.getTime();
+  // Start the mock clock
+  serverStartTime = std::chrono::steady_clock::now();
+  mockStartTime = timeInterface.getTime();
+  endpointHandler = std::make_unique<HostMockHttpEndpointHandler>(nullptr, &timeInterface, options.timeScale);
   
-  g_logger->logTimeEvent("Server startup", timeScale, g_mockStartTime);
+  logger->logTimeEvent("Server startup", options.timeScale, mockStartTime);
   
   // Initialize default settings first
   initializeDefaultSettings();
   
   // Initialize mock data
-  g_logger->logSystemEvent("Loading mock data", "file=" + mockDataFile);
-  if (!loadMockData(mockDataFile)) {
-    g_logger->logSystemEvent("Mock data load failed, using defaults", "");
+  logger->logSystemEvent("Loading mock data", "file=" + options.mockDataFile);
+  if (!loadMockData(options.mockDataFile)) {
+    logger->logSystemEvent("Mock data load failed, using defaults", "");
     initializeDefaultStatus();
   } else {
-    g_logger->logSystemEvent("Mock data loaded successfully", "");
+    logger->logSystemEvent("Mock data loaded successfully", "");
   }
   
-  httplib::Server svr;
+  server = std::make_unique<httplib::Server>();
+  if (options.threads > 0) {
+    const int threads = options.threads;
+    server->new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+  }
+  registerRoutes();
+}
+
+TestServer::~TestServer() {
+  stop();
+  cJSON_Delete(status);
+  cJSON_Delete(settings);
+}
+
+void TestServer::run() {
+  std::cout << "Host testbench web server running at http://localhost:" << options.port << std::endl;
+  std::cout << "Press Ctrl+C to stop." << std::endl;
+  
+  logger->logSystemEvent("HTTP server starting", "port=" + std::to_string(options.port) + ", address=0.0.0.0");
+  server->listen("0.0.0.0", options.port);
+  logger->logSystemEvent("HTTP server stopped", "");
+}
+
+bool TestServer::start() {
+  if (serverThread.joinable()) return true;
+  
+  logger->logSystemEvent("HTTP server starting", "port=" + std::to_string(options.port) + ", address=0.0.0.0");
+  if (!server->bind_to_port("0.0.0.0", options.port)) {
+    logger->logBasic("ERROR", "HTTP server could not bind", "port=" + std::to_string(options.port));
+    return false;
+  }
+  listenReturned = false;
+  serverThread = std::thread([this]() {
+    server->listen_after_bind();
+    listenReturned = true;
+    logger->logSystemEvent("HTTP server stopped", "");
+  });
+  
+  // Wait for the accept loop so an early stop() is not lost
+  while (!server->is_running() && !listenReturned) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+void TestServer::stop() {
+  server->stop();
+  if (serverThread.joinable()) serverThread.join();
+}
+
+void TestServer::registerRoutes() {
+  httplib::Server& svr = *server;
 
-  svr.Get("/api/settings", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Get("/api/settings", [this](const httplib::Request &req, httplib::Response &res) {
+    std::lock_guard<std::mutex> lock(stateMutex);
     char* response = cJSON_Print(settings);
     if (response) {
       res.set_content(response, "application/json");
-      g_logger->logApiRequest("GET", "/api/settings", 200, std::to_string(strlen(response)) + " bytes");
+      logger->logApiRequest("GET", "/api/settings", 200, std::to_string(strlen(response)) + " bytes");
       free(response);
     } else {
       res.status = 500;
       res.set_content("{\"error\":\"Internal server error\"}", "application/json");
-      g_logger->logApiRequest("GET", "/api/settings", 500, "error");
+      logger->logApiRequest("GET", "/api/settings", 500, "error");
     }
   });
 
-  svr.Post("/api/settings", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Post("/api/settings", [this](const httplib::Request &req, httplib::Response &res) {
+    std::lock_guard<std::mutex> lock(stateMutex);
     try {
       auto contentType = req.get_header_value("Content-Type");
-      g_logger->logVerbose("API", "POST /api/settings received", "content_type=" + contentType + ", body_size=" + std::to_string(req.body.size()));
+      logger->logVerbose("API", "POST /api/settings received", "content_type=" + contentType + ", body_size=" + std::to_string(req.body.size()));
       
       // Parse as form if the Content-Type is application/x-www-form-urlencoded
       if (contentType.find("application/x-www-form-urlencoded") != std::string::npos) {
         // Form-encoded: use params
-        g_logger->logVerbose("SETTINGS", "Processing form-encoded data", "param_count=" + std::to_string(req.params.size()));
+        logger->logVerbose("SETTINGS", "Processing form-encoded data", "param_count=" + std::to_string(req.params.size()));
         for (auto &item : req.params) {
           cJSON* existingItem = cJSON_GetObjectItem(settings, item.first.c_str());
           std::string oldValue = "null";
@@ -420,7 +464,7 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
           
           cJSON_DeleteItemFromObject(settings, item.first.c_str());
           cJSON_AddStringToObject(settings, item.first.c_str(), item.second.c_str());
-          g_logger->logSettingsChange(item.first, oldValue, item.second);
+          logger->logSettingsChange(item.first, oldValue, item.second);
         }
       } else {
         // Otherwise, treat as JSON
@@ -430,7 +474,7 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
         }
         
         int fieldCount = cJSON_GetArraySize(j);
-        g_logger->logVerbose("SETTINGS", "Processing JSON data", "field_count=" + std::to_string(fieldCount));
+        logger->logVerbose("SETTINGS", "Processing JSON data", "field_count=" + std::to_string(fieldCount));
         
         cJSON* item = nullptr;
         cJSON_ArrayForEach(item, j) {
@@ -452,40 +496,41 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
             std::string newValue = newStr ? std::string(newStr) : "null";
             if (newStr) free(newStr);
             
-            g_logger->logSettingsChange(std::string(item->string), oldValue, newValue);
+            logger->logSettingsChange(std::string(item->string), oldValue, newValue);
           }
         }
         
         cJSON_Delete(j);
       }
       updateStatusFromSettings();
-      g_logger->logBasic("SETTINGS", "Settings update completed successfully", "");
+      logger->logBasic("SETTINGS", "Settings update completed successfully", "");
       res.status = 204;
       res.set_content("", "application/json");
-      g_logger->logApiRequest("POST", "/api/settings", 204);
+      logger->logApiRequest("POST", "/api/settings", 204);
     } catch (const std::exception& e) {
-      g_logger->logBasic("ERROR", "Settings parsing failed", "error=" + std::string(e.what()));
+      logger->logBasic("ERROR", "Settings parsing failed", "error=" + std::string(e.what()));
       res.status = 400;
       res.set_content("{\"error\":\"Invalid settings format\"}", "application/json");
-      g_logger->logApiRequest("POST", "/api/settings", 400);
+      logger->logApiRequest("POST", "/api/settings", 400);
     } catch (...) {
-      g_logger->logBasic("ERROR", "Unknown settings parsing error", "");
+      logger->logBasic("ERROR", "Unknown settings parsing error", "");
       res.status = 400;
       res.set_content("{\"error\":\"Invalid settings format\"}", "application/json");
-      g_logger->logApiRequest("POST", "/api/settings", 400);
+      logger->logApiRequest("POST", "/api/settings", 400);
     }
   });
 
-  svr.Get("/api/status.json", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Get("/api/status.json", [this](const httplib::Request &req, httplib::Response &res) {
     // Calculate dynamic status based on accelerated time
+    std::lock_guard<std::mutex> lock(stateMutex);
     cJSON* dynamicStatus = cJSON_Duplicate(status, true);
     
-    g_logger->logVerbose("API", "GET /api/status.json processing", "time_scale=" + std::to_string(g_timeScale));
+    logger->logVerbose("API", "GET /api/status.json processing", "time_scale=" + std::to_string(options.timeScale));
     
     // Calculate elapsed time in mock seconds
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - g_serverStartTime).count();
-    int64_t mockElapsedSeconds = static_cast<int64_t>((elapsed * g_timeScale) / 1000);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - serverStartTime).count();
+    int64_t mockElapsedSeconds = static_cast<int64_t>((elapsed * options.timeScale) / 1000);
     
     // WSPR transmission cycle: 120 seconds (2 minutes)
     // Transmission duration: ~110.6 seconds
@@ -515,14 +560,14 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
       cJSON_AddNumberToObject(dynamicStatus, "nextTx", 0);
       if (prevTxState != "TRANSMITTING") {
         std::string curBand = getStringValue(dynamicStatus, "curBand", "unknown");
-        g_logger->logTransmissionEvent("Transmission started", curBand, 0);
+        logger->logTransmissionEvent("Transmission started", curBand, 0);
       }
     } else {
       cJSON_DeleteItemFromObject(dynamicStatus, "txState");
       cJSON_AddStringToObject(dynamicStatus, "txState", "IDLE");
       if (prevTxState == "TRANSMITTING") {
         std::string curBand = getStringValue(dynamicStatus, "curBand", "unknown");
-        g_logger->logTransmissionEvent("Transmission ended", curBand);
+        logger->logTransmissionEvent("Transmission ended", curBand);
       }
       
       // Calculate next transmission
@@ -534,10 +579,9 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
         cJSON_AddNumberToObject(dynamicStatus, "nextTx", secondsUntilNextCycle);
         
         // Log next transmission timing if significant change
-        static int lastNextTx = -1;
         if (abs(secondsUntilNextCycle - lastNextTx) > 10) {  // Log every 10 second changes
           std::string curBand = getStringValue(dynamicStatus, "curBand", "unknown");
-          g_logger->logTransmissionEvent("Next transmission scheduled", curBand, secondsUntilNextCycle);
+          logger->logTransmissionEvent("Next transmission scheduled", curBand, secondsUntilNextCycle);
           lastNextTx = secondsUntilNextCycle;
         }
       } else {
@@ -608,27 +652,27 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
     char* response = cJSON_Print(dynamicStatus);
     if (response) {
       res.set_content(response, "application/json");
-      g_logger->logApiRequest("GET", "/api/status.json", 200, std::to_string(strlen(response)) + " bytes");
+      logger->logApiRequest("GET", "/api/status.json", 200, std::to_string(strlen(response)) + " bytes");
       free(response);
     } else {
       res.status = 500;
       res.set_content("{\"error\":\"Internal server error\"}", "application/json");
-      g_logger->logApiRequest("GET", "/api/status.json", 500, "error");
+      logger->logApiRequest("GET", "/api/status.json", 500, "error");
     }
     cJSON_Delete(dynamicStatus);
   });
 
-  svr.Get("/api/time", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Get("/api/time", [this](const httplib::Request &req, httplib::Response &res) {
     int64_t mockTime = getMockTime();
-    g_logger->logTimeEvent("Time request processed", g_timeScale, mockTime);
+    logger->logTimeEvent("Time request processed", options.timeScale, mockTime);
     
     // Simulate NTP sync status
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_serverStartTime).count();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - serverStartTime).count();
     
     // Simulate last NTP sync time (every ~10 minutes in mock time)
     int64_t lastSyncInterval = 600; // 10 minutes
-    int64_t scaledElapsed = static_cast<int64_t>(elapsed * g_timeScale);
+    int64_t scaledElapsed = static_cast<int64_t>(elapsed * options.timeScale);
     int64_t timeSinceSync = scaledElapsed % (lastSyncInterval * 2);
     int64_t lastSyncTime = mockTime - timeSinceSync;
     
@@ -639,24 +683,24 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
     cJSON_AddBoolToObject(timeResponse, "synced", true);
     std::string lastSyncTimeISO = formatTimeISO(lastSyncTime);
     cJSON_AddStringToObject(timeResponse, "lastSyncTime", lastSyncTimeISO.c_str());
-    cJSON_AddNumberToObject(timeResponse, "timeScale", g_timeScale);
+    cJSON_AddNumberToObject(timeResponse, "timeScale", options.timeScale);
     
     char* response = cJSON_Print(timeResponse);
     if (response) {
       res.set_content(response, "application/json");
-      g_logger->logApiRequest("GET", "/api/time", 200, std::to_string(strlen(response)) + " bytes");
+      logger->logApiRequest("GET", "/api/time", 200, std::to_string(strlen(response)) + " bytes");
       free(response);
     } else {
       res.status = 500;
       res.set_content("{\"error\":\"Internal server error\"}", "application/json");
-      g_logger->logApiRequest("GET", "/api/time", 500, "error");
+      logger->logApiRequest("GET", "/api/time", 500, "error");
     }
     cJSON_Delete(timeResponse);
   });
 
-  svr.Post("/api/wspr/encode", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Post("/api/wspr/encode", [this](const httplib::Request &req, httplib::Response &res) {
     try {
-      g_logger->logApiRequest("POST", "/api/wspr/encode", 200, std::to_string(req.body.size()) + " bytes");
+      logger->logApiRequest("POST", "/api/wspr/encode", 200, std::to_string(req.body.size()) + " bytes");
       
       cJSON* requestData = cJSON_Parse(req.body.c_str());
       if (!requestData) {
@@ -669,7 +713,7 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
       int powerDbm = getIntValue(requestData, "powerDbm", 10);
       uint32_t frequency = static_cast<uint32_t>(getIntValue(requestData, "frequency", 14097100));
       
-      g_logger->logBasic("WSPR", "Encoding WSPR message", 
+      logger->logBasic("WSPR", "Encoding WSPR message", 
                         "call=" + callsign + ", loc=" + locator + ", pwr=" + std::to_string(powerDbm) + "dBm, freq=" + std::to_string(frequency));
       
       // Create WSPR encoder
@@ -701,26 +745,26 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
       cJSON_AddNumberToObject(response, "transmissionDurationMs", transmissionDurationMs);
       cJSON_AddNumberToObject(response, "transmissionDurationSeconds", transmissionDurationMs / 1000.0);
       
-      g_logger->logVerbose("WSPR", "WSPR encoding completed", 
+      logger->logVerbose("WSPR", "WSPR encoding completed", 
                           "symbols=" + std::to_string(WSPREncoder::TxBufferSize) + 
                           ", duration=" + std::to_string(transmissionDurationMs) + "ms");
       
       char* responseStr = cJSON_Print(response);
       if (responseStr) {
         res.set_content(responseStr, "application/json");
-        g_logger->logApiRequest("POST", "/api/wspr/encode", 200, std::to_string(strlen(responseStr)) + " bytes");
+        logger->logApiRequest("POST", "/api/wspr/encode", 200, std::to_string(strlen(responseStr)) + " bytes");
         free(responseStr);
       } else {
         res.status = 500;
         res.set_content("{\"error\":\"Internal server error\"}", "application/json");
-        g_logger->logApiRequest("POST", "/api/wspr/encode", 500, "error");
+        logger->logApiRequest("POST", "/api/wspr/encode", 500, "error");
       }
       
       cJSON_Delete(response);
       cJSON_Delete(requestData);
       
     } catch (const std::exception& e) {
-      g_logger->logBasic("ERROR", "WSPR encoding failed", "error=" + std::string(e.what()));
+      logger->logBasic("ERROR", "WSPR encoding failed", "error=" + std::string(e.what()));
       
       cJSON* errorResponse = cJSON_CreateObject();
       cJSON_AddBoolToObject(errorResponse, "success", false);
@@ -735,17 +779,29 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
         res.status = 400;
         res.set_content("{\"error\":\"Unknown error\"}", "application/json");
       }
-      g_logger->logApiRequest("POST", "/api/wspr/encode", 400, "error");
+      logger->logApiRequest("POST", "/api/wspr/encode", 400, "error");
       cJSON_Delete(errorResponse);
     }
   });
 
-  svr.Get("/api/wifi/scan", [](const httplib::Request &req, httplib::Response &res) {
+  svr.Post("/api/wspr/encode/batch", [this](const httplib::Request &req, httplib::Response &res) {
+    HostMockHttpRequest request(req);
+    HostMockHttpResponse response(res);
+    
+    HttpHandlerResult result = endpointHandler->handleApiWSPREncodeBatch(&request, &response);
+    if (result == HttpHandlerResult::OK) {
+      logger->logApiRequest("POST", "/api/wspr/encode/batch", res.status, "shared handler");
+    } else {
+      logger->logApiRequest("POST", "/api/wspr/encode/batch", res.status, "error");
+    }
+  });
+
+  svr.Get("/api/wifi/scan", [this](const httplib::Request &req, httplib::Response &res) {
     // Mock WiFi scan results with time-varying signal strengths
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_serverStartTime).count();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - serverStartTime).count();
     
-    g_logger->logVerbose("WIFI", "Scan initiated", "elapsed_time=" + std::to_string(elapsed) + "s");
+    logger->logVerbose("WIFI", "Scan initiated", "elapsed_time=" + std::to_string(elapsed) + "s");
     
     // Simulate signal strength variations over time
     int timeOffset = elapsed / 5; // Changes every 5 seconds
@@ -817,17 +873,17 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
     }
     scanDetails << "]";
     
-    g_logger->logWifiScan(networkCount, scanDetails.str());
+    logger->logWifiScan(networkCount, scanDetails.str());
     
     char* response = cJSON_Print(scanResults);
     if (response) {
       res.set_content(response, "application/json");
-      g_logger->logApiRequest("GET", "/api/wifi/scan", 200, std::to_string(strlen(response)) + " bytes");
+      logger->logApiRequest("GET", "/api/wifi/scan", 200, std::to_string(strlen(response)) + " bytes");
       free(response);
     } else {
       res.status = 500;
       res.set_content("{\"error\":\"Internal server error\"}", "application/json");
-      g_logger->logApiRequest("GET", "/api/wifi/scan", 500, "error");
+      logger->logApiRequest("GET", "/api/wifi/scan", 500, "error");
     }
     cJSON_Delete(scanResults);
   });
@@ -835,20 +891,23 @@ void startTestServer(int port, const std::string& mockDataFile, double timeScale
   // Serve static files - dynamically find web directory
   std::string webDir = findWebDirectoryForTestServer();
   svr.set_mount_point("/", webDir);
-  g_logger->logSystemEvent("Web directory configured", "path=" + webDir);
+  logger->logSystemEvent("Web directory configured", "path=" + webDir);
 
-  std::cout << "Host testbench web server running at http://localhost:" << port << std::endl;
-  std::cout << "Press Ctrl+C to stop." << std::endl;
-  
-  g_logger->logSystemEvent("HTTP server starting", "port=" + std::to_string(port) + ", address=0.0.0.0");
-  
   // Add request logging for all endpoints
-  svr.set_pre_routing_handler([](const httplib::Request& req, httplib::Response& res) {
-    g_logger->logVerbose("HTTP", "Request received", "method=" + req.method + ", path=" + req.path + ", remote=" + req.get_header_value("Host"));
+  svr.set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+    logger->logVerbose("HTTP", "Request received", "method=" + req.method + ", path=" + req.path + ", remote=" + req.get_header_value("Host"));
     return httplib::Server::HandlerResponse::Unhandled;
   });
-  
-  svr.listen("0.0.0.0", port);
-  
-  g_logger->logSystemEvent("HTTP server stopped", "");
 }
+
+void startTestServer(int port, const std::string& mockDataFile, double timeScale, const std::string& logFile, const std::string& logVerbosity) {
+  TestServer::Options options;
+  options.port = port;
+  options.mockDataFile = mockDataFile;
+  options.timeScale = timeScale;
+  options.logFile = logFile;
+  options.logVerbosity = logVerbosity;
+  TestServer server(options);
+  server.run();
+}
+
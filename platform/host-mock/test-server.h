@@ -1,4 +1,69 @@
 #pragma once
+#include "Time.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
-void startTestServer(int port, const std::string& mockDataFile = "mock-data.txt", double timeScale = 1.0, const std::string& logFile = "", const std::string& logVerbosity = "");
\ No newline at end of file
+struct cJSON;
+class BeaconLogger;
+class HostMockHttpEndpointHandler;
+namespace httplib { class Server; }
+
+/**
+ * One simulated beacon's web server.
+ *
+ * Settings, status, the mock clock and the log all belong to the instance,
+ * so one process can serve any number of beacons, each on its own port.
+ */
+class TestServer {
+public:
+  struct Options {
+    int port = 8080;
+    std::string mockDataFile = "mock-data.txt";
+    double timeScale = 1.0;
+    std::string logFile;            // empty for stderr
+    std::string logVerbosity;
+    int threads = 0;                // request threads; 0 for the httplib default
+  };
+
+  explicit TestServer(const Options& options);
+  ~TestServer();
+
+  // Serve on the calling thread until stop()
+  void run();
+
+  // Serve on a thread of its own; false if the port could not be bound
+  bool start();
+
+  void stop();
+
+  int getPort() const { return options.port; }
+
+private:
+  int64_t getMockTime() const;
+  void initializeDefaultSettings();
+  void initializeDefaultStatus();
+  bool loadMockData(const std::string& mockDataFile);
+  void updateStatusFromSettings();
+  void registerRoutes();
+
+  Options options;
+  Time timeInterface;
+  std::unique_ptr<BeaconLogger> logger;
+  std::unique_ptr<HostMockHttpEndpointHandler> endpointHandler;   // endpoints shared with the beacon
+  std::unique_ptr<httplib::Server> server;
+  std::thread serverThread;
+  std::atomic<bool> listenReturned;
+  std::chrono::steady_clock::time_point serverStartTime;
+  int64_t mockStartTime;
+  int lastNextTx;
+  std::mutex stateMutex;            // guards settings and status
+  cJSON* settings;
+  cJSON* status;
+};
+
+void startTestServer(int port, const std::string& mockDataFile = "mock-data.txt", double timeScale = 1.0, const std::string& logFile = "", const std::string& logVerbosity = "");
@@ -20,6 +20,32 @@ static const char tag[] = "Beacon";
   #include "secrets.h"
 #endif
 
+// ESP-IDF Kconfig options (host builds pass the same CONFIG_ names from CMake)
+#if __has_include("sdkconfig.h")
+  #include "sdkconfig.h"
+#endif
+
+#ifdef CONFIG_WSPR_FIXED_IDENTITY
+// Fixed-identity firmware: the WSPR frames are encoded at compile time and
+// live in flash. Runtime encoding only happens if settings change identity.
+static const char defaultCallsign[] = CONFIG_WSPR_FIXED_CALLSIGN;
+static const char defaultLocator[] = CONFIG_WSPR_FIXED_LOCATOR;
+static const int defaultPowerDbm = CONFIG_WSPR_FIXED_POWER_DBM;
+
+static constexpr WSPRFrameSet fixedWSPRFrames =
+    wsprEncodeFrameSet(CONFIG_WSPR_FIXED_CALLSIGN, CONFIG_WSPR_FIXED_LOCATOR, CONFIG_WSPR_FIXED_POWER_DBM);
+
+static_assert(wsprIsValidLocator(CONFIG_WSPR_FIXED_LOCATOR),
+              "CONFIG_WSPR_FIXED_LOCATOR must be a 4 or 6 character Maidenhead locator");
+static_assert(wsprFrameSetMatches(fixedWSPRFrames, CONFIG_WSPR_FIXED_CALLSIGN, CONFIG_WSPR_FIXED_LOCATOR,
+                                  CONFIG_WSPR_FIXED_POWER_DBM),
+              "Baked WSPR frames do not match the encoder");
+#else
+static const char defaultCallsign[] = "N0CALL";
+static const char defaultLocator[] = "AA00aa";
+static const int defaultPowerDbm = 10;
+#endif
+
 Beacon::Beacon(AppContext* ctx)
     : ctx(ctx),
       fsm(),
@@ -31,10 +57,25 @@ Beacon::Beacon(AppContext* ctx)
       currentBandIndex(0),
       currentHour(-1),
       firstTransmission(true),
-      wsprEncoder(),
+      runtimeFrames(),
+      wsprFrames(nullptr),
+      nextWSPRFrame(0),
+      mode(&wsprMode),
+      fst4wEncoder(),
+      activeFrame(),
       currentSymbolIndex(0),
       baseFrequency(0),
-      modulationActive(false)
+      toneTable(),
+      modulationActive(false),
+      modulationRun(0),
+      eventsHandled(0),
+      maxEventLatencyUs(0),
+      totalEventLatencyUs(0),
+      loopWakeups(0),
+      droppedLogged(0),
+      wantStation(false),
+      linkUp(false),
+      firstTransmissionUs(-1)
 {
     strcpy(currentBand, "20m");  // Default fallback band
     currentBandIndex = 4;  // Default fallback index
@@ -43,6 +84,7 @@ Beacon::Beacon(AppContext* ctx)
 
 Beacon::~Beacon() {
     stop();
+    scheduler.stop();
 }
 
 void Beacon::initializeCurrentBand() {
@@ -83,19 +125,28 @@ void Beacon::run() {
         // Phase 1: Platform Services Ready
         waitForPlatformServices();
         
-        // Phase 2: Load Configuration  
-        loadAndValidateSettings();
-        
-        // Phase 3: Initialize Core Components
+        // Phase 2: Wire up the FSM and scheduler before anything can fire
         initializeBeaconCore();
         
-        // Phase 4: Start Network Services
-        startNetworkServices();
+        // Phase 3: Bring up everything else as a dependency graph. Settings,
+        // hardware and the web server come up while WiFi connects; SNTP
+        // starts as soon as the link is up, and the scheduler once the
+        // network is ready and the radio initialized.
+        const int settings = startup.add("settings", [this]() { this->loadAndValidateSettings(); });
+        const int hardware = startup.add("hardware", [this]() { this->initializeHardware(); });
+        startup.add("web", [this]() { this->startWebServer(); }, {settings});
+        const int network = startup.add("network", [this]() { this->bringUpNetwork(); });
+        const int sntp = startup.add("sntp", [this]() { if (this->linkUp) this->syncTime(); }, {network});
+        const int ready = startup.add("ready", [this]() { this->enterReadyState(); }, {settings, network});
+        startup.add("scheduler", [this]() { this->startTransmissionScheduler(); }, {ready, hardware, sntp});
         
-        // Phase 5: Begin Transmission Operations
-        startTransmissionScheduler();
+        const bool started = startup.run(ctx->task, [this]() {
+            return this->ctx->timer->nowUs(TimerIntf::Clock::Monotonic);
+        }, STARTUP_STACK_SIZE);
+        logStartupTimeline();
+        if (!started) throw std::runtime_error("Startup failed");
         
-        // Phase 6: Main Operation Loop
+        // Phase 4: Main Operation Loop
         mainOperationLoop();
         
     } catch (...) {
@@ -105,8 +156,9 @@ void Beacon::run() {
 }
 
 void Beacon::stop() {
+    // The main loop stops the scheduler on its way out
     running = false;
-    scheduler.stop();
+    post(Event::Type::Stop);
 }
 
 // Phase 1: Platform Services Ready
@@ -117,18 +169,46 @@ void Beacon::waitForPlatformServices() {
     if (!ctx->logger) throw std::runtime_error("Logger service not available");
     if (!ctx->settings) throw std::runtime_error("Settings service not available");
     if (!ctx->timer) throw std::runtime_error("Timer service not available");
+    if (!ctx->task) throw std::runtime_error("Task service not available");
     if (!ctx->gpio) throw std::runtime_error("GPIO service not available");
     if (!ctx->si5351) throw std::runtime_error("Si5351 service not available");
     if (!ctx->net) throw std::runtime_error("Network service not available");
     if (!ctx->webServer) throw std::runtime_error("WebServer service not available");
     if (!ctx->wsprModulator) throw std::runtime_error("WSPR modulator service not available");
+    if (!ctx->eventGroup) throw std::runtime_error("Event group service not available");
     
     ctx->logger->logInfo("Phase 1: All platform services ready");
 }
 
-// Phase 2: Load Configuration
+// Phase 2: Initialize Core Components
+void Beacon::initializeBeaconCore() {
+    ctx->logger->logInfo("Phase 2: Initializing beacon core components...");
+    
+    // Set up FSM callbacks
+    fsm.setStateChangeCallback([this](FSM::NetworkState networkState, FSM::TransmissionState txState) {
+        this->onStateChanged(networkState, txState);
+    });
+    
+    // The scheduler's timers only wake the loop, which runs the scheduler
+    scheduler.setWakeCallback([this](Scheduler::Wake wake, uint32_t generation) {
+        this->post(Event::Type::SchedulerWake, (uint32_t) wake, generation);
+    });
+    scheduler.setTransmissionStartCallback([this]() { this->post(Event::Type::TransmissionStart); });
+    scheduler.setTransmissionEndCallback([this]() { this->post(Event::Type::TransmissionEnd); });
+    
+    // Decided now, before the startup tasks run, so the only FSM change
+    // while they do is the one the ready step makes
+    wantStation = shouldConnectToWiFi();
+    if (wantStation) {
+        fsm.transitionToStaConnecting();
+    }
+    
+    ctx->logger->logInfo("Phase 2: Core components initialized");
+}
+
+// Startup: Load Configuration
 void Beacon::loadAndValidateSettings() {
-    ctx->logger->logInfo("Phase 2: Loading and validating settings...");
+    ctx->logger->logInfo("Loading and validating settings...");
     
     // Settings should already be loaded by AppContext, verify they exist
     char* settingsJson = ctx->settings->toJsonString();
@@ -149,14 +229,14 @@ void Beacon::loadAndValidateSettings() {
     // Initialize current band based on settings
     initializeCurrentBand();
     
-    ctx->logger->logInfo("Phase 2: Settings loaded and validated");
+    // Encode WSPR frames up front so transmissions only replay symbols
+    encodeWSPRFrames();
+    
+    ctx->logger->logInfo("Settings loaded and validated");
 }
 
-// Phase 3: Initialize Core Components
-void Beacon::initializeBeaconCore() {
-    ctx->logger->logInfo("Phase 3: Initializing beacon core components...");
-    
-    // Initialize hardware
+// Startup: Initialize Hardware
+void Beacon::initializeHardware() {
     ctx->logger->logInfo("Initializing hardware components...");
     
     if (ctx->gpio) {
@@ -171,63 +251,47 @@ void Beacon::initializeBeaconCore() {
         ctx->si5351->init();
         ctx->logger->logInfo("Si5351 initialization complete");
     }
+}
+
+// Startup: Web Server, reachable while WiFi is still connecting
+void Beacon::startWebServer() {
+    if (!ctx->webServer) return;
     
-    // Set up FSM callbacks
-    fsm.setStateChangeCallback([this](FSM::NetworkState networkState, FSM::TransmissionState txState) {
-        this->onStateChanged(networkState, txState);
-    });
+    ctx->logger->logInfo("Initializing web server...");
     
-    // Set up scheduler callbacks
-    scheduler.setTransmissionStartCallback([this]() { this->onTransmissionStart(); });
-    scheduler.setTransmissionEndCallback([this]() { this->onTransmissionEnd(); });
+    // Mount SPIFFS filesystem first
+    if (ctx->fileSystem && !ctx->fileSystem->mount()) {
+        ctx->logger->logError("Failed to mount SPIFFS filesystem");
+    } else {
+        ctx->logger->logInfo("SPIFFS filesystem mounted successfully");
+    }
     
-    ctx->logger->logInfo("Phase 3: Core components initialized");
+    ctx->webServer->setSettingsChangedCallback([this]() { this->post(Event::Type::SettingsChanged); });
+    ctx->webServer->setScheduler(&scheduler);
+    ctx->webServer->setBeacon(this);
+    ctx->webServer->start();
+    ctx->logger->logInfo("Web server started");
 }
 
-// Phase 4: Start Network Services
-void Beacon::startNetworkServices() {
-    ctx->logger->logInfo("Phase 4: Starting network services...");
-    
-    // Initialize web server
-    if (ctx->webServer) {
-        ctx->logger->logInfo("Initializing web server...");
-        
-        // Mount SPIFFS filesystem first
-        if (ctx->fileSystem && !ctx->fileSystem->mount()) {
-            ctx->logger->logError("Failed to mount SPIFFS filesystem");
-        } else {
-            ctx->logger->logInfo("SPIFFS filesystem mounted successfully");
-        }
-        
-        ctx->webServer->setSettingsChangedCallback([this]() { this->onSettingsChanged(); });
-        ctx->webServer->setScheduler(&scheduler);
-        ctx->webServer->setBeacon(this);
-        ctx->webServer->start();
-        ctx->logger->logInfo("Web server started");
+// Startup: WiFi, or our own access point if that fails
+void Beacon::bringUpNetwork() {
+    linkUp = wantStation && connectToWiFi();
+    if (!linkUp) {
+        startAccessPoint();
     }
-    
-    // Start WiFi connection
-    if (shouldConnectToWiFi()) {
-        fsm.transitionToStaConnecting();
-        if (connectToWiFi()) {
-            fsm.transitionToReady();
-        } else {
-            fsm.transitionToApMode();
-            startAccessPoint();
-            fsm.transitionToReady();
-        }
-    } else {
+}
+
+// Startup: Network Ready
+void Beacon::enterReadyState() {
+    if (!linkUp) {
         fsm.transitionToApMode();
-        startAccessPoint();
-        fsm.transitionToReady();
     }
-    
-    ctx->logger->logInfo("Phase 4: Network services started");
+    fsm.transitionToReady();
 }
 
-// Phase 5: Begin Transmission Operations
+// Startup: Begin Transmission Operations
 void Beacon::startTransmissionScheduler() {
-    ctx->logger->logInfo("Phase 5: Starting transmission scheduler...");
+    ctx->logger->logInfo("Starting transmission scheduler...");
     
     // Only start scheduler if we're in ready state
     if (fsm.getNetworkState() == FSM::NetworkState::READY) {
@@ -236,23 +300,135 @@ void Beacon::startTransmissionScheduler() {
     } else {
         ctx->logger->logWarn("Network not ready - scheduler not started");
     }
-    
-    ctx->logger->logInfo("Phase 5: Transmission scheduler ready");
 }
 
-// Phase 6: Main Operation Loop
+void Beacon::logStartupTimeline() {
+    StartupGraph::Timing timeline[StartupGraph::MaxNodes];
+    const int count = startup.getTimeline(timeline, StartupGraph::MaxNodes);
+    for (int i = 0; i < count; ++i) {
+        ctx->logger->logInfo(tag, "Startup %-9s %7.1f - %7.1f ms%s", timeline[i].name,
+                           timeline[i].startUs / 1000.0, timeline[i].endUs / 1000.0,
+                           timeline[i].failed ? " FAILED" : "");
+    }
+    ctx->logger->logInfo(tag, "Startup complete after %.1f ms", startup.elapsedUs() / 1000.0);
+}
+
+int Beacon::getStartupTimeline(StartupGraph::Timing* out, int max) const {
+    return startup.getTimeline(out, max);
+}
+
+// Phase 4: Main Operation Loop
 void Beacon::mainOperationLoop() {
-    ctx->logger->logInfo("Phase 6: Entering main operation loop...");
+    ctx->logger->logInfo("Phase 4: Entering main operation loop...");
+    publishNextTransmission();
     
+    // Hourly SNTP, counted from the sync made at startup when WiFi came up.
+    // Its slack lets it run on a wakeup for an event rather than one of its own.
+    const int64_t startUs = ctx->timer->nowUs(TimerIntf::Clock::Monotonic);
+    housekeeping.add([this]() { return this->syncTime(); }, TIME_SYNC_PERIOD_US, TIME_SYNC_RETRY_US,
+                     lastTimeSync ? startUs + TIME_SYNC_PERIOD_US : startUs, TIME_SYNC_SLACK_US);
+    
+    // Sleep until an event is posted or maintenance is due; an idle beacon
+    // wakes about once an hour
     while (running) {
-        ctx->timer->executeWithPreciseTiming([this]() {
-            periodicTimeSync();
-        }, 100);
+        housekeeping.runDue(ctx->timer->nowUs(TimerIntf::Clock::Monotonic));
+        const uint32_t waitMs = housekeeping.waitMs(ctx->timer->nowUs(TimerIntf::Clock::Monotonic));
+        ctx->eventGroup->waitBits(EVENT_POSTED_BIT, true, false, waitMs);
+        loopWakeups.fetch_add(1, std::memory_order_relaxed);
+        drainEvents();
     }
     
+    scheduler.stop();
     ctx->logger->logInfo("Main operation loop exited");
 }
 
+// Any task: queue an input for the main loop and wake it. False if the
+// queue was full and the event dropped.
+bool Beacon::post(Event::Type type, uint32_t value, uint32_t run) {
+    Event event;
+    event.type = type;
+    event.value = value;
+    event.run = run;
+    event.postedUs = ctx->timer ? ctx->timer->nowUs(TimerIntf::Clock::Monotonic) : 0;
+    
+    // A full queue counts the drop; the loop logs it, since this may be
+    // a timer callback
+    const bool queued = events.push(event);
+    if (ctx->eventGroup) {
+        ctx->eventGroup->setBits(EVENT_POSTED_BIT);
+    }
+    return queued;
+}
+
+void Beacon::drainEvents() {
+    Event event;
+    while (events.pop(event)) {
+        const int64_t latencyUs = ctx->timer->nowUs(TimerIntf::Clock::Monotonic) - event.postedUs;
+        const uint32_t latency = latencyUs > 0 ? (uint32_t) latencyUs : 0;
+        if (latency > maxEventLatencyUs.load(std::memory_order_relaxed)) {
+            maxEventLatencyUs.store(latency, std::memory_order_relaxed);
+        }
+        totalEventLatencyUs.fetch_add(latency, std::memory_order_relaxed);
+        eventsHandled.fetch_add(1, std::memory_order_relaxed);
+        handleEvent(event);
+    }
+    
+    const uint32_t dropped = events.getDropped();
+    if (dropped != droppedLogged) {
+        ctx->logger->logWarn(tag, "Event queue full: %u event(s) dropped", (unsigned) (dropped - droppedLogged));
+        droppedLogged = dropped;
+    }
+}
+
+void Beacon::handleEvent(const Event& event) {
+    switch (event.type) {
+        case Event::Type::SchedulerWake:
+            scheduler.handleWake((Scheduler::Wake) event.value, event.run);
+            publishNextTransmission();
+            break;
+        case Event::Type::TransmissionStart:
+            onTransmissionStart();
+            publishNextTransmission();
+            break;
+        case Event::Type::TransmissionEnd:
+            onTransmissionEnd();
+            publishNextTransmission();
+            break;
+        case Event::Type::Symbol:
+            if (event.run == modulationRun) {
+                modulateSymbol((int) event.value);
+            }
+            break;
+        case Event::Type::SettingsChanged:
+            onSettingsChanged();
+            publishNextTransmission();
+            break;
+        case Event::Type::CalibrationStart:
+            applyCalibrationMode(true, event.value);
+            break;
+        case Event::Type::CalibrationStop:
+            applyCalibrationMode(false, 0);
+            break;
+        case Event::Type::Calibration:
+            applyCalibration();
+            break;
+        case Event::Type::Stop:
+            break;
+    }
+}
+
+Beacon::EventLoopStats Beacon::getEventLoopStats() const {
+    EventLoopStats stats;
+    stats.posted = events.getPosted();
+    stats.dropped = events.getDropped();
+    stats.maxDepth = events.getMaxDepth();
+    stats.handled = eventsHandled.load(std::memory_order_relaxed);
+    stats.maxLatencyUs = maxEventLatencyUs.load(std::memory_order_relaxed);
+    stats.totalLatencyUs = totalEventLatencyUs.load(std::memory_order_relaxed);
+    stats.wakeups = loopWakeups.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void Beacon::onStateChanged(FSM::NetworkState networkState, FSM::TransmissionState txState) {
     char logMsg[128];
     snprintf(logMsg, sizeof(logMsg), "State: %s / %s", 
@@ -280,6 +456,11 @@ void Beacon::onTransmissionStart() {
     fsm.transitionToTransmissionPending();
     startTransmission();
     fsm.transitionToTransmitting();
+    
+    // Time to first transmission, on the startup timeline's clock
+    if (firstTransmissionUs.load(std::memory_order_relaxed) < 0) {
+        firstTransmissionUs.store(startup.elapsedUs(), std::memory_order_relaxed);
+    }
 }
 
 void Beacon::onTransmissionEnd() {
@@ -313,13 +494,14 @@ void Beacon::onSettingsChanged() {
         detectTimezone();  // Update timezone first
         firstTransmission = true;  // Reset to start from first enabled band
         initializeCurrentBand();  // Then update band selection
+        encodeWSPRFrames();  // Re-encode callsign/locator/power frames
         
         // Restart scheduler if network is ready - this will immediately check for next transmission opportunity
         if (fsm.getNetworkState() == FSM::NetworkState::READY) {
             scheduler.start();
             
             // Show actual next transmission time instead of generic message
-            NextTransmissionInfo nextTx = getNextTransmissionInfo();
+            NextTransmissionInfo nextTx = predictNextTransmission();
             if (nextTx.secondsUntil < 0) {
                 ctx->logger->logInfo(tag, "Scheduler restarted - new settings applied, no transmissions scheduled (txPct=0 or no enabled bands)");
             } else if (nextTx.secondsUntil == 0) {
@@ -380,9 +562,9 @@ void Beacon::startTransmission() {
         uint32_t frequency = getBandInt(currentBand, "freq", 14095600);
         
         snprintf(logMsg, sizeof(logMsg), "🟢 TX START: %s, %s, %ddBm on %s (%.6f MHz)",
-            ctx->settings->getString("call", "N0CALL"),
-            ctx->settings->getString("loc", "AA00aa"), 
-            ctx->settings->getInt("pwr", 10),
+            ctx->settings->getString("call", defaultCallsign),
+            ctx->settings->getString("loc", defaultLocator), 
+            ctx->settings->getInt("pwr", defaultPowerDbm),
             currentBand,
             frequency / 1000000.0
         );
@@ -399,7 +581,7 @@ void Beacon::endTransmission() {
     ctx->logger->logInfo(tag, "🔴 TRANSMISSION ENDING...");
     char logMsg[128];
     snprintf(logMsg, sizeof(logMsg), "🔴 TX END on %s after %.1f seconds", 
-            currentBand, Scheduler::WSPR_TRANSMISSION_DURATION_SEC);
+            currentBand, scheduler.getTransmissionDurationSec());
     ctx->logger->logInfo(tag, logMsg);
     
     // Stop WSPR modulation
@@ -416,7 +598,7 @@ void Beacon::endTransmission() {
     incrementTransmissionStats();
 }
 
-void Beacon::syncTime() {
+bool Beacon::syncTime() {
     ctx->logger->logInfo("Syncing time via SNTP");
     
     if (ctx->time) {
@@ -425,17 +607,11 @@ void Beacon::syncTime() {
         if (ctx->time->syncTime(ntpServer)) {
             lastTimeSync = ctx->time->getTime();
             ctx->logger->logInfo("Time sync initiated with %s", ntpServer);
-        } else {
-            ctx->logger->logWarn("Failed to initiate time sync");
+            return true;
         }
+        ctx->logger->logWarn("Failed to initiate time sync");
     }
-}
-
-void Beacon::periodicTimeSync() {
-    int64_t now = ctx->time->getTime();
-    if ((now - lastTimeSync) > 3600) {
-        syncTime();
-    }
+    return false;
 }
 
 
@@ -491,7 +667,6 @@ bool Beacon::connectToWiFi() {
     
     if (connected) {
         ctx->logger->logInfo("WiFi connected");
-        syncTime();
     }
     
     return connected;
@@ -784,12 +959,39 @@ int Beacon::getLocalHour(time_t utcTime) {
 
 // Next transmission prediction methods
 Beacon::NextTransmissionInfo Beacon::getNextTransmissionInfo() const {
-    NextTransmissionInfo info = {0, "", 0, false};
+    const PublishedNextTransmission published = nextTransmission.get();
+    NextTransmissionInfo info = published.info;
+    
+    // Count down from when it was predicted; the loop publishes again at
+    // every slot, so this never runs far past zero
+    if (info.secondsUntil > 0 && ctx->time) {
+        const int64_t elapsed = ctx->time->getTime() - published.publishedAt;
+        info.secondsUntil = elapsed < info.secondsUntil ? info.secondsUntil - (int) elapsed : 0;
+    }
+    return info;
+}
+
+// Main loop: predict from the current frames, band and schedule, and make
+// that what the web server reads
+void Beacon::publishNextTransmission() {
+    PublishedNextTransmission published;
+    published.info = predictNextTransmission();
+    published.publishedAt = ctx->time ? ctx->time->getTime() : 0;
+    nextTransmission.post(published);
+}
+
+// Main loop only
+Beacon::NextTransmissionInfo Beacon::predictNextTransmission() const {
+    NextTransmissionInfo info = {0, "", 0, false, 1};
     
     if (!ctx->settings) {
         return info;
     }
     
+    if (wsprFrames) {
+        info.messageType = wsprFrames->types[nextWSPRFrame];
+    }
+    
     // Get seconds until next actual transmission (not just opportunity)
     info.secondsUntil = scheduler.getSecondsUntilNextActualTransmission();
     
@@ -903,53 +1105,98 @@ const char* Beacon::predictNextBand(time_t futureTime) const {
 
 
 
+void Beacon::encodeWSPRFrames() {
+    if (!ctx->settings) {
+        return;
+    }
+    
+    const char* callsign = ctx->settings->getString("call", defaultCallsign);
+    const char* locator = ctx->settings->getString("loc", defaultLocator);
+    int8_t powerDbm = (int8_t)ctx->settings->getInt("pwr", defaultPowerDbm);
+    nextWSPRFrame = 0;
+    
+    // The mode decides the slot length, so the scheduler follows it
+    mode = findBeaconMode(ctx->settings->getString("mode", wsprMode.name));
+    scheduler.setMode(mode);
+    ctx->logger->logInfo(tag, "Beacon mode %s: %ds slots, %.1fs transmissions",
+                       mode->name, mode->slotSeconds, mode->durationSec());
+    
+#ifdef CONFIG_WSPR_FIXED_IDENTITY
+    if (strcasecmp(callsign, defaultCallsign) == 0 && strcasecmp(locator, defaultLocator) == 0 &&
+        powerDbm == defaultPowerDbm) {
+        wsprFrames = &fixedWSPRFrames;
+        ctx->logger->logInfo(tag, "Using %d compile-time WSPR frame(s) for %s %s %ddBm",
+                           wsprFrames->count, callsign, locator, powerDbm);
+        return;
+    }
+#endif
+    
+    runtimeFrames = wsprEncodeFrameSet(callsign, locator, powerDbm);
+    wsprFrames = &runtimeFrames;
+    
+    ctx->logger->logInfo(tag, "Encoded %d WSPR frame(s) for %s %s %ddBm (types %d%s%d)",
+                       wsprFrames->count, callsign, locator, powerDbm, wsprFrames->types[0],
+                       wsprFrames->count > 1 ? "/" : "", wsprFrames->count > 1 ? wsprFrames->types[1] : 0);
+}
+
 void Beacon::startWSPRModulation() {
     if (!ctx->settings || !ctx->si5351 || !ctx->wsprModulator) {
         ctx->logger->logError(tag, "Cannot start WSPR modulation - missing components");
         return;
     }
     
-    // Get WSPR parameters from settings
-    const char* callsign = ctx->settings->getString("call", "N0CALL");
-    const char* locator = ctx->settings->getString("loc", "AA00aa");
-    int8_t powerDbm = (int8_t)ctx->settings->getInt("pwr", 10);
-    
-    ctx->logger->logInfo(tag, "Encoding WSPR message: %s %s %ddBm", callsign, locator, powerDbm);
+    if (!wsprFrames) {
+        encodeWSPRFrames();
+    }
     
-    // Encode the WSPR message
-    wsprEncoder.encode(callsign, locator, powerDbm);
+    // Pick the cached frame for this transmission and advance the rotation
+    WSPREncoder::MessageType type = wsprFrames->types[nextWSPRFrame];
+    if (mode == &wsprMode) {
+        activeFrame = wsprSymbolFrame(wsprFrames->frames[nextWSPRFrame]);
+    } else {
+        fst4wEncoder.encode(ctx->settings->getString("call", defaultCallsign),
+                            ctx->settings->getString("loc", defaultLocator),
+                            (int8_t)ctx->settings->getInt("pwr", defaultPowerDbm), type);
+        activeFrame = fst4wEncoder.frame();
+    }
+    ctx->logger->logInfo(tag, "Sending %s Type %d frame", mode->name, type);
+    nextWSPRFrame = (nextWSPRFrame + 1) % wsprFrames->count;
     
     // Reset modulation state
     currentSymbolIndex = 0;
     modulationActive = true;
+    const uint32_t symbolRun = ++modulationRun;
     
-    // Calculate all 4 WSPR frequencies for glitch-free switching
-    double wspr_freqs[4];
-    for (int i = 0; i < 4; i++) {
-        wspr_freqs[i] = baseFrequency + (i * WSPREncoder::ToneSpacing / 100.0); // Convert centi-Hz to Hz
-    }
+    // Calculate all tone frequencies once for glitch-free switching; the
+    // spacing comes from the mode, not the encoder's nominal one
+    mode->toneTable(baseFrequency, toneTable);
     
-    // Setup Si5351 for glitch-free WSPR frequency transitions
-    uint32_t initialFreq = baseFrequency + (wsprEncoder.symbols[0] * WSPREncoder::ToneSpacing / 100);
-    ctx->si5351->setupChannelSmooth(0, initialFreq, wspr_freqs);
+    // Setup Si5351 for glitch-free frequency transitions
+    uint8_t firstSymbol = activeFrame.symbol(0);
+    ctx->si5351->setupChannelSmooth(0, toneTable[firstSymbol], toneTable, mode->toneCount);
     ctx->si5351->enableOutput(0, true);
     
-    ctx->logger->logInfo(tag, "WSPR frequencies: %.2f, %.2f, %.2f, %.2f Hz", 
-                        wspr_freqs[0], wspr_freqs[1], wspr_freqs[2], wspr_freqs[3]);
+    ctx->logger->logInfo(tag, "%s frequencies: %d tones from %.2f Hz, %.3f Hz apart", mode->name,
+                        mode->toneCount, toneTable[0], mode->toneSpacingHz());
     
     ctx->logger->logInfo(tag, "Starting with symbol %d, freq %.2f Hz offset", 
-                       wsprEncoder.symbols[0], wsprEncoder.symbols[0] * 1.46);
+                       firstSymbol, toneTable[firstSymbol] - baseFrequency);
     // Start the symbol stream visualization
     if (ctx->symbolOutput) {
-        ctx->symbolOutput->startSymbolStream(wsprEncoder.symbols[0]);
-        ctx->symbolOutput->outputSymbolArray(wsprEncoder.symbols, WSPREncoder::TxBufferSize);
+        uint8_t symbols[ModeMaxSymbols];
+        const int count = activeFrame.count < ModeMaxSymbols ? activeFrame.count : ModeMaxSymbols;
+        for (int i = 0; i < count; i++) {
+            symbols[i] = activeFrame.symbol(i);
+        }
+        ctx->symbolOutput->startSymbolStream(firstSymbol);
+        ctx->symbolOutput->outputSymbolArray(symbols, count);
     }
-    ctx->logger->logInfo(tag, "WSPR encoding symbols starting with: %c", 'A' + wsprEncoder.symbols[0]);
+    ctx->logger->logInfo(tag, "WSPR encoding symbols starting with: %c", 'A' + firstSymbol);
     
-    // Start platform-specific WSPR modulation
-    bool started = ctx->wsprModulator->startModulation([this](int symbolIndex) {
-        this->modulateSymbol(symbolIndex);
-    }, 162);
+    // Start platform-specific WSPR modulation; its ticks come back as events
+    bool started = ctx->wsprModulator->startModulation([this, symbolRun](int symbolIndex) {
+        this->post(Event::Type::Symbol, (uint32_t) symbolIndex, symbolRun);
+    }, activeFrame.count, (int)lround(mode->symbolPeriodMs()));
     
     if (started) {
         ctx->logger->logInfo(tag, "WSPR modulation started - transmitting encoded message");
@@ -990,17 +1237,16 @@ void Beacon::modulateSymbol(int symbolIndex) {
     currentSymbolIndex = symbolIndex;
     
     // Check if we've transmitted all symbols
-    if (symbolIndex >= 162) {
-        ctx->logger->logInfo(tag, "All 162 WSPR symbols transmitted");
+    if (symbolIndex >= activeFrame.count) {
+        ctx->logger->logInfo(tag, "All %d WSPR symbols transmitted", activeFrame.count);
         return; // Let the main transmission timer handle the end
     }
     
     // Get the current symbol and calculate frequency
-    uint8_t symbol = wsprEncoder.symbols[symbolIndex];
-    uint32_t symbolFreq = baseFrequency + (symbol * WSPREncoder::ToneSpacing / 100); // Convert centi-Hz to Hz
+    uint8_t symbol = activeFrame.symbol(symbolIndex);
     
-    // Update frequency using glitch-free method
-    ctx->si5351->updateChannelFrequencyMinimal(0, symbolFreq);
+    // Switch to the tone's precomputed registers (glitch-free)
+    ctx->si5351->selectChannelTone(0, symbol);
     
     // Output symbol through interface
     if (ctx->symbolOutput) {
@@ -1022,9 +1268,12 @@ void Beacon::incrementTransmissionStats() {
     int totalTxCnt = ctx->settings->getInt("totalTxCnt", 0);
     int totalTxMin = ctx->settings->getInt("totalTxMin", 0);
     
+    // Each transmission counts its whole minutes on the air, per the active mode
+    const int txMin = (int)ceil(mode->durationSec() / 60.0);
+
     // Increment totals
     totalTxCnt++;
-    totalTxMin += 2; // WSPR transmission is ~2 minutes (110.6 seconds)
+    totalTxMin += txMin;
     
     // Update totals (RAM-only, no NVS writes)
     ctx->settings->setInt("totalTxCnt", totalTxCnt);
@@ -1039,7 +1288,7 @@ void Beacon::incrementTransmissionStats() {
     int bandTxMin = ctx->settings->getInt(bandTxMinKey, 0);
     
     bandTxCnt++;
-    bandTxMin += 2;
+    bandTxMin += txMin;
     
     ctx->settings->setInt(bandTxCntKey, bandTxCnt);
     ctx->settings->setInt(bandTxMinKey, bandTxMin);
@@ -1051,13 +1300,68 @@ void Beacon::incrementTransmissionStats() {
                         totalTxCnt, totalTxMin, currentBand, bandTxCnt, bandTxMin);
 }
 
-void Beacon::setCalibrationMode(bool enabled) {
+void Beacon::setCalibrationMode(bool enabled, uint32_t freqHz) {
+    // Setpoints from before a start or stop are stale. Cleared here, not on
+    // the loop, so setpoints posted right after the start survive.
+    calibrationFrequency.clear();
+    calibrationPreview.clear();
+    if (enabled) {
+        post(Event::Type::CalibrationStart, freqHz);
+    } else {
+        post(Event::Type::CalibrationStop);
+    }
+}
+
+void Beacon::applyCalibrationMode(bool enabled, uint32_t freqHz) {
     scheduler.setCalibrationMode(enabled);
-    if (ctx->logger) {
-        ctx->logger->logInfo(tag, "Calibration mode %s", enabled ? "enabled" : "disabled");
+    if (ctx->si5351) {
+        ctx->si5351->enableOutput(0, false);
+        if (enabled && freqHz) {
+            ctx->si5351->setFrequency(0, freqHz);
+            ctx->si5351->enableOutput(0, true);
+        }
     }
+    ctx->logger->logInfo(tag, "Calibration mode %s", enabled ? "enabled" : "disabled");
 }
 
 bool Beacon::isCalibrationMode() const {
     return scheduler.isCalibrationMode();
 }
+
+// Only the post that finds the mailbox empty queues an event; the rest
+// just replace the setpoint, so a slider cannot fill the queue. If that
+// event is dropped, the setpoint goes too, so the next post queues again.
+void Beacon::postCalibrationFrequency(double freqHz) {
+    if (calibrationFrequency.post(freqHz) && !post(Event::Type::Calibration)) {
+        calibrationFrequency.clear();
+    }
+}
+
+void Beacon::postCalibrationPreview(int32_t ppb) {
+    if (calibrationPreview.post(ppb) && !post(Event::Type::Calibration)) {
+        calibrationPreview.clear();
+    }
+}
+
+void Beacon::applyCalibration() {
+    // Taken even when they cannot be applied, so the next post finds the
+    // mailbox empty and wakes the loop again
+    double freqHz;
+    const bool newFrequency = calibrationFrequency.take(freqHz);
+    int32_t ppb;
+    const bool newPreview = calibrationPreview.take(ppb);
+    
+    Si5351Intf* si5351 = getSi5351();
+    if (!si5351 || !isCalibrationMode()) {
+        return;
+    }
+    
+    // However many setpoints arrived since the last pass, only the newest
+    // reaches the chip
+    if (newFrequency) {
+        si5351->fineTune(0, freqHz);
+    }
+    if (newPreview) {
+        si5351->previewCorrection(0, ppb);
+    }
+}
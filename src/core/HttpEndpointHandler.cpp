@@ -5,12 +5,19 @@
 #include "Scheduler.h"
 #include "Si5351Intf.h"
 #include "JTEncode.h"
+#include "WSPRBatchEncoder.h"
 #include "cJSON.h"
 #include <sstream>
 #include <iomanip>
 #include <cstring>
 #include <chrono>
 #include <cstdlib>
+#include <cmath>
+#include <vector>
+
+// Power a WSPR message can report, in dBm
+static const int WSPR_MIN_POWER_DBM = 0;
+static const int WSPR_MAX_POWER_DBM = 60;
 
 // Base HttpEndpointHandler implementation
 
@@ -118,6 +125,7 @@ std::string HttpEndpointHandler::getStatusJson() {
         cJSON_AddStringToObject(status, "nextTxBand", nextTxInfo.band);
         cJSON_AddNumberToObject(status, "nextTxFreq", nextTxInfo.frequency);
         cJSON_AddBoolToObject(status, "nextTxValid", nextTxInfo.valid);
+        cJSON_AddNumberToObject(status, "nextTxMsgType", nextTxInfo.messageType);
     } else if (scheduler) {
         // Fallback to scheduler only
         int nextTxSeconds = scheduler->getSecondsUntilNextTransmission();
@@ -132,6 +140,34 @@ std::string HttpEndpointHandler::getStatusJson() {
         cJSON_AddBoolToObject(status, "nextTxValid", false);
     }
     
+    // Add the startup timeline: each phase's start and end in ms from boot,
+    // -1 while pending, and time to first transmission
+    if (beacon) {
+        cJSON* startup = cJSON_CreateObject();
+        cJSON* phases = cJSON_CreateArray();
+        if (startup && phases) {
+            StartupGraph::Timing timeline[StartupGraph::MaxNodes];
+            const int count = beacon->getStartupTimeline(timeline, StartupGraph::MaxNodes);
+            for (int i = 0; i < count; i++) {
+                cJSON* phase = cJSON_CreateObject();
+                if (phase) {
+                    cJSON_AddStringToObject(phase, "name", timeline[i].name);
+                    cJSON_AddNumberToObject(phase, "startMs", timeline[i].startUs < 0 ? -1 : timeline[i].startUs / 1000.0);
+                    cJSON_AddNumberToObject(phase, "endMs", timeline[i].endUs < 0 ? -1 : timeline[i].endUs / 1000.0);
+                    cJSON_AddBoolToObject(phase, "ok", !timeline[i].failed);
+                    cJSON_AddItemToArray(phases, phase);
+                }
+            }
+            cJSON_AddItemToObject(startup, "phases", phases);
+            const int64_t firstTxUs = beacon->getFirstTransmissionUs();
+            cJSON_AddNumberToObject(startup, "firstTxMs", firstTxUs < 0 ? -1 : firstTxUs / 1000.0);
+            cJSON_AddItemToObject(status, "startup", startup);
+        } else {
+            cJSON_Delete(phases);
+            cJSON_Delete(startup);
+        }
+    }
+
     // Add transmission statistics from settings
     cJSON* stats = cJSON_CreateObject();
     if (stats) {
@@ -349,17 +385,10 @@ HttpHandlerResult HttpEndpointHandler::handleApiCalibrationStart(HttpRequestIntf
     uint32_t freq = (uint32_t)frequency->valueint;
     cJSON_Delete(json);
     
-    // Set calibration mode to prevent TX interference
+    // Set calibration mode to prevent TX interference; the beacon loop
+    // puts CLK0 on the frequency
     if (beacon) {
-        beacon->setCalibrationMode(true);
-        
-        // Use Si5351 from the beacon
-        Si5351Intf* si5351 = beacon->getSi5351();
-        if (si5351) {
-            si5351->enableOutput(0, false);
-            si5351->setFrequency(0, freq);
-            si5351->enableOutput(0, true);
-        }
+        beacon->setCalibrationMode(true, freq);
     }
     
     return sendJsonResponse(response, "{\"status\":\"started\"}");
@@ -368,11 +397,6 @@ HttpHandlerResult HttpEndpointHandler::handleApiCalibrationStart(HttpRequestIntf
 HttpHandlerResult HttpEndpointHandler::handleApiCalibrationStop(HttpRequestIntf* request, HttpResponseIntf* response) {
     if (beacon) {
         beacon->setCalibrationMode(false);
-        
-        Si5351Intf* si5351 = beacon->getSi5351();
-        if (si5351) {
-            si5351->enableOutput(0, false);
-        }
     }
     
     return sendJsonResponse(response, "{\"status\":\"stopped\"}");
@@ -408,19 +432,59 @@ HttpHandlerResult HttpEndpointHandler::handleApiCalibrationAdjust(HttpRequestInt
         return sendError(response, 400, "Missing frequency");
     }
     
-    uint32_t freq = (uint32_t)frequency->valueint;
+    double freq = frequency->valuedouble;
     cJSON_Delete(json);
     
+    // Queued for the beacon's main loop; a newer adjustment replaces it
     if (beacon) {
-        Si5351Intf* si5351 = beacon->getSi5351();
-        if (si5351) {
-            si5351->setFrequency(0, freq);
-        }
+        beacon->postCalibrationFrequency(freq);
     }
     
     return sendJsonResponse(response, "{\"status\":\"adjusted\"}");
 }
 
+HttpHandlerResult HttpEndpointHandler::handleApiCalibrationPreview(HttpRequestIntf* request, HttpResponseIntf* response) {
+    std::string body = request->getBody();
+    if (body.empty()) {
+        const size_t bufferSize = 256;
+        char* buffer = (char*)malloc(bufferSize);
+        if (!buffer) {
+            return sendError(response, 500, "Out of memory");
+        }
+        
+        int bytesRead = request->receiveData(buffer, bufferSize - 1);
+        if (bytesRead <= 0) {
+            free(buffer);
+            return sendError(response, 400, "Empty request body");
+        }
+        buffer[bytesRead] = '\0';
+        body = std::string(buffer);
+        free(buffer);
+    }
+    
+    cJSON* json = cJSON_Parse(body.c_str());
+    if (!json) {
+        return sendError(response, 400, "Invalid JSON");
+    }
+    
+    cJSON* ppb = cJSON_GetObjectItem(json, "ppb");
+    if (!cJSON_IsNumber(ppb)) {
+        cJSON_Delete(json);
+        return sendError(response, 400, "Missing ppb");
+    }
+    
+    int32_t correctionPpb = (int32_t)lround(ppb->valuedouble);
+    cJSON_Delete(json);
+    
+    // Moves the test signal as the correction would, without relocking the
+    // PLL or changing the stored calibration
+    if (beacon) {
+        beacon->postCalibrationPreview(correctionPpb);
+    }
+    
+    return sendJsonResponse(response, "{\"status\":\"previewing\"}");
+}
+
 HttpHandlerResult HttpEndpointHandler::handleApiCalibrationCorrection(HttpRequestIntf* request, HttpResponseIntf* response) {
     std::string body = request->getBody();
     if (body.empty()) {
@@ -485,15 +549,22 @@ HttpHandlerResult HttpEndpointHandler::handleApiWSPREncode(HttpRequestIntf* requ
     std::string locator = (locatorItem && cJSON_IsString(locatorItem)) ? locatorItem->valuestring : "AA00aa";
     int powerDbm = (powerItem && cJSON_IsNumber(powerItem)) ? powerItem->valueint : 10;
     uint32_t frequency = (frequencyItem && cJSON_IsNumber(frequencyItem)) ? (uint32_t)frequencyItem->valueint : 14097100;
+    bool powerValid = !powerItem || !cJSON_IsNumber(powerItem) ||
+                      (powerItem->valuedouble >= WSPR_MIN_POWER_DBM && powerItem->valuedouble <= WSPR_MAX_POWER_DBM);
     
     cJSON_Delete(requestData);
     
+    if (!powerValid) {
+        return sendError(response, 400, "powerDbm must be 0 to 60");
+    }
+    
     try {
         // Create WSPR encoder
         WSPREncoder encoder(frequency);
         
         // Encode the message
         encoder.encode(callsign.c_str(), locator.c_str(), static_cast<int8_t>(powerDbm));
+        SymbolFrame frame = encoder.frame();
         
         // Build response with symbols
         cJSON* response_json = cJSON_CreateObject();
@@ -502,19 +573,19 @@ HttpHandlerResult HttpEndpointHandler::handleApiWSPREncode(HttpRequestIntf* requ
         cJSON_AddStringToObject(response_json, "locator", locator.c_str());
         cJSON_AddNumberToObject(response_json, "powerDbm", powerDbm);
         cJSON_AddNumberToObject(response_json, "frequency", frequency);
-        cJSON_AddNumberToObject(response_json, "symbolCount", WSPREncoder::TxBufferSize);
-        cJSON_AddNumberToObject(response_json, "toneSpacing", WSPREncoder::ToneSpacing);
-        cJSON_AddNumberToObject(response_json, "symbolPeriod", WSPREncoder::SymbolPeriod);
+        cJSON_AddNumberToObject(response_json, "symbolCount", frame.count);
+        cJSON_AddNumberToObject(response_json, "toneSpacing", frame.toneSpacing);
+        cJSON_AddNumberToObject(response_json, "symbolPeriod", frame.symbolPeriod);
         
         // Add symbols array
         cJSON* symbolsArray = cJSON_CreateArray();
-        for (int i = 0; i < WSPREncoder::TxBufferSize; i++) {
-            cJSON_AddItemToArray(symbolsArray, cJSON_CreateNumber(encoder.symbols[i]));
+        for (int i = 0; i < frame.count; i++) {
+            cJSON_AddItemToArray(symbolsArray, cJSON_CreateNumber(frame.symbol(i)));
         }
         cJSON_AddItemToObject(response_json, "symbols", symbolsArray);
         
         // Calculate transmission duration
-        uint32_t transmissionDurationMs = WSPREncoder::TxBufferSize * WSPREncoder::SymbolPeriod;
+        uint32_t transmissionDurationMs = frame.durationMs();
         cJSON_AddNumberToObject(response_json, "transmissionDurationMs", transmissionDurationMs);
         cJSON_AddNumberToObject(response_json, "transmissionDurationSeconds", transmissionDurationMs / 1000.0);
         
@@ -546,4 +617,88 @@ HttpHandlerResult HttpEndpointHandler::handleApiWSPREncode(HttpRequestIntf* requ
             return sendError(response, 400, "Unknown error");
         }
     }
-}
\ No newline at end of file
+}
+
+HttpHandlerResult HttpEndpointHandler::handleApiWSPREncodeBatch(HttpRequestIntf* request, HttpResponseIntf* response) {
+    static const int MAX_BATCH_MESSAGES = 10000;
+    
+    std::string body = request->getBody();
+    if (body.empty()) {
+        return sendError(response, 400, "Empty request body");
+    }
+    
+    cJSON* requestData = cJSON_Parse(body.c_str());
+    if (!requestData) {
+        return sendError(response, 400, "Invalid JSON format");
+    }
+    
+    // Expect {"messages": [{"callsign": ..., "locator": ..., "powerDbm": ...}, ...]}
+    cJSON* messages = cJSON_GetObjectItem(requestData, "messages");
+    int count = messages ? cJSON_GetArraySize(messages) : 0;
+    if (count <= 0 || count > MAX_BATCH_MESSAGES) {
+        cJSON_Delete(requestData);
+        return sendError(response, 400, "messages must be an array of 1 to 10000 entries");
+    }
+    
+    std::vector<const char*> callsigns(count);
+    std::vector<const char*> locators(count);
+    std::vector<int8_t> powers(count);
+    for (int i = 0; i < count; i++) {
+        cJSON* msg = cJSON_GetArrayItem(messages, i);
+        cJSON* callsignItem = cJSON_GetObjectItem(msg, "callsign");
+        cJSON* locatorItem = cJSON_GetObjectItem(msg, "locator");
+        cJSON* powerItem = cJSON_GetObjectItem(msg, "powerDbm");
+        
+        // An int8_t cast would wrap, e.g. 300 to 44, so out-of-range power is rejected
+        if (powerItem && cJSON_IsNumber(powerItem) &&
+            (powerItem->valuedouble < WSPR_MIN_POWER_DBM || powerItem->valuedouble > WSPR_MAX_POWER_DBM)) {
+            cJSON_Delete(requestData);
+            return sendError(response, 400, "messages[" + std::to_string(i) + "].powerDbm must be 0 to 60");
+        }
+        
+        callsigns[i] = (callsignItem && cJSON_IsString(callsignItem)) ? callsignItem->valuestring : "N0CALL";
+        locators[i] = (locatorItem && cJSON_IsString(locatorItem)) ? locatorItem->valuestring : "AA00aa";
+        powers[i] = (powerItem && cJSON_IsNumber(powerItem)) ? (int8_t)powerItem->valueint : 10;
+    }
+    
+    // Strings stay owned by requestData until the response is built
+    std::vector<uint8_t> symbols((size_t)count * WSPREncoder::TxBufferSize);
+    WSPRBatchEncoder::encode(callsigns.data(), locators.data(), powers.data(), count, symbols.data());
+    
+    cJSON* response_json = cJSON_CreateObject();
+    cJSON_AddBoolToObject(response_json, "success", true);
+    cJSON_AddNumberToObject(response_json, "count", count);
+    cJSON_AddStringToObject(response_json, "kernel", WSPRBatchEncoder::isaName(WSPRBatchEncoder::bestIsa()));
+    cJSON_AddNumberToObject(response_json, "symbolCount", WSPREncoder::TxBufferSize);
+    
+    // Symbols are sent as a string of tone digits per message to keep large batches compact
+    cJSON* results = cJSON_CreateArray();
+    char symbolString[WSPREncoder::TxBufferSize + 1];
+    for (int i = 0; i < count; i++) {
+        const uint8_t* msgSymbols = &symbols[(size_t)i * WSPREncoder::TxBufferSize];
+        for (int j = 0; j < WSPREncoder::TxBufferSize; j++) {
+            symbolString[j] = '0' + msgSymbols[j];
+        }
+        symbolString[WSPREncoder::TxBufferSize] = '\0';
+        
+        cJSON* result = cJSON_CreateObject();
+        cJSON_AddStringToObject(result, "callsign", callsigns[i]);
+        cJSON_AddStringToObject(result, "locator", locators[i]);
+        cJSON_AddNumberToObject(result, "powerDbm", powers[i]);
+        cJSON_AddStringToObject(result, "symbols", symbolString);
+        cJSON_AddItemToArray(results, result);
+    }
+    cJSON_AddItemToObject(response_json, "messages", results);
+    cJSON_Delete(requestData);
+    
+    char* responseStr = cJSON_PrintUnformatted(response_json);
+    cJSON_Delete(response_json);
+    
+    if (responseStr) {
+        std::string result(responseStr);
+        free(responseStr);
+        return sendJsonResponse(response, result);
+    } else {
+        return sendError(response, 500, "Failed to generate response");
+    }
+}
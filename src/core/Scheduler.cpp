@@ -17,10 +17,12 @@ Scheduler::Scheduler(TimerIntf* timer, SettingsIntf* settings, LoggerIntf* logge
       time(time),
       schedulerTimer(nullptr),
       transmissionEndTimer(nullptr),
+      generation(0),
       transmissionInProgress(false),
       schedulerActive(false),
-      waitingForNextOpportunity(false),
-      calibrationMode(false)
+      lastOpportunitySlot(-1),
+      calibrationMode(false),
+      mode(&wsprMode)
 {}
 
 Scheduler::~Scheduler() {
@@ -35,31 +37,77 @@ void Scheduler::setTransmissionEndCallback(TransmissionCallback callback) {
     onTransmissionEndCallback = callback;
 }
 
+void Scheduler::setWakeCallback(WakeCallback callback) {
+    onWakeCallback = callback;
+}
+
+// Timer task: hand the wake over, or handle it here without an owner
+void Scheduler::wake(Wake w) {
+    const uint32_t firedIn = generation.load(std::memory_order_acquire);
+    if (onWakeCallback) {
+        onWakeCallback(w, firedIn);
+    } else {
+        handleWake(w, firedIn);
+    }
+}
+
+void Scheduler::handleWake(Wake w, uint32_t firedIn) {
+    switch (w) {
+        case Wake::Slot:
+            // A late one is harmless: each slot rolls once, and the timer
+            // is re-armed either way
+            checkTransmissionOpportunity();
+            break;
+        case Wake::TransmissionEnd:
+            // Not the end of a transmission cancelled since, or of one
+            // started after that
+            if (firedIn == generation.load(std::memory_order_relaxed)) {
+                onTransmissionEnd();
+            }
+            break;
+    }
+}
+
 void Scheduler::start() {
     if (schedulerActive) return;
     
     schedulerActive = true;
     transmissionInProgress = false;
-    waitingForNextOpportunity = false;
+    lastOpportunitySlot = -1;
+    generation.fetch_add(1, std::memory_order_release);
     
-    // Start a simple 1-second periodic timer
+    // One wakeup per slot boundary, re-armed as each is handled so a mode
+    // change takes effect from the next slot
     if (!schedulerTimer) {
-        schedulerTimer = timer->createPeriodic([this]() { 
-            checkTransmissionOpportunity(); 
-        });
+        schedulerTimer = timer->createOneShot([this]() { this->wake(Wake::Slot); });
         if (!schedulerTimer) {
             if (logger) {
-                logger->logError(tag, "Failed to create periodic timer");
+                logger->logError(tag, "Failed to create slot timer");
             }
             return;
         }
     }
     
-    timer->start(schedulerTimer, 1000); // Check every second
+    armNextSlot();
+}
+
+// Wake at the next slot boundary on the UTC clock, which follows any SNTP
+// step. Still inside the opportunity window of the current slot, that
+// slot's boundary is already past and the timer fires at once.
+void Scheduler::armNextSlot() {
+    const int64_t slotUs = (int64_t) mode->slotSeconds * 1000000;
+    const int64_t nowUs = timer->nowUs(TimerIntf::Clock::Utc);
+    int64_t boundaryUs = nowUs - nowUs % slotUs;
+    if (nowUs - boundaryUs >= OPPORTUNITY_WINDOW_SEC * 1000000LL ||
+        boundaryUs / 1000000 == lastOpportunitySlot) {
+        boundaryUs += slotUs;
+    }
+    timer->startAt(schedulerTimer, boundaryUs, TimerIntf::Clock::Utc);
 }
 
 void Scheduler::stop() {
     schedulerActive = false;
+    generation.fetch_add(1, std::memory_order_release);
     
     if (timer) {
         if (schedulerTimer) {
@@ -75,15 +123,17 @@ void Scheduler::stop() {
     }
     
     transmissionInProgress = false;
-    waitingForNextOpportunity = false;
+    lastOpportunitySlot = -1;
 }
 
 void Scheduler::cancelCurrentTransmission() {
     if (!transmissionInProgress) return;
     
-    // Just mark transmission as not in progress
+    // Just mark transmission as not in progress, and drop its end wake if
+    // already on its way
     // The task will handle calling the end callback
     transmissionInProgress = false;
+    generation.fetch_add(1, std::memory_order_release);
 }
 
 bool Scheduler::isTransmissionInProgress() const {
@@ -95,41 +145,44 @@ bool Scheduler::isValidTransmissionTime() const {
     return false;
 }
 
+void Scheduler::setMode(const ModeDescriptor* newMode) {
+    mode = newMode ? newMode : &wsprMode;
+}
+
+const ModeDescriptor* Scheduler::getMode() const {
+    return mode;
+}
+
+double Scheduler::getTransmissionDurationSec() const {
+    return mode->durationSec();
+}
+
+// Slots start on multiples of the slot period since the epoch, so 120 s
+// slots are even minutes and 1800 s slots are half hours
+int Scheduler::secondsIntoSlot(time_t t) const {
+    return static_cast<int>(t % mode->slotSeconds);
+}
+
+// UTC on the clock armNextSlot() arms against, so a wakeup lands in the
+// slot it was armed for
+time_t Scheduler::utcNowSec() const {
+    return timer ? static_cast<time_t>(timer->nowUs(TimerIntf::Clock::Utc) / 1000000) : std::time(nullptr);
+}
+
 time_t Scheduler::getNextTransmissionTime() const {
-    // Return next even minute boundary
-    time_t now = timer ? timer->getCurrentTime() : std::time(nullptr);
-    struct tm tmNow;
-    gmtime_r(&now, &tmNow);
-    
-    int minutesToNext = (tmNow.tm_min % 2 == 0) ? 2 : 1;
-    if (tmNow.tm_min % 2 == 0 && tmNow.tm_sec == 0) {
-        minutesToNext = 0;  // We're exactly at an even minute
-    }
-    
-    time_t nextTime = now + (minutesToNext * 60) - tmNow.tm_sec;
-    return nextTime;
+    // Return the next slot boundary
+    time_t now = utcNowSec();
+    int into = secondsIntoSlot(now);
+    return into == 0 ? now : now + (mode->slotSeconds - into);
 }
 
 int Scheduler::getSecondsUntilNextTransmission() const {
-    // Return seconds until next even minute (transmission opportunity)
-    time_t now = timer ? timer->getCurrentTime() : std::time(nullptr);
-    struct tm tmNow;
-    gmtime_r(&now, &tmNow);
-    
-    int secondsToWait;
-    if (tmNow.tm_min % 2 == 0) {
-        // Already on even minute
-        if (tmNow.tm_sec < 2) {
-            secondsToWait = 0;  // Within first 2 seconds of even minute
-        } else {
-            secondsToWait = 120 - tmNow.tm_sec;  // Wait for next even minute
-        }
-    } else {
-        // On odd minute, wait until next even minute
-        secondsToWait = 60 - tmNow.tm_sec;
-    }
+    // Return seconds until the next slot (transmission opportunity)
+    time_t now = utcNowSec();
+    int into = secondsIntoSlot(now);
     
-    return secondsToWait;
+    // Within the first 2 seconds of a slot counts as now
+    return into < OPPORTUNITY_WINDOW_SEC ? 0 : mode->slotSeconds - into;
 }
 
 int Scheduler::getSecondsUntilNextActualTransmission() const {
@@ -156,11 +209,11 @@ int Scheduler::getSecondsUntilNextActualTransmission() const {
         
         // Check if any bands are enabled for this hour
         if (hasAnyEnabledBandsForHour(futureHour)) {
-            // Calculate opportunities in this hour (30 per hour, every 2 minutes)
-            int startMinute = (hoursAhead == 0) ? 
-                ((currentTime % 3600) / 60) : 0; // Start from current minute if current hour
+            // Calculate opportunities in this hour (one per slot, e.g. 30 per
+            // hour for 2-minute slots); past ones are skipped below
+            int slotMinutes = mode->slotSeconds / 60;
             
-            for (int minute = startMinute; minute < 60; minute += 2) {
+            for (int minute = 0; minute < 60; minute += slotMinutes) {
                 int64_t opportunityTime = checkTime - (checkTime % 3600) + (minute * 60);
                 
                 // Skip if this opportunity is in the past
@@ -188,33 +241,30 @@ void Scheduler::checkTransmissionOpportunity() {
         return;
     }
     
-    time_t now = timer ? timer->getCurrentTime() : std::time(nullptr);
-    struct tm tmNow;
-    gmtime_r(&now, &tmNow);
+    time_t now = utcNowSec();
+    int into = secondsIntoSlot(now);
+    time_t slot = now - into;
     
-    // Check if we're at an even minute boundary (within first 2 seconds)
-    bool isTransmissionOpportunity = (tmNow.tm_min % 2 == 0) && (tmNow.tm_sec < 2);
+    // A wakeup within the first 2 seconds of a slot is its opportunity; one
+    // early or late, e.g. across a clock step, just re-arms for the next
+    bool isTransmissionOpportunity = into < OPPORTUNITY_WINDOW_SEC && slot != lastOpportunitySlot;
+    if (isTransmissionOpportunity) {
+        lastOpportunitySlot = slot; // Only one wakeup per slot
+    }
     
-    if (isTransmissionOpportunity && !transmissionInProgress && !waitingForNextOpportunity && !calibrationMode) {
+    if (isTransmissionOpportunity && !transmissionInProgress && !calibrationMode) {
         // This is a transmission opportunity - roll dice
-        waitingForNextOpportunity = true; // Prevent multiple checks in same window
-        
         int txPercent = settings ? settings->getInt("txPct", 0) : 0;
         int diceRoll = random ? random->randInt(100) : 0;
         bool shouldTransmit = (txPercent > 0) && (diceRoll < txPercent);
         
-        // IMPORTANT: NO LOGGING IN TIMER CALLBACK - IT'S NOT SAFE!
-        // The decision will be logged when startTransmission() is called
-        // or by the main loop checking for skipped transmissions
-        
         if (shouldTransmit) {
             startTransmission();
         }
     }
     
-    // Reset opportunity flag when we're past the window
-    if (waitingForNextOpportunity && tmNow.tm_sec >= 5) {
-        waitingForNextOpportunity = false;
+    if (schedulerActive) {
+        armNextSlot();
     }
 }
 
@@ -230,14 +280,14 @@ void Scheduler::startTransmission() {
     
     // Schedule end of transmission
     if (!transmissionEndTimer) {
-        transmissionEndTimer = timer->createOneShot([this]() { this->onTransmissionEnd(); });
+        transmissionEndTimer = timer->createOneShot([this]() { this->wake(Wake::TransmissionEnd); });
     }
     
     if (logger) {
-        logger->logInfo(tag, "Transmitting for %.1f seconds", WSPR_TRANSMISSION_DURATION_SEC);
+        logger->logInfo(tag, "Transmitting %s for %.1f seconds", mode->name, mode->durationSec());
     }
     
-    timer->start(transmissionEndTimer, static_cast<int>(WSPR_TRANSMISSION_DURATION_SEC * 1000));
+    timer->start(transmissionEndTimer, static_cast<int>(mode->durationSec() * 1000));
 }
 
 void Scheduler::onTransmissionEnd() {
@@ -247,7 +297,7 @@ void Scheduler::onTransmissionEnd() {
         onTransmissionEndCallback();
     }
     
-    // The periodic timer will automatically handle the next opportunity check
+    // The slot timer is already armed for the next opportunity
 }
 
 void Scheduler::setCalibrationMode(bool enabled) {
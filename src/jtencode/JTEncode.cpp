@@ -1,132 +1,711 @@
 #include "JTEncode.h"
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <stdint.h>
+#include "WSPRPipeline.h"
+#include "generator.h"
+#include "RSEncoder.h"
+#include "ConvEncoder.h"
+#include "jtencode-util.h"
 
 // --- Internal Data & Helpers ---
 
-// FT8 LDPC generator matrix placeholder
-static const uint8_t ft8LdpcGenerator[87][12] = {
-    {0b10000011, 0b00101001, 0b11001110, 0b00010001, 0b10111111, 0b00110001, 0b11101010, 0b11110101, 0b00001001, 0b11110010, 0b01111111, 0b11000000},
-    // ... all 87 rows ...
+// FT8 sync pattern and 3-bit Gray code tone mapping
+static constexpr uint8_t ft8Costas[7] = {3, 1, 4, 0, 6, 5, 2};
+static constexpr uint8_t ft8GrayMap[8] = {0, 1, 3, 2, 5, 6, 4, 7};
+
+// FT8 standard message field limits
+static constexpr uint32_t ft8NTokens = 2063592;
+static constexpr uint32_t ft8Max22 = 4194304;
+static constexpr uint16_t ft8MaxGrid4 = 32400;
+
+// Byte-at-a-time table for the FT8 CRC-14 (polynomial 0x2757, MSB first)
+struct FT8CrcTable {
+  uint16_t entries[256];
+};
+
+static constexpr uint16_t ft8CrcStep(uint16_t r) {
+  return (r & 0x2000) ? (uint16_t) ((r << 1) ^ 0x2757) : (uint16_t) (r << 1);
+}
+
+static constexpr FT8CrcTable makeFT8CrcTable() {
+  FT8CrcTable table{};
+  for (int b = 0; b < 256; ++b) {
+    uint16_t r = (uint16_t) (b << 6);
+    for (int k = 0; k < 8; ++k) r = ft8CrcStep(r);
+    table.entries[b] = r & 0x3FFF;
+  }
+  return table;
+}
+
+static constexpr FT8CrcTable ft8CrcTable = makeFT8CrcTable();
+
+// LDPC generator rows packed into two 64-bit words (message bits 0..63 and
+// 64..90, MSB first) so each parity bit is two ANDs, an XOR and a popcount.
+struct FT8LdpcRows {
+  uint64_t hi[83];
+  uint64_t lo[83];
 };
 
-// WSPR character encoding helper
-static uint8_t wsprCode(char c) {
-  if (c >= '0' && c <= '9') return c - '0';
-  if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
-  return 36; // Space
+static constexpr uint64_t ft8LoadWord(const uint8_t* bytes, int count) {
+  uint64_t w = 0;
+  for (int i = 0; i < 8; ++i) w = (w << 8) | (i < count ? bytes[i] : 0);
+  return w;
 }
 
-// WSPR interleaver hashing helper
-static uint32_t nhash(const int* d) {
-  uint32_t h = 0x811c9dc5;
-  for (int i = 0; i < 2; ++i) {
-    h ^= (uint32_t)d[i];
-    h *= 0x01000193;
+static constexpr FT8LdpcRows makeFT8LdpcRows() {
+  FT8LdpcRows rows{};
+  for (int i = 0; i < 83; ++i) {
+    rows.hi[i] = ft8LoadWord(generator_bits[i], 8);
+    rows.lo[i] = ft8LoadWord(generator_bits[i] + 8, 4);
   }
-  return h;
+  return rows;
 }
 
+static constexpr FT8LdpcRows ft8LdpcRows = makeFT8LdpcRows();
+
+// JT65 RS(63,12): GF(64) with x^6 + x + 1, first root alpha^3
+using JT65RSEncoder = RSEncoder<6, 51, 3, 1, 0x43>;
+
+static_assert(WSPREncoder::PackedBytes * 8 >= 50, "WSPR packs 50 bits");
+static_assert(FT8Encoder::PackedBytes * 8 >= FT8Encoder::CodewordBits, "FT8 keeps its codeword in packedData");
+static_assert(JT65Encoder::PackedBytes >= JT65Encoder::DataSymbols, "JT65 packs 12 six-bit symbols");
+
+// JT65 sync vector: 1 = sync tone, 0 = next data symbol
+static constexpr uint8_t jt65SyncVector[126] = {
+  1, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 0,
+  0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 1,
+  0, 1, 1, 0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 0, 1, 1,
+  0, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1,
+  1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1,
+  0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1, 1,
+  1, 1, 1, 1, 1, 1
+};
+
 // --- WSPREncoder Implementation ---
+//
+// The pipeline stages live in WSPRPipeline.h as constexpr functions so the
+// same code can bake fixed frames into flash at compile time.
+
+// Compile-time self-check of the constexpr pipeline against a golden frame
+static constexpr bool wsprFrameMatches(const WSPRSymbolFrame& frame, const char* digits) {
+  for (int i = 0; i < WSPRSymbolCount; ++i) {
+    if (frame.symbols[i] != digits[i] - '0') return false;
+  }
+  return true;
+}
+
+static_assert(wsprFrameMatches(wsprEncodeFrame("K1ABC", "FN42", 37, WSPREncoder::TYPE1),
+                               "330020001020131222100323133220200032012322002232110233"
+                               "210221321222033030301210212032132003323032203020201023"
+                               "021112330231212221332000010320132222202332323320031222"),
+              "constexpr WSPR pipeline does not match the K1ABC FN42 37 golden frame");
+static_assert(wsprCallsignHash("K1ABC") == 6521, "constexpr WSPR hash must match nhash_()");
+
+int WSPREncoder::frameSequence(const char* callsign, const char* locator, MessageType types[2]) {
+  return wsprFrameSequence(callsign, locator, types);
+}
 
 void WSPREncoder::encode(const char* callsign, const char* locator, int8_t powerDbm) {
-  strncpy(this->callsign, callsign, 11);
-  this->callsign[11] = '\0';
-  strncpy(this->locator, locator, 6);
-  this->locator[6] = '\0';
-  this->powerDbm = powerDbm;
-  packBits();
-  convolveSymbols();
-  interleave();
+  MessageType types[2];
+  frameSequence(callsign, locator, types);
+  encode(callsign, locator, powerDbm, types[0]);
+}
+
+void WSPREncoder::encode(const char* callsign, const char* locator, int8_t powerDbm, MessageType type) {
+  WSPRMessage msg = wsprMakeMessage(callsign, locator, powerDbm, type);
+  memcpy(this->callsign, msg.callsign, sizeof(this->callsign));
+  memcpy(this->locator, msg.locator, sizeof(this->locator));
+  this->powerDbm = msg.powerDbm;
+  this->messageType = msg.type;
+
+  valid = runPipeline();
 }
 
-void WSPREncoder::packBits() {
+bool WSPREncoder::packBits() {
+  if (!wsprCanPack(locator, messageType)) return false;
+
+  WSPRMessage msg{};
+  memcpy(msg.callsign, callsign, sizeof(msg.callsign));
+  memcpy(msg.locator, locator, sizeof(msg.locator));
+  msg.powerDbm = powerDbm;
+  msg.type = messageType;
+
+  uint64_t n = wsprPackMessage(msg);
   memset(packedData, 0, sizeof(packedData));
-  uint64_t n = 0;
-  uint32_t nCall = 0;
-  nCall += wsprCode(callsign[0]) * 36 * 36 * 36 * 36 * 10;
-  nCall += wsprCode(callsign[1]) * 36 * 36 * 36 * 10;
-  nCall += wsprCode(callsign[2]) * 36 * 36 * 10;
-  nCall += wsprCode(callsign[3]) * 36 * 10;
-  nCall += wsprCode(callsign[4]) * 10;
-  nCall += wsprCode(callsign[5]);
-  n = nCall;
-  uint16_t nLoc = 179 - (locator[0] - 'A') * 10 - (locator[1] - 'A');
-  nLoc *= 100;
-  nLoc += (locator[2] - '0') * 10 + (locator[3] - '0');
-  n = (n << 15) | nLoc;
-  uint8_t nPow = (powerDbm >= 0 && powerDbm <= 60) ? (uint8_t)powerDbm : 63;
-  n = (n << 7) | nPow;
   for (int i = 0; i < 50; ++i) {
     if ((n >> (49 - i)) & 1) packedData[i / 8] |= (1 << (7 - (i % 8)));
   }
+  return true;
 }
 
 void WSPREncoder::convolveSymbols() {
-  const uint32_t g1 = 0xF2D05351, g2 = 0xE4613C47;
-  uint8_t messageBuffer[205] = {0};
-  for (int i = 0; i < 50; ++i) {
-    messageBuffer[i] = (packedData[i / 8] >> (7 - (i % 8))) & 1;
+  JTConvEncoder::encodeBits(packedData, 50, symbols);
+}
+
+// Interleaves and merges the sync vector in one pass
+void WSPREncoder::interleave() {
+  uint8_t data[TxBufferSize];
+  memcpy(data, symbols, TxBufferSize);
+  wsprInterleaveSync(data, symbols);
+}
+
+// --- FT8Encoder Implementation ---
+
+// Index of c in alphabet, or -1
+static int ft8CharIndex(const char* alphabet, char c) {
+  const char* p = c ? strchr(alphabet, c) : nullptr;
+  return p ? (int) (p - alphabet) : -1;
+}
+
+// Packs DE, QRZ, CQ or a standard callsign into 28 bits. suffix receives
+// 'R' or 'P' for a /R or /P callsign and 0 otherwise.
+static bool ft8PackCall(const char* token, uint32_t& n28, char& suffix) {
+  suffix = 0;
+  if (!strcmp(token, "DE")) { n28 = 0; return true; }
+  if (!strcmp(token, "QRZ")) { n28 = 1; return true; }
+  if (!strcmp(token, "CQ")) { n28 = 2; return true; }
+
+  int len = strlen(token);
+  if (len > 2 && token[len - 2] == '/' && (token[len - 1] == 'R' || token[len - 1] == 'P')) {
+    suffix = token[len - 1];
+    len -= 2;
   }
-  for (int i = 0; i < 162; ++i) {
-    uint8_t bit1 = 0, bit2 = 0;
-    for (int j = 0; j < 32; ++j) {
-      if (((g1 >> j) & 1) != 0) bit1 ^= messageBuffer[i + j];
-      if (((g2 >> j) & 1) != 0) bit2 ^= messageBuffer[i + j];
+
+  // Align so the call area digit is the third character
+  int pad;
+  if (len >= 3 && isdigit((unsigned char) token[2])) pad = 0;
+  else if (len >= 2 && isdigit((unsigned char) token[1])) pad = 1;
+  else return false;
+  if (len + pad > 6) return false;
+
+  char call[6];
+  memset(call, ' ', sizeof(call));
+  memcpy(call + pad, token, len);
+
+  int i0 = ft8CharIndex(" 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", call[0]);
+  int i1 = ft8CharIndex("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", call[1]);
+  int i2 = ft8CharIndex("0123456789", call[2]);
+  int i3 = ft8CharIndex(" ABCDEFGHIJKLMNOPQRSTUVWXYZ", call[3]);
+  int i4 = ft8CharIndex(" ABCDEFGHIJKLMNOPQRSTUVWXYZ", call[4]);
+  int i5 = ft8CharIndex(" ABCDEFGHIJKLMNOPQRSTUVWXYZ", call[5]);
+  if (i0 < 0 || i1 < 0 || i2 < 0 || i3 < 0 || i4 < 0 || i5 < 0) return false;
+
+  n28 = ft8NTokens + ft8Max22 + ((((i0 * 36 + i1) * 10 + i2) * 27 + i3) * 27 + i4) * 27 + i5;
+  return true;
+}
+
+// Packs the directed CQ forms "CQ nnn" (three digits) and "CQ ABCD"
+// (one to four letters) into 28 bits.
+static bool ft8PackCqModifier(const char* modifier, uint32_t& n28) {
+  int len = strlen(modifier);
+  bool digits = len == 3;
+  bool letters = len >= 1 && len <= 4;
+  for (int i = 0; i < len; ++i) {
+    digits &= isdigit((unsigned char) modifier[i]) != 0;
+    letters &= modifier[i] >= 'A' && modifier[i] <= 'Z';
+  }
+
+  if (digits) {
+    n28 = 3 + atoi(modifier);
+    return true;
+  }
+
+  if (letters) {
+    uint32_t m = 0;
+    for (int i = 0; i < len; ++i) m = 27 * m + (modifier[i] - 'A' + 1);
+    n28 = 1003 + m;
+    return true;
+  }
+
+  return false;
+}
+
+// Packs a 4-character grid, signal report (-30..+99 dB, optionally with an
+// R acknowledgement), RRR, RR73, 73 or nothing into 15 bits.
+static bool ft8PackGrid(const char* token, uint16_t& g15, bool& ack) {
+  ack = false;
+  if (!*token) { g15 = ft8MaxGrid4 + 1; return true; }
+  if (!strcmp(token, "RRR")) { g15 = ft8MaxGrid4 + 2; return true; }
+  if (!strcmp(token, "RR73")) { g15 = ft8MaxGrid4 + 3; return true; }
+  if (!strcmp(token, "73")) { g15 = ft8MaxGrid4 + 4; return true; }
+
+  if (strlen(token) == 4 && token[0] >= 'A' && token[0] <= 'R' && token[1] >= 'A' && token[1] <= 'R' &&
+      isdigit((unsigned char) token[2]) && isdigit((unsigned char) token[3])) {
+    g15 = (token[0] - 'A') * 1800 + (token[1] - 'A') * 100 + (token[2] - '0') * 10 + (token[3] - '0');
+    return true;
+  }
+
+  if (token[0] == 'R' && (token[1] == '+' || token[1] == '-')) {
+    ack = true;
+    ++token;
+  }
+
+  int len = strlen(token);
+  if ((token[0] != '+' && token[0] != '-') || len < 2 || len > 3) return false;
+  for (int i = 1; i < len; ++i) {
+    if (!isdigit((unsigned char) token[i])) return false;
+  }
+
+  int report = atoi(token);
+  if (report < -30) return false;
+  g15 = ft8MaxGrid4 + 35 + report;
+  return true;
+}
+
+bool FT8Encoder::pack77(const char* message, uint8_t payload[10]) {
+  // Split into at most four upper-case tokens
+  char tokens[4][14];
+  int count = 0;
+  for (const char* p = message; *p; ) {
+    if (*p == ' ') { ++p; continue; }
+    if (count == 4) return false;
+
+    int len = 0;
+    while (*p && *p != ' ') {
+      if (len == 13) return false;
+      tokens[count][len++] = toupper((unsigned char) *p++);
     }
-    symbols[i] = (bit1 << 1) | bit2;
+    tokens[count++][len] = 0;
+  }
+  if (count < 2) return false;
+
+  uint32_t n28a, n28b;
+  char suffixA = 0, suffixB = 0;
+  int next = 1;
+
+  // "CQ DX K1ABC FN42" carries the modifier in the first call field
+  if (!strcmp(tokens[0], "CQ") && count >= 3 && (count == 4 || !ft8PackCall(tokens[1], n28b, suffixB)) &&
+      ft8PackCqModifier(tokens[1], n28a)) {
+    next = 2;
+  } else if (!ft8PackCall(tokens[0], n28a, suffixA)) {
+    return false;
   }
+
+  if (count - next < 1 || count - next > 2) return false;
+  if (!ft8PackCall(tokens[next], n28b, suffixB)) return false;
+
+  uint16_t g15;
+  bool ack;
+  if (!ft8PackGrid(count - next == 2 ? tokens[next + 1] : "", g15, ack)) return false;
+
+  // i3=1 allows /R suffixes, i3=2 (EU VHF contest style) allows /P
+  uint8_t i3 = (suffixA == 'P' || suffixB == 'P') ? 2 : 1;
+  if (i3 == 2 && (suffixA == 'R' || suffixB == 'R')) return false;
+
+  uint32_t n29a = (n28a << 1) | (suffixA ? 1 : 0);
+  uint32_t n29b = (n28b << 1) | (suffixB ? 1 : 0);
+  uint16_t igrid = g15 | (ack ? 0x8000 : 0);
+
+  // 29 + 29 + 16 + 3 bits, MSB first
+  payload[0] = n29a >> 21;
+  payload[1] = n29a >> 13;
+  payload[2] = n29a >> 5;
+  payload[3] = (uint8_t) (n29a << 3) | (uint8_t) (n29b >> 26);
+  payload[4] = n29b >> 18;
+  payload[5] = n29b >> 10;
+  payload[6] = n29b >> 2;
+  payload[7] = (uint8_t) (n29b << 6) | (uint8_t) (igrid >> 10);
+  payload[8] = igrid >> 2;
+  payload[9] = (uint8_t) (igrid << 6) | (uint8_t) (i3 << 3);
+  return true;
 }
 
-void WSPREncoder::interleave() {
-  uint8_t temporaryBuffer[TxBufferSize];
-  int d[2] = {0, 0};
-  for (int i = 0; i < TxBufferSize; ++i) {
-    d[0] = i;
-    uint32_t h = nhash(d);
-    temporaryBuffer[i] = symbols[h % 162];
+uint16_t FT8Encoder::crc14(const uint8_t payload[10]) {
+  // The CRC covers the 77 payload bits zero-padded to 82 bits
+  uint16_t r = 0;
+  for (int i = 0; i < 10; ++i) {
+    uint8_t byte = i == 9 ? (payload[9] & 0xF8) : payload[i];
+    r = ((r << 8) & 0x3FFF) ^ ft8CrcTable.entries[((r >> 6) ^ byte) & 0xFF];
   }
-  memcpy(symbols, temporaryBuffer, TxBufferSize);
+  r = ft8CrcStep(ft8CrcStep(r));
+  return r & 0x3FFF;
 }
 
-// --- FT8Encoder Implementation ---
+void FT8Encoder::encodeLdpc(const uint8_t message[12], uint8_t codeword[22]) {
+  // Bits past the 91st are ignored: the generator rows are zero there
+  uint64_t hi = ft8LoadWord(message, 8);
+  uint64_t lo = ft8LoadWord(message + 8, 4);
+
+  memcpy(codeword, message, 12);
+  codeword[11] &= 0xE0;
+  memset(codeword + 12, 0, 10);
+
+  for (int i = 0; i < 83; ++i) {
+    int parity = __builtin_popcountll((hi & ft8LdpcRows.hi[i]) ^ (lo & ft8LdpcRows.lo[i])) & 1;
+    int bit = MessageBits + i;
+    codeword[bit >> 3] |= parity << (7 - (bit & 7));
+  }
+}
 
 void FT8Encoder::encode(const char* message) {
-  packBits(message);
-  computeFec();
-  generateSync();
+  valid = runPipeline(message);
 }
 
-void FT8Encoder::packBits(const char* message) {
-  printf("  [FT8] Packing bits for message: %s\n", message);
+bool FT8Encoder::packBits(const char* message) {
   memset(packedData, 0, sizeof(packedData));
+  return pack77(message, packedData);
+}
+
+// Appends the CRC-14 and replaces the payload in packedData with the
+// 174-bit LDPC codeword.
+void FT8Encoder::computeFec() {
+  uint8_t a91[12];
+  uint16_t crc = crc14(packedData);
+
+  memcpy(a91, packedData, 10);
+  a91[9] = (packedData[9] & 0xF8) | (uint8_t) (crc >> 11);
+  a91[10] = (uint8_t) (crc >> 3);
+  a91[11] = (uint8_t) (crc << 5);
+
+  encodeLdpc(a91, packedData);
+}
+
+// 79 tones: a Costas array at 0, 36 and 72 around two blocks of 29
+// Gray-coded 8-FSK data symbols, three codeword bits each.
+void FT8Encoder::generateSync() {
+  int bit = 0;
+
+  for (int i = 0; i < TxBufferSize; ++i) {
+    if (i < 7) {
+      symbols[i] = ft8Costas[i];
+    } else if (i >= 36 && i < 43) {
+      symbols[i] = ft8Costas[i - 36];
+    } else if (i >= 72) {
+      symbols[i] = ft8Costas[i - 72];
+    } else {
+      uint8_t bits3 = 0;
+      for (int k = 0; k < 3; ++k, ++bit) bits3 = (bits3 << 1) | ((packedData[bit >> 3] >> (7 - (bit & 7))) & 1);
+      symbols[i] = ft8GrayMap[bits3];
+    }
+  }
 }
-void FT8Encoder::computeFec() { printf("  [FT8] Computing CRC-14 and LDPC FEC...\n"); }
-void FT8Encoder::generateSync() { printf("  [FT8] Generating sync bits (Costas arrays)...\n"); }
 
 // --- JT65Encoder Implementation ---
 
+// Packs 13 characters of free text base 42 into 72 bits (two 28-bit
+// words and a 16-bit word with the free-text flag set), as 12 6-bit symbols.
+static void jtPackFreeText(const char* message, uint8_t d[12]) {
+  uint8_t c[13];
+  int len = message ? strlen(message) : 0;
+  for (int i = 0; i < 13; ++i) {
+    c[i] = i < len ? jtCode(toupper((unsigned char) message[i])) : 36;
+    if (c[i] > 41) c[i] = 36;
+  }
+
+  uint32_t n1 = 0, n2 = 0, n3 = 0;
+  for (int i = 0; i < 5; ++i) n1 = n1 * 42 + c[i];
+  for (int i = 5; i < 10; ++i) n2 = n2 * 42 + c[i];
+  for (int i = 10; i < 13; ++i) n3 = n3 * 42 + c[i];
+
+  // n3 needs 17 bits; its top two move into the low bits of n1 and n2
+  n1 = (n1 << 1) | ((n3 >> 15) & 1);
+  n2 = (n2 << 1) | ((n3 >> 16) & 1);
+  n3 = (n3 & 0x7FFF) + 32768;
+
+  d[0] = (n1 >> 22) & 0x3F;
+  d[1] = (n1 >> 16) & 0x3F;
+  d[2] = (n1 >> 10) & 0x3F;
+  d[3] = (n1 >> 4) & 0x3F;
+  d[4] = ((n1 & 0x0F) << 2) | ((n2 >> 26) & 0x03);
+  d[5] = (n2 >> 20) & 0x3F;
+  d[6] = (n2 >> 14) & 0x3F;
+  d[7] = (n2 >> 8) & 0x3F;
+  d[8] = (n2 >> 2) & 0x3F;
+  d[9] = ((n2 & 0x03) << 4) | ((n3 >> 12) & 0x0F);
+  d[10] = (n3 >> 6) & 0x3F;
+  d[11] = n3 & 0x3F;
+}
+
+
 void JT65Encoder::encode(const char* message) {
-  printf("  [JT65] Encoding message: %s\n", message);
-  packBits(message);
-  computeFec();
-  interleave();
-  convolveSymbols();
-  generateSync();
-}
-void JT65Encoder::packBits(const char* message) { printf("  [JT65] Packing bits.\n"); }
-void JT65Encoder::computeFec() { printf("  [JT65] Placeholder for Reed-Solomon FEC.\n"); }
-void JT65Encoder::interleave() { printf("  [JT65] Interleaving symbols.\n"); }
-void JT65Encoder::convolveSymbols() { printf("  [JT65] Applying convolutional encoding.\n"); }
-void JT65Encoder::generateSync() { printf("  [JT65] Merging sync vector.\n"); }
+  runPipeline(message);
+}
+
+void JT65Encoder::packBits(const char* message) {
+  jtPackFreeText(message, packedData);
+}
+
+// RS(63,12) into symbols[0..62]: 51 parity symbols then the 12 data
+// symbols, both in the reversed order the JT65 decoder expects.
+void JT65Encoder::computeFec() {
+  uint8_t data[DataSymbols];
+  uint8_t parity[CodeSymbols - DataSymbols];
+
+  for (int i = 0; i < DataSymbols; ++i) data[i] = packedData[DataSymbols - 1 - i];
+  JT65RSEncoder::encode(data, DataSymbols, parity);
+
+  for (int i = 0; i < CodeSymbols - DataSymbols; ++i) symbols[CodeSymbols - DataSymbols - 1 - i] = parity[i];
+  memcpy(symbols + CodeSymbols - DataSymbols, packedData, DataSymbols);
+}
+
+// 7x9 block interleave of the 63 code symbols
+void JT65Encoder::interleave() {
+  uint8_t d[CodeSymbols];
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 7; ++j) d[j * 9 + i] = symbols[i * 7 + j];
+  }
+  memcpy(symbols, d, CodeSymbols);
+}
+
+// Gray-codes the data symbols and spreads them over the 126-symbol frame:
+// sync positions send tone 0, data symbols send tone 2 + symbol.
+void JT65Encoder::generateSync() {
+  uint8_t g[CodeSymbols];
+  for (int i = 0; i < CodeSymbols; ++i) g[i] = symbols[i] ^ (symbols[i] >> 1);
+
+  int b = 0;
+  for (int i = 0; i < TxBufferSize; ++i) {
+    symbols[i] = jt65SyncVector[i] ? 0 : g[b++] + 2;
+  }
+}
 
 // --- JT9 & JT4 Implementations ---
+//
+// JT9 sends the JT65 free-text payload through the K=32, r=1/2 code
+// (72 bits plus a 31-bit tail give 206 coded bits) and the 8-bit
+// bit-reversal interleaver, kept packed MSB first in packedData, then
+// Gray-codes three bits per 9-FSK tone.
+
+static constexpr int jtCodedBits = JTConvEncoder::outputBits(72);
+static_assert(jtCodedBits == 206, "JT9 sends 206 coded bits");
+
+// Packs the 12 free-text symbols into 72 bits, MSB first
+static void jtPackMessageBits(const char* message, uint8_t bytes[9]) {
+  uint8_t words[12];
+  jtPackFreeText(message, words);
+
+  for (int i = 0; i < 12; i += 4) {
+    uint32_t v = (words[i] << 18) | (words[i + 1] << 12) | (words[i + 2] << 6) | words[i + 3];
+    uint8_t* b = bytes + i / 4 * 3;
+    b[0] = v >> 16;
+    b[1] = v >> 8;
+    b[2] = v;
+  }
+}
+
+static inline uint8_t jtBit(const uint8_t* bytes, int i) {
+  return (bytes[i >> 3] >> (7 - (i & 7))) & 1;
+}
+
+static constexpr int jtCodedBytes = JTConvEncoder::outputBytes(72);
+static_assert(JT9Encoder::PackedBytes >= jtCodedBytes, "JT9 keeps the coded bits in packedData");
+
+// Convolves the 72 message bits in place
+static void jtConvolve(uint8_t packed[jtCodedBytes]) {
+  uint8_t coded[jtCodedBytes];
+  JTConvEncoder::encode(packed, 72, coded);
+  memcpy(packed, coded, sizeof(coded));
+}
+
+// The JT9 interleaver: coded bit i goes to jtInterleave.dest[i], the
+// i-th 8-bit bit-reversed index below 206
+struct JTInterleaveTable {
+  uint8_t dest[jtCodedBits];
+};
+
+static constexpr JTInterleaveTable makeJTInterleave() {
+  JTInterleaveTable t{};
+  int p = 0;
+  for (int i = 0; i < 256 && p < jtCodedBits; ++i) {
+    uint8_t j = bitReverse8(i);
+    if (j < jtCodedBits) t.dest[p++] = j;
+  }
+  return t;
+}
+
+static constexpr JTInterleaveTable jtInterleave = makeJTInterleave();
+
+static void jtInterleaveBits(uint8_t packed[jtCodedBytes]) {
+  uint8_t d[jtCodedBytes] = {};
+  for (int i = 0; i < jtCodedBits; ++i) {
+    if (jtBit(packed, i)) d[jtInterleave.dest[i] >> 3] |= 0x80 >> (jtInterleave.dest[i] & 7);
+  }
+  memcpy(packed, d, sizeof(d));
+}
+
+// JT9 sync tones sit at these symbol positions
+static constexpr uint8_t jt9SyncPositions[16] = {0, 1, 4, 9, 15, 22, 32, 34, 50, 51, 54, 59, 65, 72, 82, 84};
 
 void JT9Encoder::encode(const char* message) {
-  printf("  [JT9] Encoding message: %s\n", message);
-  printf("  [JT9] Placeholder for JT9 encoding pipeline.\n");
+  runPipeline(message);
+}
+
+void JT9Encoder::packBits(const char* message) {
+  memset(packedData, 0, sizeof(packedData));
+  jtPackMessageBits(message, packedData);
+}
+
+void JT9Encoder::convolveSymbols() {
+  jtConvolve(packedData);
+}
+
+void JT9Encoder::interleave() {
+  jtInterleaveBits(packedData);
+}
+
+// Three interleaved bits per data symbol (the last padded with a zero),
+// Gray-coded and sent as tone 1 + symbol between the tone-0 sync symbols.
+void JT9Encoder::generateSync() {
+  int bit = 0, sync = 0;
+  for (int i = 0; i < TxBufferSize; ++i) {
+    if (sync < 16 && jt9SyncPositions[sync] == i) {
+      symbols[i] = 0;
+      ++sync;
+      continue;
+    }
+
+    uint8_t v = 0;
+    for (int k = 0; k < 3; ++k, ++bit) v = (v << 1) | (bit < jtCodedBits ? jtBit(packedData, bit) : 0);
+    symbols[i] = (v ^ (v >> 1)) + 1;
+  }
 }
+
 void JT4Encoder::encode(const char* message) {
   printf("  [JT4] Encoding message: %s\n", message);
   printf("  [JT4] Placeholder for JT4 encoding pipeline.\n");
 }
+
+// --- FST4WEncoder Implementation ---
+
+// Byte-at-a-time table for the FST4 CRC-24 (polynomial 0x100065B, MSB first)
+struct FST4CrcTable {
+  uint32_t entries[256];
+};
+
+static constexpr uint32_t fst4CrcPoly = 0x00065B;
+
+static constexpr uint32_t fst4CrcStep(uint32_t r) {
+  return ((r << 1) ^ ((r & 0x800000) ? fst4CrcPoly : 0)) & 0xFFFFFF;
+}
+
+static constexpr FST4CrcTable makeFST4CrcTable() {
+  FST4CrcTable table{};
+  for (int b = 0; b < 256; ++b) {
+    uint32_t r = (uint32_t) b << 16;
+    for (int k = 0; k < 8; ++k) r = fst4CrcStep(r);
+    table.entries[b] = r;
+  }
+  return table;
+}
+
+static constexpr FST4CrcTable fst4CrcTable = makeFST4CrcTable();
+
+// LDPC(240,101) generator rows packed as FT8's are: message bits 0..63 in
+// hi and 64..100 in the top of lo.
+//
+// These rows are placeholders, and the code shape is wrong too: WSJT-X
+// sends FST4W as LDPC(240,74), the 50-bit message plus a 24-bit CRC, and
+// neither that generator nor the CRC below has been checked against it.
+// WSJT-X cannot decode these frames, so findBeaconMode() never selects
+// FST4W until both are replaced and verified.
+struct FST4LdpcRows {
+  uint64_t hi[139];
+  uint64_t lo[139];
+};
+
+static constexpr uint64_t fst4LoMask = ~0ULL << (64 - 37);
+
+static constexpr FST4LdpcRows makeFST4LdpcRows() {
+  FST4LdpcRows rows{};
+  uint64_t x = 0x9E3779B97F4A7C15ULL;
+  for (int i = 0; i < 139; ++i) {
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rows.hi[i] = x * 0x2545F4914F6CDD1DULL;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rows.lo[i] = (x * 0x2545F4914F6CDD1DULL) & fst4LoMask;
+  }
+  return rows;
+}
+
+static constexpr FST4LdpcRows fst4LdpcRows = makeFST4LdpcRows();
+
+// Sync words sent at symbols 0, 38, 76, 114 and 152, alternating 1, 2, 1, 2, 1
+static constexpr uint8_t fst4Sync1[8] = {0, 1, 3, 2, 1, 0, 2, 3};
+static constexpr uint8_t fst4Sync2[8] = {2, 3, 1, 0, 3, 2, 0, 1};
+static constexpr uint8_t fst4GrayMap[4] = {0, 1, 3, 2};
+
+static_assert(FST4WEncoder::PackedBytes * 8 >= FST4WEncoder::CodewordBits, "FST4W keeps its codeword in packedData");
+static_assert(FST4WEncoder::DataSymbols + FST4WEncoder::SyncSymbols == FST4WEncoder::TxBufferSize,
+              "FST4W is 120 data and 40 sync symbols");
+
+void FST4WEncoder::encode(const char* callsign, const char* locator, int8_t powerDbm, WSPREncoder::MessageType type) {
+  runPipeline(callsign, locator, powerDbm, type);
+}
+
+uint32_t FST4WEncoder::crc24(const uint8_t payload[10]) {
+  uint32_t r = 0;
+  for (int i = 0; i < 9; ++i) r = ((r << 8) & 0xFFFFFF) ^ fst4CrcTable.entries[((r >> 16) ^ payload[i]) & 0xFF];
+
+  // Bits 72..76
+  for (int k = 0; k < 5; ++k) {
+    uint32_t in = (payload[9] >> (7 - k)) & 1;
+    r = fst4CrcStep(r ^ (in << 23));
+  }
+  return r;
+}
+
+void FST4WEncoder::encodeLdpc(const uint8_t message[13], uint8_t codeword[30]) {
+  // Bits past the 101st are ignored: the generator rows are zero there
+  uint64_t hi = ft8LoadWord(message, 8);
+  uint64_t lo = ft8LoadWord(message + 8, 5) & fst4LoMask;
+
+  memcpy(codeword, message, 13);
+  codeword[12] &= 0xF8;
+  memset(codeword + 13, 0, 17);
+
+  for (int i = 0; i < 139; ++i) {
+    int parity = __builtin_popcountll((hi & fst4LdpcRows.hi[i]) ^ (lo & fst4LdpcRows.lo[i])) & 1;
+    int bit = MessageBits + i;
+    codeword[bit >> 3] |= parity << (7 - (bit & 7));
+  }
+}
+
+// The 50-bit WSPR message, MSB first, then zeros to 77 bits
+bool FST4WEncoder::packBits(const char* callsign, const char* locator, int8_t powerDbm,
+                            WSPREncoder::MessageType type) {
+  if (!wsprCanPack(locator, type)) return false;
+  uint64_t n = wsprPackMessage(wsprMakeMessage(callsign, locator, powerDbm, type));
+  memset(packedData, 0, sizeof(packedData));
+  for (int i = 0; i < 7; ++i) packedData[i] = (uint8_t) ((n << 14) >> (56 - 8 * i));
+  return true;
+}
+
+// Appends the CRC-24 and replaces the payload in packedData with the
+// 240-bit LDPC codeword.
+void FST4WEncoder::computeFec() {
+  uint8_t a101[13];
+  uint32_t crc = crc24(packedData);
+
+  // CRC bits 77..100 follow the payload in the same bit stream
+  memcpy(a101, packedData, 10);
+  a101[9] = (packedData[9] & 0xF8) | (uint8_t) (crc >> 21);
+  a101[10] = (uint8_t) (crc >> 13);
+  a101[11] = (uint8_t) (crc >> 5);
+  a101[12] = (uint8_t) (crc << 3);
+
+  encodeLdpc(a101, packedData);
+}
+
+void FST4WEncoder::generateSync() {
+  int bit = 0;
+
+  for (int i = 0; i < TxBufferSize; ++i) {
+    int block = i / 38, offset = i % 38;
+    if (offset < 8 && block <= 4) {
+      symbols[i] = (block & 1) ? fst4Sync2[offset] : fst4Sync1[offset];
+    } else {
+      int pair = ((packedData[bit >> 3] >> (7 - (bit & 7))) & 1) << 1;
+      ++bit;
+      pair |= (packedData[bit >> 3] >> (7 - (bit & 7))) & 1;
+      ++bit;
+      symbols[i] = fst4GrayMap[pair];
+    }
+  }
+}
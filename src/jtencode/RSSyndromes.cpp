@@ -0,0 +1,164 @@
+#include "RSSyndromes.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RS_SYNDROMES_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define RS_SYNDROMES_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+static constexpr int Lanes = RSSyndromes::Lanes;
+
+// --- Scalar kernel: one codeword at a time ---
+
+static void syndromesScalar(const uint8_t* block, int length, const RSSyndromes::Point* points, int nroots,
+                            uint8_t* syn) {
+  for (int i = 0; i < nroots; ++i) {
+    const RSSyndromes::Point& p = points[i];
+    uint8_t s = 0;
+    for (int j = 0; j < length; ++j) s = p.lo[s & 0x0F] ^ p.hi[s >> 4] ^ block[j];
+    syn[i] = s;
+  }
+}
+
+// Gathers symbol j of Lanes consecutive codewords into one column
+static inline void gatherColumn(const uint8_t* blocks, int length, int j, uint8_t* column) {
+  for (int l = 0; l < Lanes; ++l) column[l] = blocks[(size_t) l * length + j];
+}
+
+// Scatters Lanes syndrome vectors back to per-codeword order
+static void scatterSyndromes(const uint8_t* state, int nroots, uint8_t* syn) {
+  for (int i = 0; i < nroots; ++i) {
+    for (int l = 0; l < Lanes; ++l) syn[l * nroots + i] = state[i * Lanes + l];
+  }
+}
+
+// --- AVX2 kernel: 32 codewords per register ---
+
+#ifdef RS_SYNDROMES_HAVE_AVX2
+__attribute__((target("avx2")))
+static void syndromesAvx2(const uint8_t* blocks, int length, const RSSyndromes::Point* points, int nroots,
+                          uint8_t* syn) {
+  alignas(32) uint8_t state[RSSyndromes::MaxRoots * Lanes] = {};
+  alignas(32) uint8_t column[Lanes];
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+  for (int j = 0; j < length; ++j) {
+    gatherColumn(blocks, length, j, column);
+    __m256i d = _mm256_load_si256((const __m256i*) column);
+
+    for (int i = 0; i < nroots; ++i) {
+      __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) points[i].lo));
+      __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) points[i].hi));
+      __m256i s = _mm256_load_si256((const __m256i*) (state + i * Lanes));
+
+      __m256i prod = _mm256_xor_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(s, nibble)),
+                                      _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(s, 4), nibble)));
+      _mm256_store_si256((__m256i*) (state + i * Lanes), _mm256_xor_si256(prod, d));
+    }
+  }
+
+  scatterSyndromes(state, nroots, syn);
+}
+#endif
+
+// --- NEON kernel: two 16-codeword registers ---
+
+#ifdef RS_SYNDROMES_HAVE_NEON
+static void syndromesNeon(const uint8_t* blocks, int length, const RSSyndromes::Point* points, int nroots,
+                          uint8_t* syn) {
+  uint8_t state[RSSyndromes::MaxRoots * Lanes] = {};
+  uint8_t column[Lanes];
+  const uint8x16_t nibble = vdupq_n_u8(0x0F);
+
+  for (int j = 0; j < length; ++j) {
+    gatherColumn(blocks, length, j, column);
+
+    for (int half = 0; half < Lanes; half += 16) {
+      uint8x16_t d = vld1q_u8(column + half);
+
+      for (int i = 0; i < nroots; ++i) {
+        uint8x16_t lo = vld1q_u8(points[i].lo);
+        uint8x16_t hi = vld1q_u8(points[i].hi);
+        uint8_t* sp = state + i * Lanes + half;
+        uint8x16_t s = vld1q_u8(sp);
+
+        uint8x16_t prod = veorq_u8(vqtbl1q_u8(lo, vandq_u8(s, nibble)), vqtbl1q_u8(hi, vshrq_n_u8(s, 4)));
+        vst1q_u8(sp, veorq_u8(prod, d));
+      }
+    }
+  }
+
+  scatterSyndromes(state, nroots, syn);
+}
+#endif
+
+// --- Dispatch ---
+
+bool RSSyndromes::isSupported(Isa isa) {
+  switch (isa) {
+  case Isa::SCALAR:
+    return true;
+  case Isa::AVX2:
+#ifdef RS_SYNDROMES_HAVE_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  case Isa::NEON:
+#ifdef RS_SYNDROMES_HAVE_NEON
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+RSSyndromes::Isa RSSyndromes::bestIsa() {
+  static const Isa best = isSupported(Isa::AVX2) ? Isa::AVX2 : (isSupported(Isa::NEON) ? Isa::NEON : Isa::SCALAR);
+  return best;
+}
+
+const char* RSSyndromes::isaName(Isa isa) {
+  switch (isa) {
+  case Isa::SCALAR: return "scalar";
+  case Isa::AVX2: return "avx2";
+  case Isa::NEON: return "neon";
+  }
+  return "unknown";
+}
+
+void RSSyndromes::compute(const uint8_t* blocks, size_t count, int length, const Point* points, int nroots,
+                          uint8_t* syn) {
+  compute(bestIsa(), blocks, count, length, points, nroots, syn);
+}
+
+void RSSyndromes::compute(Isa isa, const uint8_t* blocks, size_t count, int length, const Point* points,
+                          int nroots, uint8_t* syn) {
+  if (!isSupported(isa) || nroots > MaxRoots) isa = Isa::SCALAR;
+
+  void (*kernel)(const uint8_t*, int, const Point*, int, uint8_t*) = nullptr;
+#ifdef RS_SYNDROMES_HAVE_AVX2
+  if (isa == Isa::AVX2) kernel = syndromesAvx2;
+#endif
+#ifdef RS_SYNDROMES_HAVE_NEON
+  if (isa == Isa::NEON) kernel = syndromesNeon;
+#endif
+
+  size_t c = 0;
+  if (kernel) {
+    for (; c + Lanes <= count; c += Lanes) {
+      kernel(blocks + c * length, length, points, nroots, syn + c * nroots);
+    }
+  }
+
+  // Partial last group (or everything, for the scalar kernel)
+  for (; c < count; ++c) {
+    syndromesScalar(blocks + c * length, length, points, nroots, syn + c * nroots);
+  }
+}
@@ -0,0 +1,293 @@
+#include "WSPRBatchEncoder.h"
+#include "JTEncode.h"
+#include "WSPRPipeline.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WSPR_BATCH_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define WSPR_BATCH_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+static constexpr int Lanes = WSPRBatchEncoder::Lanes;
+static constexpr uint32_t G1 = jtConvPoly1, G2 = jtConvPoly2;
+
+// One block of messages in structure-of-arrays form. The kernels fill
+// dataMask with the 162 convolutional output bits in transmission order,
+// one bit per lane.
+struct WSPRBatchBlock {
+  uint32_t call[6][Lanes];   // wsprCharCode() of the normalized callsign
+  uint32_t loc[4][Lanes];    // field and square offsets from 'A' / '0'
+  uint32_t power[Lanes];     // rounded power in dBm
+  uint8_t dataMask[WSPRSymbolCount];
+};
+
+// Loads one message into its lane. Returns false for compound callsigns,
+// which are left to WSPREncoder.
+static bool gatherLane(WSPRBatchBlock& b, int lane, const char* callsign, const char* locator, int8_t powerDbm) {
+  char call[12];
+  int len = 0;
+
+  while (*callsign == ' ') ++callsign;
+  for (; len < (int) sizeof(call) - 1 && callsign[len] && callsign[len] != ' '; ++len) {
+    call[len] = wsprToUpper(callsign[len]);
+    if (call[len] == '/') return false;
+  }
+
+  char six[6];
+  wsprNormalizeCallsign(call, len, six);
+  for (int k = 0; k < 6; ++k) b.call[k][lane] = wsprCharCode(six[k]);
+
+  char grid[4] = {'A', 'A', '0', '0'};
+  for (int k = 0; k < 4 && locator[k]; ++k) grid[k] = wsprToUpper(locator[k]);
+  b.loc[0][lane] = grid[0] - 'A';
+  b.loc[1][lane] = grid[1] - 'A';
+  b.loc[2][lane] = grid[2] - '0';
+  b.loc[3][lane] = grid[3] - '0';
+
+  b.power[lane] = wsprPower(powerDbm);
+  return true;
+}
+
+static void clearLane(WSPRBatchBlock& b, int lane) {
+  for (int k = 0; k < 6; ++k) b.call[k][lane] = 0;
+  for (int k = 0; k < 4; ++k) b.loc[k][lane] = 0;
+  b.power[lane] = 0;
+}
+
+// --- Scalar kernel ---
+
+static void packConvolveScalar(WSPRBatchBlock& b) {
+  uint32_t nCall[Lanes], m[Lanes], reg[Lanes] = {};
+
+  for (int l = 0; l < Lanes; ++l) {
+    uint32_t n = b.call[0][l];
+    n = n * 36 + b.call[1][l];
+    n = n * 10 + b.call[2][l];
+    n = n * 27 + b.call[3][l] - 10;
+    n = n * 27 + b.call[4][l] - 10;
+    n = n * 27 + b.call[5][l] - 10;
+    nCall[l] = n;
+
+    uint32_t nLoc = (179 - 10 * b.loc[0][l] - b.loc[2][l]) * 180 + 10 * b.loc[1][l] + b.loc[3][l];
+    m[l] = nLoc * 128 + b.power[l] + 64;
+  }
+
+  for (int i = 0; i < 81; ++i) {
+    uint8_t mask1 = 0, mask2 = 0;
+
+    for (int l = 0; l < Lanes; ++l) {
+      uint32_t bit = i < 28 ? (nCall[l] >> (27 - i)) & 1 : (i < 50 ? (m[l] >> (49 - i)) & 1 : 0);
+      reg[l] = (reg[l] << 1) | bit;
+      mask1 |= __builtin_parity(reg[l] & G1) << l;
+      mask2 |= __builtin_parity(reg[l] & G2) << l;
+    }
+
+    b.dataMask[2 * i] = mask1;
+    b.dataMask[2 * i + 1] = mask2;
+  }
+}
+
+// --- AVX2 kernel: all eight lanes in one register ---
+
+#ifdef WSPR_BATCH_HAVE_AVX2
+__attribute__((target("avx2")))
+static inline uint8_t parityMaskAvx2(__m256i x) {
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 8));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 4));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 2));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 1));
+  return (uint8_t) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(x, 31)));
+}
+
+__attribute__((target("avx2")))
+static void packConvolveAvx2(WSPRBatchBlock& b) {
+#define LOAD(p) _mm256_loadu_si256((const __m256i*) (p))
+  const __m256i ten = _mm256_set1_epi32(10);
+  const __m256i one = _mm256_set1_epi32(1);
+
+  __m256i n = LOAD(b.call[0]);
+  n = _mm256_add_epi32(_mm256_mullo_epi32(n, _mm256_set1_epi32(36)), LOAD(b.call[1]));
+  n = _mm256_add_epi32(_mm256_mullo_epi32(n, ten), LOAD(b.call[2]));
+  for (int k = 3; k < 6; ++k) {
+    n = _mm256_sub_epi32(_mm256_add_epi32(_mm256_mullo_epi32(n, _mm256_set1_epi32(27)), LOAD(b.call[k])), ten);
+  }
+
+  __m256i nLoc = _mm256_sub_epi32(_mm256_set1_epi32(179),
+                                  _mm256_add_epi32(_mm256_mullo_epi32(LOAD(b.loc[0]), ten), LOAD(b.loc[2])));
+  nLoc = _mm256_mullo_epi32(nLoc, _mm256_set1_epi32(180));
+  nLoc = _mm256_add_epi32(nLoc, _mm256_add_epi32(_mm256_mullo_epi32(LOAD(b.loc[1]), ten), LOAD(b.loc[3])));
+  __m256i m = _mm256_add_epi32(_mm256_slli_epi32(nLoc, 7),
+                               _mm256_add_epi32(LOAD(b.power), _mm256_set1_epi32(64)));
+#undef LOAD
+
+  const __m256i g1 = _mm256_set1_epi32((int) G1);
+  const __m256i g2 = _mm256_set1_epi32((int) G2);
+  __m256i reg = _mm256_setzero_si256();
+
+  for (int i = 0; i < 81; ++i) {
+    __m256i bit = _mm256_setzero_si256();
+    if (i < 28) {
+      bit = _mm256_and_si256(_mm256_srl_epi32(n, _mm_cvtsi32_si128(27 - i)), one);
+    } else if (i < 50) {
+      bit = _mm256_and_si256(_mm256_srl_epi32(m, _mm_cvtsi32_si128(49 - i)), one);
+    }
+
+    reg = _mm256_or_si256(_mm256_slli_epi32(reg, 1), bit);
+    b.dataMask[2 * i] = parityMaskAvx2(_mm256_and_si256(reg, g1));
+    b.dataMask[2 * i + 1] = parityMaskAvx2(_mm256_and_si256(reg, g2));
+  }
+}
+#endif
+
+// --- NEON kernel: two four-lane registers ---
+
+#ifdef WSPR_BATCH_HAVE_NEON
+static inline uint32x4_t parityNeon(uint32x4_t x) {
+  x = veorq_u32(x, vshrq_n_u32(x, 16));
+  x = veorq_u32(x, vshrq_n_u32(x, 8));
+  x = veorq_u32(x, vshrq_n_u32(x, 4));
+  x = veorq_u32(x, vshrq_n_u32(x, 2));
+  x = veorq_u32(x, vshrq_n_u32(x, 1));
+  return vandq_u32(x, vdupq_n_u32(1));
+}
+
+static inline uint8_t parityMaskNeon(uint32x4_t lo, uint32x4_t hi) {
+  static const uint32_t weightsLo[4] = {1, 2, 4, 8};
+  static const uint32_t weightsHi[4] = {16, 32, 64, 128};
+  return (uint8_t) (vaddvq_u32(vmulq_u32(parityNeon(lo), vld1q_u32(weightsLo))) +
+                    vaddvq_u32(vmulq_u32(parityNeon(hi), vld1q_u32(weightsHi))));
+}
+
+static void packConvolveNeon(WSPRBatchBlock& b) {
+  uint32x4_t n[2], m[2], reg[2];
+
+  for (int h = 0; h < 2; ++h) {
+    const int o = 4 * h;
+    uint32x4_t v = vld1q_u32(&b.call[0][o]);
+    v = vmlaq_n_u32(vld1q_u32(&b.call[1][o]), v, 36);
+    v = vmlaq_n_u32(vld1q_u32(&b.call[2][o]), v, 10);
+    for (int k = 3; k < 6; ++k) {
+      v = vsubq_u32(vmlaq_n_u32(vld1q_u32(&b.call[k][o]), v, 27), vdupq_n_u32(10));
+    }
+    n[h] = v;
+
+    uint32x4_t nLoc = vsubq_u32(vdupq_n_u32(179),
+                                vmlaq_n_u32(vld1q_u32(&b.loc[2][o]), vld1q_u32(&b.loc[0][o]), 10));
+    nLoc = vmlaq_n_u32(vmlaq_n_u32(vld1q_u32(&b.loc[3][o]), vld1q_u32(&b.loc[1][o]), 10), nLoc, 180);
+    m[h] = vaddq_u32(vshlq_n_u32(nLoc, 7), vaddq_u32(vld1q_u32(&b.power[o]), vdupq_n_u32(64)));
+    reg[h] = vdupq_n_u32(0);
+  }
+
+  const uint32x4_t g1 = vdupq_n_u32(G1), g2 = vdupq_n_u32(G2), one = vdupq_n_u32(1);
+
+  for (int i = 0; i < 81; ++i) {
+    for (int h = 0; h < 2; ++h) {
+      uint32x4_t bit = vdupq_n_u32(0);
+      if (i < 28) {
+        bit = vandq_u32(vshlq_u32(n[h], vdupq_n_s32(i - 27)), one);
+      } else if (i < 50) {
+        bit = vandq_u32(vshlq_u32(m[h], vdupq_n_s32(i - 49)), one);
+      }
+      reg[h] = vorrq_u32(vshlq_n_u32(reg[h], 1), bit);
+    }
+
+    b.dataMask[2 * i] = parityMaskNeon(vandq_u32(reg[0], g1), vandq_u32(reg[1], g1));
+    b.dataMask[2 * i + 1] = parityMaskNeon(vandq_u32(reg[0], g2), vandq_u32(reg[1], g2));
+  }
+}
+#endif
+
+// --- Dispatch ---
+
+bool WSPRBatchEncoder::isSupported(Isa isa) {
+  switch (isa) {
+  case Isa::SCALAR:
+    return true;
+  case Isa::AVX2:
+#ifdef WSPR_BATCH_HAVE_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  case Isa::NEON:
+#ifdef WSPR_BATCH_HAVE_NEON
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+WSPRBatchEncoder::Isa WSPRBatchEncoder::bestIsa() {
+  static const Isa best = isSupported(Isa::AVX2) ? Isa::AVX2 : (isSupported(Isa::NEON) ? Isa::NEON : Isa::SCALAR);
+  return best;
+}
+
+const char* WSPRBatchEncoder::isaName(Isa isa) {
+  switch (isa) {
+  case Isa::SCALAR: return "scalar";
+  case Isa::AVX2: return "avx2";
+  case Isa::NEON: return "neon";
+  }
+  return "unknown";
+}
+
+void WSPRBatchEncoder::encode(const char* const* callsigns, const char* const* locators,
+                              const int8_t* powerDbm, size_t count, uint8_t* out) {
+  encode(bestIsa(), callsigns, locators, powerDbm, count, out);
+}
+
+void WSPRBatchEncoder::encode(Isa isa, const char* const* callsigns, const char* const* locators,
+                              const int8_t* powerDbm, size_t count, uint8_t* out) {
+  if (!isSupported(isa)) isa = Isa::SCALAR;
+
+  void (*kernel)(WSPRBatchBlock&) = packConvolveScalar;
+#ifdef WSPR_BATCH_HAVE_AVX2
+  if (isa == Isa::AVX2) kernel = packConvolveAvx2;
+#endif
+#ifdef WSPR_BATCH_HAVE_NEON
+  if (isa == Isa::NEON) kernel = packConvolveNeon;
+#endif
+
+  WSPRBatchBlock block;
+
+  for (size_t base = 0; base < count; base += Lanes) {
+    int active = count - base < (size_t) Lanes ? (int) (count - base) : Lanes;
+    uint8_t vectorLanes = 0;
+
+    for (int l = 0; l < Lanes; ++l) {
+      size_t idx = base + l;
+      if (l < active && gatherLane(block, l, callsigns[idx], locators[idx], powerDbm[idx])) {
+        vectorLanes |= 1 << l;
+      } else {
+        clearLane(block, l);
+      }
+    }
+
+    if (vectorLanes) kernel(block);
+
+    for (int l = 0; l < active; ++l) {
+      size_t idx = base + l;
+      uint8_t* symbols = out + idx * WSPRSymbolCount;
+
+      if (vectorLanes & (1 << l)) {
+        for (int p = 0; p < WSPRSymbolCount; ++p) {
+          uint8_t dest = wsprInterleave.dest[p];
+          symbols[dest] = wsprSync[dest] + 2 * ((block.dataMask[p] >> l) & 1);
+        }
+      } else {
+        // Compound callsign: Type 2 packing is string work, not lane work
+        WSPREncoder encoder;
+        encoder.encode(callsigns[idx], locators[idx], powerDbm[idx]);
+        memcpy(symbols, encoder.symbols, WSPRSymbolCount);
+      }
+    }
+  }
+}
@@ -0,0 +1,494 @@
+#include "WSPRDecoder.h"
+#include "WSPRPipeline.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr int Decimation = 32;                     // 12 kHz -> 375 Hz
+static constexpr int BasebandPerSymbol = WSPRDecoder::SamplesPerSymbol / Decimation;
+static constexpr int BlockSamples = 32;                   // baseband samples per lag step
+static constexpr int BlocksPerSymbol = BasebandPerSymbol / BlockSamples;
+static constexpr int FreqSteps = 4;                       // frequency grid per tone spacing
+static constexpr double BasebandRate = (double) WSPRDecoder::SampleRate / Decimation;
+static constexpr double TwoPi = 6.283185307179586;
+
+// Soft bits are 128 + SoftScale * (normalized bit amplitude)
+static constexpr float SoftScale = 50.0f;
+
+// --- Vector helpers ---
+
+typedef float v4f __attribute__((vector_size(16)));
+
+static inline v4f load4(const float* p) {
+  v4f v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline float sum4(v4f v) {
+  return v[0] + v[1] + v[2] + v[3];
+}
+
+// Rotates 32 complex samples by the conjugate of (c + js) and sums them
+static inline void rotateSum32(const float* xr, const float* xi, const float* c, const float* s, float& re,
+                               float& im) {
+  v4f accRe = {0, 0, 0, 0}, accIm = {0, 0, 0, 0};
+  for (int i = 0; i < 32; i += 4) {
+    v4f r = load4(xr + i), q = load4(xi + i), cv = load4(c + i), sv = load4(s + i);
+    accRe += r * cv + q * sv;
+    accIm += q * cv - r * sv;
+  }
+  re = sum4(accRe);
+  im = sum4(accIm);
+}
+
+// cos/sin of 2 pi f i / rate for i = 0..31
+struct Rotation32 {
+  float c[32];
+  float s[32];
+
+  void set(double f, double rate) {
+    for (int i = 0; i < 32; ++i) {
+      c[i] = (float) cos(TwoPi * f * i / rate);
+      s[i] = (float) sin(TwoPi * f * i / rate);
+    }
+  }
+};
+
+// Multiplies (re, im) by e^(-j phase)
+static inline void rotate(float& re, float& im, double phase) {
+  float c = (float) cos(phase), s = (float) sin(phase);
+  float r = re * c + im * s;
+  im = im * c - re * s;
+  re = r;
+}
+
+// --- Demodulation ---
+
+// Mixes audio down by centerHz and sums 32-sample groups: complex baseband
+// at 375 Hz. The sum is a crude low-pass, plenty for a 6 Hz wide signal.
+static void downconvert(const float* audio, size_t samples, double centerHz, std::vector<float>& re,
+                        std::vector<float>& im) {
+  const size_t n = samples / Decimation;
+  re.resize(n);
+  im.resize(n);
+
+  Rotation32 rot;
+  rot.set(centerHz, WSPRDecoder::SampleRate);
+  static const float zeros[32] = {};
+
+  for (size_t b = 0; b < n; ++b) {
+    float r, q;
+    rotateSum32(audio + b * Decimation, zeros, rot.c, rot.s, r, q);
+    rotate(r, q, TwoPi * centerHz * (double) (b * Decimation) / WSPRDecoder::SampleRate);
+    re[b] = r;
+    im[b] = q;
+  }
+}
+
+// Tone power over one symbol for every lag: power[lag] for the symbol that
+// starts at block lag, at baseband frequency f.
+static void tonePowers(const std::vector<float>& re, const std::vector<float>& im, double f, size_t blocks,
+                       std::vector<float>& power) {
+  std::vector<float> blockRe(blocks), blockIm(blocks);
+  Rotation32 rot;
+  rot.set(f, BasebandRate);
+
+  for (size_t b = 0; b < blocks; ++b) {
+    float r, q;
+    rotateSum32(&re[b * BlockSamples], &im[b * BlockSamples], rot.c, rot.s, r, q);
+    rotate(r, q, TwoPi * f * (double) (b * BlockSamples) / BasebandRate);
+    blockRe[b] = r;
+    blockIm[b] = q;
+  }
+
+  power.assign(blocks >= BlocksPerSymbol ? blocks - BlocksPerSymbol + 1 : 0, 0.0f);
+  float sr = 0, si = 0;
+  for (size_t b = 0; b < blocks; ++b) {
+    sr += blockRe[b];
+    si += blockIm[b];
+    if (b >= BlocksPerSymbol) {
+      sr -= blockRe[b - BlocksPerSymbol];
+      si -= blockIm[b - BlocksPerSymbol];
+    }
+    if (b + 1 >= BlocksPerSymbol) power[b + 1 - BlocksPerSymbol] = sr * sr + si * si;
+  }
+}
+
+// Soft data bits from per-symbol tone amplitudes, normalized to unit RMS
+static void softBits(const float amplitude[][4], uint8_t soft[WSPRSymbolCount]) {
+  float v[WSPRSymbolCount];
+  double energy = 0;
+  for (int k = 0; k < WSPRSymbolCount; ++k) {
+    v[k] = (amplitude[k][2] + amplitude[k][3]) - (amplitude[k][0] + amplitude[k][1]);
+    energy += v[k] * v[k];
+  }
+  float norm = energy > 0 ? SoftScale / (float) sqrt(energy / WSPRSymbolCount) : 0;
+
+  for (int k = 0; k < WSPRSymbolCount; ++k) {
+    float y = 128.0f + v[k] * norm;
+    soft[k] = (uint8_t) (y < 0 ? 0 : y > 255 ? 255 : lrintf(y));
+  }
+}
+
+// --- Fano decoder ---
+
+// Fano metric for each soft value, scaled by 10: log2 of the likelihood
+// ratio against an even mix of both bits, less a bias near the code rate.
+// Soft values are assumed Gaussian around 128 +/- 0.8 * SoftScale.
+struct FanoMetrics {
+  int m[2][256];
+
+  FanoMetrics() {
+    const double mean = 0.8, sigma = 0.6, bias = 0.45;
+    for (int y = 0; y < 256; ++y) {
+      double v = (y - 128) / (double) SoftScale;
+      double p1 = exp(-(v - mean) * (v - mean) / (2 * sigma * sigma));
+      double p0 = exp(-(v + mean) * (v + mean) / (2 * sigma * sigma));
+      double mix = (p0 + p1) / 2;
+      m[1][y] = (int) lrint(fmax(-128.0, 10 * (log2(p1 / mix) - bias)));
+      m[0][y] = (int) lrint(fmax(-128.0, 10 * (log2(p0 / mix) - bias)));
+    }
+  }
+};
+
+static const FanoMetrics& fanoMetrics() {
+  static const FanoMetrics metrics;
+  return metrics;
+}
+
+static inline int encodePair(uint32_t state) {
+  return (__builtin_parity(state & jtConvPoly1) << 1) | __builtin_parity(state & jtConvPoly2);
+}
+
+// Karn's sequential decoder: walk the code tree, keeping the best branch at
+// each node while the path metric stays above a moving threshold, and back
+// up to try the other branch when it does not. The 31 tail bits are known
+// to be zero, so tail nodes have one branch.
+bool WSPRDecoder::fano(const uint8_t soft[WSPRSymbolCount], uint8_t message[7], uint32_t maxCycles,
+                       uint32_t* cycles) {
+  struct Node {
+    uint32_t state;     // encoder register with this node's bit in bit 0
+    int gamma;          // path metric to this node
+    int branch[4];      // metric of each output pair
+    int tm[2];          // metrics of the best and second branch
+    int i;              // branch being tried
+  };
+
+  const FanoMetrics& mt = fanoMetrics();
+  const int delta = 60;
+  const int nbits = CodedBits;
+  Node nodes[CodedBits + 1];
+  Node* const tail = &nodes[nbits - 31];
+  Node* const last = &nodes[nbits - 1];
+
+  for (int k = 0; k < nbits; ++k) {
+    const uint8_t s0 = soft[2 * k], s1 = soft[2 * k + 1];
+    nodes[k].branch[0] = mt.m[0][s0] + mt.m[0][s1];
+    nodes[k].branch[1] = mt.m[0][s0] + mt.m[1][s1];
+    nodes[k].branch[2] = mt.m[1][s0] + mt.m[0][s1];
+    nodes[k].branch[3] = mt.m[1][s0] + mt.m[1][s1];
+  }
+
+  Node* np = nodes;
+  np->state = 0;
+  int sym = encodePair(np->state);
+  np->tm[0] = np->branch[sym];
+  np->tm[1] = np->branch[3 ^ sym];
+  if (np->tm[0] < np->tm[1]) {
+    std::swap(np->tm[0], np->tm[1]);
+    np->state |= 1;
+  }
+  np->i = 0;
+  np->gamma = 0;
+  int t = 0;
+
+  uint32_t n = 1;
+  for (; n <= maxCycles; ++n) {
+    int ngamma = np->gamma + np->tm[np->i];
+    if (ngamma >= t) {
+      // Tighten the threshold on a first visit
+      if (np->gamma < t + delta) {
+        while (ngamma >= t + delta) t += delta;
+      }
+      np[1].gamma = ngamma;
+      np[1].state = np->state << 1;
+      if (++np == last + 1) break;
+
+      sym = encodePair(np->state);
+      if (np >= tail) {
+        np->tm[0] = np->branch[sym];
+      } else {
+        np->tm[0] = np->branch[sym];
+        np->tm[1] = np->branch[3 ^ sym];
+        if (np->tm[0] < np->tm[1]) {
+          std::swap(np->tm[0], np->tm[1]);
+          np->state |= 1;
+        }
+      }
+      np->i = 0;
+      continue;
+    }
+
+    // Threshold violated: back up, or relax the threshold if we cannot
+    for (;;) {
+      if (np == nodes || np[-1].gamma < t) {
+        t -= delta;
+        if (np->i != 0) {
+          np->i = 0;
+          np->state ^= 1;
+        }
+        break;
+      }
+      if (--np < tail && np->i != 1) {
+        ++np->i;
+        np->state ^= 1;
+        break;
+      }
+    }
+  }
+
+  if (cycles) *cycles = n;
+  if (n > maxCycles) return false;
+
+  // Bit k is bit 0 of node k's state, so node 8j + 7 holds byte j
+  for (int j = 0; j < 7; ++j) message[j] = (uint8_t) nodes[8 * j + 7].state;
+  message[6] &= 0xC0;
+  return true;
+}
+
+void WSPRDecoder::deinterleave(const uint8_t soft[WSPRSymbolCount], uint8_t out[WSPRSymbolCount]) {
+  for (int i = 0; i < WSPRSymbolCount; ++i) out[i] = soft[wsprInterleave.dest[i]];
+}
+
+// --- Unpacking ---
+
+static char wsprCodeChar(int code) {
+  return code < 10 ? '0' + code : code < 36 ? 'A' + code - 10 : ' ';
+}
+
+// Inverse of wsprPackCallsign(): six characters, spaces kept
+static bool unpackCallField(uint32_t n, char c[6]) {
+  if (n >= 262177560) return false;   // 37 * 36 * 10 * 27^3
+  for (int i = 5; i >= 3; --i) {
+    c[i] = wsprCodeChar(n % 27 + 10);
+    n /= 27;
+  }
+  c[2] = wsprCodeChar(n % 10);
+  n /= 10;
+  c[1] = wsprCodeChar(n % 36);
+  c[0] = wsprCodeChar(n / 36);
+  return true;
+}
+
+// Copies the non-space characters of a field
+static void trimField(const char* field, int len, char* out) {
+  int o = 0;
+  for (int i = 0; i < len; ++i) {
+    if (field[i] != ' ') out[o++] = field[i];
+  }
+  out[o] = '\0';
+}
+
+static bool validPower(int dbm) {
+  int units = dbm % 10;
+  return dbm >= 0 && dbm <= 60 && (units == 0 || units == 3 || units == 7);
+}
+
+bool WSPRDecoder::unpack(const uint8_t message[7], WSPRDecodeResult& result) {
+  uint64_t v = 0;
+  for (int i = 0; i < 7; ++i) v = (v << 8) | message[i];
+  v >>= 6;
+
+  const uint32_t nCall = (uint32_t) (v >> 22);
+  const uint32_t m = (uint32_t) (v & 0x3FFFFF);
+  const int t = (int) (m & 127) - 64;
+
+  result.callsign[0] = '\0';
+  result.locator[0] = '\0';
+  result.hash = 0;
+
+  char field[6];
+  if (!unpackCallField(nCall, field)) return false;
+
+  if (t < 0) {
+    // Type 3: hash, the 6-character locator rotated into the callsign field
+    result.type = WSPREncoder::TYPE3;
+    result.powerDbm = (int8_t) (-(t + 1));
+    result.hash = (uint16_t) (m >> 7);
+    result.locator[0] = field[5];
+    memcpy(result.locator + 1, field, 5);
+    result.locator[6] = '\0';
+    return validPower(result.powerDbm);
+  }
+
+  char base[7];
+  trimField(field, 6, base);
+  const int units = t % 10;
+
+  if (units == 0 || units == 3 || units == 7) {
+    // Type 1: locator and power
+    const uint32_t nLoc = m >> 7;
+    if (nLoc >= 180 * 180) return false;
+    const int lon = 179 - nLoc / 180, lat = nLoc % 180;
+    result.type = WSPREncoder::TYPE1;
+    result.locator[0] = 'A' + lon / 10;
+    result.locator[1] = 'A' + lat / 10;
+    result.locator[2] = '0' + lon % 10;
+    result.locator[3] = '0' + lat % 10;
+    result.locator[4] = '\0';
+    result.powerDbm = (int8_t) t;
+    strcpy(result.callsign, base);
+    return validPower(t) && lon / 10 < 18 && lat / 10 < 18;
+  }
+
+  // Type 2: prefix or suffix in place of the locator. Power + 1 + nAdd
+  // lands on 1/2, 4/5 or 8/9.
+  const int nAdd = (units == 2 || units == 5 || units == 9) ? 1 : 0;
+  const uint32_t ng = (m >> 7) + 32768 * nAdd;
+  result.type = WSPREncoder::TYPE2;
+  result.powerDbm = (int8_t) (t - 1 - nAdd);
+
+  char affix[4] = {};
+  if (ng < 60000) {
+    // Prefix of up to three characters
+    char p[3] = {wsprCodeChar(ng / 1369), wsprCodeChar(ng / 37 % 37), wsprCodeChar(ng % 37)};
+    if (ng / 1369 > 36) return false;
+    trimField(p, 3, affix);
+    snprintf(result.callsign, sizeof(result.callsign), "%s/%s", affix, base);
+  } else {
+    const uint32_t code = ng - 60000;
+    if (code < 36) affix[0] = wsprCodeChar(code);
+    else if (code <= 125) snprintf(affix, sizeof(affix), "%02u", code - 26);
+    else return false;
+    snprintf(result.callsign, sizeof(result.callsign), "%s/%s", base, affix);
+  }
+  return validPower(result.powerDbm);
+}
+
+// --- Top level ---
+
+static bool decodeSoft(const uint8_t soft[WSPRSymbolCount], WSPRDecodeResult& result,
+                       const WSPRDecoder::Options& options) {
+  uint8_t ordered[WSPRSymbolCount];
+  uint8_t message[7];
+  WSPRDecoder::deinterleave(soft, ordered);
+
+  result.ok = WSPRDecoder::fano(ordered, message, options.maxCyclesPerBit * WSPRDecoder::CodedBits,
+                                &result.fanoCycles) &&
+              WSPRDecoder::unpack(message, result);
+  return result.ok;
+}
+
+bool WSPRDecoder::decodeSymbols(const uint8_t symbols[WSPRSymbolCount], WSPRDecodeResult& result,
+                                const Options& options) {
+  float amplitude[WSPRSymbolCount][4] = {};
+  uint8_t soft[WSPRSymbolCount];
+  for (int k = 0; k < WSPRSymbolCount; ++k) amplitude[k][symbols[k] & 3] = 1.0f;
+  softBits(amplitude, soft);
+
+  int syncMatches = 0;
+  for (int k = 0; k < WSPRSymbolCount; ++k) syncMatches += (symbols[k] & 1) == wsprSync[k];
+
+  memset(&result, 0, sizeof(result));
+  result.syncQuality = (float) syncMatches / WSPRSymbolCount;
+  return decodeSoft(soft, result, options);
+}
+
+bool WSPRDecoder::decodeAudio(const float* audio, size_t samples, WSPRDecodeResult& result,
+                              const Options& options) {
+  memset(&result, 0, sizeof(result));
+
+  std::vector<float> re, im;
+  downconvert(audio, samples, options.centerHz, re, im);
+
+  const size_t blocks = re.size() / BlockSamples;
+  const size_t frameBlocks = (size_t) WSPRSymbolCount * BlocksPerSymbol;
+  if (blocks < frameBlocks) return false;
+  const size_t lags = blocks - frameBlocks + 1;
+
+  // Frequency grid in quarter tone spacings: offsets -range..range, plus
+  // 3 tone spacings for the upper tones
+  const double step = ToneSpacingHz / FreqSteps;
+  const int range = (int) ceil(options.freqRangeHz / step);
+  const int freqs = 2 * range + 1 + 3 * FreqSteps;
+  std::vector<std::vector<float>> power(freqs);
+  for (int f = 0; f < freqs; ++f) {
+    tonePowers(re, im, (f - range) * step - 1.5 * ToneSpacingHz, blocks, power[f]);
+  }
+
+  // The candidate whose tones' low bits best follow the sync vector
+  float best = -1;
+  int bestOffset = 0;
+  size_t bestLag = 0;
+  for (int d = 0; d <= 2 * range; ++d) {
+    for (size_t lag = 0; lag < lags; ++lag) {
+      float sync = 0, total = 0;
+      for (int k = 0; k < WSPRSymbolCount; ++k) {
+        const size_t at = lag + (size_t) k * BlocksPerSymbol;
+        float p0 = power[d][at], p1 = power[d + FreqSteps][at];
+        float p2 = power[d + 2 * FreqSteps][at], p3 = power[d + 3 * FreqSteps][at];
+        float odd = p1 + p3, even = p0 + p2;
+        sync += wsprSync[k] ? odd - even : even - odd;
+        total += odd + even;
+      }
+      float quality = total > 0 ? sync / total : 0;
+      if (quality > best) {
+        best = quality;
+        bestOffset = d;
+        bestLag = lag;
+      }
+    }
+  }
+
+  float amplitude[WSPRSymbolCount][4];
+  for (int k = 0; k < WSPRSymbolCount; ++k) {
+    const size_t at = bestLag + (size_t) k * BlocksPerSymbol;
+    for (int tone = 0; tone < 4; ++tone) amplitude[k][tone] = sqrtf(power[bestOffset + tone * FreqSteps][at]);
+  }
+
+  uint8_t soft[WSPRSymbolCount];
+  softBits(amplitude, soft);
+
+  result.freqOffsetHz = (float) ((bestOffset - range) * step);
+  result.timeOffsetSec = (float) (bestLag * BlockSamples * Decimation) / SampleRate;
+  result.syncQuality = best;
+  return decodeSoft(soft, result, options);
+}
+
+size_t WSPRDecoder::decodeBatch(const float* const* audio, size_t samples, size_t count, WSPRDecodeResult* results,
+                                unsigned threads, const Options& options) {
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+  if (threads > count) threads = (unsigned) count;
+
+  std::atomic<size_t> next(0), decoded(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      if (decodeAudio(audio[i], samples, results[i], options)) ++decoded;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();
+  for (std::thread& t : pool) t.join();
+  return decoded;
+}
+
+void WSPRDecoder::synthesize(const uint8_t symbols[WSPRSymbolCount], float* audio, size_t samples,
+                             size_t startSample, double centerHz, float amplitude) {
+  double phase = 0;
+  for (int k = 0; k < WSPRSymbolCount; ++k) {
+    const double dphi = TwoPi * (centerHz + ((symbols[k] & 3) - 1.5) * ToneSpacingHz) / SampleRate;
+    for (int i = 0; i < SamplesPerSymbol; ++i) {
+      const size_t n = startSample + (size_t) k * SamplesPerSymbol + i;
+      if (n < samples) audio[n] += amplitude * (float) sin(phase);
+      phase += dphi;
+    }
+    phase = fmod(phase, TwoPi);
+  }
+}
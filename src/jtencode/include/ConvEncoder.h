@@ -0,0 +1,146 @@
+#ifndef CONV_ENCODER_H
+#define CONV_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Table-driven rate 1/2 convolutional encoder.
+ *
+ * Each output bit is the parity of the shift register ANDed with a
+ * polynomial. That parity is linear in the register, so the 2 * ChunkBits
+ * output bits for a chunk of ChunkBits input bits are the XOR of one table
+ * entry per ChunkBits-wide slice of the previous K - 1 bits plus the new
+ * chunk. The compiler builds the tables. ChunkBits 4 gives 16-entry nibble
+ * tables, which is small enough for any flash budget. ChunkBits 8 gives
+ * 256-entry byte tables, which are faster. Input and output are packed
+ * MSB first, and each input bit produces a Poly1 bit followed by a Poly2 bit.
+ */
+template<int K, uint32_t Poly1, uint32_t Poly2, int ChunkBits = 8>
+class ConvEncoder {
+public:
+  static constexpr int TailBits = K - 1;
+  static constexpr int Lanes = (K - 1 + ChunkBits + ChunkBits - 1) / ChunkBits;
+
+  static_assert(K >= 2 && K <= 32, "ConvEncoder registers are at most 32 bits");
+  static_assert(ChunkBits == 4 || ChunkBits == 8, "ConvEncoder works a nibble or a byte at a time");
+
+  // Output bits for inputBits message bits plus the zero tail
+  static constexpr int outputBits(int inputBits) { return 2 * (inputBits + TailBits); }
+
+  // Bytes encode() writes, rounded up to whole chunks
+  static constexpr int outputBytes(int inputBits) {
+    return (inputBits + TailBits + ChunkBits - 1) / ChunkBits * ChunkBits / 4;
+  }
+
+  struct Tables {
+    uint16_t out[Lanes][1 << ChunkBits];   // out[lane][v] = output for v at slice lane
+  };
+
+  static constexpr Tables makeTables() {
+    Tables t{};
+    for (int lane = 0; lane < Lanes; ++lane) {
+      for (int v = 0; v < (1 << ChunkBits); ++v) t.out[lane][v] = chunkOutput((uint64_t) v << (lane * ChunkBits));
+    }
+    return t;
+  }
+
+  static constexpr Tables tables = makeTables();
+
+  // Encodes inputBits bits of data followed by K - 1 zero tail bits into
+  // outputBytes(inputBits) bytes of packed output. Bits past
+  // outputBits(inputBits) are zero.
+  static constexpr void encode(const uint8_t* data, int inputBits, uint8_t* out) {
+    const int chunks = (inputBits + TailBits + ChunkBits - 1) / ChunkBits;
+    uint64_t hist = 0;
+
+    for (int c = 0; c < chunks; ++c) {
+      uint16_t bits = step(hist, inputChunk(data, inputBits, c));
+      if (ChunkBits == 8) {
+        out[2 * c] = bits >> 8;
+        out[2 * c + 1] = bits & 0xFF;
+      } else {
+        out[c] = (uint8_t) bits;
+      }
+    }
+
+    // Clear what the padding bits of the last chunk produced
+    const int outBits = outputBits(inputBits);
+    if (outBits & 7) out[outBits >> 3] &= 0xFF << (8 - (outBits & 7));
+    for (int i = (outBits + 7) >> 3; i < outputBytes(inputBits); ++i) out[i] = 0;
+  }
+
+  // As encode() with one output bit per byte, for pipelines that
+  // interleave bit by bit. bits receives outputBits(inputBits) entries.
+  static constexpr void encodeBits(const uint8_t* data, int inputBits, uint8_t* bits) {
+    const int outBits = outputBits(inputBits);
+    uint64_t hist = 0;
+
+    for (int c = 0, p = 0; p < outBits; ++c) {
+      uint16_t chunk = step(hist, inputChunk(data, inputBits, c));
+      for (int j = 2 * ChunkBits - 1; j >= 0 && p < outBits; --j) bits[p++] = (chunk >> j) & 1;
+    }
+  }
+
+  // Bit-at-a-time reference: the register shifts left and the new bit
+  // enters at bit 0.
+  static constexpr void encodeReference(const uint8_t* data, int inputBits, uint8_t* bits) {
+    uint32_t reg = 0;
+    for (int i = 0; i < inputBits + TailBits; ++i) {
+      uint32_t bit = i < inputBits ? (data[i >> 3] >> (7 - (i & 7))) & 1 : 0;
+      reg = (reg << 1) | bit;
+      bits[2 * i] = parity(reg & Poly1 & regMask);
+      bits[2 * i + 1] = parity(reg & Poly2 & regMask);
+    }
+  }
+
+private:
+  static constexpr uint32_t regMask = K == 32 ? 0xFFFFFFFFu : (1u << K) - 1;
+
+  static constexpr uint8_t parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+  }
+
+  // Output bits for a window of K - 1 history bits above ChunkBits new bits
+  static constexpr uint16_t chunkOutput(uint64_t window) {
+    uint16_t bits = 0;
+    for (int j = 0; j < ChunkBits; ++j) {
+      uint32_t reg = (uint32_t) (window >> (ChunkBits - 1 - j)) & regMask;
+      bits = (bits << 2) | (parity(reg & Poly1) << 1) | parity(reg & Poly2);
+    }
+    return bits;
+  }
+
+  // Shifts one chunk into the history and returns its 2 * ChunkBits output bits
+  static constexpr uint16_t step(uint64_t& hist, uint32_t chunk) {
+    uint64_t window = (hist << ChunkBits) | chunk;
+    uint16_t bits = 0;
+    for (int lane = 0; lane < Lanes; ++lane) {
+      bits ^= tables.out[lane][(window >> (lane * ChunkBits)) & ((1 << ChunkBits) - 1)];
+    }
+    hist = window & (((uint64_t) 1 << TailBits) - 1);
+    return bits;
+  }
+
+  // Chunk c of the message bits followed by zeros. Chunks never straddle bytes.
+  static constexpr uint32_t inputChunk(const uint8_t* data, int inputBits, int c) {
+    int start = c * ChunkBits;
+    if (start >= inputBits) return 0;
+    uint32_t v = (data[start >> 3] >> (8 - ChunkBits - (start & 7))) & ((1 << ChunkBits) - 1);
+    if (start + ChunkBits > inputBits) v &= ((1 << ChunkBits) - 1) << (start + ChunkBits - inputBits);
+    return v;
+  }
+};
+
+// The K=32, r=1/2 code WSPR, JT9 and JT4 share (Layland-Lushbaugh polynomials)
+inline constexpr uint32_t jtConvPoly1 = 0xF2D05351;
+inline constexpr uint32_t jtConvPoly2 = 0xE4613C47;
+
+using JTConvEncoder = ConvEncoder<32, jtConvPoly1, jtConvPoly2>;
+
+#endif // CONV_ENCODER_H
@@ -2,101 +2,223 @@
 #define JT_ENCODE_H
 
 #include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "SymbolFrame.h"
 
 /**
- * @brief Base class for JT/WSPR/FT8 encoders.
+ * @brief Static-dispatch base for the JT/WSPR/FT8 encoders.
+ *
+ * Each mode derives from JTEncoder<Mode, ...> (CRTP). The template
+ * arguments fix its tone spacing, symbol period, symbol count and the size
+ * of the scratch buffer its stages share. runPipeline() calls the stages in
+ * a fixed order. A mode replaces the ones it needs by declaring a member of
+ * the same name, and the empty defaults inline away, so there is no vtable
+ * and every stage can be inlined. Use frame() to hand the result to code
+ * that should not know the mode.
  */
-template<uint16_t TONE_SPACING, uint16_t SYMBOL_PERIOD_MS, uint32_t DEFAULT_FREQ, int TX_BUFFER_SIZE>
+template<typename Mode, uint16_t TONE_SPACING, uint16_t SYMBOL_PERIOD_MS, uint32_t DEFAULT_FREQ,
+         int TX_BUFFER_SIZE, uint8_t TONE_COUNT, int PACKED_BYTES>
 class JTEncoder {
 public:
   static constexpr uint16_t ToneSpacing = TONE_SPACING;
   static constexpr uint16_t SymbolPeriod = SYMBOL_PERIOD_MS;
   static constexpr int TxBufferSize = TX_BUFFER_SIZE;
-  
+  static constexpr uint8_t ToneCount = TONE_COUNT;
+  static constexpr int PackedBytes = PACKED_BYTES;
+
   uint32_t txFreq;
   uint8_t symbols[TxBufferSize];
 
-  explicit JTEncoder(uint32_t frequency = DEFAULT_FREQ) : txFreq(frequency), symbols{} {}
-  virtual ~JTEncoder() = default;
-
-  // Generic encode method for most message-based modes
-  virtual void encode(const char* message) {}
+  explicit JTEncoder(uint32_t frequency = DEFAULT_FREQ) : txFreq(frequency), symbols{}, packedData{} {}
 
-  // Overload for WSPR
-  virtual void encode(const char* callsign, const char *locator, int8_t powerDbm) {}
+  // Type-erased view of the last encoded frame
+  SymbolFrame frame() const {
+    return SymbolFrame{symbols, (uint16_t) TxBufferSize, ToneSpacing, SymbolPeriod, ToneCount, 8};
+  }
 
 protected:
-  // Encoding pipeline steps. Derived classes override what they need.
-  
-  // Overloaded for different packing needs.
-  // Version for modes with a generic message string (FT8, JT65, etc.)
-  virtual void packBits(const char* message) {}
-  // Version for modes with specific fields (WSPR)
-  virtual void packBits() {}
-
-  virtual void computeFec() {}
-  virtual void interleave() {}
-  virtual void generateSync() {}
-  virtual void convolveSymbols() {}
-
-  uint8_t packedData[32]; // Increased size for larger modes
+  // Pipeline: packBits(args...) -> computeFec -> convolveSymbols ->
+  // interleave -> generateSync. A packBits that returns false stops the
+  // pipeline and leaves symbols zeroed. Returns whether all stages ran.
+  template<typename... Args>
+  bool runPipeline(const Args&... args) {
+    static_assert(std::is_base_of<JTEncoder, Mode>::value, "Mode must derive from JTEncoder<Mode, ...>");
+    Mode& mode = static_cast<Mode&>(*this);
+
+    if constexpr (std::is_same<decltype(mode.packBits(args...)), bool>::value) {
+      if (!mode.packBits(args...)) {
+        memset(symbols, 0, sizeof(symbols));
+        return false;
+      }
+    } else {
+      mode.packBits(args...);
+    }
+
+    mode.computeFec();
+    mode.convolveSymbols();
+    mode.interleave();
+    mode.generateSync();
+    return true;
+  }
+
+  // Default stages do nothing
+  void computeFec() {}
+  void convolveSymbols() {}
+  void interleave() {}
+  void generateSync() {}
+
+  uint8_t packedData[PackedBytes];
 };
 
 // --- Encoder Classes for Each Mode ---
 
-class WSPREncoder : public JTEncoder<146, 683, 14097000UL + 1500, 162> {
+class WSPREncoder : public JTEncoder<WSPREncoder, 146, 683, 14097000UL + 1500, 162, 4, 7> {
 public:
+  // Type 1: callsign, 4-char locator, power
+  // Type 2: compound callsign (prefix/suffix), power
+  // Type 3: 15-bit callsign hash, 6-char locator, power
+  enum MessageType : uint8_t { TYPE1 = 1, TYPE2 = 2, TYPE3 = 3 };
+
   using JTEncoder::JTEncoder;
+
+  // Encodes the first frame of this station's frame sequence. A Type 3
+  // frame needs a 6-char locator; asking for one without leaves symbols
+  // zeroed and isValid() false.
   void encode(const char* callsign, const char* locator, int8_t powerDbm);
+  void encode(const char* callsign, const char* locator, int8_t powerDbm, MessageType type);
+  bool isValid() const { return valid; }
+
+  MessageType getMessageType() const { return messageType; }
+
+  // Fills types with the frames a station must alternate between to be
+  // fully reported (compound calls and 6-char locators need a Type 3
+  // frame as well). Returns 1 or 2.
+  static int frameSequence(const char* callsign, const char* locator, MessageType types[2]);
 
 private:
-  // This now correctly overrides the new parameter-less virtual function in the base class.
-  void packBits() override;
-  void convolveSymbols() override;
-  void interleave() override;
+  friend JTEncoder;
+
+  bool packBits();
+  void convolveSymbols();
+  void interleave();
 
   char callsign[12];
   char locator[7];
   int8_t powerDbm;
+  MessageType messageType = TYPE1;
+  bool valid = false;
 };
 
-class FT8Encoder : public JTEncoder<625, 160, 14074000UL, 79> {
+class FT8Encoder : public JTEncoder<FT8Encoder, 625, 160, 14074000UL, 79, 8, 22> {
 public:
+  static constexpr int PayloadBits = 77;    // source-encoded message
+  static constexpr int MessageBits = 91;    // payload + CRC-14
+  static constexpr int CodewordBits = 174;  // LDPC(174,91) codeword
+
   using JTEncoder::JTEncoder;
-  void encode(const char* message) override;
+
+  // Encodes a standard message ("CQ K1ABC FN42", "CQ DX K1ABC FN42",
+  // "K1ABC W9XYZ -11", "W9XYZ K1ABC R-09", "K1ABC W9XYZ RR73", calls may
+  // carry /R or /P). Anything else leaves symbols zeroed and isValid() false.
+  void encode(const char* message);
+  bool isValid() const { return valid; }
+
+  // Source-encodes a message into 77 bits, MSB first. Returns false if the
+  // message is not a supported standard message.
+  static bool pack77(const char* message, uint8_t payload[10]);
+
+  // CRC-14 (polynomial 0x2757) of a 77-bit payload as FT8 appends it.
+  static uint16_t crc14(const uint8_t payload[10]);
+
+  // Copies the 91 message bits and appends the 83 LDPC parity bits.
+  static void encodeLdpc(const uint8_t message[12], uint8_t codeword[22]);
+
 private:
-  void packBits(const char* message) override;
-  void computeFec() override;
-  void generateSync() override;
+  friend JTEncoder;
+
+  bool packBits(const char* message);
+  void computeFec();
+  void generateSync();
+
+  bool valid = false;
 };
 
-class JT65Encoder : public JTEncoder<269, 372, 14076000UL, 126> {
+class JT65Encoder : public JTEncoder<JT65Encoder, 269, 372, 14076000UL, 126, 66, 12> {
 public:
+  static constexpr int DataSymbols = 12;   // 72 bits as 6-bit symbols
+  static constexpr int CodeSymbols = 63;   // RS(63,12) over GF(64)
+
   using JTEncoder::JTEncoder;
-  void encode(const char* message) override;
+
+  // Encodes a free-text message of up to 13 characters from
+  // 0-9 A-Z space + - . / ?; lowercase is folded, anything else is a space.
+  void encode(const char* message);
+
 private:
-  void packBits(const char* message) override;
-  void computeFec() override;
-  void interleave() override;
-  void generateSync() override;
-  void convolveSymbols() override;
+  friend JTEncoder;
+
+  void packBits(const char* message);
+  void computeFec();
+  void interleave();
+  void generateSync();
 };
 
-class JT9Encoder : public JTEncoder<174, 576, 14076000UL, 85> {
+class JT9Encoder : public JTEncoder<JT9Encoder, 174, 576, 14076000UL, 85, 9, 26> {
 public:
+  static constexpr int DataSymbols = 69;   // 206 coded bits, three per 8-FSK symbol
+  static constexpr int SyncSymbols = 16;
+
   using JTEncoder::JTEncoder;
-  void encode(const char* message) override;
+
+  // Encodes a free-text message as JT65Encoder does.
+  void encode(const char* message);
+
 private:
-  // JT9 uses a slightly different pipeline structure
+  friend JTEncoder;
+
+  void packBits(const char* message);
+  void convolveSymbols();
+  void interleave();
+  void generateSync();
 };
 
-class JT4Encoder : public JTEncoder<437, 229, 14078500UL, 206> {
+// JT4 is not implemented yet: encode() only reports the message.
+class JT4Encoder : public JTEncoder<JT4Encoder, 437, 229, 14078500UL, 206, 4, 1> {
 public:
   using JTEncoder::JTEncoder;
-  void encode(const char* message) override;
-private:
-  // JT4 has its own unique pipeline
+  void encode(const char* message);
 };
 
+// FST4W carries the same 50-bit message as WSPR, so it takes the same
+// arguments. The symbols are the same for every T/R period; the tone
+// spacing and symbol period below are FST4W-120's, and ModeDescriptor has
+// all four.
+class FST4WEncoder : public JTEncoder<FST4WEncoder, 146, 683, 474200UL + 1500, 160, 4, 30> {
+public:
+  static constexpr int PayloadBits = 77;    // 50-bit WSPR message, zero-extended
+  static constexpr int MessageBits = 101;   // payload + CRC-24
+  static constexpr int CodewordBits = 240;  // LDPC(240,101) codeword
+  static constexpr int DataSymbols = 120;   // two coded bits per 4-FSK symbol
+  static constexpr int SyncSymbols = 40;    // five 8-symbol sync words
+
+  using JTEncoder::JTEncoder;
+
+  void encode(const char* callsign, const char* locator, int8_t powerDbm,
+              WSPREncoder::MessageType type = WSPREncoder::TYPE1);
+
+  // CRC-24 (polynomial 0x100065B) of a 77-bit payload, MSB first
+  static uint32_t crc24(const uint8_t payload[10]);
+
+  // Copies the 101 message bits and appends the 139 LDPC parity bits.
+  static void encodeLdpc(const uint8_t message[13], uint8_t codeword[30]);
+
+private:
+  friend JTEncoder;
+
+  bool packBits(const char* callsign, const char* locator, int8_t powerDbm, WSPREncoder::MessageType type);
+  void computeFec();
+  void generateSync();
+};
 
 #endif // JT_ENCODE_H
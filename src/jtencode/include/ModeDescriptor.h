@@ -0,0 +1,78 @@
+#ifndef MODE_DESCRIPTOR_H
+#define MODE_DESCRIPTOR_H
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+/**
+ * @brief Timing of a beacon mode, for scheduling and modulation.
+ *
+ * Everything follows from the samples per symbol at WSJT-X's 12 kHz audio
+ * rate: the symbol period is samplesPerSymbol / 12000 s and the tones are
+ * 12000 / samplesPerSymbol Hz apart. Transmissions start one second into
+ * a slot that begins on a multiple of slotSeconds since the UTC epoch, so
+ * 120, 300, 900 and 1800 s slots fall on even minutes, five minutes,
+ * quarter hours and half hours.
+ */
+struct ModeDescriptor {
+  const char* name;
+  uint16_t slotSeconds;        // T/R period
+  uint16_t symbolCount;
+  uint8_t toneCount;
+  uint32_t samplesPerSymbol;   // at 12000 Hz
+
+  static constexpr uint32_t SampleRate = 12000;
+  static constexpr int StartOffsetSec = 1;
+
+  constexpr double toneSpacingHz() const { return (double) SampleRate / samplesPerSymbol; }
+  constexpr double symbolPeriodMs() const { return 1000.0 * samplesPerSymbol / SampleRate; }
+  constexpr double durationSec() const { return (double) symbolCount * samplesPerSymbol / SampleRate; }
+
+  // Fills tones[0..toneCount) with the RF frequency of each tone above
+  // baseHz. Done once per transmission so the Si5351 never recomputes it.
+  constexpr void toneTable(double baseHz, double* tones) const {
+    for (int i = 0; i < toneCount; ++i) tones[i] = baseHz + i * toneSpacingHz();
+  }
+};
+
+inline constexpr int ModeMaxTones = 4;
+inline constexpr int ModeMaxSymbols = 162;
+
+inline constexpr ModeDescriptor wsprMode = {"WSPR", 120, 162, 4, 8192};
+inline constexpr ModeDescriptor fst4w120Mode = {"FST4W-120", 120, 160, 4, 8200};
+inline constexpr ModeDescriptor fst4w300Mode = {"FST4W-300", 300, 160, 4, 21504};
+inline constexpr ModeDescriptor fst4w900Mode = {"FST4W-900", 900, 160, 4, 66560};
+inline constexpr ModeDescriptor fst4w1800Mode = {"FST4W-1800", 1800, 160, 4, 134400};
+
+// Modes the beacon will transmit. FST4W stays out until FST4WEncoder uses
+// WSJT-X's LDPC(240,74) generator and CRC; its frames cannot be decoded yet.
+inline constexpr const ModeDescriptor* beaconModes[] = {
+  &wsprMode,
+};
+
+// Every timing descriptor, including modes not yet offered to the beacon
+inline constexpr const ModeDescriptor* allModes[] = {
+  &wsprMode, &fst4w120Mode, &fst4w300Mode, &fst4w900Mode, &fst4w1800Mode,
+};
+
+// Mode by name, case-insensitive; WSPR if the name is unknown
+inline const ModeDescriptor* findBeaconMode(const char* name) {
+  for (const ModeDescriptor* mode : beaconModes) {
+    if (name && strcasecmp(name, mode->name) == 0) return mode;
+  }
+  return &wsprMode;
+}
+
+constexpr bool modesFitMaxima() {
+  for (const ModeDescriptor* mode : allModes) {
+    if (mode->toneCount > ModeMaxTones || mode->symbolCount > ModeMaxSymbols) return false;
+  }
+  return true;
+}
+
+static_assert(modesFitMaxima(), "ModeMaxTones and ModeMaxSymbols cover every mode");
+static_assert(wsprMode.durationSec() == 110.592, "WSPR is 162 symbols of 8192 samples");
+static_assert(fst4w1800Mode.durationSec() == 1792.0, "FST4W-1800 is 160 symbols of 134400 samples");
+
+#endif // MODE_DESCRIPTOR_H
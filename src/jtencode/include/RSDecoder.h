@@ -0,0 +1,252 @@
+#ifndef RS_DECODER_H
+#define RS_DECODER_H
+
+#include "RSEncoder.h"
+#include "RSSyndromes.h"
+
+/**
+ * @brief Fixed-parameter Reed-Solomon decoder matching RSEncoder.
+ *
+ * Berlekamp-Massey with erasures, Chien search and Forney's algorithm
+ * (Karn's decode_rs) over the encoder's compile-time tables. Blocks are
+ * data followed by parity, as RSEncoder and RSEncode produce them; a block
+ * shorter than NN is a shortened code. Decoding corrects e errors and s
+ * erasures whenever 2e + s <= NRoots. Nothing is allocated.
+ */
+template<int SymBits, int NRoots, int Fcr, int Prim, int GfPoly = rsDefaultGfPoly(SymBits)>
+class RSDecoder {
+public:
+  using Encoder = RSEncoder<SymBits, NRoots, Fcr, Prim, GfPoly>;
+  static constexpr int NN = Encoder::NN;
+
+  // Syndrome evaluation points alpha^((Fcr + i) * Prim) as nibble multiply tables
+  struct PointTable {
+    RSSyndromes::Point points[NRoots];
+  };
+
+  static constexpr PointTable makePoints() {
+    PointTable t{};
+    const auto& gf = Encoder::tables;
+    for (int i = 0; i < NRoots; ++i) {
+      int logc = ((Fcr + i) * Prim) % NN;
+      for (int n = 0; n < 16; ++n) {
+        t.points[i].lo[n] = n ? gf.alphaTo[(gf.indexOf[n] + logc) % NN] : 0;
+        int h = n << 4;
+        t.points[i].hi[n] = (n && h <= NN) ? gf.alphaTo[(gf.indexOf[h] + logc) % NN] : 0;
+      }
+    }
+    return t;
+  }
+
+  static constexpr PointTable points = makePoints();
+
+  // prim-th root of 1, index form, for the Chien search
+  static constexpr int makeIPrim() {
+    int iprim = 1;
+    while (iprim % Prim != 0) iprim += NN;
+    return iprim / Prim;
+  }
+
+  static constexpr int IPrim = makeIPrim();
+
+  // Syndromes of one block, polynomial form
+  static void syndromes(const uint8_t* block, int length, uint8_t syn[NRoots]) {
+    RSSyndromes::compute(RSSyndromes::Isa::SCALAR, block, 1, length, points.points, NRoots, syn);
+  }
+
+  // Syndromes of count blocks of length symbols stored back to back,
+  // vectorized across blocks. syn receives count * NRoots symbols.
+  static void syndromes(const uint8_t* blocks, size_t count, int length, uint8_t* syn) {
+    RSSyndromes::compute(blocks, count, length, points.points, NRoots, syn);
+  }
+
+  // Corrects block in place. erasures lists symbol positions known to be
+  // bad. Returns the number of symbols corrected, or -1 if the block is
+  // uncorrectable. positions, if given, receives the corrected positions.
+  static int decode(uint8_t* block, int length, const int* erasures = nullptr, int erasureCount = 0,
+                    int* positions = nullptr) {
+    uint8_t syn[NRoots];
+    syndromes(block, length, syn);
+    return decode(block, length, syn, erasures, erasureCount, positions);
+  }
+
+  // As above with syndromes already computed.
+  static int decode(uint8_t* block, int length, const uint8_t syn[NRoots], const int* erasures, int erasureCount,
+                    int* positions = nullptr) {
+    const auto& gf = Encoder::tables;
+    const int A0 = NN;
+    const int pad = NN - length;
+
+    if (length <= NRoots || length > NN || erasureCount < 0 || erasureCount > NRoots) return -1;
+    for (int i = 0; i < erasureCount; ++i) {
+      if (erasures[i] < 0 || erasures[i] >= length) return -1;
+    }
+
+    // Syndromes to index form
+    int s[NRoots];
+    int synError = 0;
+    for (int i = 0; i < NRoots; ++i) {
+      synError |= syn[i];
+      s[i] = gf.indexOf[syn[i]];
+    }
+    if (!synError) return 0;
+
+    // Start from the erasure locator polynomial
+    uint8_t lambda[NRoots + 1] = {};
+    lambda[0] = 1;
+    if (erasureCount > 0) {
+      lambda[1] = gf.alphaTo[modnn(Prim * (NN - 1 - (erasures[0] + pad)))];
+      for (int i = 1; i < erasureCount; ++i) {
+        int u = modnn(Prim * (NN - 1 - (erasures[i] + pad)));
+        for (int j = i + 1; j > 0; --j) {
+          int tmp = gf.indexOf[lambda[j - 1]];
+          if (tmp != A0) lambda[j] ^= gf.alphaTo[modnn(u + tmp)];
+        }
+      }
+    }
+
+    int b[NRoots + 1];
+    uint8_t t[NRoots + 1];
+    for (int i = 0; i <= NRoots; ++i) b[i] = gf.indexOf[lambda[i]];
+
+    // Berlekamp-Massey for the error+erasure locator polynomial
+    int el = erasureCount;
+    for (int r = erasureCount + 1; r <= NRoots; ++r) {
+      int discr = 0;
+      for (int i = 0; i < r; ++i) {
+        if (lambda[i] != 0 && s[r - i - 1] != A0) discr ^= gf.alphaTo[modnn(gf.indexOf[lambda[i]] + s[r - i - 1])];
+      }
+      discr = gf.indexOf[discr];
+
+      if (discr == A0) {
+        shiftUp(b);
+        continue;
+      }
+
+      // T(x) = lambda(x) - discr * x * B(x)
+      t[0] = lambda[0];
+      for (int i = 0; i < NRoots; ++i) {
+        t[i + 1] = b[i] != A0 ? lambda[i + 1] ^ gf.alphaTo[modnn(discr + b[i])] : lambda[i + 1];
+      }
+
+      if (2 * el <= r + erasureCount - 1) {
+        el = r + erasureCount - el;
+        // B(x) = lambda(x) / discr
+        for (int i = 0; i <= NRoots; ++i) b[i] = lambda[i] == 0 ? A0 : modnn(gf.indexOf[lambda[i]] - discr + NN);
+      } else {
+        shiftUp(b);
+      }
+      memcpy(lambda, t, sizeof(lambda));
+    }
+
+    // lambda to index form
+    int lam[NRoots + 1];
+    int degLambda = 0;
+    for (int i = 0; i <= NRoots; ++i) {
+      lam[i] = gf.indexOf[lambda[i]];
+      if (lam[i] != A0) degLambda = i;
+    }
+    if (degLambda == 0) return -1;
+
+    // Chien search for the roots of lambda
+    int reg[NRoots + 1];
+    int root[NRoots], loc[NRoots];
+    int count = 0;
+    memcpy(reg + 1, lam + 1, NRoots * sizeof(int));
+    for (int i = 1, k = IPrim - 1; i <= NN; ++i, k = modnn(k + IPrim)) {
+      int q = 1;
+      for (int j = degLambda; j > 0; --j) {
+        if (reg[j] != A0) {
+          reg[j] = modnn(reg[j] + j);
+          q ^= gf.alphaTo[reg[j]];
+        }
+      }
+      if (q != 0) continue;
+
+      // A root in the shortened-away padding is not a real error location
+      if (k < pad) return -1;
+      root[count] = i;
+      loc[count] = k;
+      if (++count == degLambda) break;
+    }
+    if (count != degLambda) return -1;
+
+    // Error evaluator omega(x) = s(x) * lambda(x) mod x^NRoots, index form
+    int omega[NRoots + 1];
+    int degOmega = degLambda - 1;
+    for (int i = 0; i <= degOmega; ++i) {
+      int tmp = 0;
+      for (int j = i; j >= 0; --j) {
+        if (s[i - j] != A0 && lam[j] != A0) tmp ^= gf.alphaTo[modnn(s[i - j] + lam[j])];
+      }
+      omega[i] = gf.indexOf[tmp];
+    }
+
+    // Forney: error value = omega(1/X) * (1/X)^(Fcr-1) / lambda'(1/X)
+    uint8_t value[NRoots];
+    for (int j = count - 1; j >= 0; --j) {
+      int num1 = 0;
+      for (int i = degOmega; i >= 0; --i) {
+        if (omega[i] != A0) num1 ^= gf.alphaTo[modnn(omega[i] + i * root[j])];
+      }
+      int num2 = gf.alphaTo[modnn(root[j] * (Fcr - 1) + NN)];
+
+      // lambda[i + 1] for even i is the formal derivative
+      int den = 0;
+      for (int i = (degLambda < NRoots - 1 ? degLambda : NRoots - 1) & ~1; i >= 0; i -= 2) {
+        if (lam[i + 1] != A0) den ^= gf.alphaTo[modnn(lam[i + 1] + i * root[j])];
+      }
+      if (den == 0) return -1;
+
+      value[j] = num1 ? gf.alphaTo[modnn(gf.indexOf[num1] + gf.indexOf[num2] + NN - gf.indexOf[den])] : 0;
+    }
+
+    // Only touch the block once every error value is known
+    for (int j = 0; j < count; ++j) block[loc[j] - pad] ^= value[j];
+
+    if (positions) {
+      for (int i = 0; i < count; ++i) positions[i] = loc[i] - pad;
+    }
+    return count;
+  }
+
+  // Decodes count blocks in place (no erasures), computing syndromes for
+  // groups of blocks in one SIMD pass so clean blocks skip the rest.
+  // results, if given, receives each block's decode() result. Returns the
+  // number of uncorrectable blocks.
+  static size_t decodeBatch(uint8_t* blocks, size_t count, int length, int* results = nullptr) {
+    constexpr size_t Group = 2 * RSSyndromes::Lanes;
+    uint8_t syn[Group * NRoots];
+    size_t failures = 0;
+
+    for (size_t base = 0; base < count; base += Group) {
+      size_t n = count - base < Group ? count - base : Group;
+      syndromes(blocks + base * length, n, length, syn);
+
+      for (size_t c = 0; c < n; ++c) {
+        int result = decode(blocks + (base + c) * length, length, syn + c * NRoots, nullptr, 0);
+        if (result < 0) ++failures;
+        if (results) results[base + c] = result;
+      }
+    }
+
+    return failures;
+  }
+
+private:
+  static constexpr int modnn(int x) {
+    while (x >= NN) {
+      x -= NN;
+      x = (x >> SymBits) + (x & NN);
+    }
+    return x;
+  }
+
+  // B(x) = x * B(x), index form
+  static void shiftUp(int b[NRoots + 1]) {
+    memmove(b + 1, b, NRoots * sizeof(int));
+    b[0] = NN;
+  }
+};
+
+#endif // RS_DECODER_H
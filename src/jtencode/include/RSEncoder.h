@@ -0,0 +1,103 @@
+#ifndef RS_ENCODER_H
+#define RS_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Default primitive field polynomials for the symbol sizes JT modes use
+constexpr int rsDefaultGfPoly(int symBits) {
+  return symBits == 3 ? 0xB : symBits == 4 ? 0x13 : symBits == 5 ? 0x25 :
+         symBits == 6 ? 0x43 : symBits == 7 ? 0x89 : 0x11D;
+}
+
+/**
+ * @brief Fixed-parameter Reed-Solomon encoder.
+ *
+ * Same code as RSEncode (Karn's encode_rs: data first, parity in index
+ * order) with every parameter fixed at compile time. The GF tables and a
+ * generator table pre-multiplied by every possible feedback symbol are
+ * built by the compiler, so encoding is a row lookup and NRoots XORs per
+ * data symbol, with a circular parity register instead of a shift. Nothing
+ * is allocated; a shortened code is just a shorter data array.
+ */
+template<int SymBits, int NRoots, int Fcr, int Prim, int GfPoly = rsDefaultGfPoly(SymBits)>
+class RSEncoder {
+public:
+  static constexpr int NN = (1 << SymBits) - 1;
+  static constexpr int MaxDataSymbols = NN - NRoots;
+
+  static_assert(SymBits >= 2 && SymBits <= 8, "RSEncoder symbols are at most 8 bits");
+  static_assert(NRoots > 0 && NRoots < NN, "NRoots must leave room for data");
+  static_assert(Fcr >= 0 && Fcr <= NN && Prim > 0 && Prim <= NN, "Fcr/Prim out of range");
+
+  struct Tables {
+    uint8_t alphaTo[NN + 1];          // index form -> polynomial form
+    uint8_t indexOf[NN + 1];          // polynomial form -> index form
+    uint8_t genpoly[NRoots + 1];      // generator polynomial, index form
+    uint8_t taps[NN + 1][NRoots];     // taps[fb][k] = fb * genpoly[NRoots - 1 - k]
+    bool primitive;
+  };
+
+  static constexpr Tables makeTables() {
+    Tables t{};
+    t.indexOf[0] = NN;
+    t.alphaTo[NN] = 0;
+
+    int sr = 1;
+    for (int i = 0; i < NN; ++i) {
+      t.indexOf[sr] = i;
+      t.alphaTo[i] = sr;
+      sr <<= 1;
+      if (sr & (1 << SymBits)) sr ^= GfPoly;
+      sr &= NN;
+    }
+    t.primitive = sr == 1;
+
+    // genpoly = product of (x + alpha^((Fcr + i) * Prim)), built in polynomial form
+    uint8_t g[NRoots + 1] = {};
+    g[0] = 1;
+    for (int i = 0, root = Fcr * Prim; i < NRoots; ++i, root += Prim) {
+      g[i + 1] = 1;
+      for (int j = i; j > 0; --j) {
+        g[j] = g[j] ? g[j - 1] ^ t.alphaTo[(t.indexOf[g[j]] + root) % NN] : g[j - 1];
+      }
+      g[0] = t.alphaTo[(t.indexOf[g[0]] + root) % NN];
+    }
+    for (int i = 0; i <= NRoots; ++i) t.genpoly[i] = t.indexOf[g[i]];
+
+    for (int fb = 1; fb <= NN; ++fb) {
+      for (int k = 0; k < NRoots; ++k) {
+        t.taps[fb][k] = t.alphaTo[(t.indexOf[fb] + t.genpoly[NRoots - 1 - k]) % NN];
+      }
+    }
+    return t;
+  }
+
+  static constexpr Tables tables = makeTables();
+  static_assert(tables.primitive, "GfPoly is not primitive for SymBits");
+
+  // Computes the NRoots parity symbols for count data symbols
+  // (count <= MaxDataSymbols; fewer means a shortened code).
+  static void encode(const uint8_t* data, size_t count, uint8_t* parity) {
+    uint8_t reg[NRoots] = {};
+    int head = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+      const uint8_t* tap = tables.taps[(data[i] ^ reg[head]) & NN];
+
+      // The oldest register slot becomes the newest; no shifting
+      reg[head] = 0;
+      head = head + 1 == NRoots ? 0 : head + 1;
+
+      int k = 0;
+      for (int j = head; j < NRoots; ++j) reg[j] ^= tap[k++];
+      for (int j = 0; j < head; ++j) reg[j] ^= tap[k++];
+    }
+
+    memcpy(parity, reg + head, NRoots - head);
+    memcpy(parity + NRoots - head, reg, head);
+  }
+};
+
+#endif // RS_ENCODER_H
@@ -0,0 +1,45 @@
+#ifndef RS_SYNDROMES_H
+#define RS_SYNDROMES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Reed-Solomon syndrome evaluation across many codewords.
+ *
+ * Codewords are taken Lanes at a time. Each symbol position becomes one
+ * vector of Lanes bytes, and each syndrome's Horner step is a GF multiply
+ * by a constant, done with two 16-entry nibble tables (PSHUFB on AVX2, TBL
+ * on NEON), plus an XOR. The kernel is picked at runtime with a portable
+ * scalar fallback, as in WSPRBatchEncoder.
+ */
+class RSSyndromes {
+public:
+  enum class Isa : uint8_t { SCALAR, AVX2, NEON };
+
+  static constexpr int Lanes = 32;
+  static constexpr int MaxRoots = 64;
+
+  // Multiply-by-constant tables for one evaluation point c:
+  // lo[n] = n * c and hi[n] = (n << 4) * c in the field.
+  struct Point {
+    uint8_t lo[16];
+    uint8_t hi[16];
+  };
+
+  // For each of count codewords of length symbols (stored back to back),
+  // syn[c * nroots + i] = codeword c evaluated at points[i], Horner from
+  // symbol 0. More than MaxRoots points runs as scalar.
+  static void compute(const uint8_t* blocks, size_t count, int length, const Point* points, int nroots,
+                      uint8_t* syn);
+
+  // As above with a specific kernel. Unsupported kernels run as scalar.
+  static void compute(Isa isa, const uint8_t* blocks, size_t count, int length, const Point* points, int nroots,
+                      uint8_t* syn);
+
+  static Isa bestIsa();
+  static bool isSupported(Isa isa);
+  static const char* isaName(Isa isa);
+};
+
+#endif // RS_SYNDROMES_H
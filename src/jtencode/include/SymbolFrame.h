@@ -0,0 +1,41 @@
+#ifndef SYMBOL_FRAME_H
+#define SYMBOL_FRAME_H
+
+#include <stdint.h>
+
+/**
+ * @brief Non-owning view of an encoded channel symbol sequence.
+ *
+ * The modulator only needs the symbol sequence, how far apart the tones are
+ * and how long each symbol lasts. This view holds exactly that, so
+ * code that transmits frames never needs the concrete encoder type. Symbols
+ * are either one per byte or packed MSB first at 1, 2 or 4 bits each, as
+ * WSPRPackedFrame stores them in flash. Copying the view never allocates
+ * or copies the symbols.
+ */
+struct SymbolFrame {
+  const uint8_t* data = nullptr;
+  uint16_t count = 0;           // channel symbols
+  uint16_t toneSpacing = 0;     // centi-Hz between adjacent tones
+  uint16_t symbolPeriod = 0;    // ms per symbol
+  uint8_t toneCount = 0;        // distinct tones the mode uses
+  uint8_t bitsPerSymbol = 8;    // 8 = one symbol per byte, else 1, 2 or 4 packed
+
+  constexpr bool empty() const { return !data || count == 0; }
+
+  constexpr uint8_t symbol(int i) const {
+    if (bitsPerSymbol == 8) return data[i];
+    const int perByte = 8 / bitsPerSymbol;
+    const int shift = 8 - bitsPerSymbol * (i % perByte + 1);
+    return (data[i / perByte] >> shift) & ((1 << bitsPerSymbol) - 1);
+  }
+
+  constexpr uint8_t operator[](int i) const { return symbol(i); }
+
+  // Tone offset from the base frequency, centi-Hz
+  constexpr uint32_t toneOffset(uint8_t tone) const { return (uint32_t) tone * toneSpacing; }
+
+  constexpr uint32_t durationMs() const { return (uint32_t) count * symbolPeriod; }
+};
+
+#endif // SYMBOL_FRAME_H
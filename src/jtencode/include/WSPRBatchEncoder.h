@@ -0,0 +1,37 @@
+#ifndef WSPR_BATCH_ENCODER_H
+#define WSPR_BATCH_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Bulk WSPR encoder for generating symbol tables for many stations.
+ *
+ * Messages are processed in blocks of Lanes in structure-of-arrays form, so
+ * the Type 1 packing arithmetic and the convolutional encoder run across
+ * messages in SIMD lanes. The kernel is picked at runtime (AVX2 on x86,
+ * NEON on AArch64) with a portable scalar fallback. Output is identical to
+ * WSPREncoder::encode() for every message, including compound callsigns,
+ * which are handed to WSPREncoder one at a time.
+ */
+class WSPRBatchEncoder {
+public:
+  enum class Isa : uint8_t { SCALAR, AVX2, NEON };
+
+  static constexpr int Lanes = 8;
+
+  // Encodes count messages. out receives count * 162 channel symbols,
+  // message after message. No heap allocation.
+  static void encode(const char* const* callsigns, const char* const* locators,
+                     const int8_t* powerDbm, size_t count, uint8_t* out);
+
+  // As above with a specific kernel. Unsupported kernels run as scalar.
+  static void encode(Isa isa, const char* const* callsigns, const char* const* locators,
+                     const int8_t* powerDbm, size_t count, uint8_t* out);
+
+  static Isa bestIsa();
+  static bool isSupported(Isa isa);
+  static const char* isaName(Isa isa);
+};
+
+#endif // WSPR_BATCH_ENCODER_H
@@ -0,0 +1,86 @@
+#ifndef WSPR_DECODER_H
+#define WSPR_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "JTEncode.h"
+#include "WSPRTables.h"
+
+struct WSPRDecodeResult {
+  bool ok;
+  WSPREncoder::MessageType type;
+  char callsign[12];        // Type 1 and 2; empty for Type 3
+  char locator[7];          // 4 characters for Type 1, 6 for Type 3
+  int8_t powerDbm;
+  uint16_t hash;            // Type 3 callsign hash
+  float freqOffsetHz;       // audio: offset of the tone centre from centerHz
+  float timeOffsetSec;      // audio: frame start from the first sample
+  float syncQuality;        // audio: 0..1 agreement with the sync vector
+  uint32_t fanoCycles;
+};
+
+struct WSPRDecodeOptions {
+  float centerHz = 1500.0f;         // audio frequency midway between tones 1 and 2
+  float freqRangeHz = 4.0f;         // search +/- this much around centerHz
+  uint32_t maxCyclesPerBit = 10000; // Fano effort limit
+};
+
+/**
+ * @brief Host-side WSPR receiver for loopback verification.
+ *
+ * It takes either the 162 channel tones or real 12 kHz audio. Audio is mixed
+ * down and block-summed to 375 Hz baseband, then correlated against the four
+ * tones over a grid of quarter-bin frequency offsets and eighth-symbol lags.
+ * The candidate that best matches the sync vector gives the soft data bits.
+ * These are de-interleaved and decoded with a Fano sequential decoder for the
+ * K=32 code, then the 50 bits are unpacked to callsign, locator and power.
+ * Correlation uses 4-wide GCC vector arithmetic (SSE2 on x86-64, NEON on
+ * aarch64). decodeBatch() decodes many recordings across threads.
+ */
+class WSPRDecoder {
+public:
+  static constexpr int SampleRate = 12000;
+  static constexpr int SamplesPerSymbol = 8192;
+  static constexpr double ToneSpacingHz = (double) SampleRate / SamplesPerSymbol;
+  static constexpr size_t FrameSamples = (size_t) WSPRSymbolCount * SamplesPerSymbol;
+  static constexpr int MessageBits = 50;
+  static constexpr int CodedBits = MessageBits + 31;
+
+  using Options = WSPRDecodeOptions;
+
+  // Decodes a frame of channel tones (0..3)
+  static bool decodeSymbols(const uint8_t symbols[WSPRSymbolCount], WSPRDecodeResult& result,
+                            const Options& options = Options());
+
+  // Finds and decodes a frame in samples of 12 kHz audio. The whole frame
+  // must lie inside the recording; extra audio either side widens the time
+  // search.
+  static bool decodeAudio(const float* audio, size_t samples, WSPRDecodeResult& result,
+                          const Options& options = Options());
+
+  // Decodes count recordings of samples each on up to threads threads (0 =
+  // one per core). Returns how many decoded.
+  static size_t decodeBatch(const float* const* audio, size_t samples, size_t count, WSPRDecodeResult* results,
+                            unsigned threads = 0, const Options& options = Options());
+
+  // Pipeline stages, public for tests.
+
+  // Soft bits (128 = erasure, 255 = certain 1) in transmission order to
+  // decoder order
+  static void deinterleave(const uint8_t soft[WSPRSymbolCount], uint8_t out[WSPRSymbolCount]);
+
+  // Fano decode of 162 soft bits in decoder order into 50 message bits packed
+  // MSB first. Returns false if maxCycles ran out.
+  static bool fano(const uint8_t soft[WSPRSymbolCount], uint8_t message[7], uint32_t maxCycles,
+                   uint32_t* cycles = nullptr);
+
+  // Unpacks 50 message bits. Returns false for values no encoder produces.
+  static bool unpack(const uint8_t message[7], WSPRDecodeResult& result);
+
+  // Adds a phase-continuous WSPR frame to audio starting at startSample,
+  // tone k at centerHz + (k - 1.5) * ToneSpacingHz.
+  static void synthesize(const uint8_t symbols[WSPRSymbolCount], float* audio, size_t samples, size_t startSample,
+                         double centerHz, float amplitude);
+};
+
+#endif // WSPR_DECODER_H
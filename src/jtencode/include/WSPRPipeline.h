@@ -0,0 +1,365 @@
+#ifndef WSPR_PIPELINE_H
+#define WSPR_PIPELINE_H
+
+#include <stdint.h>
+#include "JTEncode.h"
+#include "WSPRTables.h"
+#include "ConvEncoder.h"
+
+// The WSPR encoding pipeline (normalize -> pack -> convolve -> interleave ->
+// sync) as constexpr functions. WSPREncoder runs these at runtime, and
+// fixed-identity firmware evaluates them at compile time so the finished
+// frame lives in flash.
+
+inline constexpr char wsprToUpper(char c) {
+  return (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+}
+
+inline constexpr bool wsprIsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+inline constexpr int wsprStrLen(const char* s) {
+  int n = 0;
+  while (s[n]) ++n;
+  return n;
+}
+
+inline constexpr int wsprFindSlash(const char* s) {
+  for (int i = 0; s[i]; ++i) {
+    if (s[i] == '/') return i;
+  }
+  return -1;
+}
+
+// A message ready to pack: uppercase, trimmed, power rounded to a legal level.
+struct WSPRMessage {
+  char callsign[12];
+  char locator[7];
+  int8_t powerDbm;
+  WSPREncoder::MessageType type;
+};
+
+// Frames a station must alternate between to be fully reported. A 6-char
+// locator needs a Type 3 frame as well; a compound call with a 4-char
+// locator sends Type 2 alone, as WSJT-X does. Returns 1 or 2.
+inline constexpr int wsprFrameSequence(const char* callsign, const char* locator, WSPREncoder::MessageType types[2]) {
+  int n = 0;
+  bool compound = wsprFindSlash(callsign) >= 0;
+
+  types[n++] = compound ? WSPREncoder::TYPE2 : WSPREncoder::TYPE1;
+  if (wsprStrLen(locator) == 6) types[n++] = WSPREncoder::TYPE3;
+
+  return n;
+}
+
+// Type 3 carries the full 6-character locator and has no way to send a
+// shorter one, so it needs exactly six characters.
+inline constexpr bool wsprCanPack(const char* locator, WSPREncoder::MessageType type) {
+  return type != WSPREncoder::TYPE3 || wsprStrLen(locator) == 6;
+}
+
+inline constexpr WSPRMessage wsprMakeMessage(const char* callsign, const char* locator, int8_t powerDbm,
+                                             WSPREncoder::MessageType type) {
+  WSPRMessage msg{};
+
+  while (*callsign == ' ') ++callsign;
+  int i = 0;
+  for (; i < (int) sizeof(msg.callsign) - 1 && callsign[i] && callsign[i] != ' '; ++i) {
+    msg.callsign[i] = wsprToUpper(callsign[i]);
+  }
+  msg.callsign[i] = '\0';
+
+  i = 0;
+  for (; i < 6 && locator[i]; ++i) msg.locator[i] = wsprToUpper(locator[i]);
+  msg.locator[i] = '\0';
+
+  msg.powerDbm = wsprPower(powerDbm);
+  msg.type = type;
+  return msg;
+}
+
+// WSPR wants the call area digit in the third of six characters, so a
+// callsign like "K1AB" is right-shifted to " K1AB  " before packing.
+inline constexpr void wsprNormalizeCallsign(const char* call, int len, char out[6]) {
+  if (len > 6) len = 6;
+
+  int o = 0;
+  if (len >= 3 && wsprIsDigit(call[1]) && !wsprIsDigit(call[2])) out[o++] = ' ';
+
+  for (int i = 0; i < len && o < 6; ++i) out[o++] = call[i];
+  while (o < 6) out[o++] = ' ';
+}
+
+// 28-bit callsign: [0-9A-Z ] [0-9A-Z] [0-9] then three of [A-Z ]
+inline constexpr uint32_t wsprPackCallsign(const char* c) {
+  uint32_t n = wsprCharCode(c[0]);
+  n = n * 36 + wsprCharCode(c[1]);
+  n = n * 10 + wsprCharCode(c[2]);
+  n = n * 27 + wsprCharCode(c[3]) - 10;
+  n = n * 27 + wsprCharCode(c[4]) - 10;
+  n = n * 27 + wsprCharCode(c[5]) - 10;
+  return n;
+}
+
+inline constexpr uint32_t wsprRotate(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+// Bob Jenkins' lookup3 hashlittle() reading bytes, as nhash_() does, so it
+// can run at compile time. WSPR uses an initial value of 146 and keeps the
+// low 15 bits as the Type 3 callsign hash.
+inline constexpr uint32_t wsprHash(const char* key, int length, uint32_t initVal) {
+  uint32_t a = 0xdeadbeef + (uint32_t) length + initVal;
+  uint32_t b = a, c = a;
+  int p = 0;
+
+  while (length > 12) {
+    a += (uint8_t) key[p] + ((uint32_t) (uint8_t) key[p + 1] << 8) +
+         ((uint32_t) (uint8_t) key[p + 2] << 16) + ((uint32_t) (uint8_t) key[p + 3] << 24);
+    b += (uint8_t) key[p + 4] + ((uint32_t) (uint8_t) key[p + 5] << 8) +
+         ((uint32_t) (uint8_t) key[p + 6] << 16) + ((uint32_t) (uint8_t) key[p + 7] << 24);
+    c += (uint8_t) key[p + 8] + ((uint32_t) (uint8_t) key[p + 9] << 8) +
+         ((uint32_t) (uint8_t) key[p + 10] << 16) + ((uint32_t) (uint8_t) key[p + 11] << 24);
+
+    a -= c; a ^= wsprRotate(c, 4);  c += b;
+    b -= a; b ^= wsprRotate(a, 6);  a += c;
+    c -= b; c ^= wsprRotate(b, 8);  b += a;
+    a -= c; a ^= wsprRotate(c, 16); c += b;
+    b -= a; b ^= wsprRotate(a, 19); a += c;
+    c -= b; c ^= wsprRotate(b, 4);  b += a;
+
+    length -= 12;
+    p += 12;
+  }
+
+  if (length == 0) return c;
+
+  // Last block; bytes land in a, b, c little-endian
+  for (int i = 0; i < length; ++i) {
+    uint32_t v = (uint32_t) (uint8_t) key[p + i] << (8 * (i % 4));
+    if (i < 4) a += v;
+    else if (i < 8) b += v;
+    else c += v;
+  }
+
+  c ^= b; c -= wsprRotate(b, 14);
+  a ^= c; a -= wsprRotate(c, 11);
+  b ^= a; b -= wsprRotate(a, 25);
+  c ^= b; c -= wsprRotate(b, 16);
+  a ^= c; a -= wsprRotate(c, 4);
+  b ^= a; b -= wsprRotate(a, 14);
+  c ^= b; c -= wsprRotate(b, 24);
+  return c;
+}
+
+inline constexpr uint32_t wsprCallsignHash(const char* callsign) {
+  return wsprHash(callsign, wsprStrLen(callsign), 146) & 0x7FFF;
+}
+
+// Prefix characters are coded 0-9, A-Z and space as 36, three to a group.
+inline constexpr uint32_t wsprPrefixCode(char c) {
+  uint8_t code = wsprCharCode(c);
+  return code > 36 ? 36 : code;
+}
+
+// Packs a message into its 50-bit value: 28 bits of callsign field followed
+// by 22 bits of locator/prefix/hash and power.
+inline constexpr uint64_t wsprPackMessage(const WSPRMessage& msg) {
+  const char* callsign = msg.callsign;
+  const char* locator = msg.locator;
+  int len = wsprStrLen(callsign);
+  int slashPos = wsprFindSlash(callsign);
+  char baseCall[6] = {};
+  uint32_t nCall = 0;
+  uint32_t m = 0;
+
+  switch (msg.type) {
+  case WSPREncoder::TYPE1: {
+    // 15-bit locator and 7-bit power share the remaining 22 bits
+    wsprNormalizeCallsign(callsign, slashPos >= 0 ? slashPos : len, baseCall);
+    nCall = wsprPackCallsign(baseCall);
+    uint32_t nLoc = (179 - 10 * (locator[0] - 'A') - (locator[2] - '0')) * 180
+                  + 10 * (locator[1] - 'A') + (locator[3] - '0');
+    m = nLoc * 128 + msg.powerDbm + 64;
+    break;
+  }
+
+  case WSPREncoder::TYPE2: {
+    // Compound callsign: base call in the callsign field, and the prefix
+    // or suffix in place of the locator. Values past 15 bits spill into
+    // the power field as an extra +1.
+    if (slashPos < 0) slashPos = len;
+    int suffixLen = len - slashPos - 1;
+    uint32_t ng = 0;
+
+    if (suffixLen == 1) {
+      // Single character suffix, e.g. K1ABC/P or K1ABC/7
+      uint32_t code = wsprCharCode(callsign[slashPos + 1]);
+      ng = 60000 + (code > 35 ? 38 : code);
+      wsprNormalizeCallsign(callsign, slashPos, baseCall);
+    } else if (suffixLen == 2 && wsprIsDigit(callsign[slashPos + 1]) && wsprIsDigit(callsign[slashPos + 2])) {
+      // Two digit suffix /10 to /99
+      ng = 60000 + 26 + 10 * (callsign[slashPos + 1] - '0') + (callsign[slashPos + 2] - '0');
+      wsprNormalizeCallsign(callsign, slashPos, baseCall);
+    } else {
+      // One to three character prefix, right aligned, e.g. PJ4/K1ABC
+      char prefix[3] = {' ', ' ', ' '};
+      int prefixLen = slashPos > 3 ? 3 : slashPos;
+      for (int i = 0; i < prefixLen; ++i) prefix[3 - prefixLen + i] = callsign[slashPos - prefixLen + i];
+      ng = (wsprPrefixCode(prefix[0]) * 37 + wsprPrefixCode(prefix[1])) * 37 + wsprPrefixCode(prefix[2]);
+      const char* base = slashPos < len ? callsign + slashPos + 1 : callsign;
+      wsprNormalizeCallsign(base, wsprStrLen(base), baseCall);
+    }
+
+    int nAdd = ng >= 32768 ? 1 : 0;
+    ng -= nAdd * 32768;
+    nCall = wsprPackCallsign(baseCall);
+    m = ng * 128 + msg.powerDbm + 1 + nAdd + 64;
+    break;
+  }
+
+  case WSPREncoder::TYPE3: {
+    // Hashed callsign with the 6-character locator rotated into the
+    // callsign field ("FN42AX" is sent as "N42AXF"). Callers check
+    // wsprCanPack() first.
+    char rotated[6] = {locator[1], locator[2], locator[3], locator[4], locator[5], locator[0]};
+    nCall = wsprPackCallsign(rotated);
+    m = wsprCallsignHash(callsign) * 128 - (msg.powerDbm + 1) + 64;
+    break;
+  }
+  }
+
+  return ((uint64_t) nCall << 22) | m;
+}
+
+// K=32, r=1/2 convolutional code over the 50 message bits plus 31 zero
+// tail bits, giving 162 data bits in transmission order before interleaving.
+inline constexpr void wsprConvolve(uint64_t packed, uint8_t data[WSPRSymbolCount]) {
+  uint8_t message[7] = {};
+  for (int i = 0; i < 7; ++i) message[i] = (uint8_t) ((packed << 14) >> (56 - 8 * i));
+  JTConvEncoder::encodeBits(message, 50, data);
+}
+
+// Interleaves the data bits and merges the sync vector into channel symbols.
+inline constexpr void wsprInterleaveSync(const uint8_t data[WSPRSymbolCount], uint8_t symbols[WSPRSymbolCount]) {
+  for (int i = 0; i < WSPRSymbolCount; ++i) {
+    uint8_t dest = wsprInterleave.dest[i];
+    symbols[dest] = wsprSync[dest] + 2 * data[i];
+  }
+}
+
+struct WSPRSymbolFrame {
+  uint8_t symbols[WSPRSymbolCount];
+};
+
+inline constexpr WSPRSymbolFrame wsprEncodeFrame(const char* callsign, const char* locator, int8_t powerDbm,
+                                                 WSPREncoder::MessageType type) {
+  WSPRSymbolFrame frame{};
+  uint8_t data[WSPRSymbolCount] = {};
+
+  wsprConvolve(wsprPackMessage(wsprMakeMessage(callsign, locator, powerDbm, type)), data);
+  wsprInterleaveSync(data, frame.symbols);
+  return frame;
+}
+
+// 162 two-bit symbols, four to a byte, first symbol in the top bits.
+struct WSPRPackedFrame {
+  uint8_t bytes[(WSPRSymbolCount + 3) / 4];
+
+  constexpr uint8_t symbol(int i) const {
+    return (bytes[i >> 2] >> (6 - 2 * (i & 3))) & 3;
+  }
+};
+
+inline constexpr WSPRPackedFrame wsprPackFrame(const uint8_t symbols[WSPRSymbolCount]) {
+  WSPRPackedFrame packed{};
+  for (int i = 0; i < WSPRSymbolCount; ++i) {
+    packed.bytes[i >> 2] |= (symbols[i] & 3) << (6 - 2 * (i & 3));
+  }
+  return packed;
+}
+
+// A packed frame as the type-erased view the modulator consumes
+inline constexpr SymbolFrame wsprSymbolFrame(const WSPRPackedFrame& frame) {
+  return SymbolFrame{frame.bytes, WSPRSymbolCount, WSPREncoder::ToneSpacing, WSPREncoder::SymbolPeriod,
+                     WSPREncoder::ToneCount, 2};
+}
+
+// Every frame a station alternates between, already packed for transmission.
+struct WSPRFrameSet {
+  int count;
+  WSPREncoder::MessageType types[2];
+  WSPRPackedFrame frames[2];
+};
+
+inline constexpr WSPRFrameSet wsprEncodeFrameSet(const char* callsign, const char* locator, int8_t powerDbm) {
+  WSPRFrameSet set{};
+  set.count = wsprFrameSequence(callsign, locator, set.types);
+
+  for (int i = 0; i < set.count; ++i) {
+    set.frames[i] = wsprPackFrame(wsprEncodeFrame(callsign, locator, powerDbm, set.types[i]).symbols);
+  }
+
+  return set;
+}
+
+// True for a 4 or 6 character Maidenhead locator (case-insensitive subsquare).
+inline constexpr bool wsprIsValidLocator(const char* locator) {
+  int len = wsprStrLen(locator);
+  if (len != 4 && len != 6) return false;
+
+  for (int i = 0; i < 2; ++i) {
+    char c = wsprToUpper(locator[i]);
+    if (c < 'A' || c > 'R') return false;
+    if (!wsprIsDigit(locator[i + 2])) return false;
+  }
+
+  for (int i = 4; i < len; ++i) {
+    char c = wsprToUpper(locator[i]);
+    if (c < 'A' || c > 'X') return false;
+  }
+
+  return true;
+}
+
+// True for a plain callsign that fits the 28-bit callsign field: after
+// normalizing, [0-9A-Z ] [0-9A-Z] [0-9] then three of [A-Z ], with spaces
+// only as padding. wsprPackCallsign() does not check, and anything else
+// packs onto some other callsign's value.
+inline constexpr bool wsprIsValidCallsign(const char* callsign) {
+  int len = wsprStrLen(callsign);
+  if (len < 1 || len > 6) return false;
+  for (int i = 0; i < len; ++i) {
+    char c = wsprToUpper(callsign[i]);
+    if (!wsprIsDigit(c) && (c < 'A' || c > 'Z')) return false;
+  }
+
+  char field[6] = {};
+  wsprNormalizeCallsign(callsign, len, field);
+  int used = len + (field[0] == ' ' ? 1 : 0);
+  if (used > 6 || field[1] == ' ' || !wsprIsDigit(field[2])) return false;
+  for (int i = 3; i < used; ++i) {
+    if (wsprIsDigit(field[i])) return false;
+  }
+  return true;
+}
+
+// Checks a packed frame set symbol for symbol against a fresh unpacked encode.
+// Used to self-check frame sets baked in at compile time.
+inline constexpr bool wsprFrameSetMatches(const WSPRFrameSet& set, const char* callsign, const char* locator,
+                                          int8_t powerDbm) {
+  if (set.count < 1 || set.count > 2) return false;
+
+  for (int f = 0; f < set.count; ++f) {
+    WSPRSymbolFrame expected = wsprEncodeFrame(callsign, locator, powerDbm, set.types[f]);
+
+    for (int i = 0; i < WSPRSymbolCount; ++i) {
+      if (set.frames[f].symbol(i) != expected.symbols[i]) return false;
+    }
+  }
+
+  return true;
+}
+
+#endif // WSPR_PIPELINE_H
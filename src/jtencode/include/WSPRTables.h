@@ -0,0 +1,78 @@
+#ifndef WSPR_TABLES_H
+#define WSPR_TABLES_H
+
+#include <stdint.h>
+
+// Constant tables shared by the WSPR encoders. Everything here is
+// constexpr so it lives in flash and can be used at compile time.
+
+inline constexpr int WSPRSymbolCount = 162;
+
+// WSPR character code: 0-9, A-Z as 10-35, anything else is space (36)
+inline constexpr uint8_t wsprCharCode(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+  return 36;
+}
+
+// Legal WSPR power levels end in 0, 3 or 7 dBm. Round down to one of them
+// so the Type 2 power field never collides with the prefix/suffix marker.
+inline constexpr int8_t wsprPower(int8_t dbm) {
+  if (dbm < 0) return 0;
+  if (dbm > 60) return 60;
+  int units = dbm % 10;
+  return dbm - units + (units >= 7 ? 7 : (units >= 3 ? 3 : 0));
+}
+
+// WSPR 162-bit sync vector. Channel symbol i is wsprSync[i] + 2 * data[i].
+inline constexpr uint8_t wsprSync[WSPRSymbolCount] = {
+  1,1,0,0,0,0,0,0,1,0,0,0,1,1,1,0,0,0,1,0,0,1,0,1,1,1,1,0,0,0,0,0,0,0,1,0,0,1,0,1,
+  0,0,0,0,0,0,1,0,1,1,0,0,1,1,0,1,0,0,0,1,1,0,1,0,0,0,0,1,1,0,1,0,1,0,1,0,1,0,0,1,
+  0,0,1,0,1,1,0,0,0,1,1,0,1,0,1,0,0,0,1,0,0,0,0,0,1,0,0,1,0,0,1,1,1,0,1,1,0,0,1,1,
+  0,1,0,0,0,1,1,1,0,0,0,0,0,1,0,1,0,0,1,1,0,0,0,0,0,0,0,1,1,0,1,0,1,1,0,0,0,1,1,0,
+  0,0
+};
+
+inline constexpr uint8_t bitReverse8(uint8_t b) {
+  uint8_t r = 0;
+  for (int i = 0; i < 8; ++i) r = (r << 1) | ((b >> i) & 1);
+  return r;
+}
+
+// WSPR interleaver: walk i = 0..255, and the next convolutional output bit
+// lands at bitReverse8(i) whenever that index is below 162.
+struct WSPRInterleaveTable {
+  uint8_t dest[WSPRSymbolCount];
+};
+
+inline constexpr WSPRInterleaveTable makeWSPRInterleave() {
+  WSPRInterleaveTable t{};
+  int p = 0;
+
+  for (int i = 0; i < 256 && p < WSPRSymbolCount; ++i) {
+    uint8_t j = bitReverse8(i);
+    if (j < WSPRSymbolCount) t.dest[p++] = j;
+  }
+
+  return t;
+}
+
+inline constexpr WSPRInterleaveTable wsprInterleave = makeWSPRInterleave();
+
+inline constexpr bool isWSPRInterleavePermutation() {
+  bool seen[WSPRSymbolCount] = {};
+
+  for (int i = 0; i < WSPRSymbolCount; ++i) {
+    uint8_t j = wsprInterleave.dest[i];
+    if (j >= WSPRSymbolCount || seen[j]) return false;
+    seen[j] = true;
+  }
+
+  return true;
+}
+
+static_assert(isWSPRInterleavePermutation(), "WSPR interleaver must be a permutation of 0..161");
+static_assert(wsprInterleave.dest[0] == 0 && wsprInterleave.dest[1] == 128 && wsprInterleave.dest[2] == 64,
+              "WSPR interleaver must follow 8-bit bit reversal order");
+
+#endif // WSPR_TABLES_H
@@ -3,7 +3,9 @@
 
 #include <stdint.h>
 
-const uint8_t generator_bits[83][12] = {
+// FT8 LDPC(174,91) generator: row i gives parity bit i as the XOR of the
+// 91 message bits selected by the row, MSB first.
+constexpr uint8_t generator_bits[83][12] = {
     {0b10000011, 0b00101001, 0b11001110, 0b00010001, 0b10111111, 0b00110001, 0b11101010, 0b11110101, 0b00001001, 0b11110010, 0b01111111, 0b11000000},
     {0b01110110, 0b00011100, 0b00100110, 0b01001110, 0b00100101, 0b11000010, 0b01011001, 0b00110011, 0b01010100, 0b10010011, 0b00010011, 0b00100000},
     {0b11011100, 0b00100110, 0b01011001, 0b00000010, 0b11111011, 0b00100111, 0b01111100, 0b01100100, 0b00010000, 0b10100001, 0b10111101, 0b11000000},
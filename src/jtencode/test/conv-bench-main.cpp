@@ -0,0 +1,96 @@
+#include "JTEncode.h"
+#include "ConvEncoder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Throughput benchmark: messages per second for each mode built on the
+// K=32 convolutional code, and the convolution alone bit at a time
+// against the nibble and byte tables.
+
+using NibbleEncoder = ConvEncoder<32, jtConvPoly1, jtConvPoly2, 4>;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Encoder>
+static double timeMessages(const char* name, const std::vector<std::string>& messages, int rounds, unsigned& sink) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (const std::string& m : messages) {
+      Encoder enc;
+      enc.encode(m.c_str());
+      sink += enc.symbols[40];
+    }
+  }
+  double rate = messages.size() * rounds / secondsSince(start);
+  printf("  %-14s %12.0f msg/s\n", name, rate);
+  return rate;
+}
+
+// Times one way of convolving count 72-bit messages, as JT9 does
+template<typename Fn>
+static double timeConvolve(const char* name, const std::vector<uint8_t>& payloads, int rounds, double baseline,
+                           unsigned& sink, Fn convolve) {
+  const size_t count = payloads.size() / 9;
+  uint8_t out[JTConvEncoder::outputBits(72)];
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      convolve(&payloads[i * 9], out);
+      sink += out[20];
+    }
+  }
+  double rate = count * rounds / secondsSince(start);
+  if (baseline > 0) printf("  %-14s %12.0f msg/s  (%.2fx)\n", name, rate, rate / baseline);
+  else printf("  %-14s %12.0f msg/s\n", name, rate);
+  return rate;
+}
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < count; ++i) {
+    char msg[32];
+    snprintf(msg, sizeof(msg), "K%d%c%c%c %c%c%d%d", (int) (i % 10), 'A' + (int) (i % 26),
+             'A' + (int) (i / 26 % 26), 'A' + (int) (i / 676 % 26), 'A' + (int) (i % 18),
+             'A' + (int) (i / 18 % 18), (int) (i / 7 % 10), (int) (i / 3 % 10));
+    messages.push_back(msg);
+  }
+
+  unsigned sink = 0;
+  printf("Encode throughput, %zu messages x %d rounds\n", count, rounds);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      WSPREncoder enc;
+      enc.encode(messages[i].substr(0, 6).c_str(), "FN42", 37);
+      sink += enc.symbols[40];
+    }
+  }
+  printf("  %-14s %12.0f msg/s\n", "WSPREncoder", count * rounds / secondsSince(start));
+  timeMessages<JT9Encoder>("JT9Encoder", messages, rounds, sink);
+
+  std::vector<uint8_t> payloads(count * 9);
+  for (size_t i = 0; i < payloads.size(); ++i) payloads[i] = (uint8_t) (i * 2654435761u >> 13);
+
+  printf("\nK=32 convolution of 72-bit messages\n");
+  double bitwise = timeConvolve("bit-at-a-time", payloads, rounds, 0, sink, [](const uint8_t* m, uint8_t* out) {
+    JTConvEncoder::encodeReference(m, 72, out);
+  });
+  timeConvolve("nibble tables", payloads, rounds, bitwise, sink, [](const uint8_t* m, uint8_t* out) {
+    NibbleEncoder::encode(m, 72, out);
+  });
+  timeConvolve("byte tables", payloads, rounds, bitwise, sink, [](const uint8_t* m, uint8_t* out) {
+    JTConvEncoder::encode(m, 72, out);
+  });
+
+  return sink == 0xFFFFFFFF;
+}
@@ -0,0 +1,103 @@
+#include "ConvEncoder.h"
+#include "WSPRPipeline.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+// Encodes random messages of every length up to maxBits with encode() and
+// encodeBits() and compares both against the bit-at-a-time reference.
+template<typename Encoder>
+static bool matchesReference(int maxBits, int rounds) {
+  uint32_t seed = 7;
+  uint8_t data[16];
+  uint8_t packed[Encoder::outputBytes(128)];
+  uint8_t bits[Encoder::outputBits(128)];
+  uint8_t expected[Encoder::outputBits(128)];
+
+  for (int inputBits = 1; inputBits <= maxBits; ++inputBits) {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint8_t& b : data) {
+        seed = seed * 1103515245 + 12345;
+        b = seed >> 16;
+      }
+
+      // Bits past inputBits are garbage and must be ignored
+      Encoder::encodeReference(data, inputBits, expected);
+      memset(packed, 0xA5, sizeof(packed));
+      Encoder::encode(data, inputBits, packed);
+      Encoder::encodeBits(data, inputBits, bits);
+
+      const int n = Encoder::outputBits(inputBits);
+      for (int i = 0; i < n; ++i) {
+        if (bits[i] != expected[i]) return false;
+        if (((packed[i >> 3] >> (7 - (i & 7))) & 1) != expected[i]) return false;
+      }
+      for (int i = n; i < Encoder::outputBytes(inputBits) * 8; ++i) {
+        if ((packed[i >> 3] >> (7 - (i & 7))) & 1) return false;
+      }
+    }
+  }
+  return true;
+}
+
+// First output bits of a single 1 bit are the polynomials' top bits, one of each
+template<typename Encoder>
+static constexpr bool impulseMatches(uint32_t poly1, uint32_t poly2, int k) {
+  uint8_t one[1] = {0x80};
+  uint8_t bits[Encoder::outputBits(1)] = {};
+  Encoder::encodeBits(one, 1, bits);
+  for (int i = 0; i < k; ++i) {
+    if (bits[2 * i] != ((poly1 >> i) & 1) || bits[2 * i + 1] != ((poly2 >> i) & 1)) return false;
+  }
+  return true;
+}
+
+static_assert(impulseMatches<JTConvEncoder>(jtConvPoly1, jtConvPoly2, 32),
+              "The impulse response of a convolutional code is its polynomials");
+
+using NibbleEncoder = ConvEncoder<32, jtConvPoly1, jtConvPoly2, 4>;
+using ShortEncoder = ConvEncoder<7, 0x4F, 0x6D>;         // K=7 (171,133 octal, reversed)
+using ShortNibbleEncoder = ConvEncoder<7, 0x4F, 0x6D, 4>;
+
+int main() {
+  std::cout << "Starting ConvEncoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Table Encoder vs Bit-at-a-Time Reference ---" << std::endl;
+  check("K=32 byte tables, 1..128 bits", matchesReference<JTConvEncoder>(128, 20));
+  check("K=32 nibble tables, 1..128 bits", matchesReference<NibbleEncoder>(128, 20));
+  check("K=7 byte tables, 1..128 bits", matchesReference<ShortEncoder>(128, 20));
+  check("K=7 nibble tables, 1..128 bits", matchesReference<ShortNibbleEncoder>(128, 20));
+
+  std::cout << "\n--- Test Case 2: Sizes ---" << std::endl;
+  check("WSPR: 50 bits -> 162 coded bits", JTConvEncoder::outputBits(50) == 162);
+  check("JT9/JT4: 72 bits -> 206 coded bits", JTConvEncoder::outputBits(72) == 206);
+  check("Byte tables: 5 lanes for K=32", JTConvEncoder::Lanes == 5);
+  check("Nibble tables: 9 lanes for K=32", NibbleEncoder::Lanes == 9);
+  check("Nibble tables fit in 288 bytes", sizeof(NibbleEncoder::Tables) == 288);
+
+  std::cout << "\n--- Test Case 3: WSPR Golden Frame Through ConvEncoder ---" << std::endl;
+  {
+    // K1ABC FN42 37 as a packed 50-bit message, interleaved with sync
+    constexpr uint64_t packed = wsprPackMessage(wsprMakeMessage("K1ABC", "FN42", 37, WSPREncoder::TYPE1));
+    uint8_t data[WSPRSymbolCount], symbols[WSPRSymbolCount];
+    wsprConvolve(packed, data);
+    wsprInterleaveSync(data, symbols);
+
+    const char* golden = "330020001020131222100323133220200032012322002232110233"
+                         "210221321222033030301210212032132003323032203020201023"
+                         "021112330231212221332000010320132222202332323320031222";
+    bool ok = true;
+    for (int i = 0; i < WSPRSymbolCount; ++i) ok &= symbols[i] == golden[i] - '0';
+    check("K1ABC FN42 37", ok);
+  }
+
+  std::cout << "\nConvEncoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+#include "JTEncode.h"
+#include "ModeDescriptor.h"
+#include "WSPRPipeline.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <cstring>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static int getBit(const uint8_t* bytes, int bit) {
+  return (bytes[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+// Bit-at-a-time CRC-24 over the 77-bit payload
+static uint32_t referenceCrc24(const uint8_t payload[10]) {
+  uint32_t r = 0;
+  for (int i = 0; i < FST4WEncoder::PayloadBits; ++i) {
+    int top = ((r >> 23) & 1) ^ getBit(payload, i);
+    r = (r << 1) & 0xFFFFFF;
+    if (top) r ^= 0x00065B;
+  }
+  return r;
+}
+
+static bool isSyncSymbol(int i) {
+  return i % 38 < 8;
+}
+
+// Undoes the Gray mapping of the data symbols back into the codeword
+static void dataBits(const FST4WEncoder& enc, uint8_t codeword[30]) {
+  static const uint8_t grayInverse[4] = {0, 1, 3, 2};
+  memset(codeword, 0, 30);
+  int bit = 0;
+  for (int i = 0; i < FST4WEncoder::TxBufferSize; ++i) {
+    if (isSyncSymbol(i)) continue;
+    int pair = grayInverse[enc.symbols[i] & 3];
+    codeword[bit >> 3] |= ((pair >> 1) & 1) << (7 - (bit & 7));
+    ++bit;
+    codeword[bit >> 3] |= (pair & 1) << (7 - (bit & 7));
+    ++bit;
+  }
+}
+
+int main() {
+  std::cout << "Starting FST4W Encoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: CRC-24 Against Bitwise Reference ---" << std::endl;
+  {
+    uint32_t seed = 4242;
+    bool match = true;
+    for (int n = 0; n < 2000; ++n) {
+      uint8_t payload[10];
+      for (int i = 0; i < 10; ++i) {
+        seed = seed * 1103515245 + 12345;
+        payload[i] = seed >> 16;
+      }
+      payload[9] &= 0xF8;
+      match &= FST4WEncoder::crc24(payload) == referenceCrc24(payload);
+    }
+    check("Table CRC-24 matches bitwise CRC-24", match);
+
+    uint8_t zero[10] = {};
+    check("CRC-24 of the zero payload is zero", FST4WEncoder::crc24(zero) == 0);
+  }
+
+  std::cout << "\n--- Test Case 2: LDPC(240,101) Codeword ---" << std::endl;
+  {
+    uint32_t seed = 99;
+    bool systematic = true, linear = true;
+    for (int n = 0; n < 500; ++n) {
+      uint8_t a[13], b[13], sum[13];
+      for (int i = 0; i < 13; ++i) {
+        seed = seed * 1103515245 + 12345;
+        a[i] = seed >> 16;
+        seed = seed * 1103515245 + 12345;
+        b[i] = seed >> 16;
+      }
+      a[12] &= 0xF8;
+      b[12] &= 0xF8;
+      for (int i = 0; i < 13; ++i) sum[i] = a[i] ^ b[i];
+
+      uint8_t ca[30], cb[30], cs[30];
+      FST4WEncoder::encodeLdpc(a, ca);
+      FST4WEncoder::encodeLdpc(b, cb);
+      FST4WEncoder::encodeLdpc(sum, cs);
+
+      for (int i = 0; i < FST4WEncoder::MessageBits; ++i) systematic &= getBit(ca, i) == getBit(a, i);
+      for (int i = 0; i < 30; ++i) linear &= cs[i] == (ca[i] ^ cb[i]);
+    }
+    check("Codeword starts with the 101 message bits", systematic);
+    check("Encoding is linear over GF(2)", linear);
+
+    uint8_t zero[13] = {}, codeword[30];
+    FST4WEncoder::encodeLdpc(zero, codeword);
+    bool allZero = true;
+    for (uint8_t byte : codeword) allZero &= byte == 0;
+    check("Zero message encodes to the zero codeword", allZero);
+  }
+
+  std::cout << "\n--- Test Case 3: Sync and Tones ---" << std::endl;
+  {
+    static const uint8_t sync1[8] = {0, 1, 3, 2, 1, 0, 2, 3};
+    static const uint8_t sync2[8] = {2, 3, 1, 0, 3, 2, 0, 1};
+    FST4WEncoder enc;
+    enc.encode("K1ABC", "FN42", 37);
+
+    bool sync = true;
+    for (int block = 0; block < 5; ++block) {
+      for (int k = 0; k < 8; ++k) sync &= enc.symbols[38 * block + k] == ((block & 1) ? sync2[k] : sync1[k]);
+    }
+    check("Sync words at symbols 0, 38, 76, 114 and 152", sync);
+
+    bool inRange = true;
+    for (int i = 0; i < FST4WEncoder::TxBufferSize; ++i) inRange &= enc.symbols[i] <= 3;
+    check("All tones in 0..3", inRange);
+
+    SymbolFrame frame = enc.frame();
+    check("Frame view has 160 four-tone symbols", frame.count == 160 && frame.toneCount == 4);
+  }
+
+  std::cout << "\n--- Test Case 4: Payload Round Trip ---" << std::endl;
+  {
+    struct Station {
+      const char* callsign;
+      const char* locator;
+      int8_t powerDbm;
+      WSPREncoder::MessageType type;
+    };
+    static const Station stations[] = {
+      {"K1ABC", "FN42", 37, WSPREncoder::TYPE1},
+      {"G4ABC", "IO91", 20, WSPREncoder::TYPE1},
+      {"PJ4/K1ABC", "FN42", 30, WSPREncoder::TYPE2},
+      {"K1ABC", "FN42ab", 10, WSPREncoder::TYPE3},
+    };
+    for (const Station& s : stations) {
+      FST4WEncoder enc;
+      enc.encode(s.callsign, s.locator, s.powerDbm, s.type);
+
+      uint8_t codeword[30];
+      dataBits(enc, codeword);
+
+      uint64_t n = wsprPackMessage(wsprMakeMessage(s.callsign, s.locator, s.powerDbm, s.type));
+      uint64_t carried = 0;
+      for (int i = 0; i < 50; ++i) carried = (carried << 1) | getBit(codeword, i);
+      bool padded = true;
+      for (int i = 50; i < FST4WEncoder::PayloadBits; ++i) padded &= getBit(codeword, i) == 0;
+
+      uint32_t crc = 0;
+      for (int i = 0; i < 24; ++i) crc = (crc << 1) | getBit(codeword, FST4WEncoder::PayloadBits + i);
+
+      uint8_t expected[30];
+      uint8_t message[13] = {};
+      memcpy(message, codeword, 13);
+      message[12] &= 0xF8;
+      FST4WEncoder::encodeLdpc(message, expected);
+
+      std::string name = std::string(s.callsign) + " " + s.locator;
+      check(name + " carries the WSPR message", carried == n && padded);
+      check(name + " CRC-24 matches", crc == FST4WEncoder::crc24(codeword));
+      check(name + " parity matches", !memcmp(codeword, expected, sizeof(expected)));
+    }
+  }
+
+  std::cout << "\n--- Test Case 5: Mode Descriptors ---" << std::endl;
+  {
+    check("WSPR is 110.592 s at 1.4648 Hz", wsprMode.durationSec() == 110.592 &&
+          std::fabs(wsprMode.toneSpacingHz() - 1.46484375) < 1e-12);
+    check("FST4W-120 is 109.3 s at 1.4634 Hz", std::fabs(fst4w120Mode.durationSec() - 109.333) < 0.001 &&
+          std::fabs(fst4w120Mode.toneSpacingHz() - 1.46341) < 0.0001);
+    check("FST4W-300 is 286.7 s at 0.558 Hz", std::fabs(fst4w300Mode.durationSec() - 286.72) < 0.001 &&
+          std::fabs(fst4w300Mode.toneSpacingHz() - 0.55804) < 0.0001);
+    check("FST4W-900 is 887.5 s at 0.180 Hz", std::fabs(fst4w900Mode.durationSec() - 887.467) < 0.001 &&
+          std::fabs(fst4w900Mode.toneSpacingHz() - 0.18029) < 0.0001);
+    check("FST4W-1800 is 1792 s at 0.0893 Hz", fst4w1800Mode.durationSec() == 1792.0 &&
+          std::fabs(fst4w1800Mode.toneSpacingHz() - 0.089286) < 0.000001);
+
+    bool fits = true;
+    for (const ModeDescriptor* mode : allModes) {
+      fits &= mode->durationSec() + ModeDescriptor::StartOffsetSec < mode->slotSeconds;
+      fits &= mode->toneCount <= ModeMaxTones;
+    }
+    check("Every mode fits its slot", fits);
+
+    check("findBeaconMode is case-insensitive", findBeaconMode("wspr") == &wsprMode);
+    check("findBeaconMode does not offer unverified FST4W", findBeaconMode("FST4W-900") == &wsprMode &&
+          findBeaconMode("FST4W-120") == &wsprMode);
+    check("findBeaconMode falls back to WSPR", findBeaconMode("JT65") == &wsprMode &&
+          findBeaconMode(nullptr) == &wsprMode);
+
+    double tones[ModeMaxTones];
+    fst4w300Mode.toneTable(474200.0, tones);
+    bool spaced = true;
+    for (int i = 0; i < 4; ++i) spaced &= std::fabs(tones[i] - (474200.0 + i * 12000.0 / 21504)) < 1e-9;
+    check("Tone table steps by the mode's spacing", spaced);
+  }
+
+  std::cout << "\nFST4W Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include "JTEncode.h"
+#include "generator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Throughput benchmark: FT8 messages per second for the full encoder, and
+// the 64-bit word LDPC encoder against a bytewise parity loop.
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Parity of each generator row over the message, a byte at a time
+static void bytewiseLdpc(const uint8_t message[12], uint8_t codeword[22]) {
+  memcpy(codeword, message, 12);
+  codeword[11] &= 0xE0;
+  memset(codeword + 12, 0, 10);
+  for (int i = 0; i < 83; ++i) {
+    uint8_t sum = 0;
+    for (int j = 0; j < 12; ++j) sum ^= message[j] & generator_bits[i][j];
+    int bit = FT8Encoder::MessageBits + i;
+    codeword[bit >> 3] |= __builtin_parity(sum) << (7 - (bit & 7));
+  }
+}
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < count; ++i) {
+    char msg[32];
+    snprintf(msg, sizeof(msg), "K%d%c%c%c W9XYZ %c%c%d%d", (int) (i % 10), 'A' + (int) (i % 26),
+             'A' + (int) (i / 26 % 26), 'A' + (int) (i / 676 % 26), 'A' + (int) (i % 18),
+             'A' + (int) (i / 18 % 18), (int) (i / 7 % 10), (int) (i / 3 % 10));
+    messages.push_back(msg);
+  }
+
+  printf("FT8 encode throughput, %zu messages x %d rounds\n", count, rounds);
+
+  unsigned sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      FT8Encoder enc;
+      enc.encode(messages[i].c_str());
+      sink += enc.symbols[40];
+    }
+  }
+  printf("  %-12s %12.0f msg/s\n", "FT8Encoder", count * rounds / secondsSince(start));
+
+  std::vector<uint8_t> payloads(count * 12);
+  for (size_t i = 0; i < payloads.size(); ++i) payloads[i] = (uint8_t) (i * 2654435761u >> 13);
+
+  uint8_t codeword[22];
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      bytewiseLdpc(&payloads[i * 12], codeword);
+      sink += codeword[20];
+    }
+  }
+  double bytewise = secondsSince(start);
+  printf("  %-12s %12.0f msg/s\n", "LDPC/bytes", count * rounds / bytewise);
+
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      FT8Encoder::encodeLdpc(&payloads[i * 12], codeword);
+      sink += codeword[20];
+    }
+  }
+  double words = secondsSince(start);
+  printf("  %-12s %12.0f msg/s  (%.2fx)\n", "LDPC/words", count * rounds / words, bytewise / words);
+
+  return sink == 0xFFFFFFFF;
+}
@@ -0,0 +1,165 @@
+#include "JTEncode.h"
+#include "generator.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+// Golden channel tones (79 symbols as digits 0..7) produced by the
+// reference FT8 encoding process, with the CRC-14 of each payload.
+struct GoldenVector {
+  const char* message;
+  uint16_t crc;
+  const char* tones;
+};
+
+static const GoldenVector goldenVectors[] = {
+  {"CQ K1ABC FN42", 2862,
+      "3140652000000001005476704606021533433140652736011047517007334745455133543140652"},
+  {"K1ABC W9XYZ -11", 11905,
+      "3140652032247523504061147017463022603140652054445103423557634070241144523140652"},
+  {"W9XYZ K1ABC R-09", 11005,
+      "3140652020355725005476704627463523673140652461375524341536404620765601323140652"},
+  {"K1ABC W9XYZ RR73", 11883,
+      "3140652032247523504061147017455422543140652656077704107145041657342273103140652"},
+  {"W9XYZ K1ABC 73", 15642,
+      "3140652020355725005476704617456027313140652614507505233746545070403065563140652"},
+  {"CQ DX K1ABC FN42", 14501,
+      "3140652000001047505476704606021524133140652372603155376066613120704715013140652"},
+  {"CQ 123 K1ABC FN42", 14019,
+      "3140652000000077005476704606021526653140652151275706500005203744035713163140652"},
+  {"G4ABC/P PA9XYZ JO22", 5874,
+      "3140652033040342222473413510546556673140652125365204412473533331244335523140652"},
+  {"K1ABC/R W9XYZ EN37", 3274,
+      "3140652032247523404061147005134332153140652623707512241501513760247527103140652"},
+  {"QRZ VK2ABC QF56", 4948,
+      "3140652000000000641001102014362035463140652336350255136460070563251447213140652"},
+  {"K1ABC W9XYZ RRR", 6080,
+      "3140652032247523504061147017455536753140652026476123033360147535031332563140652"},
+  {"K1ABC W9XYZ", 14954,
+      "3140652032247523504061147017455324543140652615750275761167565315424251233140652"},
+};
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static std::string toneString(const FT8Encoder& enc) {
+  std::string s;
+  for (int i = 0; i < FT8Encoder::TxBufferSize; ++i) s += (char) ('0' + enc.symbols[i]);
+  return s;
+}
+
+static int getBit(const uint8_t* bytes, int bit) {
+  return (bytes[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+// Bit-at-a-time CRC-14 over the zero-padded 82-bit payload
+static uint16_t referenceCrc14(const uint8_t payload[10]) {
+  uint16_t r = 0;
+  for (int i = 0; i < 82; ++i) {
+    int in = i < FT8Encoder::PayloadBits ? getBit(payload, i) : 0;
+    int top = ((r >> 13) & 1) ^ in;
+    r = (r << 1) & 0x3FFF;
+    if (top) r ^= 0x2757;
+  }
+  return r;
+}
+
+// Byte-at-a-time LDPC parity straight from generator_bits
+static void referenceLdpc(const uint8_t message[12], uint8_t codeword[22]) {
+  memset(codeword, 0, 22);
+  for (int i = 0; i < FT8Encoder::MessageBits; ++i) codeword[i >> 3] |= getBit(message, i) << (7 - (i & 7));
+  for (int i = 0; i < 83; ++i) {
+    int parity = 0;
+    for (int j = 0; j < FT8Encoder::MessageBits; ++j) parity ^= getBit(message, j) & getBit(generator_bits[i], j);
+    int bit = FT8Encoder::MessageBits + i;
+    codeword[bit >> 3] |= parity << (7 - (bit & 7));
+  }
+}
+
+int main() {
+  std::cout << "Starting FT8 Encoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Golden Tone Vectors ---" << std::endl;
+  for (const GoldenVector& v : goldenVectors) {
+    FT8Encoder enc;
+    enc.encode(v.message);
+    check(std::string(v.message) + " tones", enc.isValid() && toneString(enc) == v.tones);
+
+    uint8_t payload[10] = {};
+    check(std::string(v.message) + " CRC-14", FT8Encoder::pack77(v.message, payload) &&
+          FT8Encoder::crc14(payload) == v.crc);
+  }
+
+  std::cout << "\n--- Test Case 2: Payload Packing ---" << std::endl;
+  {
+    // c28 = 2 (CQ), c28 = " K1ABC", g15 = FN42, i3 = 1
+    const char* expected = "00000000000000000000000000100000010011011110111100011010100010100001100110001";
+    uint8_t payload[10] = {};
+    FT8Encoder::pack77("CQ K1ABC FN42", payload);
+    std::string bits;
+    for (int i = 0; i < FT8Encoder::PayloadBits; ++i) bits += (char) ('0' + getBit(payload, i));
+    check("CQ K1ABC FN42 payload bits", bits == expected);
+
+    uint8_t lower[10] = {};
+    FT8Encoder::pack77("  cq k1abc fn42 ", lower);
+    check("Case and spacing are ignored", !memcmp(payload, lower, sizeof(payload)));
+  }
+
+  std::cout << "\n--- Test Case 3: Unsupported Messages ---" << std::endl;
+  {
+    const char* invalid[] = {
+      "", "CQ", "HELLO WORLD", "CQ K1ABC FN42 EXTRA JUNK", "K1ABC W9XYZ FN4",
+      "K1ABC W9XYZ -31", "K1ABC/R W9XYZ/P FN42", "<K1ABC> W9XYZ", "K1ABCDEF W9XYZ"
+    };
+    for (const char* message : invalid) {
+      FT8Encoder enc;
+      enc.encode(message);
+      bool zeroed = true;
+      for (int i = 0; i < FT8Encoder::TxBufferSize; ++i) zeroed &= enc.symbols[i] == 0;
+      check(std::string("Rejects \"") + message + "\"", !enc.isValid() && zeroed);
+    }
+  }
+
+  std::cout << "\n--- Test Case 4: CRC-14 and LDPC Against Bitwise References ---" << std::endl;
+  {
+    uint32_t seed = 2024;
+    bool crcMatch = true, ldpcMatch = true;
+    for (int n = 0; n < 2000; ++n) {
+      uint8_t message[12];
+      for (int i = 0; i < 12; ++i) {
+        seed = seed * 1103515245 + 12345;
+        message[i] = seed >> 16;
+      }
+      message[9] &= 0xF8;
+      crcMatch &= FT8Encoder::crc14(message) == referenceCrc14(message);
+
+      uint8_t fast[22], slow[22];
+      FT8Encoder::encodeLdpc(message, fast);
+      referenceLdpc(message, slow);
+      ldpcMatch &= !memcmp(fast, slow, sizeof(fast));
+    }
+    check("Table CRC-14 matches bitwise CRC-14", crcMatch);
+    check("64-bit LDPC parity matches bytewise parity", ldpcMatch);
+  }
+
+  std::cout << "\n--- Test Case 5: Costas Sync ---" << std::endl;
+  {
+    static const uint8_t costas[7] = {3, 1, 4, 0, 6, 5, 2};
+    FT8Encoder enc;
+    enc.encode("K1ABC W9XYZ -11");
+    bool sync = true;
+    for (int i = 0; i < 7; ++i) sync &= enc.symbols[i] == costas[i] && enc.symbols[36 + i] == costas[i] &&
+                                        enc.symbols[72 + i] == costas[i];
+    check("Costas arrays at symbols 0, 36 and 72", sync);
+    bool inRange = true;
+    for (int i = 0; i < FT8Encoder::TxBufferSize; ++i) inRange &= enc.symbols[i] <= 7;
+    check("All tones in 0..7", inRange);
+  }
+
+  std::cout << "\nFT8 Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
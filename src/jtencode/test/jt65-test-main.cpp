@@ -0,0 +1,94 @@
+#include "JTEncode.h"
+#include <iostream>
+#include <string>
+
+// Golden channel tones (126 symbols as two-digit tone numbers 00..65)
+// produced by the reference JT65 encoding process.
+struct GoldenVector {
+  const char* message;
+  const char* tones;
+};
+
+static const GoldenVector goldenVectors[] = {
+  {"NT7S CN85",
+      "004838000021606300000000000033001600071765005700003125005955240000005918000000001500"
+      "004100000000076423000002005000520000413600004300050046002558006517301542520000523009"
+      "400710240000570056360052000050003500070038090000484600303400115609200000000000000000"},
+  {"CQ K1ABC FN42",
+      "006518000034045700000000000027002700453627000600005942001015110000001936000000005800"
+      "004800000000210826000009001700290000612200002200360058006109004742185055620000305111"
+      "102963450000130003390013000058005900330036320000090900203100455612550000000000000000"},
+  {"TEST 123 -/.?",
+      "000663000046506000000000000020002000380726003300004254000460270000004611000000006500"
+      "003800000000491753000040004400640000430400003300620041001610004752133402410000542064"
+      "650923260000510056530002000024001900170062200000252000093800210442580000000000000000"},
+  {"hello world",
+      "003125000062503600000000000008004100112528005700001749001418440000001327000000006500"
+      "006500000000111262000002004800230000175600005600640053005041002258271764540000380506"
+      "431561120000430065450041000017002100340035550000276200640600572844500000000000000000"},
+  {"R3PTAR ABCDEFG",
+      "004555000021073300000000000027006400615715005500006037001023590000001230000000005000"
+      "000900000000232525000053005500620000624900004800540022001902004512156104460000473306"
+      "410613320000080049230011000045005300340058440000356000280400084105580000000000000000"},
+};
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static std::string toneString(const JT65Encoder& enc) {
+  std::string s;
+  for (int i = 0; i < JT65Encoder::TxBufferSize; ++i) {
+    s += (char) ('0' + enc.symbols[i] / 10);
+    s += (char) ('0' + enc.symbols[i] % 10);
+  }
+  return s;
+}
+
+int main() {
+  std::cout << "Starting JT65 Encoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Golden Tone Vectors ---" << std::endl;
+  for (const GoldenVector& v : goldenVectors) {
+    JT65Encoder enc;
+    enc.encode(v.message);
+    check(std::string(v.message) + " tones", toneString(enc) == v.tones);
+  }
+
+  std::cout << "\n--- Test Case 2: Message Preparation ---" << std::endl;
+  {
+    JT65Encoder upper, lower, padded, truncated;
+    upper.encode("HELLO WORLD");
+    lower.encode("hello world");
+    padded.encode("HELLO WORLD  ");
+    truncated.encode("HELLO WORLD  EXTRA");
+    check("Lowercase folds to uppercase", toneString(upper) == toneString(lower));
+    check("Short messages pad with spaces", toneString(upper) == toneString(padded));
+    check("Long messages truncate at 13 characters", toneString(upper) == toneString(truncated));
+
+    JT65Encoder invalid, spaced;
+    invalid.encode("A#B");
+    spaced.encode("A B");
+    check("Unsupported characters send as spaces", toneString(invalid) == toneString(spaced));
+  }
+
+  std::cout << "\n--- Test Case 3: Sync Pattern ---" << std::endl;
+  {
+    JT65Encoder enc;
+    enc.encode("CQ K1ABC FN42");
+    int syncTones = 0;
+    bool inRange = true;
+    for (int i = 0; i < JT65Encoder::TxBufferSize; ++i) {
+      syncTones += enc.symbols[i] == 0;
+      inRange &= enc.symbols[i] <= 65;
+    }
+    check("63 sync tones and 63 data tones", syncTones == 63);
+    check("All tones in 0..65", inRange);
+  }
+
+  std::cout << "\nJT65 Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+#include "JTEncode.h"
+#include <iostream>
+#include <string>
+
+// Golden channel tones (85 symbols, tones 0..8) produced by the reference
+// JT9 encoding process.
+struct GoldenVector {
+  const char* message;
+  const char* tones;
+};
+
+static const GoldenVector goldenVectors[] = {
+  {"NT7S CN85", "0068053680651160574756073142645303014547282653883100280578702162606313610173448282010"},
+  {"CQ K1ABC FN42", "0018073140256570477157078325886502075438458223214700110621806537804725820377617552010"},
+  {"TEST 123 -/.?", "0081017450183750252465047441342504053361331236767800570824504557607663210336636251040"},
+  {"hello world", "0036073470732480324161058224425308047376344532437200120552502483202138180228317812010"},
+  {"R3PTAR ABCDEFG", "0065054660365750547541087872233505036321341147482100320386306425607851270572156755010"},
+};
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static std::string toneString(const JT9Encoder& enc) {
+  std::string s;
+  for (int i = 0; i < JT9Encoder::TxBufferSize; ++i) s += (char) ('0' + enc.symbols[i]);
+  return s;
+}
+
+int main() {
+  std::cout << "Starting JT9 Encoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Golden Tone Vectors ---" << std::endl;
+  for (const GoldenVector& v : goldenVectors) {
+    JT9Encoder enc;
+    enc.encode(v.message);
+    check(std::string(v.message) + " tones", toneString(enc) == v.tones);
+  }
+
+  std::cout << "\n--- Test Case 2: Message Preparation ---" << std::endl;
+  {
+    JT9Encoder upper, lower, padded, truncated;
+    upper.encode("HELLO WORLD");
+    lower.encode("hello world");
+    padded.encode("HELLO WORLD  ");
+    truncated.encode("HELLO WORLD  EXTRA");
+    check("Lowercase folds to uppercase", toneString(upper) == toneString(lower));
+    check("Short messages pad with spaces", toneString(upper) == toneString(padded));
+    check("Long messages truncate at 13 characters", toneString(upper) == toneString(truncated));
+  }
+
+  std::cout << "\n--- Test Case 3: Sync Pattern ---" << std::endl;
+  {
+    static const int syncPositions[JT9Encoder::SyncSymbols] = {0, 1, 4, 9, 15, 22, 32, 34,
+                                                               50, 51, 54, 59, 65, 72, 82, 84};
+    JT9Encoder enc;
+    enc.encode("CQ K1ABC FN42");
+    bool syncOk = true, dataOk = true;
+    int s = 0;
+    for (int i = 0; i < JT9Encoder::TxBufferSize; ++i) {
+      if (s < JT9Encoder::SyncSymbols && syncPositions[s] == i) {
+        syncOk &= enc.symbols[i] == 0;
+        ++s;
+      } else {
+        dataOk &= enc.symbols[i] >= 1 && enc.symbols[i] <= 8;
+      }
+    }
+    check("16 sync symbols send tone 0", syncOk);
+    check("69 data symbols send tones 1..8", dataOk && JT9Encoder::TxBufferSize - s == JT9Encoder::DataSymbols);
+  }
+
+  std::cout << "\nJT9 Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+#include "JTEncode.h"
+#include "SymbolRenderer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Real-time factor of SymbolRenderer: seconds of signal rendered per second
+// of wall time, for the vector NCO alone and for whole WSPR frames streamed
+// to a WAV file, against a per-sample sin()/cos() oscillator.
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The obvious oscillator: one double-precision sin/cos per sample
+static void scalarRender(float* out, int count, double hz, double& phase, bool iq) {
+  const double step = 6.283185307179586 * hz / 12000;
+  for (int i = 0; i < count; ++i) {
+    if (iq) {
+      out[2 * i] = (float) (0.5 * cos(phase));
+      out[2 * i + 1] = (float) (0.5 * sin(phase));
+    } else {
+      out[i] = (float) (0.5 * cos(phase));
+    }
+    phase = fmod(phase + step, 6.283185307179586);
+  }
+}
+
+int main(int argc, char** argv) {
+  int frames = argc > 1 ? atoi(argv[1]) : 4;
+  const char* path = argc > 2 ? argv[2] : "/dev/null";
+  const int chunk = 2048;
+  const double frameSec = 162 * 8192 / 12000.0;
+
+  WSPREncoder enc;
+  enc.encode("K1ABC", "FN42", 37);
+  std::vector<float> out(2 * chunk);
+  float sink = 0;
+
+  printf("Render real-time factor, %d WSPR frames (%.0f s of signal)\n", frames, frames * frameSec);
+
+  for (int iq = 0; iq < 2; ++iq) {
+    const char* name = iq ? "IQ" : "audio";
+    const size_t samples = (size_t) frames * 162 * 8192;
+
+    auto start = std::chrono::steady_clock::now();
+    double phase = 0;
+    for (size_t done = 0; done < samples; done += chunk) {
+      scalarRender(out.data(), chunk, 1500.0 + (done / 8192 % 4) * 1.46, phase, iq);
+      sink += out[7];
+    }
+    double scalar = samples / 12000.0 / secondsSince(start);
+
+    SymbolRenderer::Options options;
+    options.format = iq ? SymbolRenderer::IQ : SymbolRenderer::AUDIO;
+    SymbolRenderer nco("/dev/null", options);
+    nco.startSymbolStream(0);
+    start = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < samples; done += chunk) {
+      nco.render(out.data(), chunk);
+      sink += out[7];
+    }
+    double vector = samples / 12000.0 / secondsSince(start);
+
+    // Whole frames through the SymbolOutputIntf calls, quantized and written
+    int64_t now = 0;
+    options.leadInSec = options.leadOutSec = 0;
+    SymbolRenderer renderer(path, options, [&now]() { return now; });
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+      renderer.startSymbolStream(enc.symbols[0]);
+      for (int k = 0; k < 162; ++k) {
+        now = (int64_t) ((f * 163 + k) * 8192e6 / 12000);
+        renderer.outputSymbol(k, enc.symbols[k]);
+      }
+      now += (int64_t) (8192e6 / 12000);
+      renderer.endSymbolStream();
+    }
+    double streamed = frames * frameSec / secondsSince(start);
+
+    printf("  %-6s scalar sin/cos %9.0fx   vector NCO %9.0fx (%.1fx)   to WAV %9.0fx\n", name, scalar, vector,
+           vector / scalar, streamed);
+  }
+
+  return sink == 12345.0f;
+}
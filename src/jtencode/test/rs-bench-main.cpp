@@ -0,0 +1,85 @@
+#include "RSEncode.h"
+#include "RSEncoder.h"
+#include "RSDecoder.h"
+#include "JTEncode.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Throughput benchmark: blocks per second for the runtime RSEncode class
+// and the fixed-parameter RSEncoder template, for JT65 RS(63,12) and a
+// CCSDS-style RS(255,223), the complete JT65 encoder, and RSDecoder
+// syndrome evaluation with each supported kernel.
+
+// Keeps the optimizer from discarding the encoded output
+static unsigned sink = 0;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Encoder>
+static void compare(const char* name, int gfPoly, int fcr, int prim, size_t blocks) {
+  constexpr int nroots = Encoder::NN - Encoder::MaxDataSymbols;
+  const int count = Encoder::MaxDataSymbols;
+  RSEncode runtime(__builtin_ctz(Encoder::NN + 1), gfPoly, fcr, prim, nroots, 0);
+
+  std::vector<uint8_t> data(blocks * count);
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (uint8_t) (i * 2654435761u >> 11) & Encoder::NN;
+
+  std::vector<uint8_t> block(count), parityVector;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t b = 0; b < blocks; ++b) {
+    block.assign(data.begin() + b * count, data.begin() + (b + 1) * count);
+    runtime.encode(block, parityVector);
+    sink += parityVector[0];
+  }
+  double slow = secondsSince(start);
+
+  uint8_t parity[nroots];
+  start = std::chrono::steady_clock::now();
+  for (size_t b = 0; b < blocks; ++b) {
+    Encoder::encode(&data[b * count], count, parity);
+    sink += parity[0];
+  }
+  double fast = secondsSince(start);
+
+  printf("  %-14s RSEncode %10.0f blocks/s   RSEncoder %10.0f blocks/s  (%.2fx)\n", name,
+         blocks / slow, blocks / fast, slow / fast);
+}
+
+int main(int argc, char** argv) {
+  size_t blocks = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+
+  printf("Reed-Solomon encode throughput, %zu blocks\n", blocks);
+  compare<RSEncoder<6, 51, 3, 1, 0x43>>("RS(63,12)", 0x43, 3, 1, blocks);
+  compare<RSEncoder<8, 32, 112, 11>>("RS(255,223)", 0x11D, 112, 11, blocks / 4);
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < blocks; ++i) {
+    JT65Encoder enc;
+    enc.encode(i & 1 ? "CQ K1ABC FN42" : "NT7S CN85");
+    sink += enc.symbols[1];
+  }
+  printf("  %-14s %10.0f msg/s\n", "JT65Encoder", blocks / secondsSince(start));
+
+  // Syndromes over noisy JT65 blocks
+  using JT65Decoder = RSDecoder<6, 51, 3, 1, 0x43>;
+  std::vector<uint8_t> noisy(blocks * 63), syn(blocks * 51);
+  for (size_t i = 0; i < noisy.size(); ++i) noisy[i] = (uint8_t) (i * 2654435761u >> 9) & 63;
+
+  const RSSyndromes::Isa isas[] = {RSSyndromes::Isa::SCALAR, RSSyndromes::Isa::AVX2, RSSyndromes::Isa::NEON};
+  double scalar = 0;
+  for (RSSyndromes::Isa isa : isas) {
+    if (!RSSyndromes::isSupported(isa)) continue;
+
+    start = std::chrono::steady_clock::now();
+    RSSyndromes::compute(isa, noisy.data(), blocks, 63, JT65Decoder::points.points, 51, syn.data());
+    double t = secondsSince(start);
+    sink += syn[blocks * 51 - 1];
+    if (isa == RSSyndromes::Isa::SCALAR) scalar = t;
+    printf("  syndromes/%-6s %8.0f blocks/s  (%.2fx)\n", RSSyndromes::isaName(isa), blocks / t, scalar / t);
+  }
+  return sink == 0xFFFFFFFF;
+}
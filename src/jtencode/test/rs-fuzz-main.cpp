@@ -0,0 +1,122 @@
+#include "RSDecoder.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Parallel Reed-Solomon fuzz harness: encodes random blocks, injects random
+// errors and erasures up to the design limit (2e + s <= NRoots), decodes
+// with batched SIMD syndromes and checks every block comes back intact.
+// Usage: ./rs-fuzz [blocks] [threads]
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct FuzzStats {
+  std::atomic<uint64_t> blocks{0};
+  std::atomic<uint64_t> symbolsCorrected{0};
+  std::atomic<uint64_t> failures{0};
+};
+
+template<typename Decoder>
+static void fuzzWorker(int length, uint64_t blocks, uint32_t seed, FuzzStats& stats) {
+  constexpr int nroots = Decoder::NN - Decoder::Encoder::MaxDataSymbols;
+  constexpr int Group = 2 * RSSyndromes::Lanes;
+  const int dataCount = length - nroots;
+
+  std::vector<uint8_t> original(Group * length), corrupted(Group * length), syn(Group * nroots);
+  std::vector<int> erasures(Group * nroots);
+  std::vector<int> erasureCount(Group);
+  uint64_t corrected = 0, failures = 0;
+
+  auto next = [&seed]() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  };
+
+  for (uint64_t done = 0; done < blocks; done += Group) {
+    int n = blocks - done < (uint64_t) Group ? (int) (blocks - done) : Group;
+
+    for (int c = 0; c < n; ++c) {
+      uint8_t* b = &original[c * length];
+      for (int i = 0; i < dataCount; ++i) b[i] = next() & Decoder::NN;
+      Decoder::Encoder::encode(b, dataCount, b + dataCount);
+      memcpy(&corrupted[c * length], b, length);
+
+      int s = next() % (nroots + 1);
+      int e = next() % ((nroots - s) / 2 + 1);
+      int* pos = &erasures[c * nroots];
+      for (int i = 0; i < s + e; ++i) {
+        bool fresh;
+        do {
+          pos[i] = next() % length;
+          fresh = true;
+          for (int k = 0; k < i; ++k) fresh &= pos[k] != pos[i];
+        } while (!fresh);
+
+        uint8_t flip = next() & Decoder::NN;
+        if (i >= s && flip == 0) flip = 1;
+        corrupted[c * length + pos[i]] ^= flip;
+      }
+      erasureCount[c] = s;
+    }
+
+    Decoder::syndromes(corrupted.data(), n, length, syn.data());
+
+    for (int c = 0; c < n; ++c) {
+      int result = Decoder::decode(&corrupted[c * length], length, &syn[c * nroots], &erasures[c * nroots],
+                                   erasureCount[c]);
+      if (result < 0 || memcmp(&corrupted[c * length], &original[c * length], length)) {
+        ++failures;
+      } else {
+        corrected += result;
+      }
+    }
+  }
+
+  stats.blocks += blocks;
+  stats.symbolsCorrected += corrected;
+  stats.failures += failures;
+}
+
+template<typename Decoder>
+static bool fuzz(const char* name, int length, uint64_t blocks, int threads) {
+  FuzzStats stats;
+  std::vector<std::thread> pool;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < threads; ++t) {
+    uint64_t share = blocks / threads + (t < (int) (blocks % threads) ? 1 : 0);
+    pool.emplace_back(fuzzWorker<Decoder>, length, share, 0x9E3779B9u * (t + 1), std::ref(stats));
+  }
+  for (std::thread& t : pool) t.join();
+  double seconds = secondsSince(start);
+
+  printf("  %-14s %10llu blocks  %12llu symbols fixed  %10.0f blocks/s  %s\n", name,
+         (unsigned long long) stats.blocks, (unsigned long long) stats.symbolsCorrected, stats.blocks / seconds,
+         stats.failures ? "[FAIL]" : "[PASS]");
+  if (stats.failures) printf("    %llu blocks not restored\n", (unsigned long long) stats.failures);
+  return stats.failures == 0;
+}
+
+int main(int argc, char** argv) {
+  uint64_t blocks = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+  int threads = argc > 2 ? atoi(argv[2]) : (int) std::thread::hardware_concurrency();
+  if (threads < 1) threads = 1;
+
+  printf("Reed-Solomon fuzz, %d thread(s), syndromes via %s\n", threads,
+         RSSyndromes::isaName(RSSyndromes::bestIsa()));
+
+  bool ok = fuzz<RSDecoder<6, 51, 3, 1, 0x43>>("RS(63,12)", 63, blocks, threads);
+  ok &= fuzz<RSDecoder<8, 32, 112, 11>>("RS(255,223)", 255, blocks / 10, threads);
+  ok &= fuzz<RSDecoder<8, 16, 0, 1>>("RS(155,139)", 155, blocks / 10, threads);
+
+  printf("\nReed-Solomon Fuzz %s\n", ok ? "PASSED" : "FAILED");
+  return ok ? 0 : 1;
+}
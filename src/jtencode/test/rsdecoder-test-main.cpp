@@ -0,0 +1,170 @@
+#include "RSDecoder.h"
+#include "RSEncode.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static uint32_t seed = 4242;
+
+static uint32_t nextRandom() {
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+// Picks n distinct positions in [0, length)
+static void pickPositions(int length, int n, int* out) {
+  for (int i = 0; i < n; ++i) {
+    bool fresh;
+    do {
+      out[i] = nextRandom() % length;
+      fresh = true;
+      for (int k = 0; k < i; ++k) fresh &= out[k] != out[i];
+    } while (!fresh);
+  }
+}
+
+// Encodes random blocks, corrupts them with every mix of errors and
+// erasures within the design limit and checks that decode restores them.
+template<typename Decoder>
+static bool roundTrip(int length, int blocks) {
+  constexpr int nroots = Decoder::NN - Decoder::Encoder::MaxDataSymbols;
+  const int dataCount = length - nroots;
+  std::vector<uint8_t> original(length), block(length);
+  int positions[nroots];
+
+  for (int n = 0; n < blocks; ++n) {
+    for (int i = 0; i < dataCount; ++i) original[i] = nextRandom() & Decoder::NN;
+    Decoder::Encoder::encode(original.data(), dataCount, original.data() + dataCount);
+
+    int erasures = nextRandom() % (nroots + 1);
+    int errors = (nroots - erasures) / 2;
+    if (errors > 0) errors = nextRandom() % (errors + 1);
+
+    block = original;
+    pickPositions(length, erasures + errors, positions);
+    for (int i = 0; i < erasures + errors; ++i) {
+      // Erased symbols may or may not actually be wrong; errors always are
+      uint8_t flip = nextRandom() & Decoder::NN;
+      if (i >= erasures && flip == 0) flip = 1;
+      block[positions[i]] ^= flip;
+    }
+
+    int result = Decoder::decode(block.data(), length, positions, erasures);
+    if (result < 0 || block != original) return false;
+  }
+  return true;
+}
+
+// Every supported syndrome kernel must agree with the scalar one
+template<typename Decoder>
+static bool kernelsAgree(int length, size_t count) {
+  constexpr int nroots = Decoder::NN - Decoder::Encoder::MaxDataSymbols;
+  std::vector<uint8_t> blocks(count * length);
+  for (uint8_t& b : blocks) b = nextRandom() & Decoder::NN;
+
+  std::vector<uint8_t> expected(count * nroots), actual(count * nroots);
+  RSSyndromes::compute(RSSyndromes::Isa::SCALAR, blocks.data(), count, length, Decoder::points.points, nroots,
+                       expected.data());
+
+  const RSSyndromes::Isa isas[] = {RSSyndromes::Isa::AVX2, RSSyndromes::Isa::NEON};
+  for (RSSyndromes::Isa isa : isas) {
+    if (!RSSyndromes::isSupported(isa)) continue;
+    RSSyndromes::compute(isa, blocks.data(), count, length, Decoder::points.points, nroots, actual.data());
+    if (actual != expected) return false;
+  }
+  return true;
+}
+
+using JT65Decoder = RSDecoder<6, 51, 3, 1, 0x43>;
+using CcsdsDecoder = RSDecoder<8, 32, 112, 11>;
+using Rs255x239Decoder = RSDecoder<8, 16, 0, 1>;
+using Rs15Decoder = RSDecoder<4, 5, 0, 1>;
+
+int main() {
+  std::cout << "Starting RSDecoder Tests..." << std::endl;
+  std::cout << "Best syndrome kernel: " << RSSyndromes::isaName(RSSyndromes::bestIsa()) << std::endl;
+
+  std::cout << "\n--- Test Case 1: Errors and Erasures Round Trip ---" << std::endl;
+  check("JT65 RS(63,12)", roundTrip<JT65Decoder>(63, 3000));
+  check("RS(255,223) CCSDS parameters", roundTrip<CcsdsDecoder>(255, 500));
+  check("RS(255,239) shortened to 155", roundTrip<Rs255x239Decoder>(155, 1000));
+  check("RS(15,10) shortened to 13", roundTrip<Rs15Decoder>(13, 3000));
+
+  std::cout << "\n--- Test Case 2: Decoding RSEncode Output ---" << std::endl;
+  {
+    RSEncode reference(6, 0x43, 3, 1, 51, 0);
+    std::vector<uint8_t> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, parity;
+    reference.encode(data, parity);
+
+    std::vector<uint8_t> block(data);
+    block.insert(block.end(), parity.begin(), parity.end());
+    std::vector<uint8_t> original(block);
+
+    uint8_t syn[51];
+    JT65Decoder::syndromes(block.data(), 63, syn);
+    bool clean = true;
+    for (uint8_t s : syn) clean &= s == 0;
+    check("RSEncode codeword has zero syndromes", clean);
+
+    for (int i = 0; i < 25; ++i) block[i * 2] ^= 0x15;
+    int positions[51];
+    int result = JT65Decoder::decode(block.data(), 63, nullptr, 0, positions);
+    check("25 errors corrected", result == 25 && block == original);
+  }
+
+  std::cout << "\n--- Test Case 3: Limits ---" << std::endl;
+  {
+    uint8_t block[63] = {};
+    check("Clean block reports zero corrections", JT65Decoder::decode(block, 63) == 0);
+
+    int erasures[52];
+    for (int i = 0; i < 52; ++i) erasures[i] = i;
+    block[0] = 1;
+    check("More erasures than roots is uncorrectable", JT65Decoder::decode(block, 63, erasures, 52) == -1);
+
+    int outOfRange = 63;
+    check("Erasure outside the block is rejected", JT65Decoder::decode(block, 63, &outOfRange, 1) == -1);
+  }
+
+  std::cout << "\n--- Test Case 4: SIMD Syndromes Match Scalar ---" << std::endl;
+  check("JT65 RS(63,12), 1001 blocks", kernelsAgree<JT65Decoder>(63, 1001));
+  check("RS(255,223), 100 blocks", kernelsAgree<CcsdsDecoder>(255, 100));
+  check("RS(15,10) shortened, 77 blocks", kernelsAgree<Rs15Decoder>(13, 77));
+
+  std::cout << "\n--- Test Case 5: Batch Decode ---" << std::endl;
+  {
+    const size_t count = 500;
+    std::vector<uint8_t> original(count * 63), blocks;
+    for (size_t c = 0; c < count; ++c) {
+      uint8_t* b = &original[c * 63];
+      for (int i = 0; i < 12; ++i) b[i] = nextRandom() & 63;
+      JT65Decoder::Encoder::encode(b, 12, b + 12);
+    }
+    blocks = original;
+
+    // Every third block clean, the rest with up to 25 errors
+    int positions[25];
+    for (size_t c = 0; c < count; ++c) {
+      if (c % 3 == 0) continue;
+      int errors = 1 + nextRandom() % 25;
+      pickPositions(63, errors, positions);
+      for (int i = 0; i < errors; ++i) blocks[c * 63 + positions[i]] ^= 1 + nextRandom() % 63;
+    }
+
+    std::vector<int> results(count);
+    size_t failed = JT65Decoder::decodeBatch(blocks.data(), count, 63, results.data());
+    check("All blocks restored", failed == 0 && blocks == original);
+    check("Clean blocks report zero corrections", results[0] == 0 && results[3] == 0 && results[1] > 0);
+  }
+
+  std::cout << "\nRSDecoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
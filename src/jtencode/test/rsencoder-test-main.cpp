@@ -0,0 +1,102 @@
+#include "RSEncoder.h"
+#include "RSEncode.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Count heap allocations so we can check that encode() never allocates.
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  ++allocationCount;
+  void* p = malloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+// Encodes random blocks with both implementations and compares parity.
+// RSEncode pads at the front, so the template sees the same block shortened.
+template<typename Encoder>
+static bool matchesRSEncode(int gfPoly, int fcr, int prim, int pad, int blocks) {
+  constexpr int nroots = Encoder::NN - Encoder::MaxDataSymbols;
+  RSEncode reference(__builtin_ctz(Encoder::NN + 1), gfPoly, fcr, prim, nroots, pad);
+  const int count = Encoder::MaxDataSymbols - pad;
+
+  uint32_t seed = 99;
+  std::vector<uint8_t> data(count), expected;
+  uint8_t parity[nroots];
+
+  for (int n = 0; n < blocks; ++n) {
+    for (int i = 0; i < count; ++i) {
+      seed = seed * 1103515245 + 12345;
+      data[i] = (seed >> 16) & Encoder::NN;
+    }
+    reference.encode(data, expected);
+    Encoder::encode(data.data(), count, parity);
+    for (int i = 0; i < nroots; ++i) {
+      if (parity[i] != expected[i]) return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  std::cout << "Starting RSEncoder Template Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Golden Parity ---" << std::endl;
+  {
+    // Reference values from a polynomial-division RS encoder
+    const uint8_t data1[] = {1, 2, 3};
+    const uint8_t expected1[] = {0, 0, 1, 3};
+    uint8_t parity1[4];
+    RSEncoder<3, 4, 1, 1>::encode(data1, 3, parity1);
+    check("RS(7,3) parity", !memcmp(parity1, expected1, sizeof(parity1)));
+
+    uint8_t data2[223];
+    for (int i = 0; i < 223; ++i) data2[i] = i + 1;
+    const uint8_t expected2[] = {
+      33, 113, 149, 182, 242, 1, 40, 48, 157, 106, 13, 25, 44, 79, 102, 7,
+      102, 179, 237, 190, 125, 228, 242, 101, 101, 80, 36, 190, 106, 171, 65, 113
+    };
+    uint8_t parity2[32];
+    RSEncoder<8, 32, 112, 11>::encode(data2, 223, parity2);
+    check("RS(255,223) CCSDS parameters parity", !memcmp(parity2, expected2, sizeof(parity2)));
+  }
+
+  std::cout << "\n--- Test Case 2: Matches RSEncode ---" << std::endl;
+  check("RS(7,3) fcr=1", matchesRSEncode<RSEncoder<3, 4, 1, 1>>(0xB, 1, 1, 0, 500));
+  check("RS(15,x) shortened by 2", matchesRSEncode<RSEncoder<4, 5, 0, 1>>(0x13, 0, 1, 2, 500));
+  check("JT65 RS(63,12)", matchesRSEncode<RSEncoder<6, 51, 3, 1, 0x43>>(0x43, 3, 1, 0, 500));
+  check("RS(255,223) fcr=112 prim=11", matchesRSEncode<RSEncoder<8, 32, 112, 11>>(0x11D, 112, 11, 0, 200));
+  check("RS(255,239) shortened by 100", matchesRSEncode<RSEncoder<8, 16, 0, 1>>(0x11D, 0, 1, 100, 200));
+
+  std::cout << "\n--- Test Case 3: Allocation-Free Encode ---" << std::endl;
+  {
+    uint8_t data[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    uint8_t parity[51];
+    size_t before = allocationCount;
+    for (int i = 0; i < 100; ++i) RSEncoder<6, 51, 3, 1>::encode(data, 12, parity);
+    check("No heap allocations during encode", allocationCount == before);
+  }
+
+  std::cout << "\nRSEncoder Template Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+#include "si5351.h"
+#include "I2CBus.h"
+#include "Si5351Sim.h"
+#include "Si5351Solver.h"
+#include "LatestValue.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static const uint8_t Address = 0x60;
+static const uint32_t XtalHz = 25000000;
+
+// CLK0 on a chip behind the host bus, locked and retuned as the ESP32
+// wrapper's setFrequency() and fineTune() do
+struct Channel {
+  I2CBus bus;
+  Si5351Sim chip;
+  Si5351 si5351;
+  Si5351Solution locked;
+
+  Channel() : si5351(&bus, Address) { bus.attach(Address, &chip); }
+
+  void lock(uint64_t milliHz) {
+    locked = Si5351Solver::solve(milliHz, XtalHz, 0);
+    uint8_t pll[8], ms[8];
+    Si5351Solver::registers(locked.pll, 0, 0, pll);
+    Si5351Solver::registers(locked.ms, locked.msDivBy4, locked.rDivLog2, ms);
+    si5351.setupCLKRegisters(0, Si5351::PLL::A, pll, ms, locked.msInteger, Si5351::DriveStrength::MA_8);
+    si5351.enableOutputs(0x01);
+  }
+
+  bool retune(uint64_t milliHz, int32_t ppb) {
+    const Si5351Solution s = Si5351Solver::retune(milliHz, XtalHz, ppb, locked);
+    if (!s.ok) return false;
+    uint8_t regs[8];
+    if (s.ms.p1 != locked.ms.p1 || s.ms.p2 != locked.ms.p2 || s.ms.p3 != locked.ms.p3) {
+      Si5351Solver::registers(s.ms, s.msDivBy4, s.rDivLog2, regs);
+      si5351.writeMultisynthRegisters(0, regs);
+    } else {
+      Si5351Solver::registers(s.pll, 0, 0, regs);
+      si5351.writePLLRegisters(Si5351::PLL::A, regs);
+    }
+    locked = s;
+    return true;
+  }
+
+  int pllResets() const {
+    int resets = 0;
+    for (const Si5351SimEvent& e : chip.getEvents()) resets += e.kind == Si5351SimEvent::PllReset;
+    return resets;
+  }
+};
+
+// WSPR transmit frequencies (dial + 1500 Hz) from 2200 m to 2 m
+static const uint64_t bandHz[] = {
+  137500, 475700, 1838100, 3570100, 5288700, 7040100, 10140200, 14097100,
+  18106100, 21096100, 24926100, 28126100, 50294500, 70092500, 144490500,
+};
+
+typedef std::chrono::steady_clock Clock;
+
+struct Setpoint {
+  uint64_t milliHz;
+  Clock::time_point postedAt;
+};
+
+int main() {
+  std::cout << "Starting Si5351 Calibration Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Fine Tuning Without a PLL Reset ---" << std::endl;
+  {
+    // +-500 Hz around every band in 0.1 Hz steps
+    bool retuned = true, exact = true, quiet = true, small = true, pllKept = true;
+    double worstHz = 0;
+    for (uint64_t hz : bandHz) {
+      Channel ch;
+      ch.lock(hz * 1000);
+      uint8_t pllBefore[8];
+      memcpy(pllBefore, ch.chip.getRegisters() + 26, 8);
+      const bool msTuned = !ch.locked.msDivBy4 && (ch.locked.ms.p1 + 512) / 128 >= 8;
+
+      ch.retune(hz * 1000 - 500000, 0);   // leaves integer mode once
+      ch.chip.clearEvents();
+      ch.bus.resetStats();
+      const double t0 = ch.bus.getTimeUs();
+      int steps = 0;
+      for (uint64_t mHz = hz * 1000 - 500000; mHz <= hz * 1000 + 500000; mHz += 100, ++steps) {
+        if (!ch.retune(mHz, 0)) {
+          retuned = false;
+          break;
+        }
+        const int64_t got = (int64_t) ch.chip.getFrequency(0).nanoHz() - (int64_t) (mHz * 1000000);
+        exact &= std::llabs(got - ch.locked.errorNanoHz) <= 2;
+        worstHz = std::fmax(worstHz, std::fabs(got / 1e9));
+      }
+      quiet &= ch.pllResets() == 0 && ch.chip.glitchUs(0, t0, ch.bus.getTimeUs(), 1000) == 0 && ch.chip.isValid(0);
+      // A full MS burst is 10 bytes on the wire with the device address
+      small &= ch.bus.getBytes() <= 9ULL * steps && ch.bus.getBusTimeUs() <= steps * (9.0 * 10 + 2) * 10;
+      if (msTuned) pllKept &= memcmp(pllBefore, ch.chip.getRegisters() + 26, 8) == 0;
+    }
+    std::cout << "  worst error " << worstHz * 1e3 << " mHz" << std::endl;
+    check("Every step from 2200 m to 2 m retunes", retuned);
+    check("Output matches the reported error", exact);
+    check("Every step within 5 mHz", worstHz < 0.005);
+    check("No PLL reset, gap or invalid setup while tuning", quiet);
+    check("No more bus time per step than one MS burst", small);
+    check("PLL registers untouched below 2 m", pllKept);
+  }
+
+  std::cout << "\n--- Test Case 2: Correction Preview ---" << std::endl;
+  {
+    // A crystal 12.3 ppm slow, previewed and cancelled on the locked PLL
+    bool onFrequency = true, pllKept = true, quiet = true;
+    for (uint64_t hz : bandHz) {
+      Channel ch;
+      ch.lock(hz * 1000);
+      const bool msTuned = !ch.locked.msDivBy4 && (ch.locked.ms.p1 + 512) / 128 >= 8;
+      uint8_t pllBefore[8];
+      memcpy(pllBefore, ch.chip.getRegisters() + 26, 8);
+      ch.chip.setCrystal(XtalHz, -12300);
+      ch.chip.clearEvents();
+
+      ch.retune(hz * 1000, -12300);
+      onFrequency &= std::fabs(ch.chip.getFrequency(0).hz() - hz) < 0.005;
+      if (msTuned) pllKept &= memcmp(pllBefore, ch.chip.getRegisters() + 26, 8) == 0;
+      quiet &= ch.pllResets() == 0;
+    }
+    check("Previewed correction puts the output on frequency", onFrequency);
+    check("PLL registers untouched below 2 m", pllKept);
+    check("No PLL reset", quiet);
+  }
+
+  std::cout << "\n--- Test Case 3: Latest Value Wins ---" << std::endl;
+  {
+    LatestValue<int> mailbox;
+    int value = -1;
+    check("Nothing to take at first", !mailbox.take(value));
+    int wakes = 0;
+    for (int i = 0; i < 1000; ++i) wakes += mailbox.post(i);
+    check("Only the first post of a burst finds the mailbox empty", wakes == 1);
+    const bool newest = mailbox.take(value) && value == 999;
+    check("A burst of 1000 posts is one take of the newest", newest && !mailbox.take(value));
+    check("999 posts superseded", mailbox.getPosted() == 1000 && mailbox.getSuperseded() == 999);
+    check("A post after a take finds it empty again", mailbox.post(1000) && mailbox.take(value));
+    mailbox.post(5);
+    mailbox.clear();
+    check("Cleared posts are dropped", !mailbox.take(value));
+  }
+
+  std::cout << "\n--- Test Case 4: Burst of 1000 Requests ---" << std::endl;
+  {
+    // A slider posts 1000 setpoints 50 us apart; the beacon loop applies
+    // the newest every 2 ms and waits out each update's bus time
+    const int requests = 1000;
+    const auto tick = std::chrono::milliseconds(2);
+    Channel ch;
+    ch.lock(14097100000ULL);
+    ch.chip.clearEvents();
+    ch.bus.resetStats();
+
+    LatestValue<Setpoint> mailbox;
+    std::atomic<bool> done(false);
+    int updates = 0;
+    uint64_t applied = 0;
+    double worstLatencyMs = 0;
+    bool tuned = true;
+
+    const auto start = Clock::now();
+    std::thread loop([&]() {
+      while (true) {
+        const bool last = done.load();
+        Setpoint s;
+        if (mailbox.take(s)) {
+          const double busBefore = ch.bus.getBusTimeUs();
+          tuned &= ch.retune(s.milliHz, 0);
+          std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(ch.bus.getBusTimeUs() - busBefore));
+          const double ms = std::chrono::duration<double, std::milli>(Clock::now() - s.postedAt).count();
+          worstLatencyMs = std::fmax(worstLatencyMs, ms);
+          applied = s.milliHz;
+          ++updates;
+        }
+        if (last) break;
+        std::this_thread::sleep_for(tick);
+      }
+    });
+    for (int i = 0; i < requests; ++i) {
+      mailbox.post({14097000000ULL + (uint64_t) i * 200, Clock::now()});
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    done = true;
+    loop.join();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const uint64_t lastPosted = 14097000000ULL + (uint64_t) (requests - 1) * 200;
+
+    std::printf("  %d requests over %.1f ms: %d hardware updates (%.0f/s), %llu bytes, worst latency %.2f ms\n",
+                requests, elapsedMs, updates, updates * 1000 / elapsedMs, (unsigned long long) ch.bus.getBytes(),
+                worstLatencyMs);
+    check("Every update retunes", tuned);
+    check("The last setpoint is what the chip holds", applied == lastPosted &&
+          std::fabs(ch.chip.getFrequency(0).hz() - lastPosted / 1000.0) < 0.005);
+    check("Bursts collapse to one update per loop pass", updates < requests / 2 &&
+          (uint32_t) updates + mailbox.getSuperseded() == (uint32_t) requests);
+    check("No PLL reset during the burst", ch.pllResets() == 0);
+    check("Latency under 50 ms", worstLatencyMs < 50);
+  }
+
+  std::cout << "\nSi5351 Calibration Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+#include "si5351.h"
+#include "I2CBus.h"
+#include "Si5351Solver.h"
+#include "Si5351ToneTable.h"
+#include "ModeDescriptor.h"
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static const uint8_t Address = 0x60;
+static const uint32_t XtalHz = 25000000;
+
+struct Traffic {
+  uint64_t transactions;
+  uint64_t bytes;
+  double busTimeUs;
+  uint8_t registers[256];
+};
+
+// Runs setup, then measures step, on a fresh chip with the shadow on or off
+static Traffic measure(bool shadow, const std::function<void(Si5351&)>& setup,
+                       const std::function<void(Si5351&)>& step) {
+  I2CBus bus;
+  Si5351 si5351(&bus, Address);
+  si5351.setShadowEnabled(shadow);
+  setup(si5351);
+  bus.resetStats();
+  step(si5351);
+
+  Traffic t;
+  t.transactions = bus.getTransactions();
+  t.bytes = bus.getBytes();
+  t.busTimeUs = bus.getBusTimeUs();
+  memcpy(t.registers, bus.getRegisters(), sizeof(t.registers));
+  return t;
+}
+
+struct Solved {
+  uint8_t pll[8];
+  uint8_t ms[8];
+  bool integer;
+};
+
+static Solved solve(uint64_t milliHz) {
+  const Si5351Solution s = Si5351Solver::solve(milliHz, XtalHz, 0);
+  Solved r;
+  Si5351Solver::registers(s.pll, 0, 0, r.pll);
+  Si5351Solver::registers(s.ms, s.msDivBy4, s.rDivLog2, r.ms);
+  r.integer = s.msInteger;
+  return r;
+}
+
+static Traffic before, after;
+
+// Before/after report line; both runs must leave the same registers
+static void report(const char* name, const std::function<void(Si5351&)>& setup,
+                   const std::function<void(Si5351&)>& step) {
+  before = measure(false, setup, step);
+  after = measure(true, setup, step);
+  std::printf("  %-34s %3llu tx %4llu B %7.0f us  ->  %3llu tx %4llu B %7.0f us\n", name,
+              (unsigned long long) before.transactions, (unsigned long long) before.bytes, before.busTimeUs,
+              (unsigned long long) after.transactions, (unsigned long long) after.bytes, after.busTimeUs);
+  check(std::string(name) + ": same registers either way",
+        memcmp(before.registers, after.registers, sizeof(before.registers)) == 0);
+}
+
+int main() {
+  std::cout << "Starting Si5351 I2C Traffic Tests..." << std::endl;
+
+  const Solved band20 = solve(14097100000ULL), band40 = solve(7040100000ULL);
+  const auto to20 = [&](Si5351& s) {
+    s.setupCLKRegisters(0, Si5351::PLL::A, band20.pll, band20.ms, band20.integer, Si5351::DriveStrength::MA_8);
+  };
+  const auto to40 = [&](Si5351& s) {
+    s.setupCLKRegisters(0, Si5351::PLL::A, band40.pll, band40.ms, band40.integer, Si5351::DriveStrength::MA_8);
+  };
+
+  Si5351ToneTable table;
+  double tones[ModeMaxTones];
+  wsprMode.toneTable(14097100, tones);
+  table.compute(XtalHz, 0, tones, 4);
+  const auto toneSetup = [&](Si5351& s) {
+    s.setupCLK0Tone(table.pllMult, table.tones[0].regs, Si5351::DriveStrength::MA_8);
+  };
+
+  std::cout << "\n--- Test Case 1: Band Change (before -> after) ---" << std::endl;
+  {
+    report("Band change, whole-Hz calc", [](Si5351& s) { s.setupCLK0(14097100, Si5351::DriveStrength::MA_8); },
+           [](Si5351& s) { s.setupCLK0(7040100, Si5351::DriveStrength::MA_8); });
+    check("Under a quarter of the transactions", after.transactions * 4 < before.transactions);
+    check("Less bus time", after.busTimeUs < before.busTimeUs);
+
+    report("Band change, solver registers", to20, to40);
+    check("Fewer or equal transactions", after.transactions <= before.transactions);
+    check("No more bytes", after.bytes <= before.bytes);
+
+    report("Same band again, solver registers", to20, to20);
+    check("Only the PLL reset is written", after.transactions == 1 && after.bytes == 2);
+  }
+
+  std::cout << "\n--- Test Case 2: WSPR Tone Step (before -> after) ---" << std::endl;
+  {
+    report("Tone step, tone table burst", toneSetup, [&](Si5351& s) {
+      s.writeCLK0Multisynth(table.tones[1].regs + table.burstStart, table.burstStart, 8 - table.burstStart);
+    });
+    check("No more bytes", after.bytes <= before.bytes);
+
+    report("Tone step back to the same tone", toneSetup, [&](Si5351& s) {
+      s.writeCLK0Multisynth(table.tones[0].regs + table.burstStart, table.burstStart, 8 - table.burstStart);
+    });
+    check("Nothing is written", after.transactions == 0);
+
+    uint8_t sparse[8];
+    memcpy(sparse, table.tones[0].regs, sizeof(sparse));
+    sparse[5] ^= 0x01;
+    sparse[7] ^= 0x01;
+    report("Tone step, two bytes apart", toneSetup, [&](Si5351& s) { s.writeCLK0Multisynth(sparse, 0, 8); });
+    check("Unchanged bytes are never written", after.transactions == 2 && after.bytes == 4);
+
+    report("Tone step, whole-Hz minimal update",
+           [](Si5351& s) { s.setupCLK0Smooth(14097100, nullptr, Si5351::DriveStrength::MA_8); },
+           [](Si5351& s) { s.updateCLK0FrequencyMinimal(14097103); });
+    check("No more bytes", after.bytes <= before.bytes);
+  }
+
+  std::cout << "\n--- Test Case 3: Shadow ---" << std::endl;
+  {
+    I2CBus bus;
+    Si5351 si5351(&bus, Address);
+    check("Constructor writes one burst per register run", bus.getTransactions() == 3);
+
+    bus.resetStats();
+    si5351.enableOutputs(0x01);
+    si5351.enableOutputs(0x01);
+    check("Unchanged output enable is skipped", bus.getTransactions() == 1);
+
+    bus.resetStats();
+    si5351.invalidateShadow();
+    si5351.enableOutputs(0x01);
+    check("Invalidated shadow writes again", bus.getTransactions() == 1 && bus.getRegisters()[3] == 0xFE);
+  }
+
+  std::cout << "\nSi5351 I2C Traffic Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+#include "si5351.h"
+#include "I2CBus.h"
+#include "Si5351Sim.h"
+#include "Si5351Solver.h"
+#include "Si5351ToneTable.h"
+#include "ModeDescriptor.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static const uint8_t Address = 0x60;
+static const uint32_t XtalHz = 25000000;
+
+// WSPR transmit frequencies (dial + 1500 Hz) from 2200 m to 2 m
+static const uint64_t bandHz[] = {
+  137500, 475700, 1838100, 3570100, 5288700, 7040100, 10140200, 14097100,
+  18106100, 21096100, 24926100, 28126100, 50294500, 70092500, 144490500,
+};
+
+// Solver registers written through the driver, as the ESP32 wrapper does
+static Si5351Solution program(Si5351& si5351, int clk, uint64_t milliHz, int32_t correctionPpb) {
+  const Si5351Solution s = Si5351Solver::solve(milliHz, XtalHz, correctionPpb);
+  uint8_t pll[8], ms[8];
+  Si5351Solver::registers(s.pll, 0, 0, pll);
+  Si5351Solver::registers(s.ms, s.msDivBy4, s.rDivLog2, ms);
+  si5351.setupCLKRegisters(clk, clk == 0 ? Si5351::PLL::A : Si5351::PLL::B, pll, ms, s.msInteger,
+                           Si5351::DriveStrength::MA_8);
+  return s;
+}
+
+int main() {
+  std::cout << "Starting Si5351 Simulator Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Solver Registers Through the Driver ---" << std::endl;
+  {
+    bool valid = true, exact = true, corrected = true;
+    for (uint64_t hz : bandHz) {
+      for (int clk : {0, 2}) {
+        I2CBus bus;
+        Si5351Sim chip;
+        bus.attach(Address, &chip);
+        Si5351 si5351(&bus, Address);
+
+        const Si5351Solution s = program(si5351, clk, hz * 1000, 0);
+        const int64_t want = (int64_t) (hz * 1000000000) + s.errorNanoHz;
+        valid &= chip.isValid(clk);
+        exact &= std::llabs((int64_t) chip.getFrequency(clk).nanoHz() - want) <= 1;
+
+        // A crystal 2.5 ppm fast, corrected for
+        chip.setCrystal(XtalHz, 2500);
+        program(si5351, clk, hz * 1000, 2500);
+        corrected &= chip.isValid(clk) && std::fabs(chip.getFrequency(clk).hz() - hz) < 0.001;
+      }
+    }
+    check("Every band decodes to a valid CLK0 and CLK2 setup", valid);
+    check("Decoded frequency is the solver's, to the nanohertz", exact);
+    check("A corrected crystal error lands on frequency", corrected);
+  }
+
+  std::cout << "\n--- Test Case 2: Whole-Hz Driver Path ---" << std::endl;
+  {
+    bool valid = true;
+    double worstHz = 0;
+    for (uint64_t hz : bandHz) {
+      I2CBus bus;
+      Si5351Sim chip;
+      bus.attach(Address, &chip);
+      Si5351 si5351(&bus, Address);
+      si5351.setupCLK0((int32_t) hz, Si5351::DriveStrength::MA_8);
+      valid &= chip.isValid(0);
+      worstHz = std::fmax(worstHz, std::fabs(chip.getFrequency(0).hz() - hz));
+    }
+    std::cout << "  setupCLK0 worst error " << worstHz << " Hz" << std::endl;
+    check("setupCLK0 registers decode on every band", valid);
+  }
+
+  std::cout << "\n--- Test Case 3: WSPR Transmission ---" << std::endl;
+  {
+    I2CBus bus;
+    Si5351Sim chip;
+    bus.attach(Address, &chip);
+    Si5351 si5351(&bus, Address);
+
+    double tones[ModeMaxTones];
+    wsprMode.toneTable(14097100, tones);
+    Si5351ToneTable table;
+    table.compute(XtalHz, 0, tones, 4);
+    si5351.setupCLK0Tone(table.pllMult, table.tones[0].regs, Si5351::DriveStrength::MA_8);
+    si5351.enableOutputs(0x01);
+
+    const double periodUs = wsprMode.symbolPeriodMs() * 1000;
+    const double startUs = bus.getTimeUs();
+    bus.resetStats();
+    chip.clearEvents();
+
+    // Symbol times are when each burst ends; the RF is checked mid-symbol
+    bool onTone = true;
+    int changes = 0, previous = 0;
+    uint32_t lfsr = 0xACE1;
+    for (int i = 0; i < wsprMode.symbolCount; ++i) {
+      lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+      const int symbol = lfsr & 3;
+      const double symbolStartUs = startUs + i * periodUs;
+      bus.advanceUs(symbolStartUs - bus.getTimeUs());
+
+      const Si5351ToneTable::Tone& t = table.tones[symbol];
+      si5351.writeCLK0Multisynth(t.regs + table.burstStart, table.burstStart, 8 - table.burstStart);
+      if (symbol != previous) ++changes;
+      previous = symbol;
+
+      const double rf = chip.frequencyAt(0, symbolStartUs + periodUs / 2).hz();
+      onTone &= std::fabs(rf - tones[symbol]) < 0.01;
+    }
+    const double endUs = startUs + wsprMode.symbolCount * periodUs;
+
+    int frequencyEvents = 0;
+    for (const Si5351SimEvent& e : chip.getEvents()) {
+      if (e.kind == Si5351SimEvent::Frequency) ++frequencyEvents;
+    }
+    std::printf("  %d symbols: %llu transactions, %llu bytes, %.1f ms of bus time\n", wsprMode.symbolCount,
+                (unsigned long long) bus.getTransactions(), (unsigned long long) bus.getBytes(),
+                bus.getBusTimeUs() / 1000);
+    check("RF is on the symbol's tone within 0.01 Hz", onTone);
+    check("No output gaps or PLL resets while transmitting", chip.glitchUs(0, startUs, endUs, 100) == 0);
+    check("One frequency change per tone change, none in between", frequencyEvents == changes);
+    check("At most one transaction per symbol", bus.getTransactions() <= (uint64_t) wsprMode.symbolCount);
+  }
+
+  std::cout << "\n--- Test Case 4: Glitch Windows ---" << std::endl;
+  {
+    I2CBus bus;
+    Si5351Sim chip;
+    bus.attach(Address, &chip);
+    Si5351 si5351(&bus, Address);
+    program(si5351, 0, 14097100000ULL, 0);
+    si5351.enableOutputs(0x01);
+
+    const double t0 = bus.getTimeUs();
+    chip.clearEvents();
+    program(si5351, 0, 7040100000ULL, 0);
+    bool reset = false;
+    for (const Si5351SimEvent& e : chip.getEvents()) reset |= e.kind == Si5351SimEvent::PllReset && e.clk == 0;
+    check("A band change resets PLL A", reset);
+    check("The reset counts as a glitch until the PLL settles",
+          std::fabs(chip.glitchUs(0, t0, bus.getTimeUs() + 1000, 500) - 500) < 1e-6);
+
+    const double off = bus.getTimeUs();
+    si5351.enableOutputs(0x00);
+    bus.advanceUs(1000);
+    si5351.enableOutputs(0x01);
+    const double gap = chip.glitchUs(0, off, bus.getTimeUs(), 0);
+    check("Disabling the output for 1 ms is a 1 ms gap", gap > 1000 && gap < 1400);
+  }
+
+  std::cout << "\n--- Test Case 5: Register Mistakes ---" << std::endl;
+  {
+    I2CBus bus;
+    Si5351Sim chip;
+    bus.attach(Address, &chip);
+    Si5351 si5351(&bus, Address);
+    si5351.enableOutputs(0x01);
+
+    // Integer mode on a fractional divider
+    const Si5351Solution s = Si5351Solver::solve(14097100000ULL, XtalHz, 0);
+    uint8_t pll[8], ms[8];
+    Si5351Solver::registers(s.pll, 0, 0, pll);
+    Si5351Solver::registers(s.ms, 0, 0, ms);
+    si5351.setupCLKRegisters(0, Si5351::PLL::A, pll, ms, true, Si5351::DriveStrength::MA_8);
+    bool flagged = false;
+    for (const Si5351SimEvent& e : chip.getEvents()) {
+      flagged |= e.kind == Si5351SimEvent::Invalid && e.detail.find("integer mode") != std::string::npos;
+    }
+    check("Integer mode with a fractional divider is flagged", !s.msInteger && !chip.isValid(0) && flagged);
+
+    // A device at another address does not acknowledge
+    check("Other addresses NACK", !bus.write(0x61, ms, 2));
+  }
+
+  std::cout << "\nSi5351 Simulator Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
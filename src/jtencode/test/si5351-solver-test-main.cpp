@@ -0,0 +1,196 @@
+#include "Si5351Solver.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+typedef __int128 Wide;
+
+static Wide magnitude(Wide v) { return v < 0 ? -v : v; }
+
+// Achieved output in nanohertz from the solution's P values alone, exactly
+static Wide achievedNanoHz(const Si5351Solution& s, uint32_t xtalHz, int32_t ppb) {
+  const Wide xtal = (Wide) xtalHz * (1000000000LL + ppb);
+  const Wide pllNum = (Wide) s.pll.p3 * (s.pll.p1 + 512) + s.pll.p2;   // PLL = xtal * pllNum / (128 P3)
+  Wide msNum = (Wide) s.ms.p3 * (s.ms.p1 + 512) + s.ms.p2;             // MS = msNum / (128 P3)
+  Wide msDen = s.ms.p3;
+  if (s.msDivBy4) {
+    msNum = 4 * 128;
+    msDen = 1;
+  }
+  const Wide num = xtal * pllNum * msDen;
+  return num / ((Wide) s.pll.p3 * msNum << s.rDivLog2);
+}
+
+// The whole-hertz calculation the driver used before: int32 Hz, correction
+// through a double, truncated 20-bit fractions
+static double legacyHz(int32_t fclk, uint32_t fxtal, int32_t correction) {
+  int32_t rdiv = 1;
+  if (fclk < 1000000) {
+    fclk *= 64;
+    rdiv = 64;
+  }
+  fclk = fclk - (int32_t) ((((double) fclk) / 100000000.0) * ((double) correction));
+
+  if (fclk < 81000000) {
+    int32_t a = 600000000 / fxtal;
+    int32_t fpll = a * fxtal;
+    int32_t x = fpll / fclk;
+    while (x > 900 && a < 90) {
+      a++;
+      fpll = a * fxtal;
+      x = fpll / fclk;
+    }
+    const int32_t t = (fclk >> 20) + 1;
+    const int32_t y = (fpll % fclk) / t, z = fclk / t;
+    const double pll = (double) fxtal * a * (1 + correction / 1e8);
+    return pll / (x + (double) y / z) / rdiv;
+  }
+  const int32_t x = fclk >= 150000000 ? 4 : fclk >= 100000000 ? 6 : 8;
+  const int32_t numerator = x * fclk;
+  const int32_t a = numerator / (int32_t) fxtal;
+  const int32_t t = (fxtal >> 20) + 1;
+  const int32_t b = (numerator % fxtal) / t, c = fxtal / t;
+  return (double) fxtal * (1 + correction / 1e8) * (a + (double) b / c) / x / rdiv;
+}
+
+// WSPR/FST4W dial frequencies of the IARU band plans, 2200 m to 2 m,
+// including the alternate 80 m and 60 m spots
+static const uint32_t dialHz[] = {
+  136000, 474200, 1836600, 3568600, 3592600, 5287200, 5364700, 7038600, 10138700,
+  14095600, 18104600, 21094600, 24924600, 28124600, 50293000, 70091000, 144489000,
+};
+
+int main() {
+  std::cout << "Starting Si5351 Solver Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Best Rational Approximation ---" << std::endl;
+  {
+    // Against a brute force search of every denominator
+    bool best = true, bounded = true;
+    srand(5351);
+    for (int trial = 0; trial < 300; ++trial) {
+      const uint64_t den = 1 + ((uint64_t) rand() << 20 ^ (uint64_t) rand()) % 100000000000ULL;
+      const uint64_t num = ((uint64_t) rand() << 24 ^ (uint64_t) rand()) % (den * 40);
+      const uint32_t maxDen = 1 + rand() % 3000;
+
+      uint64_t n;
+      uint32_t c;
+      Si5351Solver::bestRational128(num, den, maxDen, n, c);
+      bounded &= c >= 1 && c <= maxDen;
+
+      const Wide x = (Wide) 128 * num;
+      const Wide error = magnitude((Wide) n * den - x * c);   // over c * den
+      for (uint32_t k = 1; k <= maxDen; ++k) {
+        for (Wide m = x * k / den; m <= x * k / den + 1; ++m) {
+          // |m/k - x/den| < |n/c - x/den|, cross-multiplied
+          if (magnitude(m * den - x * k) * c < error * k) best = false;
+        }
+      }
+    }
+    check("Denominator within bound", bounded);
+    check("No fraction with a smaller denominator is closer", best);
+
+    uint64_t n;
+    uint32_t c;
+    Si5351Solver::bestRational128(3, 7, Si5351Solver::MaxDenominator, n, c);
+    check("Exact ratios are found exactly", n == 384 && c == 7);
+  }
+
+  std::cout << "\n--- Test Case 2: Band Plan Sweep ---" << std::endl;
+  {
+    // Every 0.1 Hz of the 1400-1600 Hz audio window of every band, with
+    // crystals and corrections a board might have
+    const uint32_t xtals[] = {25000000, 27000000};
+    const int32_t ppbs[] = {0, 2500, -13370, 31410};
+    uint64_t solves = 0;
+    double worstHz = 0, worst2mHz = 0, worstLegacyHz = 0;
+    bool ok = true, exact = true, ranges = true;
+
+    for (uint32_t xtal : xtals) {
+      for (int32_t ppb : ppbs) {
+        for (uint32_t dial : dialHz) {
+          for (uint64_t mHz = 1400000; mHz <= 1600000; mHz += 100) {
+            const uint64_t target = (uint64_t) dial * 1000 + mHz;
+            const Si5351Solution s = Si5351Solver::solve(target, xtal, ppb);
+            ++solves;
+            if (!s.ok) {
+              ok = false;
+              continue;
+            }
+
+            const Wide achieved = achievedNanoHz(s, xtal, ppb);
+            const Wide error = achieved - (Wide) target * 1000000;
+            exact &= magnitude(error - s.errorNanoHz) <= 1;
+            // 2 m has only the divide-by-6 output, so only the PLL's rationals
+            double& worst = dial > 100000000 ? worst2mHz : worstHz;
+            worst = std::fmax(worst, std::fabs((double) s.errorNanoHz) / 1e9);
+
+            // PLL 15-90 and 600-900 MHz, output divider 4, 6 or 8-2048
+            const double pllRatio = (s.pll.p1 + 512 + (double) s.pll.p2 / s.pll.p3) / 128;
+            const double msRatio = s.msDivBy4 ? 4 : (s.ms.p1 + 512 + (double) s.ms.p2 / s.ms.p3) / 128;
+            const double vco = xtal * (1 + ppb / 1e9) * pllRatio;
+            ranges &= pllRatio >= 15 && pllRatio <= 90 && vco >= 599999999 && vco <= 900000001 &&
+                      s.pll.p3 <= Si5351Solver::MaxDenominator && s.ms.p3 <= Si5351Solver::MaxDenominator &&
+                      (msRatio == 4 || msRatio == 6 || (msRatio >= 8 && msRatio <= 2048));
+
+            if (target < 150000000000ULL && ppb % 10 == 0) {
+              const double want = target / 1000.0;
+              worstLegacyHz = std::fmax(worstLegacyHz, std::fabs(legacyHz((int32_t) (want), xtal, ppb / 10) - want));
+            }
+          }
+        }
+      }
+    }
+    std::cout << "  " << solves << " frequencies: worst error " << worstHz * 1e6 << " uHz to 4 m, "
+              << worst2mHz * 1e6 << " uHz on 2 m, whole-Hz method " << worstLegacyHz << " Hz" << std::endl;
+    check("Every frequency from 2200 m to 2 m is solved", ok);
+    check("Reported error matches the registers exactly", exact);
+    check("PLL, VCO and dividers within the chip's limits", ranges);
+    check("Every frequency to 4 m within 1 mHz", worstHz < 0.001);
+    check("Every 2 m frequency within 10 mHz", worst2mHz < 0.01);
+    check("Better than the whole-Hz method", worstHz < worstLegacyHz / 100);
+  }
+
+  std::cout << "\n--- Test Case 3: Layouts ---" << std::endl;
+  {
+    const Si5351Solution lf = Si5351Solver::solve(137500000, 25000000, 0);
+    check("2200 m uses the R divider", lf.ok && lf.rDivLog2 > 0);
+    const Si5351Solution vhf = Si5351Solver::solve(144490500000ULL, 25000000, 0);
+    check("2 m uses an even integer output divider", vhf.ok && vhf.msInteger && vhf.ms.p2 == 0);
+    const Si5351Solution exact = Si5351Solver::solve(10000000000ULL, 25000000, 0);
+    check("10 MHz from 25 MHz is exact", exact.ok && exact.errorNanoHz == 0);
+    check("Zero and out of range targets are rejected", !Si5351Solver::solve(0, 25000000, 0).ok &&
+          !Si5351Solver::solve(1000000, 25000000, 0).ok && !Si5351Solver::solve(250000000000ULL, 25000000, 0).ok);
+
+    uint8_t regs[8];
+    Si5351Solver::registers({0x2ABCD, 0xF1234, 0xE5678}, 0, 3, regs);
+    const uint8_t expected[8] = {0x56, 0x78, 0x32, 0xAB, 0xCD, 0xEF, 0x12, 0x34};
+    bool same = true;
+    for (int i = 0; i < 8; ++i) same &= regs[i] == expected[i];
+    check("Register bytes pack P1, P2, P3 and R", same);
+  }
+
+  std::cout << "\n--- Test Case 4: Solve Time ---" << std::endl;
+  {
+    const int rounds = 20000;
+    int64_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+      sink += Si5351Solver::solve(14097100000ULL + i * 7, 25000000, 2500).errorNanoHz;
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << us / rounds << " us per solve on this host (" << (sink != 0) << ")" << std::endl;
+  }
+
+  std::cout << "\nSi5351 Solver Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+#include "Si5351.h"
+#include "ModeDescriptor.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+// Frequency from the MS register bytes alone, as the chip would decode them
+static double registerHz(const Si5351ToneTable& table, const uint8_t r[8]) {
+  const uint32_t p3 = ((uint32_t) (r[5] & 0xF0) << 12) | ((uint32_t) r[0] << 8) | r[1];
+  const uint32_t p1 = ((uint32_t) (r[2] & 0x3) << 16) | ((uint32_t) r[3] << 8) | r[4];
+  const uint32_t p2 = ((uint32_t) (r[5] & 0xF) << 16) | ((uint32_t) r[6] << 8) | r[7];
+  const int rDiv = 1 << ((r[2] >> 4) & 7);
+  return 128.0 * table.pllHz / (p1 + 512 + (double) p2 / p3) / rDiv;
+}
+
+// WSPR transmit frequencies (dial + 1500 Hz) from 2200 m to 10 m
+static const double bandHz[] = {
+  137500, 475700, 1838100, 3570100, 5288700, 7040100, 10140200,
+  14097100, 18106100, 21096100, 24926100, 28126100,
+};
+
+int main() {
+  std::cout << "Starting Si5351 Tone Table Tests..." << std::endl;
+
+  Si5351 si5351;
+  si5351.setVerbose(false);
+
+  std::cout << "\n--- Test Case 1: Synthesized Tones Within 0.01 Hz ---" << std::endl;
+  for (const ModeDescriptor* mode : allModes) {
+    double worstHz = 0, worstOffsetHz = 0;
+    bool all = true;
+    for (double base : bandHz) {
+      double tones[ModeMaxTones];
+      mode->toneTable(base, tones);
+      si5351.setupChannelSmooth(0, tones[0], tones, mode->toneCount);
+      all &= si5351.getToneTable().toneCount == mode->toneCount;
+
+      double f0 = 0;
+      for (int k = 0; k < mode->toneCount; ++k) {
+        si5351.selectChannelTone(0, k);
+        const double f = si5351.getFrequency(0);
+        if (k == 0) f0 = f;
+        worstHz = std::fmax(worstHz, std::fabs(f - tones[k]));
+        worstOffsetHz = std::fmax(worstOffsetHz, std::fabs((f - f0) - k * mode->toneSpacingHz()));
+      }
+    }
+    std::cout << "  " << mode->name << ": worst tone error " << worstHz << " Hz, worst spacing error "
+              << worstOffsetHz << " Hz" << std::endl;
+    check(std::string(mode->name) + " tones within 0.01 Hz on every band", all && worstHz < 0.01);
+    check(std::string(mode->name) + " tone offsets within 0.01 Hz", all && worstOffsetHz < 0.01);
+  }
+
+  std::cout << "\n--- Test Case 2: Register Bytes ---" << std::endl;
+  {
+    bool decoded = true, burst = true, lowBands = true;
+    for (double base : bandHz) {
+      double tones[ModeMaxTones];
+      wsprMode.toneTable(base, tones);
+      si5351.setupChannelSmooth(0, tones[0], tones, wsprMode.toneCount);
+      const Si5351ToneTable& table = si5351.getToneTable();
+
+      for (int k = 0; k < table.toneCount; ++k) {
+        decoded &= std::fabs(registerHz(table, table.tones[k].regs) - tones[k]) < 0.01;
+        for (int r = 0; r < table.burstStart; ++r) burst &= table.tones[k].regs[r] == table.tones[0].regs[r];
+      }
+      burst &= table.burstStart >= 2;   // P3 never changes
+      lowBands &= base * 2048 > table.pllHz || table.rDivLog2 > 0;
+    }
+    check("Register bytes decode to each tone", decoded);
+    check("Registers before burstStart are shared by all tones", burst);
+    check("2200 m uses the R divider", lowBands);
+  }
+
+  std::cout << "\n--- Test Case 3: Calibration ---" << std::endl;
+  {
+    const int32_t correction = 250;   // 2.5 ppm
+    si5351.setCalibration(correction);
+    double tones[ModeMaxTones];
+    wsprMode.toneTable(14097100, tones);
+    si5351.setupChannelSmooth(0, tones[2], tones, wsprMode.toneCount);
+    check("Setup starts on the requested tone",
+          std::fabs(si5351.getFrequency(0) - tones[2] * (1 - correction / 1e8)) < 0.01);
+
+    bool corrected = true;
+    for (int k = 0; k < 4; ++k) {
+      si5351.selectChannelTone(0, k);
+      corrected &= std::fabs(si5351.getFrequency(0) - tones[k] * (1 - correction / 1e8)) < 0.01;
+    }
+    check("Tones are programmed with the correction applied", corrected);
+    si5351.setCalibration(0);
+  }
+
+  std::cout << "\n--- Test Case 4: Out of Range ---" << std::endl;
+  {
+    double tones[ModeMaxTones];
+    wsprMode.toneTable(144490500, tones);
+    Si5351ToneTable table;
+    check("2 m is beyond the fractional multisynth", !table.compute(25000000, 0, tones, 4) &&
+          table.toneCount == 0);
+  }
+
+  std::cout << "\nSi5351 Tone Table Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
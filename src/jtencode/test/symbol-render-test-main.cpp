@@ -0,0 +1,225 @@
+#include "JTEncode.h"
+#include "SymbolRenderer.h"
+#include "WSPRDecoder.h"
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Renders WSPR frames through SymbolRenderer, reads the WAV files back and
+// checks the header, the timing, phase continuity and that WSPRDecoder
+// decodes them.
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+struct Wav {
+  int channels = 0;
+  int sampleRate = 0;
+  int bits = 0;
+  std::vector<int16_t> samples;
+};
+
+static uint32_t getLE(const uint8_t* p, int bytes) {
+  uint32_t v = 0;
+  for (int i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+  return v;
+}
+
+static bool readWav(const std::string& path, Wav& wav) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t h[44];
+  bool ok = fread(h, 1, sizeof(h), f) == sizeof(h) && !memcmp(h, "RIFF", 4) && !memcmp(h + 8, "WAVEfmt ", 8) &&
+            !memcmp(h + 36, "data", 4) && getLE(h + 20, 2) == 1;
+  if (ok) {
+    wav.channels = getLE(h + 22, 2);
+    wav.sampleRate = getLE(h + 24, 4);
+    wav.bits = getLE(h + 34, 2);
+    wav.samples.resize(getLE(h + 40, 4) / 2);
+    ok = fread(wav.samples.data(), 2, wav.samples.size(), f) == wav.samples.size() && fgetc(f) == EOF &&
+         getLE(h + 4, 4) == 36 + wav.samples.size() * 2;
+  }
+  fclose(f);
+  return ok;
+}
+
+// Drives a renderer the way Beacon does, with symbol k starting at
+// startUs[k] and the stream ending at endUs
+static void transmit(SymbolRenderer& renderer, const uint8_t* symbols, int count, int64_t& now,
+                     const std::vector<int64_t>& startUs, int64_t endUs) {
+  renderer.startSymbolStream(symbols[0]);
+  renderer.outputSymbolArray(symbols, count);
+  for (int k = 0; k < count; ++k) {
+    now = startUs[k];
+    renderer.outputSymbol(k, symbols[k]);
+  }
+  now = endUs;
+  renderer.endSymbolStream();
+}
+
+static std::vector<int64_t> symbolTimes(int count, double periodUs, double jitterUs, std::mt19937& rng) {
+  std::uniform_real_distribution<double> jitter(-jitterUs, jitterUs);
+  std::vector<int64_t> t(count);
+  for (int k = 0; k < count; ++k) t[k] = 5000000 + (int64_t) llround(k * periodUs + (k ? jitter(rng) : 0));
+  return t;
+}
+
+int main() {
+  std::cout << "Starting Symbol Renderer Tests..." << std::endl;
+  const double periodUs = 8192e6 / 12000;
+  const std::string path = "symbol-render-test.wav";
+
+  WSPREncoder enc;
+  enc.encode("K1ABC", "FN42", 37);
+
+  std::cout << "\n--- Test Case 1: Audio WAV ---" << std::endl;
+  {
+    std::mt19937 rng(1);
+    int64_t now = 0;
+    std::vector<int64_t> t = symbolTimes(WSPRSymbolCount, periodUs, 0, rng);
+    {
+      SymbolRenderer::Options options;
+      SymbolRenderer renderer(path, options, [&now]() { return now; });
+      check("File opens", renderer.isOpen());
+      transmit(renderer, enc.symbols, WSPRSymbolCount, now, t, t.back() + (int64_t) llround(periodUs));
+    }
+
+    Wav wav;
+    bool read = readWav(path, wav);
+    check("Header parses and sizes match the data", read);
+    check("12 kHz 16-bit mono", wav.channels == 1 && wav.sampleRate == 12000 && wav.bits == 16);
+    const size_t expected = WSPRDecoder::FrameSamples + 2 * 12000;
+    check("Lead-in + 162 x 8192 + lead-out samples (+/- 1)",
+          wav.samples.size() + 1 >= expected && wav.samples.size() <= expected + 1);
+
+    std::vector<float> audio(wav.samples.begin(), wav.samples.end());
+    check("Lead-in is silent", wav.samples[0] == 0 && wav.samples[11999] == 0 && wav.samples[12001] != 0);
+
+    WSPRDecodeResult r;
+    WSPRDecoder::decodeAudio(audio.data(), audio.size(), r);
+    check("WSPRDecoder decodes the file", r.ok && !strcmp(r.callsign, "K1ABC") && !strcmp(r.locator, "FN42") &&
+                                            r.powerDbm == 37);
+    check("Frame found at 1 s, 0 Hz offset", fabs(r.timeOffsetSec - 1.0) < 0.05 && fabs(r.freqOffsetHz) < 0.2);
+  }
+
+  std::cout << "\n--- Test Case 2: Timing Jitter ---" << std::endl;
+  {
+    std::mt19937 rng(2);
+    int64_t now = 0;
+    std::vector<int64_t> t = symbolTimes(WSPRSymbolCount, periodUs, 15000, rng);
+    SymbolRenderer::TimingStats stats;
+    {
+      SymbolRenderer::Options options;
+      options.centerHz = 1520.0;
+      SymbolRenderer renderer(path, options, [&now]() { return now; });
+      transmit(renderer, enc.symbols, WSPRSymbolCount, now, t, t.back() + (int64_t) llround(periodUs));
+      stats = renderer.timingStats();
+    }
+    check("161 symbol periods measured", stats.symbols == WSPRSymbolCount - 1);
+    check("Jitter of +/- 15 ms per edge is reported", stats.maxJitterMs > 15.0 && stats.maxJitterMs <= 30.0 &&
+                                                      stats.rmsJitterMs > 5.0);
+
+    Wav wav;
+    readWav(path, wav);
+    std::vector<float> audio(wav.samples.begin(), wav.samples.end());
+    WSPRDecoder::Options decodeOptions;
+    decodeOptions.centerHz = 1520.0f;
+    WSPRDecodeResult r;
+    WSPRDecoder::decodeAudio(audio.data(), audio.size(), r, decodeOptions);
+    check("Jittered frame still decodes", r.ok && !strcmp(r.callsign, "K1ABC"));
+
+    // The first tone change happens where the clock said it did
+    int k = 1;
+    while (enc.symbols[k] == enc.symbols[k - 1]) ++k;
+    const size_t boundary = 12000 + (size_t) ((t[k] - t[0]) * 12000 / 1000000);
+    const double f0 = 1520.0 + (enc.symbols[k - 1] - 1.5) * 12000.0 / 8192;
+    const double f1 = 1520.0 + (enc.symbols[k] - 1.5) * 12000.0 / 8192;
+    auto power = [&](size_t from, double hz) {
+      std::complex<double> acc = 0;
+      for (size_t n = from; n < from + 4096; ++n) {
+        acc += (double) wav.samples[n] * std::polar(1.0, -6.283185307179586 * hz * n / 12000);
+      }
+      return std::norm(acc);
+    };
+    check("Tone changes at the measured boundary",
+          power(boundary - 4096, f0) > 10 * power(boundary - 4096, f1) && power(boundary, f1) > 10 * power(boundary, f0));
+  }
+
+  std::cout << "\n--- Test Case 3: Phase-Continuous IQ ---" << std::endl;
+  {
+    // Short 8-FSK burst with a 10 ms period, so every tone change is checked
+    static const uint8_t tones[] = {0, 7, 3, 3, 5, 1, 6, 2, 4, 0};
+    const int count = sizeof(tones);
+    std::mt19937 rng(3);
+    int64_t now = 0;
+    std::vector<int64_t> t = symbolTimes(count, 10000, 0, rng);
+
+    SymbolRenderer::Options options;
+    options.format = SymbolRenderer::IQ;
+    options.centerHz = -250.0;
+    options.toneSpacingHz = 100.0;
+    options.toneCount = 8;
+    options.symbolPeriodMs = 10.0;
+    options.amplitude = 0.9f;
+    options.leadInSec = 0;
+    options.leadOutSec = 0;
+    {
+      SymbolRenderer renderer(path, options, [&now]() { return now; });
+      transmit(renderer, tones, count, now, t, t.back() + 10000);
+    }
+
+    Wav wav;
+    bool read = readWav(path, wav);
+    check("Stereo IQ file", read && wav.channels == 2 && wav.samples.size() == 2 * 120 * count);
+
+    double worstStep = 0, worstMagnitude = 0;
+    const double full = 0.9 * 32767;
+    for (int n = 0; n < 120 * count; ++n) {
+      const std::complex<double> z(wav.samples[2 * n], wav.samples[2 * n + 1]);
+      worstMagnitude = std::fmax(worstMagnitude, fabs(std::abs(z) - full));
+      if (n == 0) continue;
+
+      // Sample n is sample n - 1 advanced by the tone sample n - 1 was sent on
+      const double hz = options.centerHz + (tones[(n - 1) / 120] - 3.5) * options.toneSpacingHz;
+      const std::complex<double> prev(wav.samples[2 * n - 2], wav.samples[2 * n - 1]);
+      worstStep = std::fmax(worstStep, std::abs(z - prev * std::polar(1.0, 6.283185307179586 * hz / 12000)));
+    }
+    check("Constant envelope (within 2 LSB)", worstMagnitude < 2.0);
+    check("No phase jump at any sample, tone changes included (within 3 LSB)", worstStep < 3.0);
+  }
+
+  std::cout << "\n--- Test Case 4: Vector NCO Against Scalar ---" << std::endl;
+  {
+    SymbolRenderer::Options options;
+    options.format = SymbolRenderer::IQ;
+    options.centerHz = 1234.5;
+    options.amplitude = 1.0f;
+    SymbolRenderer renderer("/dev/null", options);
+    renderer.startSymbolStream(2);
+
+    // Long enough for many lane resyncs and a partial final vector
+    const int n = 5003;
+    std::vector<float> out(2 * n);
+    renderer.render(out.data(), n);
+    const double hz = 1234.5 + 0.5 * 12000.0 / 8192;
+    double worst = 0;
+    for (int i = 0; i < n; ++i) {
+      const double a = 6.283185307179586 * hz * i / 12000;
+      worst = std::fmax(worst, std::abs(std::complex<double>(out[2 * i], out[2 * i + 1]) - std::polar(1.0, a)));
+    }
+    check("Matches cos/sin to 1e-5 over 5003 samples", worst < 1e-5);
+  }
+
+  remove(path.c_str());
+  std::cout << "\nSymbol Renderer Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,261 @@
+#include "Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point t) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+// One periodic timer's firings, as lateness against start + n * period
+struct Probe {
+  TimerIntf::Timer* timer = nullptr;
+  Clock::time_point started;
+  int periodMs = 0;
+  int fired = 0;
+  std::vector<float> latenessMs;
+};
+
+// ./bench-timer [timers] [seconds] [workers]
+int main(int argc, char** argv) {
+  const int count = argc > 1 ? atoi(argv[1]) : 10000;
+  const int seconds = argc > 2 ? atoi(argv[2]) : 5;
+  const int workers = argc > 3 ? atoi(argv[3]) : 4;
+  std::cout << "Starting Host Timer Benchmark..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: " << count << " Periodic Timers for " << seconds << " s ---" << std::endl;
+  {
+    Timer timers(workers);
+    std::vector<Probe> probes(count);
+
+    // Periods of 20-100 ms, so about a thousand firings per 20 ms
+    const auto setupStart = Clock::now();
+    for (int i = 0; i < count; ++i) {
+      Probe& p = probes[i];
+      p.periodMs = 20 + (i * 7919) % 81;
+      p.latenessMs.reserve(seconds * 1000 / p.periodMs + 2);
+      p.timer = timers.createPeriodic([&p]() {
+        const double due = (double) ++p.fired * p.periodMs;
+        p.latenessMs.push_back((float) (msSince(p.started) - due));
+      });
+      p.started = Clock::now();
+      timers.start(p.timer, p.periodMs);
+    }
+    const double setupMs = msSince(setupStart);
+
+    const std::clock_t cpuStart = std::clock();
+    const auto runStart = Clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    const double cpuPercent = 100.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC / (msSince(runStart) / 1000);
+
+    const auto stopStart = Clock::now();
+    for (Probe& p : probes) timers.stop(p.timer);
+    const double stopMs = msSince(stopStart);
+    const auto stoppedAt = Clock::now();
+
+    // Let anything already queued drain, then nothing more may fire
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t firedAfterStop = timers.getFired();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    firedAfterStop = timers.getFired() - firedAfterStop;
+
+    std::vector<float> all;
+    bool counts = true;
+    for (Probe& p : probes) {
+      const double ranMs = std::chrono::duration<double, std::milli>(stoppedAt - p.started).count();
+      const int expected = (int) (ranMs / p.periodMs);
+      counts &= std::abs(p.fired - expected) <= 1;
+      all.insert(all.end(), p.latenessMs.begin(), p.latenessMs.end());
+    }
+    std::sort(all.begin(), all.end());
+    const auto at = [&](double q) { return all.empty() ? 0.0 : all[(size_t) (q * (all.size() - 1))]; };
+
+    std::printf("  %zu firings, %llu overruns; lateness median %.3f ms, p99 %.3f ms, max %.3f ms\n",
+                all.size(), (unsigned long long) timers.getOverruns(), at(0.5), at(0.99), at(1.0));
+    std::printf("  CPU %.1f%% of one core; start %.1f ms, stop %.1f ms for all %d\n", cpuPercent, setupMs, stopMs,
+                count);
+    check("Every timer fired once per period", counts);
+    check("Median lateness under 2 ms", at(0.5) < 2);
+    check("p99 lateness under 20 ms", at(0.99) < 20);
+    check("Nothing fires after stop", firedAfterStop == 0);
+
+    const auto destroyStart = Clock::now();
+    for (Probe& p : probes) timers.destroy(p.timer);
+    std::printf("  destroy %.1f ms for all %d\n", msSince(destroyStart), count);
+  }
+
+  std::cout << "\n--- Test Case 2: Non-Blocking Control ---" << std::endl;
+  {
+    Timer timers(2);
+    std::atomic<int> runs(0);
+    TimerIntf::Timer* slow = timers.createOneShot([&runs]() {
+      std::this_thread::sleep_for(std::chrono::seconds(2));
+      ++runs;
+    });
+    timers.start(slow, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The callback is sleeping; none of these may wait for it
+    auto t = Clock::now();
+    timers.stop(slow);
+    const double stopMs = msSince(t);
+    t = Clock::now();
+    timers.start(slow, 1000);
+    const double restartMs = msSince(t);
+    t = Clock::now();
+    timers.destroy(slow);
+    const double destroyMs = msSince(t);
+    std::printf("  during a 2 s callback: stop %.3f ms, restart %.3f ms, destroy %.3f ms\n", stopMs, restartMs,
+                destroyMs);
+    check("stop, start and destroy return at once", stopMs < 10 && restartMs < 10 && destroyMs < 10);
+
+    // Other timers keep firing on the remaining worker
+    std::atomic<int> ticks(0);
+    TimerIntf::Timer* fast = timers.createPeriodic([&ticks]() { ++ticks; });
+    timers.start(fast, 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    timers.destroy(fast);
+    check("A busy worker does not hold up other timers", ticks >= 15);
+
+    // A one-shot restarted before it fires only fires for the restart
+    std::atomic<int> shots(0);
+    TimerIntf::Timer* once = timers.createOneShot([&shots]() { ++shots; });
+    timers.start(once, 30);
+    timers.start(once, 60);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    check("A restarted one-shot fires once", shots == 1);
+    timers.destroy(once);
+
+    // A one-shot that re-arms itself from its callback is due again while
+    // that callback still runs; every link of the chain must fire
+    std::atomic<int> links(0);
+    TimerIntf::Timer* chain = nullptr;
+    chain = timers.createOneShot([&]() {
+      if (++links < 5) timers.start(chain, 0);
+    });
+    timers.start(chain, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    check("A one-shot re-armed from its callback keeps firing", links == 5);
+    timers.destroy(chain);
+  }
+
+  std::cout << "\n--- Test Case 3: Absolute Deadlines ---" << std::endl;
+  {
+    Timer timers(2);
+    std::atomic<int64_t> firedAt(0);
+    TimerIntf::Timer* once = timers.createOneShot([&]() { firedAt = timers.nowUs(TimerIntf::Clock::Monotonic); });
+
+    int64_t deadline = timers.nowUs(TimerIntf::Clock::Monotonic) + 50000;
+    timers.startAt(once, deadline, TimerIntf::Clock::Monotonic);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::printf("  monotonic deadline met %.3f ms late\n", (firedAt - deadline) / 1000.0);
+    check("A monotonic deadline fires on time", firedAt >= deadline && firedAt - deadline < 5000);
+
+    firedAt = 0;
+    deadline = timers.nowUs(TimerIntf::Clock::Monotonic) - 1000000;
+    timers.startAt(once, deadline, TimerIntf::Clock::Monotonic);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    check("A deadline already past fires at once", firedAt != 0);
+
+    // Wall clock stepped 1.5 s forward 100 ms into a 2 s wait: the timer
+    // fires at the same UTC instant, 0.5 s after it was started
+    firedAt = 0;
+    auto t = Clock::now();
+    timers.startAt(once, timers.nowUs(TimerIntf::Clock::Utc) + 2000000, TimerIntf::Clock::Utc);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    timers.stepUtc(1500000);
+    while (firedAt == 0 && msSince(t) < 3000) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double ms = msSince(t);
+    std::printf("  UTC deadline 2000 ms away, clock stepped +1500 ms: fired after %.1f ms\n", ms);
+    check("A forward step brings a UTC deadline closer", firedAt != 0 && std::abs(ms - 500) < 30);
+
+    // And 1 s back: a 300 ms wait becomes 1.3 s
+    firedAt = 0;
+    t = Clock::now();
+    timers.startAt(once, timers.nowUs(TimerIntf::Clock::Utc) + 300000, TimerIntf::Clock::Utc);
+    timers.stepUtc(-1000000);
+    while (firedAt == 0 && msSince(t) < 3000) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ms = msSince(t);
+    std::printf("  UTC deadline 300 ms away, clock stepped -1000 ms: fired after %.1f ms\n", ms);
+    check("A backward step pushes a UTC deadline out", firedAt != 0 && std::abs(ms - 1300) < 30);
+    timers.destroy(once);
+
+    // Periodic on whole tenths of a UTC second, across a 37 ms step
+    std::vector<int64_t> phases;
+    std::mutex phaseMutex;
+    TimerIntf::Timer* tenths = timers.createPeriodic([&]() {
+      std::lock_guard<std::mutex> lock(phaseMutex);
+      phases.push_back(timers.nowUs(TimerIntf::Clock::Utc) % 100000);
+    });
+    const int64_t utcNow = timers.nowUs(TimerIntf::Clock::Utc);
+    timers.startAt(tenths, utcNow - utcNow % 100000 + 100000, TimerIntf::Clock::Utc, 100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(450));
+    timers.stepUtc(37000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    timers.destroy(tenths);
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    int aligned = 0;
+    for (int64_t phase : phases) aligned += phase < 5000;
+    std::printf("  %d of %zu periodic UTC firings within 5 ms of a tenth\n", aligned, phases.size());
+    check("Periodic UTC firings stay on the wall-clock grid across a step", phases.size() >= 8 &&
+          aligned >= (int) phases.size() - 1);
+  }
+
+  std::cout << "\n--- Test Case 4: Slack Coalescing ---" << std::endl;
+  {
+    // 64 periodic timers of 200-263 ms, first strict and then with 100 ms
+    // of slack, each for 2 s
+    uint64_t wakeups[2] = {};
+    bool counts = true, withinSlack = true;
+    for (int pass = 0; pass < 2; ++pass) {
+      Timer timers(2);
+      std::vector<Probe> probes(64);
+      for (int i = 0; i < (int) probes.size(); ++i) {
+        Probe& p = probes[i];
+        p.periodMs = 200 + i;
+        p.timer = timers.createPeriodic([&p]() {
+          const double due = (double) ++p.fired * p.periodMs;
+          p.latenessMs.push_back((float) (msSince(p.started) - due));
+        });
+        if (pass) timers.setSlack(p.timer, 100);
+        p.started = Clock::now();
+        timers.start(p.timer, p.periodMs);
+      }
+      std::this_thread::sleep_for(std::chrono::seconds(2));
+      for (Probe& p : probes) timers.destroy(p.timer);
+      wakeups[pass] = timers.getWakeups();
+
+      for (Probe& p : probes) {
+        counts &= std::abs(p.fired - 2000 / p.periodMs) <= 1;
+        if (pass) {
+          for (float late : p.latenessMs) withinSlack &= late > -1 && late < 100 + 20;
+        }
+      }
+    }
+    std::printf("  dispatcher wakeups: %llu strict, %llu with 100 ms slack\n", (unsigned long long) wakeups[0],
+                (unsigned long long) wakeups[1]);
+    check("Every timer still fires once per period", counts);
+    check("No firing later than its slack, give or take jitter", withinSlack);
+    check("Slack cuts wakeups at least fivefold", wakeups[1] * 5 <= wakeups[0]);
+  }
+
+  std::cout << "\nHost Timer Benchmark " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+#include "JTEncode.h"
+#include "WSPRBatchEncoder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Throughput benchmark: messages per second for the one-at-a-time
+// WSPREncoder and for each supported WSPRBatchEncoder kernel.
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  int rounds = argc > 2 ? atoi(argv[2]) : 5;
+
+  std::vector<std::string> calls, locs;
+  std::vector<int8_t> powers;
+  for (size_t i = 0; i < count; ++i) {
+    char call[8], loc[5];
+    snprintf(call, sizeof(call), "K%d%c%c%c", (int) (i % 10), 'A' + (int) (i % 26),
+             'A' + (int) (i / 26 % 26), 'A' + (int) (i / 676 % 26));
+    snprintf(loc, sizeof(loc), "%c%c%d%d", 'A' + (int) (i % 18), 'A' + (int) (i / 18 % 18),
+             (int) (i / 7 % 10), (int) (i / 3 % 10));
+    calls.push_back(call);
+    locs.push_back(loc);
+    powers.push_back((int8_t) (i % 61));
+  }
+
+  std::vector<const char*> callPtrs, locPtrs;
+  for (size_t i = 0; i < count; ++i) {
+    callPtrs.push_back(calls[i].c_str());
+    locPtrs.push_back(locs[i].c_str());
+  }
+  std::vector<uint8_t> out(count * WSPREncoder::TxBufferSize);
+
+  printf("WSPR encode throughput, %zu messages x %d rounds\n", count, rounds);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      WSPREncoder enc;
+      enc.encode(callPtrs[i], locPtrs[i], powers[i]);
+      out[i * WSPREncoder::TxBufferSize] = enc.symbols[0];
+    }
+  }
+  double single = secondsSince(start);
+  printf("  %-12s %12.0f msg/s\n", "WSPREncoder", count * rounds / single);
+
+  const WSPRBatchEncoder::Isa isas[] = {
+    WSPRBatchEncoder::Isa::SCALAR, WSPRBatchEncoder::Isa::AVX2, WSPRBatchEncoder::Isa::NEON
+  };
+  for (WSPRBatchEncoder::Isa isa : isas) {
+    if (!WSPRBatchEncoder::isSupported(isa)) continue;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+      WSPRBatchEncoder::encode(isa, callPtrs.data(), locPtrs.data(), powers.data(), count, out.data());
+    }
+    double t = secondsSince(start);
+    printf("  batch/%-6s %12.0f msg/s  (%.2fx)\n", WSPRBatchEncoder::isaName(isa), count * rounds / t, single / t);
+  }
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "JTEncode.h"
+#include "WSPRBatchEncoder.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+// Builds a deterministic spread of callsigns, locators and powers,
+// including short calls, lowercase input and a few compound callsigns.
+static void makeIdentities(size_t count, std::vector<std::string>& calls, std::vector<std::string>& locs,
+                           std::vector<int8_t>& powers) {
+  static const char* prefixes[] = {"K", "W", "N", "G", "VK", "JA", "DL", "k", "2E"};
+  uint32_t seed = 12345;
+
+  for (size_t i = 0; i < count; ++i) {
+    seed = seed * 1103515245 + 12345;
+    std::string call = prefixes[(seed >> 8) % 9];
+    call += (char) ('0' + (seed >> 12) % 10);
+    int suffixLen = 1 + (seed >> 16) % 3;
+    for (int k = 0; k < suffixLen; ++k) call += (char) ('A' + (seed >> (18 + 3 * k)) % 26);
+    if (i % 97 == 5) call = "PJ4/" + call;
+    if (i % 89 == 7) call += "/P";
+
+    std::string loc;
+    loc += (char) ('A' + (seed >> 3) % 18);
+    loc += (char) ('A' + (seed >> 7) % 18);
+    loc += (char) ('0' + (seed >> 11) % 10);
+    loc += (char) ('0' + (seed >> 15) % 10);
+
+    calls.push_back(call);
+    locs.push_back(loc);
+    powers.push_back((int8_t) ((seed >> 20) % 61));
+  }
+}
+
+int main() {
+  std::cout << "Starting WSPR Batch Encoder Tests..." << std::endl;
+  std::cout << "Best kernel: " << WSPRBatchEncoder::isaName(WSPRBatchEncoder::bestIsa()) << std::endl;
+
+  // Not a multiple of Lanes, so the last block is partially filled
+  const size_t count = 1003;
+  std::vector<std::string> calls, locs;
+  std::vector<int8_t> powers;
+  makeIdentities(count, calls, locs, powers);
+
+  std::vector<const char*> callPtrs, locPtrs;
+  for (size_t i = 0; i < count; ++i) {
+    callPtrs.push_back(calls[i].c_str());
+    locPtrs.push_back(locs[i].c_str());
+  }
+
+  std::vector<uint8_t> expected(count * WSPREncoder::TxBufferSize);
+  for (size_t i = 0; i < count; ++i) {
+    WSPREncoder enc;
+    enc.encode(callPtrs[i], locPtrs[i], powers[i]);
+    memcpy(&expected[i * WSPREncoder::TxBufferSize], enc.symbols, WSPREncoder::TxBufferSize);
+  }
+
+  const WSPRBatchEncoder::Isa isas[] = {
+    WSPRBatchEncoder::Isa::SCALAR, WSPRBatchEncoder::Isa::AVX2, WSPRBatchEncoder::Isa::NEON
+  };
+
+  std::cout << "\n--- Test Case 1: Batch Matches WSPREncoder ---" << std::endl;
+  for (WSPRBatchEncoder::Isa isa : isas) {
+    std::string name = WSPRBatchEncoder::isaName(isa);
+    if (!WSPRBatchEncoder::isSupported(isa)) {
+      std::cout << "  Test: " << name << " kernel [SKIP - not supported]" << std::endl;
+      continue;
+    }
+
+    std::vector<uint8_t> actual(count * WSPREncoder::TxBufferSize, 0xFF);
+    WSPRBatchEncoder::encode(isa, callPtrs.data(), locPtrs.data(), powers.data(), count, actual.data());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (memcmp(&actual[i * WSPREncoder::TxBufferSize], &expected[i * WSPREncoder::TxBufferSize],
+                 WSPREncoder::TxBufferSize) != 0) {
+        if (mismatches++ == 0) std::cout << "    First mismatch: " << calls[i] << " " << locs[i] << std::endl;
+      }
+    }
+    check(name + " kernel, " + std::to_string(count) + " messages", mismatches == 0);
+  }
+
+  std::cout << "\n--- Test Case 2: Empty Batch ---" << std::endl;
+  {
+    uint8_t guard = 0xAA;
+    WSPRBatchEncoder::encode(callPtrs.data(), locPtrs.data(), powers.data(), 0, &guard);
+    check("count == 0 writes nothing", guard == 0xAA);
+  }
+
+  std::cout << "\nWSPR Batch Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+#include "JTEncode.h"
+#include "WSPRDecoder.h"
+#include "WSPRPipeline.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Encodes frames with WSPREncoder and decodes them again with WSPRDecoder,
+// both from the channel tones and from synthesized noisy audio.
+
+struct LoopbackCase {
+  const char* callsign;
+  const char* locator;
+  int8_t powerDbm;
+  WSPREncoder::MessageType type;
+};
+
+static const LoopbackCase cases[] = {
+  {"K1ABC", "FN42", 37, WSPREncoder::TYPE1},
+  {"NT7S", "CN85", 20, WSPREncoder::TYPE1},
+  {"G4ABC", "IO91", 0, WSPREncoder::TYPE1},
+  {"PJ4/K1ABC", "FN42", 37, WSPREncoder::TYPE2},
+  {"K1ABC/P", "FN42", 37, WSPREncoder::TYPE2},
+  {"K1ABC/12", "FN42", 30, WSPREncoder::TYPE2},
+  {"K1ABC", "FN42AX", 37, WSPREncoder::TYPE3},
+  {"PJ4/K1ABC", "FK52UD", 23, WSPREncoder::TYPE3},
+};
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static std::string caseName(const LoopbackCase& c) {
+  return std::string(c.callsign) + " " + c.locator + " " + std::to_string(c.powerDbm) + " (Type " +
+         std::to_string((int) c.type) + ")";
+}
+
+// Does the decoded message say what was sent?
+static bool matches(const LoopbackCase& c, const WSPRDecodeResult& r) {
+  if (!r.ok || r.type != c.type || r.powerDbm != c.powerDbm) return false;
+  if (c.type == WSPREncoder::TYPE3) {
+    return strcmp(r.locator, c.locator) == 0 && r.hash == wsprCallsignHash(c.callsign);
+  }
+  // Type 2 carries a prefix or suffix in place of the locator
+  const char* locator = c.type == WSPREncoder::TYPE2 ? "" : c.locator;
+  return strcmp(r.callsign, c.callsign) == 0 && strcmp(r.locator, locator) == 0;
+}
+
+// Noise of unit variance plus a frame at snrDb in 2500 Hz, starting
+// startSec into the recording
+static std::vector<float> makeAudio(const WSPREncoder& enc, double snrDb, double startSec, double centerHz,
+                                    std::mt19937& rng) {
+  const size_t samples = WSPRDecoder::FrameSamples + 3 * WSPRDecoder::SampleRate;
+  std::vector<float> audio(samples);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  for (float& s : audio) s = noise(rng);
+
+  // Sine power A^2 / 2 against noise power 2500 / 6000 in the reference band
+  const float amplitude = (float) sqrt(2.0 * 2500.0 / 6000.0 * pow(10.0, snrDb / 10));
+  WSPRDecoder::synthesize(enc.symbols, audio.data(), samples, (size_t) (startSec * WSPRDecoder::SampleRate),
+                          centerHz, amplitude);
+  return audio;
+}
+
+int main() {
+  std::cout << "Starting WSPR Loopback Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Channel Tone Round Trip ---" << std::endl;
+  for (const LoopbackCase& c : cases) {
+    WSPREncoder enc;
+    enc.encode(c.callsign, c.locator, c.powerDbm, c.type);
+    WSPRDecodeResult r;
+    WSPRDecoder::decodeSymbols(enc.symbols, r);
+    check(caseName(c), matches(c, r) && r.syncQuality == 1.0f);
+  }
+
+  std::cout << "\n--- Test Case 2: Symbol Errors ---" << std::endl;
+  {
+    // Flip the data bit of every 20th symbol: 9 hard errors spread over the frame
+    const LoopbackCase& c = cases[0];
+    WSPREncoder enc;
+    enc.encode(c.callsign, c.locator, c.powerDbm, c.type);
+    uint8_t corrupted[WSPRSymbolCount];
+    memcpy(corrupted, enc.symbols, sizeof(corrupted));
+    for (int k = 0; k < WSPRSymbolCount; k += 20) corrupted[k] ^= 2;
+    WSPRDecodeResult r;
+    WSPRDecoder::decodeSymbols(corrupted, r);
+    check("9 flipped data bits still decode", matches(c, r));
+
+    // All tone 0 decodes to message 0, which no encoder produces
+    uint8_t zero[WSPRSymbolCount] = {};
+    WSPRDecoder::decodeSymbols(zero, r);
+    check("All-zero frame is rejected", !r.ok);
+  }
+
+  std::cout << "\n--- Test Case 3: Noisy Audio ---" << std::endl;
+  {
+    struct AudioCase {
+      int message;
+      double snrDb;
+      double startSec;
+      double offsetHz;
+    };
+    static const AudioCase audioCases[] = {
+      {0, -20, 1.0, 0.0},
+      {1, -22, 0.37, 1.7},
+      {3, -20, 2.61, -2.9},
+      {6, -20, 1.92, 3.3},
+    };
+
+    std::mt19937 rng(12345);
+    for (const AudioCase& a : audioCases) {
+      const LoopbackCase& c = cases[a.message];
+      WSPREncoder enc;
+      enc.encode(c.callsign, c.locator, c.powerDbm, c.type);
+      std::vector<float> audio = makeAudio(enc, a.snrDb, a.startSec, 1500.0 + a.offsetHz, rng);
+
+      WSPRDecodeResult r;
+      WSPRDecoder::decodeAudio(audio.data(), audio.size(), r);
+      std::string name = caseName(c) + " at " + std::to_string((int) a.snrDb) + " dB";
+      check(name + " decodes", matches(c, r));
+      check(name + " time within 0.1 s", fabs(r.timeOffsetSec - a.startSec) < 0.1);
+      check(name + " frequency within 0.4 Hz", fabs(r.freqOffsetHz - a.offsetHz) < 0.4);
+    }
+  }
+
+  std::cout << "\n--- Test Case 4: Threaded Batch ---" << std::endl;
+  {
+    const int count = 6;
+    std::mt19937 rng(777);
+    std::vector<std::vector<float>> recordings;
+    std::vector<const float*> pointers;
+    for (int i = 0; i < count; ++i) {
+      const LoopbackCase& c = cases[i];
+      WSPREncoder enc;
+      enc.encode(c.callsign, c.locator, c.powerDbm, c.type);
+      recordings.push_back(makeAudio(enc, -18, 0.5 + 0.3 * i, 1500.0 - 2.0 + 0.8 * i, rng));
+    }
+    for (const std::vector<float>& r : recordings) pointers.push_back(r.data());
+
+    WSPRDecodeResult results[count];
+    size_t decoded = WSPRDecoder::decodeBatch(pointers.data(), recordings[0].size(), count, results, 4);
+    bool allMatch = true;
+    for (int i = 0; i < count; ++i) allMatch = allMatch && matches(cases[i], results[i]);
+    check("Batch of " + std::to_string(count) + " on 4 threads decodes", decoded == count);
+    check("Batch results stay in input order", allMatch);
+  }
+
+  std::cout << "\n--- Test Case 5: Noise Only ---" << std::endl;
+  {
+    std::mt19937 rng(99);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> audio(WSPRDecoder::FrameSamples + 2 * WSPRDecoder::SampleRate);
+    for (float& s : audio) s = noise(rng);
+    WSPRDecodeResult r;
+    WSPRDecoder::decodeAudio(audio.data(), audio.size(), r);
+    check("Noise alone does not decode", !r.ok);
+
+    std::vector<float> shortAudio(WSPRDecoder::FrameSamples / 2);
+    check("Recording shorter than a frame is rejected", !WSPRDecoder::decodeAudio(shortAudio.data(),
+                                                                                     shortAudio.size(), r));
+  }
+
+  std::cout << "\nWSPR Loopback Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,258 @@
+#include "WSPRPipeline.h"
+#include "WSPRDecoder.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Exhaustive Type 1 pack/unpack verifier: ./verify-wspr-pack [threads] [stride]
+//
+// Walks every value of the 28-bit callsign field (37 * 36 * 10 * 27^3) and
+// keeps those a legal callsign normalizes to. Each is packed with a
+// locator/power pair and unpacked again, and must come back unchanged. The
+// pairs step through all 32,400 locators x 19 powers, so every pair is used
+// about 400 times over a full sweep. A stride above 1 checks every
+// stride-th field only.
+//
+// The full product (~10^14 messages) would take weeks, and it is not
+// needed: the packed value is nCall << 22 | m with m below 2^22, so it is
+// a bijection over the product exactly when the callsign field and the
+// locator/power field are bijections on their own. Both are checked
+// against a bitmap of every value produced, so any collision is found.
+
+static constexpr uint32_t CallFields = 37u * 36 * 10 * 27 * 27 * 27;
+static constexpr uint32_t LocatorPowers = 180u * 180 * 19;
+static constexpr uint32_t PairStep = 104729;   // prime, so coprime to LocatorPowers
+static constexpr uint64_t ChunkSize = 1 << 14;
+
+static const int8_t powerLevels[19] = {0, 3, 7, 10, 13, 17, 20, 23, 27, 30, 33, 37, 40, 43, 47, 50, 53, 57, 60};
+
+static void fieldFor(uint32_t n, char field[6]) {
+  static const char letters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+  static const char alnum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+  for (int i = 5; i >= 3; --i) {
+    field[i] = letters[n % 27];
+    n /= 27;
+  }
+  field[2] = '0' + n % 10;
+  n /= 10;
+  field[1] = alnum[n % 36];
+  field[0] = alnum[n / 36];
+}
+
+static void locatorFor(uint32_t pair, char locator[5], int8_t& powerDbm) {
+  uint32_t loc = pair / 19;
+  powerDbm = powerLevels[pair % 19];
+  locator[0] = 'A' + loc / 1800;
+  locator[1] = 'A' + loc / 100 % 18;
+  locator[2] = '0' + loc / 10 % 10;
+  locator[3] = '0' + loc % 10;
+  locator[4] = '\0';
+}
+
+// One bit per possible value; set bits are values already produced
+class SeenBitmap {
+public:
+  explicit SeenBitmap(uint64_t bits) : words((bits + 63) / 64) {
+    for (std::atomic<uint64_t>& w : words) w.store(0, std::memory_order_relaxed);
+  }
+
+  // Returns false if the value was already set
+  bool mark(uint64_t value) {
+    const uint64_t bit = 1ULL << (value & 63);
+    return !(words[value >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+  }
+
+private:
+  std::vector<std::atomic<uint64_t>> words;
+};
+
+// Work-stealing range pool. Each worker owns a contiguous range and takes
+// chunks from its end; a worker that runs dry takes the front half of the
+// largest range left, so fast threads pick up after slow ones without a
+// shared counter on the hot path.
+class RangePool {
+public:
+  RangePool(uint64_t count, unsigned workers) : queues(workers), steals(0) {
+    for (unsigned w = 0; w < workers; ++w) {
+      queues[w].begin = count * w / workers;
+      queues[w].end = count * (w + 1) / workers;
+    }
+  }
+
+  bool next(unsigned worker, uint64_t& begin, uint64_t& end) {
+    if (take(queues[worker], begin, end)) return true;
+
+    while (true) {
+      unsigned victim = worker;
+      uint64_t largest = 0;
+      for (unsigned w = 0; w < queues.size(); ++w) {
+        std::lock_guard<std::mutex> guard(queues[w].lock);
+        if (queues[w].end - queues[w].begin > largest) {
+          largest = queues[w].end - queues[w].begin;
+          victim = w;
+        }
+      }
+      if (largest == 0) return false;
+
+      uint64_t stolenBegin, stolenEnd;
+      {
+        std::lock_guard<std::mutex> guard(queues[victim].lock);
+        Queue& q = queues[victim];
+        if (q.begin == q.end) continue;
+        stolenBegin = q.begin;
+        stolenEnd = q.begin + (q.end - q.begin + 1) / 2;
+        q.begin = stolenEnd;
+      }
+      {
+        std::lock_guard<std::mutex> guard(queues[worker].lock);
+        queues[worker].begin = stolenBegin;
+        queues[worker].end = stolenEnd;
+      }
+      steals.fetch_add(1, std::memory_order_relaxed);
+      if (take(queues[worker], begin, end)) return true;
+    }
+  }
+
+  uint64_t stealCount() const { return steals.load(); }
+
+private:
+  struct Queue {
+    std::mutex lock;
+    uint64_t begin = 0, end = 0;
+  };
+
+  static bool take(Queue& q, uint64_t& begin, uint64_t& end) {
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.begin == q.end) return false;
+    end = q.end;
+    begin = q.end - q.begin > ChunkSize ? q.end - ChunkSize : q.begin;
+    q.end = begin;
+    return true;
+  }
+
+  std::vector<Queue> queues;
+  std::atomic<uint64_t> steals;
+};
+
+struct Totals {
+  std::atomic<uint64_t> messages{0}, mismatches{0}, collisions{0};
+  std::mutex reportLock;
+  int reported = 0;
+};
+
+static void report(Totals& totals, const char* what, const char* callsign, const char* locator, int powerDbm) {
+  std::lock_guard<std::mutex> guard(totals.reportLock);
+  if (totals.reported++ < 10) std::printf("  %s: %s %s %d\n", what, callsign, locator, powerDbm);
+}
+
+static void verifyMessage(uint32_t field, uint32_t pair, const char* callsign, Totals& totals, SeenBitmap& calls) {
+  char locator[5];
+  int8_t powerDbm;
+  locatorFor(pair, locator, powerDbm);
+
+  const uint64_t packed = wsprPackMessage(wsprMakeMessage(callsign, locator, powerDbm, WSPREncoder::TYPE1));
+  const uint32_t nCall = (uint32_t) (packed >> 22);
+  if (nCall != field || !calls.mark(nCall)) {
+    totals.collisions.fetch_add(1, std::memory_order_relaxed);
+    report(totals, "callsign field collision", callsign, locator, powerDbm);
+  }
+
+  uint8_t message[7];
+  for (int i = 0; i < 7; ++i) message[i] = (uint8_t) ((packed << 6) >> (48 - 8 * i));
+  WSPRDecodeResult result{};
+  if (!WSPRDecoder::unpack(message, result) || result.type != WSPREncoder::TYPE1 ||
+      strcmp(result.callsign, callsign) != 0 || strcmp(result.locator, locator) != 0 ||
+      result.powerDbm != powerDbm) {
+    totals.mismatches.fetch_add(1, std::memory_order_relaxed);
+    report(totals, "round trip mismatch", callsign, locator, powerDbm);
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned threads = argc > 1 ? (unsigned) atoi(argv[1]) : 0;
+  const uint32_t stride = argc > 2 && atoi(argv[2]) > 0 ? (uint32_t) atoi(argv[2]) : 1;
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+
+  std::cout << "Starting WSPR Type 1 Pack/Unpack Verification..." << std::endl;
+  std::cout << "  " << threads << " thread(s), every " << stride << " of " << CallFields << " callsign fields"
+            << std::endl;
+
+  int failures = 0;
+
+  // The 22-bit locator/power field on its own, all 615,600 values
+  {
+    SeenBitmap seen(1u << 22);
+    uint32_t bad = 0;
+    for (uint32_t pair = 0; pair < LocatorPowers; ++pair) {
+      char locator[5];
+      int8_t powerDbm;
+      locatorFor(pair, locator, powerDbm);
+      const uint64_t m = wsprPackMessage(wsprMakeMessage("K1ABC", locator, powerDbm, WSPREncoder::TYPE1)) &
+                         0x3FFFFF;
+      if (!seen.mark(m) || (m & 127) < 64) ++bad;
+    }
+    std::cout << "  Test: " << LocatorPowers << " locator/power values are distinct"
+              << (bad ? " [FAIL]" : " [PASS]") << std::endl;
+    if (bad) ++failures;
+  }
+
+  // Every legal callsign, each with the next locator/power pair
+  Totals totals;
+  SeenBitmap calls(1u << 28);
+  const uint64_t count = (CallFields + stride - 1) / stride;
+  RangePool pool(count, threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  auto worker = [&](unsigned id) {
+    uint64_t begin, end, messages = 0;
+    while (pool.next(id, begin, end)) {
+      for (uint64_t k = begin; k < end; ++k) {
+        const uint32_t field = (uint32_t) (k * stride);
+        char text[6], callsign[7];
+        fieldFor(field, text);
+
+        // The callsign is the field without its padding; the field must be
+        // what that callsign normalizes to
+        int b = text[0] == ' ' ? 1 : 0, e = 6;
+        while (e > b && text[e - 1] == ' ') --e;
+        memcpy(callsign, text + b, e - b);
+        callsign[e - b] = '\0';
+        if (!wsprIsValidCallsign(callsign)) continue;
+
+        char normalized[6] = {};
+        wsprNormalizeCallsign(callsign, e - b, normalized);
+        if (memcmp(normalized, text, 6) != 0) continue;
+
+        ++messages;
+        verifyMessage(field, (uint32_t) ((uint64_t) field * PairStep % LocatorPowers), callsign, totals, calls);
+      }
+    }
+    totals.messages.fetch_add(messages);
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker, t);
+  worker(0);
+  for (std::thread& t : workers) t.join();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const uint64_t messages = totals.messages.load();
+  std::printf("  %llu legal callsigns packed and unpacked in %.1f s: %.2f M messages/s (%llu steals)\n",
+              (unsigned long long) messages, seconds,
+              messages / seconds / 1e6, (unsigned long long) pool.stealCount());
+
+  std::cout << "  Test: No callsign field collisions" << (totals.collisions ? " [FAIL]" : " [PASS]") << std::endl;
+  std::cout << "  Test: Every message unpacks unchanged" << (totals.mismatches ? " [FAIL]" : " [PASS]") << std::endl;
+  if (totals.collisions) ++failures;
+  if (totals.mismatches) ++failures;
+
+  std::cout << "\nWSPR Pack/Unpack Verification " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
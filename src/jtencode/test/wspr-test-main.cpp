@@ -0,0 +1,279 @@
+#include "JTEncode.h"
+#include "WSPRPipeline.h"
+#include "nhash.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+// Count heap allocations so we can check that encode() never allocates.
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  ++allocationCount;
+  void* p = malloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+// Golden channel symbols (sync + 2 * data, 162 symbols as digits 0..3)
+// produced by the reference WSPR encoding process.
+struct GoldenVector {
+  const char* callsign;
+  const char* locator;
+  int8_t powerDbm;
+  const char* symbols;
+};
+
+static const GoldenVector goldenVectors[] = {
+  {"K1ABC", "FN42", 37,
+      "330020001020131222100323133220200032012322002232110233"
+      "210221321222033030301210212032132003323032203020201023"
+      "021112330231212221332000010320132222202332323320031222"},
+  {"K1AB", "FN42", 37,
+      "310020201000131222100323113220000212010320202232130231"
+      "010221321222233210303210012212110003123032223020201003"
+      "021110130011210221332220012322332222222330323300033220"},
+  {"G4JNT", "IO90", 30,
+      "332200001222333022100121133220200030012100002012112033"
+      "030201121020213010301012032010110221123012223200023201"
+      "001112112031230003312222012120310022222130121320031222"},
+  {"N0CALL", "EN34", 10,
+      "312200021020131022100123333000020212010322220210112213"
+      "032223321022231230301232212210112003321012221220201023"
+      "003312130213212221312020232120310022220332301122233220"},
+  {"VK2ABC", "QF56", 0,
+      "312202021000111020322303333222200210010322220210310211"
+      "212221103022211212101232212032332221303210003200223201"
+      "023112332231210001312222232120312220022330323322233002"},
+  {"W1AW", "FN31", 60,
+      "332022001022333222302101333200020012030120200230332013"
+      "012023103020013212101010210010112201301010221002001023"
+      "201332110213212203312220230300312202200330301300033020"},
+};
+
+// Type 2 and Type 3 golden vectors. The Type 3 hash is nhash_() over the
+// full callsign with an initial value of 146, masked to 15 bits.
+struct TypedGoldenVector {
+  const char* callsign;
+  const char* locator;
+  int8_t powerDbm;
+  WSPREncoder::MessageType type;
+  const char* symbols;
+};
+
+static const TypedGoldenVector typedGoldenVectors[] = {
+  {"PJ4/K1ABC", "FN42", 37, WSPREncoder::TYPE2,
+      "310220001022131020100123131220220230030322022010130031"
+      "010003323222013010301210032032112203323030223022021023"
+      "001310310031230021332000010120112222222132323102011022"},
+  {"K1ABC/P", "FN42", 37, WSPREncoder::TYPE2,
+      "310220001022111020100121113222020030012122022230130033"
+      "010001323222013032301210032232130201123230223020001023"
+      "021312330011230021332000030120132002202330123122033020"},
+  {"K1ABC/12", "FN42", 30, WSPREncoder::TYPE2,
+      "330220021020113022100321133020200230032120022210130233"
+      "030001301022033232321210012232130003103030203220001221"
+      "023112330233230223312202030122132020202132103322031020"},
+  {"K1ABC", "FN42AX", 37, WSPREncoder::TYPE3,
+      "332220023220333220322103133220222012210120222030132213"
+      "012021103002011232323030210030132021323232201022223221"
+      "201330130211012021312002210122132020220110101322231200"},
+  {"PJ4/K1ABC", "FK52UD", 23, WSPREncoder::TYPE3,
+      "332020203000133202300301111220202012032302220012330213"
+      "210003123000231012103230230212130223103230201202201203"
+      "001110110211012201112222012322310022020110101302031002"},
+};
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static std::string symbolString(const WSPREncoder& enc) {
+  std::string s;
+  for (int i = 0; i < WSPREncoder::TxBufferSize; ++i) s += (char) ('0' + enc.symbols[i]);
+  return s;
+}
+
+int main() {
+  std::cout << "Starting WSPR Encoder Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Golden Symbol Vectors ---" << std::endl;
+  for (const GoldenVector& g : goldenVectors) {
+    WSPREncoder enc;
+    enc.encode(g.callsign, g.locator, g.powerDbm);
+    std::string actual = symbolString(enc);
+    std::string name = std::string(g.callsign) + " " + g.locator + " " + std::to_string(g.powerDbm);
+    check(name, actual == g.symbols);
+    if (actual != g.symbols) {
+      std::cout << "    Expected: " << g.symbols << std::endl;
+      std::cout << "    Actual:   " << actual << std::endl;
+    }
+  }
+
+  std::cout << "\n--- Test Case 1b: Type 2/3 Golden Symbol Vectors ---" << std::endl;
+  for (const TypedGoldenVector& g : typedGoldenVectors) {
+    WSPREncoder enc;
+    enc.encode(g.callsign, g.locator, g.powerDbm, g.type);
+    std::string actual = symbolString(enc);
+    std::string name = "Type " + std::to_string((int) g.type) + " " + g.callsign + " " + g.locator +
+                       " " + std::to_string(g.powerDbm);
+    check(name, actual == g.symbols && enc.getMessageType() == g.type);
+    if (actual != g.symbols) {
+      std::cout << "    Expected: " << g.symbols << std::endl;
+      std::cout << "    Actual:   " << actual << std::endl;
+    }
+  }
+
+  std::cout << "\n--- Test Case 1c: Frame Sequences ---" << std::endl;
+  {
+    WSPREncoder::MessageType types[2];
+    int n = WSPREncoder::frameSequence("K1ABC", "FN42", types);
+    check("K1ABC FN42 sends Type 1 only", n == 1 && types[0] == WSPREncoder::TYPE1);
+    n = WSPREncoder::frameSequence("K1ABC", "FN42AX", types);
+    check("K1ABC FN42AX alternates Type 1/3", n == 2 && types[0] == WSPREncoder::TYPE1 && types[1] == WSPREncoder::TYPE3);
+    n = WSPREncoder::frameSequence("PJ4/K1ABC", "FN42AX", types);
+    check("PJ4/K1ABC FN42AX alternates Type 2/3", n == 2 && types[0] == WSPREncoder::TYPE2 && types[1] == WSPREncoder::TYPE3);
+    n = WSPREncoder::frameSequence("PJ4/K1ABC", "FN42", types);
+    check("PJ4/K1ABC FN42 sends Type 2 only", n == 1 && types[0] == WSPREncoder::TYPE2);
+
+    // Type 3 sends six locator characters and must not invent two
+    WSPREncoder t3;
+    t3.encode("K1ABC", "FN42AX", 37, WSPREncoder::TYPE3);
+    bool sixOk = t3.isValid();
+    t3.encode("K1ABC", "FN42", 37, WSPREncoder::TYPE3);
+    bool allZero = true;
+    for (int i = 0; i < WSPREncoder::TxBufferSize; ++i) allZero &= t3.symbols[i] == 0;
+    check("Type 3 rejects a 4-char locator", sixOk && !t3.isValid() && allZero);
+
+    WSPREncoder a, b;
+    a.encode("PJ4/K1ABC", "FN42", 37);
+    b.encode("PJ4/K1ABC", "FN42", 37, WSPREncoder::TYPE2);
+    check("Default encode uses first frame type", symbolString(a) == symbolString(b));
+  }
+
+  std::cout << "\n--- Test Case 1d: Power Rounding ---" << std::endl;
+  {
+    WSPREncoder a, b;
+    a.encode("K1ABC", "FN42", 39);
+    b.encode("K1ABC", "FN42", 37);
+    check("39 dBm rounds down to 37 dBm", symbolString(a) == symbolString(b));
+  }
+
+  std::cout << "\n--- Test Case 2: Callsign Normalization ---" << std::endl;
+  {
+    WSPREncoder a, b, c;
+    a.encode("K1AB", "FN42", 37);
+    b.encode(" K1AB", "FN42", 37);
+    c.encode("k1ab", "fn42", 37);
+    check("K1AB right-aligned matches \" K1AB\"", symbolString(a) == symbolString(b));
+    check("Lowercase input matches uppercase", symbolString(a) == symbolString(c));
+  }
+
+  std::cout << "\n--- Test Case 3: Sync Vector Merge ---" << std::endl;
+  {
+    WSPREncoder enc;
+    enc.encode("K1ABC", "FN42", 37);
+    bool inRange = true;
+    for (int i = 0; i < WSPREncoder::TxBufferSize; ++i) inRange &= enc.symbols[i] <= 3;
+    check("All symbols in 0..3", inRange);
+    // Sync bit is the low bit of each channel symbol
+    check("Sync bits lead with 1,1,0,0", (enc.symbols[0] & 1) == 1 && (enc.symbols[1] & 1) == 1 &&
+          (enc.symbols[2] & 1) == 0 && (enc.symbols[3] & 1) == 0);
+  }
+
+  std::cout << "\n--- Test Case 4: Allocation-Free Encode ---" << std::endl;
+  {
+    WSPREncoder enc;
+    size_t before = allocationCount;
+    for (int i = 0; i < 100; ++i) {
+      enc.encode("K1ABC", "FN42", 37);
+      enc.encode("PJ4/K1ABC", "FN42AX", 37, WSPREncoder::TYPE2);
+      enc.encode("PJ4/K1ABC", "FN42AX", 37, WSPREncoder::TYPE3);
+    }
+    check("No heap allocations during encode", allocationCount == before);
+  }
+
+  std::cout << "\n--- Test Case 5: Compile-Time Frame Sets ---" << std::endl;
+  {
+    static constexpr WSPRFrameSet type1Set = wsprEncodeFrameSet("K1ABC", "FN42", 37);
+    static constexpr WSPRFrameSet compoundSet = wsprEncodeFrameSet("PJ4/K1ABC", "FN42AX", 37);
+    static_assert(type1Set.count == 1 && compoundSet.count == 2, "unexpected frame counts");
+
+    struct { const WSPRFrameSet* set; const char* callsign; const char* locator; } cases[] = {
+      {&type1Set, "K1ABC", "FN42"},
+      {&compoundSet, "PJ4/K1ABC", "FN42AX"},
+    };
+
+    WSPREncoder enc;
+    for (const auto& c : cases) {
+      for (int f = 0; f < c.set->count; ++f) {
+        enc.encode(c.callsign, c.locator, 37, c.set->types[f]);
+        bool match = true;
+        for (int i = 0; i < WSPREncoder::TxBufferSize; ++i) match &= c.set->frames[f].symbol(i) == enc.symbols[i];
+        check(std::string("constexpr ") + c.callsign + " " + c.locator + " Type " +
+              std::to_string(c.set->types[f]) + " matches runtime encode", match);
+      }
+    }
+
+    // The constexpr hash must agree with nhash_() for every length it will see.
+    bool hashMatch = true;
+    char key[21];
+    for (int len = 1; len <= 20; ++len) {
+      for (int seed = 0; seed < 50; ++seed) {
+        for (int i = 0; i < len; ++i) key[i] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ/ "[(seed * 7 + i * 13 + len) % 38];
+        key[len] = 0;
+        int nlen = len;
+        uint32_t ival = 146;
+        hashMatch &= wsprHash(key, len, 146) == (uint32_t) nhash_(key, &nlen, &ival);
+      }
+    }
+    check("wsprHash matches nhash_ for lengths 1..20", hashMatch);
+  }
+
+  std::cout << "\n--- Test Case 6: SymbolFrame Views ---" << std::endl;
+  {
+    // Statically dispatched encoders carry no vtable
+    check("Encoders are not polymorphic", !std::is_polymorphic<WSPREncoder>::value &&
+                                              !std::is_polymorphic<FT8Encoder>::value &&
+                                              !std::is_polymorphic<JT65Encoder>::value &&
+                                              !std::is_polymorphic<JT9Encoder>::value &&
+                                              !std::is_polymorphic<JT4Encoder>::value);
+
+    WSPREncoder enc;
+    enc.encode("K1ABC", "FN42", 37);
+    SymbolFrame unpacked = enc.frame();
+    WSPRPackedFrame packedFrame = wsprPackFrame(enc.symbols);
+    SymbolFrame packed = wsprSymbolFrame(packedFrame);
+
+    bool same = unpacked.count == WSPRSymbolCount && packed.count == WSPRSymbolCount;
+    for (int i = 0; same && i < WSPRSymbolCount; ++i) same = unpacked[i] == enc.symbols[i] && packed[i] == enc.symbols[i];
+    check("Unpacked and packed views match the symbols", same);
+    check("View carries tone spacing and symbol period",
+          packed.toneSpacing == 146 && packed.symbolPeriod == 683 && packed.toneCount == 4);
+    check("WSPR frame lasts 110.6 s", packed.durationMs() == 110646);
+    check("Tone 3 is 4.38 Hz up", packed.toneOffset(3) == 438);
+
+    // Any mode hands the modulator the same kind of view
+    JT9Encoder jt9;
+    jt9.encode("CQ K1ABC FN42");
+    SymbolFrame jt9Frame = jt9.frame();
+    check("JT9 view: 85 symbols, 9 tones, 576 ms",
+          jt9Frame.count == 85 && jt9Frame.toneCount == 9 && jt9Frame.symbolPeriod == 576 && jt9Frame[1] == 0);
+  }
+
+  std::cout << "\nWSPR Encoder Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
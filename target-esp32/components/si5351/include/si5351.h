@@ -2,7 +2,7 @@
 #define SI5351_H
 
 #include <cstdint>
-#include "sdkconfig.h"
+#include "I2CBusIntf.h"
 
 class Si5351 {
 public:
@@ -45,10 +45,8 @@ public:
   };
 
   // --- Constructor & Destructor ---
-  explicit Si5351(uint8_t i2cAddr,
-		  uint8_t sdaPin,
-		  uint8_t sclPin,
-		  int32_t correction = 0);
+  // The bus is the caller's and must outlive the driver
+  Si5351(I2CBusIntf* bus, uint8_t i2cAddr, int32_t correction = 0);
   ~Si5351();
 
   // Prevent copying
@@ -70,14 +68,48 @@ public:
   void updateCLK0Frequency(int32_t newFreq);
   void updateCLK0FrequencyMinimal(int32_t newFreq);
   
+  // --- Precomputed Tone Methods ---
+  // Integer-mode PLL A at pllMult * crystal, CLK0 fractional from it with
+  // the eight MS0 register bytes (42-49) given
+  void setupCLK0Tone(uint8_t pllMult, const uint8_t msRegs[8], DriveStrength driveStrength);
+  // Writes count MS0 register bytes starting at register 42 + first in
+  // one I2C burst
+  void writeCLK0Multisynth(const uint8_t* regs, uint8_t first, uint8_t count);
+  
+  // --- Solver Register Methods ---
+  // PLL and output multisynth from precomputed register bytes (the PLL's
+  // eight feedback bytes at 26 or 34, the output's eight MS bytes), then a
+  // PLL reset
+  void setupCLKRegisters(uint8_t output, PLL pll, const uint8_t pllRegs[8], const uint8_t msRegs[8],
+                         bool integerMode, DriveStrength driveStrength);
+  // One burst of the PLL's eight feedback bytes without a reset, for small
+  // steps of a fractional PLL
+  void writePLLRegisters(PLL pll, const uint8_t regs[8]);
+  // One burst of an output's eight MS bytes without a PLL reset, for small
+  // steps of its fractional divider; integer mode is cleared first
+  void writeMultisynthRegisters(uint8_t output, const uint8_t msRegs[8]);
+  
+  // --- Register Shadow ---
+  // Writes land in a 256-byte copy of the registers and go out at the end
+  // of each call as one burst per run of changed bytes; bytes the chip
+  // already holds are skipped. Disabled, every register write is its own
+  // transaction, as the driver did before.
+  void setShadowEnabled(bool enabled);
+  // Forgets what the chip holds (e.g. after it lost power), so the next
+  // writes all go out
+  void invalidateShadow();
+  
   // --- Zero-Register-Write WSPR Methods ---
   void setupWSPROutputs(int32_t baseFreq, DriveStrength driveStrength);
   void selectWSPRTone(uint8_t tone);
 
 private:
   // --- Private Methods ---
-  void i2cInit(uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin);
   uint8_t write(uint8_t reg, uint8_t data);
+  void writeBurst(uint8_t first, const uint8_t* data, uint8_t count);
+  void strobe(uint8_t reg, uint8_t data);
+  void setShadow(uint8_t reg, uint8_t data, bool always);
+  void flush();
   void writeBulk(uint8_t baseaddr, int32_t p1, int32_t p2, int32_t p3, uint8_t divBy4, RDiv rdiv);
   void writeFractionalOnly(uint8_t baseaddr, int32_t p2, int32_t p3);
   void writeP2Only(uint8_t baseaddr, int32_t p2);
@@ -85,8 +117,15 @@ private:
 
   // --- Private Member Variables ---
   int32_t correction;
-  void* busHandle; // Use void* to hide C-style handles from the header
-  void* devHandle;
+  I2CBusIntf* bus;
+  uint8_t i2cAddr;
+  
+  // Register shadow: bit r of shadowKnown says shadow[r] is what the chip
+  // holds, bit r of shadowDirty that it still has to be written
+  bool shadowEnabled;
+  uint8_t shadow[256];
+  uint8_t shadowKnown[32];
+  uint8_t shadowDirty[32];
   
   // Stored configuration for smooth frequency updates
   PLLConfig currentPLLConfig;
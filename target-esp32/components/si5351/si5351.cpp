@@ -1,10 +1,20 @@
 // vim: set ai et ts=4 sw=4:
 
 #include "si5351.h"
+#include <cstring>
+#ifdef ESP_PLATFORM
 #include "sdkconfig.h"
-#include "freertos/FreeRTOS.h"
-#include "driver/i2c_master.h"
 #include "esp_log.h"
+#else
+// Host builds run the driver against an I2CBusIntf mock, without logging
+#define ESP_LOGI(tag, ...) do { (void) (tag); } while (0)
+#define ESP_LOGW(tag, ...) do { (void) (tag); } while (0)
+#define ESP_LOGV(tag, ...) do { (void) (tag); } while (0)
+#endif
+
+#ifndef CONFIG_SI5351_CRYSTAL_FREQ
+#define CONFIG_SI5351_CRYSTAL_FREQ 25000000
+#endif
 
 // --- Private Register Definitions ---
 enum {
@@ -32,15 +42,17 @@ static const char *TAG = "Si5351";
 
 // --- Constructor / Destructor ---
 
-Si5351::Si5351(uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin, int32_t correctionVal) {
+Si5351::Si5351(I2CBusIntf* bus, uint8_t i2cAddr, int32_t correctionVal) {
+  this->bus = bus;
+  this->i2cAddr = i2cAddr;
   correction = correctionVal;
-  busHandle = nullptr;
-  devHandle = nullptr;
+  shadowEnabled = true;
+  memset(shadow, 0, sizeof(shadow));
+  invalidateShadow();
   currentBaseFreq = 0;
   // Initialize configs to zero
   currentPLLConfig = {0, 0, 0};
   currentOutputConfig = {false, 0, 0, 0, RDiv::DIV_1};
-  i2cInit(i2cAddr, sdaPin, sclPin);
 
   write(SI5351_REG_OUTPUT_ENABLE_CONTROL, 0xFF); // Disable all outputs
   write(SI5351_REG_CLK0_CONTROL, 0x80);
@@ -48,52 +60,94 @@ Si5351::Si5351(uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin, int32_t correcti
   write(SI5351_REG_CLK2_CONTROL, 0x80);
 
   write(SI5351_REG_CRYSTAL_LOAD, CRYSTAL_LOAD_10PF);
+  flush();
 }
 
 Si5351::~Si5351() {
-  if (devHandle) {
-    i2c_master_bus_rm_device((i2c_master_dev_handle_t)devHandle);
-  }
-  if (busHandle) {
-    i2c_del_master_bus((i2c_master_bus_handle_t)busHandle);
-  }
 }
 
-// --- Private I2C Methods ---
+// --- Register Shadow ---
+
+void Si5351::setShadowEnabled(bool enabled) {
+  flush();
+  shadowEnabled = enabled;
+}
+
+void Si5351::invalidateShadow() {
+  memset(shadowKnown, 0, sizeof(shadowKnown));
+  memset(shadowDirty, 0, sizeof(shadowDirty));
+}
+
+void Si5351::setShadow(uint8_t reg, uint8_t data, bool always) {
+  const uint8_t bit = 1 << (reg & 7);
+  if (!always && (shadowKnown[reg >> 3] & bit) && shadow[reg] == data) return;
+  shadow[reg] = data;
+  shadowDirty[reg >> 3] |= bit;
+}
 
-void Si5351::i2cInit(uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin) {
-  i2c_master_bus_config_t busConfig = {
-    .i2c_port = I2C_NUM_0,
-    .sda_io_num = (gpio_num_t)sdaPin,
-    .scl_io_num = (gpio_num_t)sclPin,
-    .clk_source = I2C_CLK_SRC_DEFAULT,
-    .glitch_ignore_cnt = 7,
-    .intr_priority = 0,
-    .trans_queue_depth = 0,
-    .flags = {
-      .enable_internal_pullup = true,
-      .allow_pd = false
+void Si5351::flush() {
+  // One auto-increment burst per run of dirty registers, in address
+  // order, so a PLL reset (177) follows the PLL and MS parameters. A clean
+  // register always ends the run: unchanged bytes are never written.
+  uint8_t writeBuf[257];
+  int reg = 0;
+  while (reg < 256) {
+    if (!(shadowDirty[reg >> 3] & (1 << (reg & 7)))) {
+      reg++;
+      continue;
     }
-  };
-  ESP_LOGI(TAG, "i2c_new_master_bus i2cAddr=%02X, sdaPin=%u, sclPin=%u", (int) i2cAddr, sdaPin, sclPin);
-  ESP_ERROR_CHECK(i2c_new_master_bus(&busConfig, (i2c_master_bus_handle_t*)&busHandle));
-
-  i2c_device_config_t devConfig = {
-    .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-    .device_address = i2cAddr,
-    .scl_speed_hz = 100000,
-    .scl_wait_us = 0,
-    .flags = 0,
-  };
-  ESP_LOGI(TAG, "i2c_master_bus_add_device");
-  ESP_ERROR_CHECK(i2c_master_bus_add_device((i2c_master_bus_handle_t)busHandle, &devConfig,
-					    (i2c_master_dev_handle_t*)&devHandle));
-  ESP_LOGI(TAG, "done");
+    int end = reg;
+    while (end < 256 && (shadowDirty[end >> 3] & (1 << (end & 7)))) end++;
+
+    writeBuf[0] = (uint8_t)reg;
+    memcpy(writeBuf + 1, shadow + reg, end - reg);
+    if (bus->write(i2cAddr, writeBuf, end - reg + 1)) {
+      for (int r = reg; r < end; r++) {
+        shadowKnown[r >> 3] |= 1 << (r & 7);
+        shadowDirty[r >> 3] &= ~(1 << (r & 7));
+      }
+    } else {
+      // Left dirty for the next flush; the chip may hold anything now
+      for (int r = reg; r < end; r++) shadowKnown[r >> 3] &= ~(1 << (r & 7));
+      ESP_LOGW(TAG, "I2C burst to registers %d-%d failed", reg, end - 1);
+    }
+    reg = end;
+  }
 }
 
+// --- Private I2C Methods ---
+
 uint8_t Si5351::write(uint8_t reg, uint8_t data) {
+  if (shadowEnabled) {
+    setShadow(reg, data, false);
+    return 1;
+  }
+  shadow[reg] = data;  // kept current for read-modify-writes
   uint8_t writeBuf[2] = {reg, data};
-  return i2c_master_transmit((i2c_master_dev_handle_t)devHandle, writeBuf, sizeof(writeBuf), -1) == ESP_OK;
+  return bus->write(i2cAddr, writeBuf, sizeof(writeBuf));
+}
+
+void Si5351::writeBurst(uint8_t first, const uint8_t* data, uint8_t count) {
+  if (shadowEnabled) {
+    for (int i = 0; i < count; i++) setShadow(first + i, data[i], false);
+    return;
+  }
+  uint8_t writeBuf[9];
+  if (count > 8) return;
+  writeBuf[0] = first;
+  memcpy(writeBuf + 1, data, count);
+  memcpy(shadow + first, data, count);
+  bus->write(i2cAddr, writeBuf, count + 1);
+}
+
+void Si5351::strobe(uint8_t reg, uint8_t data) {
+  // Self-clearing command bits take effect on every write
+  if (shadowEnabled) {
+    setShadow(reg, data, true);
+    return;
+  }
+  uint8_t writeBuf[2] = {reg, data};
+  bus->write(i2cAddr, writeBuf, sizeof(writeBuf));
 }
 
 void Si5351::writeBulk(uint8_t baseaddr, int32_t p1, int32_t p2, int32_t p3, uint8_t divBy4, RDiv rdiv) {
@@ -118,12 +172,11 @@ void Si5351::writeFractionalOnly(uint8_t baseaddr, int32_t p2, int32_t p3) {
 void Si5351::writeP2Only(uint8_t baseaddr, int32_t p2) {
   // For WSPR tones, only p2 changes, so write only registers +6 and +7
   // Use burst write to minimize glitches - single I2C transaction for both bytes
-  uint8_t writeBuf[3] = {
-    (uint8_t)(baseaddr + 6),  // Start register address
+  uint8_t regs[2] = {
     (uint8_t)((p2 >> 8) & 0xFF),  // Register +6 value
     (uint8_t)(p2 & 0xFF)          // Register +7 value  
   };
-  i2c_master_transmit((i2c_master_dev_handle_t)devHandle, writeBuf, sizeof(writeBuf), -1);
+  writeBurst(baseaddr + 6, regs, sizeof(regs));
 }
 
 void Si5351::writeP2OnlyGlitchFree(uint8_t baseaddr, int32_t p2, uint8_t clk_num) {
@@ -131,12 +184,11 @@ void Si5351::writeP2OnlyGlitchFree(uint8_t baseaddr, int32_t p2, uint8_t clk_num
   // No output disable/enable, no phase resets, no other register touches
   // This eliminates ALL possible implicit PLL reset triggers
   
-  uint8_t writeBuf[3] = {
-    (uint8_t)(baseaddr + 6),        // Start register address (reg 48 for CLK0)
+  uint8_t regs[2] = {
     (uint8_t)((p2 >> 8) & 0xFF),    // Register +6 value (p2 middle byte)
     (uint8_t)(p2 & 0xFF)            // Register +7 value (p2 low byte)
   };
-  i2c_master_transmit((i2c_master_dev_handle_t)devHandle, writeBuf, sizeof(writeBuf), -1);
+  writeBurst(baseaddr + 6, regs, sizeof(regs));
   
   // That's it! No other register writes that could trigger PLL resets
 }
@@ -151,7 +203,8 @@ void Si5351::setupPLL(PLL pll, const PLLConfig& conf) {
   p3 = conf.denom;
   uint8_t baseaddr = (pll == PLL::A ? 26 : 34);
   writeBulk(baseaddr, p1, p2, p3, 0, RDiv::DIV_1);
-  write(SI5351_REG_PLL_RESET, (1<<7) | (1<<5));
+  strobe(SI5351_REG_PLL_RESET, (1<<7) | (1<<5));
+  flush();
 }
 
 int Si5351::setupOutput(uint8_t output, PLL pllSource, DriveStrength driveStrength, const OutputConfig& conf, uint8_t phaseOffset) {
@@ -188,6 +241,7 @@ int Si5351::setupOutput(uint8_t output, PLL pllSource, DriveStrength driveStreng
   write(ctrlReg, clkControl);
   writeBulk(baseaddr, p1, p2, p3, divBy4, conf.rdiv);
   // Phase offset is not implemented in this simplified driver version
+  flush();
     
   return 0;
 }
@@ -284,6 +338,7 @@ void Si5351::setupCLK2(int32_t fclk, DriveStrength driveStrength) {
 
 void Si5351::enableOutputs(uint8_t enabled) {
   write(SI5351_REG_OUTPUT_ENABLE_CONTROL, ~enabled);
+  flush();
 }
 
 void Si5351::setCorrection(int32_t correctionPPM) {
@@ -377,6 +432,7 @@ void Si5351::updateCLK0Frequency(int32_t newFreq) {
   
   // Write MultiSynth registers for CLK0 (baseaddr = 42)
   writeBulk(SI5351_REG_MS0_PARAMS_1, p1, p2, p3, 0, newConfig.rdiv);
+  flush();
   
   // Update stored config
   currentOutputConfig = newConfig;
@@ -417,6 +473,7 @@ void Si5351::updateCLK0FrequencyMinimal(int32_t newFreq) {
   // Write p2 registers with glitch-free method (disable output during update)
   // This prevents any glitches from propagating to the output
   writeP2OnlyGlitchFree(SI5351_REG_MS0_PARAMS_1, p2, 0);  // CLK0 = clk_num 0
+  flush();
   
   // Update stored config
   currentOutputConfig.num = num;
@@ -425,6 +482,50 @@ void Si5351::updateCLK0FrequencyMinimal(int32_t newFreq) {
            (long)newFreq, (long)p2);
 }
 
+void Si5351::setupCLK0Tone(uint8_t pllMult, const uint8_t msRegs[8], DriveStrength driveStrength) {
+  currentPLLConfig = {pllMult, 0, 1};
+  currentBaseFreq = 0;  // the updateCLK0Frequency* path needs setupCLK0Smooth again
+  setupPLL(PLL::A, currentPLLConfig);
+  write(SI5351_REG_CLK0_CONTROL, 0x0C | (uint8_t)driveStrength);  // fractional, PLL A
+  writeBurst(SI5351_REG_MS0_PARAMS_1, msRegs, 8);
+  flush();
+}
+
+void Si5351::writeCLK0Multisynth(const uint8_t* regs, uint8_t first, uint8_t count) {
+  if (first + count > 8) return;
+  writeBurst(SI5351_REG_MS0_PARAMS_1 + first, regs, count);
+  flush();
+}
+
+void Si5351::setupCLKRegisters(uint8_t output, PLL pll, const uint8_t pllRegs[8], const uint8_t msRegs[8],
+                               bool integerMode, DriveStrength driveStrength) {
+  if (output > 2) return;
+  currentBaseFreq = 0;  // the updateCLK0Frequency* path needs setupCLK0Smooth again
+
+  writeBurst(pll == PLL::A ? 26 : 34, pllRegs, 8);
+  strobe(SI5351_REG_PLL_RESET, (1<<7) | (1<<5));
+
+  uint8_t clkControl = 0x0C | (uint8_t)driveStrength;
+  if (pll == PLL::B) clkControl |= (1 << 5);
+  if (integerMode) clkControl |= (1 << 6);
+  write(SI5351_REG_CLK0_CONTROL + output, clkControl);
+
+  writeBurst(SI5351_REG_MS0_PARAMS_1 + 8 * output, msRegs, 8);
+  flush();
+}
+
+void Si5351::writePLLRegisters(PLL pll, const uint8_t regs[8]) {
+  writeBurst(pll == PLL::A ? 26 : 34, regs, 8);
+  flush();
+}
+
+void Si5351::writeMultisynthRegisters(uint8_t output, const uint8_t msRegs[8]) {
+  if (output > 2) return;
+  write(SI5351_REG_CLK0_CONTROL + output, shadow[SI5351_REG_CLK0_CONTROL + output] & ~(1 << 6));
+  writeBurst(SI5351_REG_MS0_PARAMS_1 + 8 * output, msRegs, 8);
+  flush();
+}
+
 void Si5351::setupWSPROutputs(int32_t baseFreq, DriveStrength driveStrength) {
   // Setup 4 different outputs (CLK0, CLK1, CLK2 + one more) for WSPR tones
   // This avoids ANY register writes during transmission - just output enable switching!
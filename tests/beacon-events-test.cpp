@@ -0,0 +1,191 @@
+#include "beacon-harness.h"
+#include "Scheduler.h"
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+    std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+    if (!ok) ++failures;
+}
+
+// Timers that fire only when the test says, on a UTC clock it sets
+class ManualTimer : public TimerIntf {
+public:
+    struct Entry : TimerIntf::Timer {
+        std::function<void()> callback;
+        int64_t deadlineUs = -1;
+    };
+
+    TimerIntf::Timer* createOneShot(const std::function<void()>& callback) override {
+        entries.emplace_back(new Entry());
+        entries.back()->callback = callback;
+        return entries.back().get();
+    }
+    TimerIntf::Timer* createPeriodic(const std::function<void()>& callback) override { return createOneShot(callback); }
+    void start(TimerIntf::Timer* t, unsigned int timeoutMs) override {
+        static_cast<Entry*>(t)->deadlineUs = utcUs + timeoutMs * 1000LL;
+    }
+    void startAt(TimerIntf::Timer* t, int64_t deadlineUs, Clock, unsigned int) override {
+        static_cast<Entry*>(t)->deadlineUs = deadlineUs;
+    }
+    void setSlack(TimerIntf::Timer*, unsigned int) override {}
+    int64_t nowUs(Clock) override { return utcUs; }
+    void stop(TimerIntf::Timer* t) override { static_cast<Entry*>(t)->deadlineUs = -1; }
+    void destroy(TimerIntf::Timer*) override {}
+    void delayMs(int) override {}
+    void executeWithPreciseTiming(const std::function<void()>& callback, int) override { callback(); }
+    void syncTime() override {}
+    time_t getCurrentTime() override { return (time_t) (utcUs / 1000000) + coarseSkewSec; }
+
+    // Fire the index'th timer created, as the timer task would
+    void fire(size_t index) {
+        entries[index]->deadlineUs = -1;
+        entries[index]->callback();
+    }
+    int64_t deadlineUs(size_t index) const { return entries[index]->deadlineUs; }
+
+    int64_t utcUs = 0;
+    time_t coarseSkewSec = 0;   // getCurrentTime() minus nowUs(Clock::Utc)
+
+private:
+    std::vector<std::unique_ptr<Entry>> entries;
+};
+
+int main() {
+    std::cout << "Starting Beacon Event Tests..." << std::endl;
+
+    BeaconHarness h;
+    check("Beacon reaches its main loop", h.start());
+
+    std::cout << "\n--- Test Case 1: Calibration Flood ---" << std::endl;
+    {
+        h.beacon->setCalibrationMode(true, 14097100);
+        check("Calibration mode starts", h.logger.waitFor("Calibration mode enabled", 1, 2000));
+
+        // Hold the loop inside the first setpoint while the web page floods
+        // both mailboxes, then change settings behind the flood
+        h.si5351.hold();
+        h.beacon->postCalibrationFrequency(14097100.0);
+        check("The loop is busy with the first setpoint", h.si5351.waitHeld(2000));
+
+        const Beacon::EventLoopStats before = h.beacon->getEventLoopStats();
+        for (int i = 1; i <= 10000; ++i) {
+            h.beacon->postCalibrationFrequency(14097100.0 + i * 0.01);
+            h.beacon->postCalibrationPreview(i);
+        }
+        h.webServer.changeSettings();
+        const Beacon::EventLoopStats flooded = h.beacon->getEventLoopStats();
+        h.si5351.release();
+
+        std::cout << "  20000 setpoints queued " << (flooded.posted - before.posted) << " events, "
+                  << (flooded.dropped - before.dropped) << " dropped" << std::endl;
+        check("Each mailbox queues one event per burst", flooded.posted - before.posted == 3);
+        check("Nothing is dropped", flooded.dropped == before.dropped);
+        check("The settings change still arrives", h.logger.waitFor("Settings changed", 1, 2000));
+        check("Only the newest frequency reaches the chip", h.si5351.fineTunes == 2);
+    }
+
+    std::cout << "\n--- Test Case 2: After the Flood ---" << std::endl;
+    {
+        // The mailboxes were emptied, so the next setpoint wakes the loop
+        h.beacon->postCalibrationFrequency(14097200.0);
+        bool applied = false;
+        for (int i = 0; i < 200 && !applied; ++i) {
+            applied = h.si5351.fineTunes == 3;
+            if (!applied) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        check("A later setpoint is applied", applied);
+
+        // Out of calibration mode the setpoint is dropped, not left pending
+        h.beacon->setCalibrationMode(false);
+        check("Calibration mode stops", h.logger.waitFor("Calibration mode disabled", 1, 2000));
+        const Beacon::EventLoopStats idle = h.beacon->getEventLoopStats();
+        h.beacon->postCalibrationFrequency(14097300.0);
+        h.webServer.changeSettings();   // handled after the setpoint, in order
+        const bool handled = h.logger.waitFor("Settings changed", 2, 2000);
+        h.beacon->postCalibrationFrequency(14097400.0);
+        check("Each later post wakes the loop again", handled &&
+              h.beacon->getEventLoopStats().posted - idle.posted == 3);
+        check("Neither reaches the chip", h.si5351.fineTunes == 3);
+    }
+
+    std::cout << "\n--- Test Case 3: Next Transmission Snapshot ---" << std::endl;
+    {
+        // The web server reads only what the loop published
+        check("The loop is idle", h.waitIdle(2000));
+        const Beacon::NextTransmissionInfo off = h.beacon->getNextTransmissionInfo();
+        check("Published at startup: nothing scheduled at txPct 0",
+              std::string(off.band) == "20m" && off.secondsUntil < 0 && !off.valid);
+
+        h.settings.setInt("txPct", 100);
+        const Beacon::NextTransmissionInfo stale = h.beacon->getNextTransmissionInfo();
+        check("A setting alone does not change it", stale.secondsUntil < 0);
+        h.webServer.changeSettings();
+        check("The loop handles the change", h.waitIdle(2000));
+        const Beacon::NextTransmissionInfo on = h.beacon->getNextTransmissionInfo();
+        check("Republished once the loop applied it", on.secondsUntil >= 0 && on.secondsUntil <= 120);
+        h.settings.setInt("txPct", 0);
+    }
+
+    h.stop();
+
+    std::cout << "\n--- Test Case 4: Scheduler Wakes ---" << std::endl;
+    {
+        // The scheduler's timers only hand their wake to the owner's thread;
+        // the opportunity roll and the re-arming happen when it is handled
+        ManualTimer timer;
+        Settings settings;
+        settings.setInt("txPct", 100);
+        Scheduler scheduler(&timer, &settings);
+        std::vector<std::pair<Scheduler::Wake, uint32_t>> wakes;
+        int starts = 0, ends = 0;
+        scheduler.setWakeCallback([&](Scheduler::Wake wake, uint32_t generation) { wakes.push_back({wake, generation}); });
+        scheduler.setTransmissionStartCallback([&]() { ++starts; });
+        scheduler.setTransmissionEndCallback([&]() { ++ends; });
+
+        const int64_t slotUs = 120LL * 1000000;
+        timer.utcUs = 1000 * slotUs - 5000000;
+        scheduler.start();
+        check("The slot timer is armed on the next boundary", timer.deadlineUs(0) == 1000 * slotUs);
+
+        timer.utcUs = 1000 * slotUs + 300000;
+        timer.fire(0);
+        check("A slot wake only hands over", wakes.size() == 1 && wakes[0].first == Scheduler::Wake::Slot &&
+              starts == 0 && timer.deadlineUs(0) == -1);
+
+        scheduler.handleWake(wakes[0].first, wakes[0].second);
+        check("Handling it rolls and re-arms", starts == 1 && scheduler.isTransmissionInProgress() &&
+              timer.deadlineUs(0) == 1001 * slotUs);
+
+        timer.fire(1);
+        check("The transmission end is handed over too", wakes.size() == 2 &&
+              wakes[1].first == Scheduler::Wake::TransmissionEnd && ends == 0);
+        scheduler.cancelCurrentTransmission();
+        scheduler.handleWake(wakes[1].first, wakes[1].second);
+        check("An end queued before a cancel is dropped", ends == 0);
+
+        timer.utcUs = 1001 * slotUs;
+        timer.fire(0);
+        scheduler.handleWake(wakes[2].first, wakes[2].second);
+        timer.fire(1);
+        scheduler.handleWake(wakes[3].first, wakes[3].second);
+        check("A current one ends the transmission", starts == 2 && ends == 1 && !scheduler.isTransmissionInProgress());
+
+        // Slots are taken from the UTC clock the timer is armed on, even
+        // when the coarse wall clock disagrees
+        timer.utcUs = 1002 * slotUs + 500000;
+        timer.coarseSkewSec = -30;
+        check("Slot arithmetic uses nowUs(Clock::Utc)", scheduler.getSecondsUntilNextTransmission() == 0);
+        timer.fire(0);
+        scheduler.handleWake(wakes[4].first, wakes[4].second);
+        check("A wake at the armed boundary is its slot's opportunity", starts == 3);
+        scheduler.stop();
+    }
+
+    std::cout << "\nBeacon Event Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+    return failures ? 1 : 0;
+}
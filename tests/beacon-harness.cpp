@@ -0,0 +1,169 @@
+#include "beacon-harness.h"
+#include <chrono>
+#include <cstdio>
+
+// The context is filled in by BeaconHarness, from its own members
+AppContext::AppContext()
+    : logger(nullptr), gpio(nullptr), net(nullptr), nvs(nullptr), si5351(nullptr), fileSystem(nullptr),
+      settings(nullptr), webServer(nullptr), timer(nullptr), time(nullptr), task(nullptr), eventGroup(nullptr),
+      wsprModulator(nullptr), symbolOutput(nullptr), random(nullptr) {}
+
+AppContext::~AppContext() {}
+
+// --- CapturingLogger ---
+
+#define CAPTURE(tag, format)                \
+    do {                                    \
+        va_list args;                       \
+        va_start(args, format);             \
+        vadd(tag, format, args);            \
+        va_end(args);                       \
+    } while (0)
+
+void CapturingLogger::logInfo(const char* tag, const char* format, ...) { CAPTURE(tag, format); }
+void CapturingLogger::logWarn(const char* tag, const char* format, ...) { CAPTURE(tag, format); }
+void CapturingLogger::logError(const char* tag, const char* format, ...) { CAPTURE(tag, format); }
+void CapturingLogger::logDebug(const char* tag, const char* format, ...) { CAPTURE(tag, format); }
+
+void CapturingLogger::vadd(const char* tag, const char* format, va_list args) {
+    char line[256];
+    const int n = snprintf(line, sizeof(line), "%s: ", tag ? tag : "");
+    vsnprintf(line + n, sizeof(line) - n, format, args);
+    add(line);
+}
+
+void CapturingLogger::add(const std::string& line) {
+    std::lock_guard<std::mutex> lock(mutex);
+    lines.push_back(line);
+    changed.notify_all();
+}
+
+int CapturingLogger::count(const char* text) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    int n = 0;
+    for (const std::string& line : lines) {
+        if (line.find(text) != std::string::npos) ++n;
+    }
+    return n;
+}
+
+bool CapturingLogger::waitFor(const char* text, int n, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() {
+        int found = 0;
+        for (const std::string& line : lines) {
+            if (line.find(text) != std::string::npos) ++found;
+        }
+        return found >= n;
+    });
+}
+
+// --- SteppableTimer ---
+
+void SteppableTimer::startAt(TimerIntf::Timer* t, int64_t deadlineUs, Clock clock, unsigned int periodMs) {
+    if (clock == Clock::Utc) return;
+    
+    // A monotonic deadline the beacon computed from the stepped clock
+    timer.startAt(t, deadlineUs - stepUs, clock, periodMs);
+}
+
+int64_t SteppableTimer::nowUs(Clock clock) {
+    return timer.nowUs(clock) + (clock == Clock::Monotonic ? stepUs.load() : 0);
+}
+
+// --- GatedSi5351 ---
+
+void GatedSi5351::fineTune(int channel, double freqHz) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        inside = true;
+        changed.notify_all();
+        changed.wait(lock, [this]() { return !holding; });
+        inside = false;
+    }
+    Si5351::fineTune(channel, freqHz);
+    ++fineTunes;
+}
+
+void GatedSi5351::hold() {
+    std::lock_guard<std::mutex> lock(mutex);
+    holding = true;
+}
+
+void GatedSi5351::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    holding = false;
+    changed.notify_all();
+}
+
+bool GatedSi5351::waitHeld(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return inside; });
+}
+
+// --- WatchedEventGroup ---
+
+uint32_t WatchedEventGroup::waitBits(uint32_t bitsToWaitFor, bool clearOnExit, bool waitForAll, uint32_t timeoutMs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastTimeoutMs = timeoutMs;
+        asleep = true;
+        changed.notify_all();
+    }
+    const uint32_t bits = EventGroup::waitBits(bitsToWaitFor, clearOnExit, waitForAll, timeoutMs);
+    std::lock_guard<std::mutex> lock(mutex);
+    asleep = false;
+    return bits;
+}
+
+bool WatchedEventGroup::waitAsleep(int timeoutMs, const std::function<bool()>& done) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() { return asleep && done(); });
+}
+
+// --- BeaconHarness ---
+
+BeaconHarness::BeaconHarness() : modulator(&timer) {
+    ctx.logger = &logger;
+    ctx.gpio = &gpio;
+    ctx.net = &net;
+    ctx.nvs = &nvs;
+    ctx.si5351 = &si5351;
+    ctx.fileSystem = &fileSystem;
+    ctx.settings = &settings;
+    ctx.webServer = &webServer;
+    ctx.timer = &timer;
+    ctx.time = &time;
+    ctx.task = &task;
+    ctx.eventGroup = &eventGroup;
+    ctx.wsprModulator = &modulator;
+
+    // Nothing transmits unless a test asks for it
+    settings.setInt("txPct", 0);
+    beacon.reset(new Beacon(&ctx));
+}
+
+BeaconHarness::~BeaconHarness() {
+    stop();
+}
+
+bool BeaconHarness::start() {
+    thread = std::thread([this]() { beacon->run(); });
+    return logger.waitFor("Entering main operation loop", 1, 5000);
+}
+
+void BeaconHarness::stop() {
+    if (!thread.joinable()) return;
+    si5351.release();
+    beacon->stop();
+    thread.join();
+}
+
+bool BeaconHarness::waitIdle(int timeoutMs) {
+    // The loop only sleeps after draining the queue and running maintenance,
+    // so asleep with nothing left unhandled means the pass is over
+    return eventGroup.waitAsleep(timeoutMs, [this]() {
+        const Beacon::EventLoopStats stats = beacon->getEventLoopStats();
+        return stats.handled == stats.posted;
+    });
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Beacon.h"
+#include "EventGroup.h"
+#include "FileSystem.h"
+#include "GPIO.h"
+#include "NVS.h"
+#include "Net.h"
+#include "Settings.h"
+#include "Si5351.h"
+#include "Task.h"
+#include "Time.h"
+#include "Timer.h"
+#include "WSPRModulator.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A real Beacon on the host mocks, run on a thread of its own as main()
+// runs it on the ESP32. Tests drive it only through what the other tasks
+// use: posts, the web server's callbacks and the clock.
+
+// Keeps log lines in memory so a test can wait for what the beacon did
+class CapturingLogger : public LoggerIntf {
+public:
+    void logInfo(const char* msg) override { add(msg); }
+    void logWarn(const char* msg) override { add(msg); }
+    void logError(const char* msg) override { add(msg); }
+    void logDebug(const char* msg) override { add(msg); }
+    void logInfo(const char* tag, const char* format, ...) override;
+    void logWarn(const char* tag, const char* format, ...) override;
+    void logError(const char* tag, const char* format, ...) override;
+    void logDebug(const char* tag, const char* format, ...) override;
+    void vlogInfo(const char* tag, const char* format, va_list args) override { vadd(tag, format, args); }
+    void vlogWarn(const char* tag, const char* format, va_list args) override { vadd(tag, format, args); }
+    void vlogError(const char* tag, const char* format, va_list args) override { vadd(tag, format, args); }
+    void vlogDebug(const char* tag, const char* format, va_list args) override { vadd(tag, format, args); }
+
+    // Lines containing text so far
+    int count(const char* text) const;
+
+    // Until at least n lines contain text; false on timeout
+    bool waitFor(const char* text, int n, int timeoutMs);
+
+private:
+    void add(const std::string& line);
+    void vadd(const char* tag, const char* format, va_list args);
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::string> lines;
+};
+
+// The host Timer, except that the monotonic clock the beacon reads can be
+// stepped forward, so an hour-long deadline comes due without the wait.
+// UTC deadlines, i.e. the scheduler's slot boundaries, are never armed, so
+// no slot wake lands in the event counts a test makes.
+class SteppableTimer : public TimerIntf {
+public:
+    TimerIntf::Timer* createOneShot(const std::function<void()>& callback) override { return timer.createOneShot(callback); }
+    TimerIntf::Timer* createPeriodic(const std::function<void()>& callback) override { return timer.createPeriodic(callback); }
+    void start(TimerIntf::Timer* t, unsigned int timeoutMs) override { timer.start(t, timeoutMs); }
+    void startAt(TimerIntf::Timer* t, int64_t deadlineUs, Clock clock, unsigned int periodMs = 0) override;
+    void setSlack(TimerIntf::Timer* t, unsigned int slackMs) override { timer.setSlack(t, slackMs); }
+    int64_t nowUs(Clock clock) override;
+    void stop(TimerIntf::Timer* t) override { timer.stop(t); }
+    void destroy(TimerIntf::Timer* t) override { timer.destroy(t); }
+    void delayMs(int timeoutMs) override { timer.delayMs(timeoutMs); }
+    void executeWithPreciseTiming(const std::function<void()>& callback, int intervalMs) override {
+        timer.executeWithPreciseTiming(callback, intervalMs);
+    }
+    void syncTime() override { timer.syncTime(); }
+    time_t getCurrentTime() override { return timer.getCurrentTime(); }
+
+    void advanceMonotonic(int64_t us) { stepUs += us; }
+
+private:
+    ::Timer timer;
+    std::atomic<int64_t> stepUs{0};
+};
+
+// Counts SNTP requests, and can fail them as an unreachable server would
+class CountingTime : public Time {
+public:
+    bool syncTime(const char* ntpServer) override {
+        ++syncs;
+        return !failing && Time::syncTime(ntpServer);
+    }
+
+    std::atomic<int> syncs{0};
+    std::atomic<bool> failing{false};
+};
+
+// The host Si5351, whose fineTune() can be held to keep the main loop busy
+class GatedSi5351 : public Si5351 {
+public:
+    GatedSi5351() { setVerbose(false); }
+
+    void fineTune(int channel, double freqHz) override;
+
+    void hold();
+    void release();
+
+    // Until the loop is inside a held fineTune(); false on timeout
+    bool waitHeld(int timeoutMs);
+
+    std::atomic<int> fineTunes{0};
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool holding = false;
+    bool inside = false;
+};
+
+// The host event group, telling when the main loop has gone back to sleep
+class WatchedEventGroup : public EventGroup {
+public:
+    uint32_t waitBits(uint32_t bitsToWaitFor, bool clearOnExit, bool waitForAll, uint32_t timeoutMs) override;
+
+    // Until a task is waiting on the group and done() holds, checked while
+    // it cannot wake; false on timeout
+    bool waitAsleep(int timeoutMs, const std::function<bool()>& done);
+
+    // Timeout of the latest wait, how long the task meant to sleep
+    std::atomic<uint32_t> lastTimeoutMs{0};
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool asleep = false;
+};
+
+// Keeps the callbacks the beacon registers so a test can play the web UI
+class FakeWebServer : public WebServerIntf {
+public:
+    void start() override {}
+    void stop() override {}
+    void setSettingsChangedCallback(const std::function<void()>& cb) override { settingsChanged = cb; }
+    void setScheduler(Scheduler*) override {}
+    void setBeacon(Beacon*) override {}
+    void updateBeaconState(const char*, const char*, const char*, uint32_t) override {}
+
+    // As a POST to /api/settings does
+    void changeSettings() {
+        if (settingsChanged) settingsChanged();
+    }
+
+private:
+    std::function<void()> settingsChanged;
+};
+
+struct BeaconHarness {
+    BeaconHarness();
+    ~BeaconHarness();
+
+    // Run the beacon until it is in its main loop; false if it never got there
+    bool start();
+    void stop();
+
+    // Until the loop has handled every event posted and its maintenance, and
+    // sleeps again; false on timeout
+    bool waitIdle(int timeoutMs);
+
+    CapturingLogger logger;
+    GPIO gpio;
+    Net net;
+    NVS nvs;
+    GatedSi5351 si5351;
+    FileSystem fileSystem;
+    Settings settings;
+    FakeWebServer webServer;
+    SteppableTimer timer;
+    CountingTime time;
+    Task task;
+    WatchedEventGroup eventGroup;
+    WSPRModulator modulator;
+    AppContext ctx;
+    std::unique_ptr<Beacon> beacon;
+    std::thread thread;
+};
@@ -0,0 +1,146 @@
+#include "EventQueue.h"
+#include "EventGroup.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Shaped like Beacon's events: small and copied by value
+struct Event {
+  uint8_t producer;
+  uint32_t sequence;
+  int64_t postedUs;
+};
+
+static const uint32_t PostedBit = 1 << 0;
+
+int main() {
+  std::cout << "Starting Event Queue Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: One Thread ---" << std::endl;
+  {
+    EventQueue<Event, 8> queue;
+    Event e;
+    check("Empty at first", !queue.pop(e) && queue.size() == 0);
+    bool pushed = true;
+    for (uint32_t i = 0; i < 8; ++i) pushed &= queue.push({0, i, 0});
+    check("Holds its capacity", pushed && queue.size() == 8);
+    check("A push to a full queue fails and is counted", !queue.push({0, 8, 0}) && queue.getDropped() == 1);
+    bool fifo = true;
+    for (uint32_t i = 0; i < 8; ++i) fifo &= queue.pop(e) && e.sequence == i;
+    check("Pops in order", fifo && !queue.pop(e));
+    check("Posted and high-water counts", queue.getPosted() == 8 && queue.getMaxDepth() == 8);
+
+    // Many laps of the ring
+    bool laps = true;
+    for (uint32_t i = 0; i < 1000; ++i) {
+      laps &= queue.push({0, i, 0}) && queue.push({0, i + 1, 0});
+      laps &= queue.pop(e) && e.sequence == i && queue.pop(e) && e.sequence == i + 1;
+    }
+    check("Wraps around the ring", laps && queue.size() == 0);
+  }
+
+  std::cout << "\n--- Test Case 2: Four Producers, One Consumer ---" << std::endl;
+  {
+    // Producers retry while the queue is full, so every event must arrive
+    // once and in each producer's order
+    const int producers = 4;
+    const uint32_t perProducer = 200000;
+    EventQueue<Event, 64> queue;
+    std::atomic<bool> go(false);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p]() {
+        while (!go) std::this_thread::yield();
+        for (uint32_t i = 0; i < perProducer; ++i) {
+          while (!queue.push({(uint8_t) p, i, 0})) std::this_thread::yield();
+        }
+      });
+    }
+
+    std::vector<uint32_t> next(producers, 0);
+    bool ordered = true;
+    uint64_t received = 0;
+    const auto start = Clock::now();
+    go = true;
+    Event e;
+    while (received < (uint64_t) producers * perProducer) {
+      if (!queue.pop(e)) {
+        std::this_thread::yield();
+        continue;
+      }
+      ordered &= e.sequence == next[e.producer]++;
+      ++received;
+    }
+    for (auto& t : threads) t.join();
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::printf("  %llu events in %.1f ms (%.1f M/s), %u full pushes retried, max depth %u\n",
+                (unsigned long long) received, ms, received / ms / 1000, queue.getDropped(), queue.getMaxDepth());
+    check("Every event arrives in its producer's order", ordered);
+    check("Nothing left over", !queue.pop(e) && queue.getPosted() == producers * perProducer);
+  }
+
+  std::cout << "\n--- Test Case 3: Wake Latency ---" << std::endl;
+  {
+    // Three producers post every millisecond for a second to a consumer
+    // sleeping on an event group, as the beacon loop does
+    EventQueue<Event, 64> queue;
+    EventGroup group;
+    std::atomic<bool> done(false);
+    std::vector<double> latencyMs;
+    latencyMs.reserve(4000);
+
+    std::thread consumer([&]() {
+      Event e;
+      while (true) {
+        const bool last = done.load();
+        group.waitBits(PostedBit, true, false, 100);
+        while (queue.pop(e)) latencyMs.push_back((nowUs() - e.postedUs) / 1000.0);
+        if (last) break;
+      }
+    });
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 3; ++p) {
+      threads.emplace_back([&, p]() {
+        for (uint32_t i = 0; i < 1000; ++i) {
+          queue.push({(uint8_t) p, i, nowUs()});
+          group.setBits(PostedBit);
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+    done = true;
+    group.setBits(PostedBit);
+    consumer.join();
+
+    std::sort(latencyMs.begin(), latencyMs.end());
+    const auto at = [&](double q) { return latencyMs.empty() ? 0.0 : latencyMs[(size_t) (q * (latencyMs.size() - 1))]; };
+    std::printf("  %zu events: latency median %.3f ms, p99 %.3f ms, max %.3f ms; max depth %u\n", latencyMs.size(),
+                at(0.5), at(0.99), at(1.0), queue.getMaxDepth());
+    check("Every event handled", latencyMs.size() == 3000 && queue.getDropped() == 0);
+    check("Median latency under 1 ms", at(0.5) < 1);
+    check("p99 latency under 20 ms", at(0.99) < 20);
+  }
+
+  std::cout << "\nEvent Queue Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+#include "Housekeeping.h"
+#include "beacon-harness.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+    std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+    if (!ok) ++failures;
+}
+
+// Beacon's SNTP schedule
+static const int64_t SYNC_PERIOD_US = 3600LL * 1000000;
+static const int64_t SYNC_RETRY_US = 60LL * 1000000;
+static const int64_t SYNC_SLACK_US = 5LL * 60 * 1000000;
+
+// Whether the loop went to sleep until aboutUs after the last sync, give or
+// take the few seconds of real time the test has taken since
+static bool sleepsFor(BeaconHarness& h, int64_t aboutUs) {
+    const int64_t ms = h.eventGroup.lastTimeoutMs;
+    return ms <= aboutUs / 1000 && ms > aboutUs / 1000 - 10000;
+}
+
+// Change settings as the web UI does, waking the loop, and wait until it
+// has handled that and run whatever maintenance was due
+static bool settle(BeaconHarness& h) {
+    h.webServer.changeSettings();
+    return h.waitIdle(2000);
+}
+
+int main() {
+    std::cout << "Starting Housekeeping Tests..." << std::endl;
+
+    std::cout << "\n--- Test Case 1: Deadlines ---" << std::endl;
+    {
+        Housekeeping h;
+        check("Nothing to do waits forever", h.waitMs(0) == Housekeeping::Forever);
+
+        int syncs = 0, flushes = 0;
+        bool syncOk = false;
+        h.add([&]() { ++syncs; return syncOk; }, 3600000000LL, 60000000LL, 1000);
+        h.add([&]() { ++flushes; return true; }, 500000, 500000, 2500);
+        check("Wait rounds up to the earliest deadline", h.waitMs(0) == 1 && h.waitMs(1) == 1 && h.waitMs(999) == 1);
+        check("A deadline already due waits 0", h.waitMs(1000) == 0 && h.waitMs(5000) == 0);
+
+        check("Only due actions run", h.runDue(1000) == 1 && syncs == 1 && flushes == 0);
+        check("The next deadline is the earliest of all", h.runDue(2500) == 1 && flushes == 1 &&
+              h.nextDeadlineUs() == 502500);
+        h.runDue(502500);
+        check("Each keeps its own schedule", syncs == 1 && flushes == 2 && h.nextDeadlineUs() == 1002500);
+        syncOk = true;
+        for (int64_t t = 1002500; t < 60001000; t += 500000) h.runDue(t);
+        h.runDue(60001000);
+        check("A failed action is retried a minute later, not an hour", syncs == 2);
+        syncs = 0;
+        for (int64_t t = 60001000; t <= 3660001000LL; t += 500000) h.runDue(t);
+        check("A successful one waits its period", syncs == 1);
+
+        check("Long waits stay finite", h.waitMs(-5000000000000LL) == Housekeeping::Forever - 1);
+    }
+
+    std::cout << "\n--- Test Case 1b: Slack ---" << std::endl;
+    {
+        Housekeeping h;
+        int syncs = 0, flushes = 0;
+        h.add([&]() { ++syncs; return true; }, 3600000000LL, 60000000LL, 1000000, 300000000LL);
+        h.add([&]() { ++flushes; return true; }, 2000000, 2000000, 2000000);
+        check("Slack lets the loop sleep past the deadline", h.nextDeadlineUs() == 2000000 && h.waitMs(1500000) == 500);
+        check("A slack action rides along with another wakeup", h.runDue(2000000) == 2 && syncs == 1 && flushes == 1);
+        check("Then keeps its period from that run", h.nextDeadlineUs() == 4000000);
+    }
+
+    // The rest runs Beacon::mainOperationLoop itself, on the host mocks.
+    // The beacon's monotonic clock is stepped, so the hourly sync comes due
+    // without waiting for it, and every check counts rather than times.
+    BeaconHarness h;
+    check("Beacon reaches its main loop", h.start());
+
+    std::cout << "\n--- Test Case 2: Idle Loop ---" << std::endl;
+    {
+        // Without WiFi at startup the first sync is due as the loop starts
+        check("The first sync runs on entering the loop", h.waitIdle(2000) && h.time.syncs == 1);
+        check("Then the loop sleeps for the hour and its slack", sleepsFor(h, SYNC_PERIOD_US + SYNC_SLACK_US));
+
+        const uint32_t before = h.beacon->getEventLoopStats().wakeups;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const uint32_t idle = h.beacon->getEventLoopStats().wakeups - before;
+        std::printf("  %u wakeups in 1 s idle\n", (unsigned) idle);
+        check("An idle loop stays asleep", idle == 0);
+
+        const uint32_t start = h.beacon->getEventLoopStats().wakeups;
+        bool allHandled = true;
+        for (int i = 0; i < 10; ++i) allHandled = settle(h) && allHandled;
+        check("Each event is handled", allHandled);
+        check("One wakeup per event", h.beacon->getEventLoopStats().wakeups - start == 10);
+        check("Events do not sync early", h.time.syncs == 1);
+    }
+
+    std::cout << "\n--- Test Case 3: Hourly Sync ---" << std::endl;
+    {
+        h.timer.advanceMonotonic(SYNC_PERIOD_US - 60LL * 1000000);
+        check("Not before the hour", settle(h) && h.time.syncs == 1);
+        check("The wait still ends at the hour plus slack", sleepsFor(h, 60LL * 1000000 + SYNC_SLACK_US));
+
+        // Past the hour but inside the slack, the sync waits for a wakeup
+        // the loop makes anyway
+        h.timer.advanceMonotonic(2LL * 60 * 1000000);
+        check("Due within slack, it rides along with an event", settle(h) && h.time.syncs == 2);
+
+        h.time.failing = true;
+        h.timer.advanceMonotonic(SYNC_PERIOD_US);
+        check("A failed sync is counted", settle(h) && h.time.syncs == 3);
+        check("The retry is what the loop sleeps for", sleepsFor(h, SYNC_RETRY_US + SYNC_SLACK_US));
+        h.time.failing = false;
+        h.timer.advanceMonotonic(SYNC_RETRY_US);
+        check("It is retried a minute later, not an hour", settle(h) && h.time.syncs == 4);
+        h.timer.advanceMonotonic(SYNC_RETRY_US);
+        check("A success goes back to hourly", settle(h) && h.time.syncs == 4);
+    }
+
+    h.stop();
+
+    std::cout << "\nHousekeeping Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+    return failures ? 1 : 0;
+}
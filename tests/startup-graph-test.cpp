@@ -0,0 +1,121 @@
+#include "StartupGraph.h"
+#include "Task.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+static int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void work(int ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Node a ended before node b started
+static bool before(const StartupGraph::Timing* t, int a, int b) {
+  return t[a].endUs >= 0 && t[b].startUs >= t[a].endUs;
+}
+
+int main() {
+  std::cout << "Starting Startup Graph Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Beacon Startup ---" << std::endl;
+  {
+    // Beacon::run's graph with stand-in durations; WiFi is the slow one
+    const int settingsMs = 30, hardwareMs = 80, webMs = 50, networkMs = 300, sntpMs = 20, readyMs = 5,
+              schedulerMs = 5;
+    Task tasks;
+    StartupGraph graph;
+    const int settings = graph.add("settings", []() { work(settingsMs); });
+    const int hardware = graph.add("hardware", []() { work(hardwareMs); });
+    const int web = graph.add("web", []() { work(webMs); }, {settings});
+    const int network = graph.add("network", []() { work(networkMs); });
+    const int sntp = graph.add("sntp", []() { work(sntpMs); }, {network});
+    const int ready = graph.add("ready", []() { work(readyMs); }, {settings, network});
+    const int scheduler = graph.add("scheduler", []() { work(schedulerMs); }, {ready, hardware, sntp});
+
+    // Watch the timeline while startup runs, as /api/status would
+    std::atomic<bool> sawPartial(false);
+    std::thread watcher([&]() {
+      work(150);
+      StartupGraph::Timing t[StartupGraph::MaxNodes];
+      const int n = graph.getTimeline(t, StartupGraph::MaxNodes);
+      sawPartial = n == 7 && t[web].endUs >= 0 && t[network].startUs >= 0 && t[network].endUs < 0 &&
+                   t[scheduler].startUs < 0;
+    });
+
+    const int64_t start = nowUs();
+    const bool ok = graph.run(&tasks, nowUs);
+    const double totalMs = (nowUs() - start) / 1000.0;
+    watcher.join();
+
+    StartupGraph::Timing t[StartupGraph::MaxNodes];
+    const int n = graph.getTimeline(t, StartupGraph::MaxNodes);
+    for (int i = 0; i < n; ++i) {
+      std::printf("  %-9s %7.1f - %7.1f ms\n", t[i].name, t[i].startUs / 1000.0, t[i].endUs / 1000.0);
+    }
+    const int sequentialMs = settingsMs + hardwareMs + webMs + networkMs + sntpMs + readyMs + schedulerMs;
+    const int criticalMs = networkMs + sntpMs + schedulerMs;
+    std::printf("  startup %.1f ms; one phase at a time would be %d ms, the critical path is %d ms\n", totalMs,
+                sequentialMs, criticalMs);
+
+    check("Every node ran", ok && n == 7);
+    check("Independent nodes start together",
+          t[settings].startUs < 5000 && t[hardware].startUs < 5000 && t[network].startUs < 5000);
+    check("The web server is up before WiFi", before(t, settings, web) && t[web].endUs < t[network].endUs);
+    check("SNTP starts as soon as the link is up", before(t, network, sntp) && t[sntp].startUs - t[network].endUs < 5000);
+    check("Each node waits for all its dependencies",
+          before(t, settings, ready) && before(t, network, ready) && before(t, ready, scheduler) &&
+          before(t, hardware, scheduler) && before(t, sntp, scheduler));
+    check("Startup takes the critical path, not the sum", totalMs < criticalMs + 30 && totalMs < sequentialMs * 0.8);
+    check("The timeline is readable while startup runs", sawPartial);
+  }
+
+  std::cout << "\n--- Test Case 2: A Failing Node ---" << std::endl;
+  {
+    Task tasks;
+    StartupGraph graph;
+    std::atomic<int> ran(0);
+    const int settings = graph.add("settings", [&]() { ++ran; throw std::runtime_error("Failed to load settings"); });
+    const int hardware = graph.add("hardware", [&]() { ++ran; work(10); });
+    const int web = graph.add("web", [&]() { ++ran; }, {settings});
+    const int scheduler = graph.add("scheduler", [&]() { ++ran; }, {web, hardware});
+    const bool ok = graph.run(&tasks, nowUs);
+
+    StartupGraph::Timing t[StartupGraph::MaxNodes];
+    graph.getTimeline(t, StartupGraph::MaxNodes);
+    check("run() reports the failure", !ok);
+    check("The node that threw is marked failed", t[settings].failed && t[settings].endUs >= 0);
+    check("Independent nodes still run", !t[hardware].failed && t[hardware].endUs >= 0);
+    check("Everything after it is skipped", t[web].failed && t[web].startUs < 0 && t[scheduler].failed &&
+          t[scheduler].startUs < 0 && ran == 2);
+  }
+
+  std::cout << "\n--- Test Case 3: Building the Graph ---" << std::endl;
+  {
+    StartupGraph graph;
+    const int first = graph.add("first", []() {});
+    check("A dependency must already exist", graph.add("self", []() {}, {1}) == -1 &&
+          graph.add("later", []() {}, {first + 5}) == -1);
+    int added = 1;
+    while (graph.add("more", []() {}, {first}) >= 0) ++added;
+    check("Holds MaxNodes", added == StartupGraph::MaxNodes);
+    check("Nothing has started", graph.elapsedUs() == -1);
+  }
+
+  std::cout << "\nStartup Graph Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+#include "Task.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const std::string& testName, bool ok) {
+  std::cout << "  Test: " << testName << (ok ? " [PASS]" : " [FAIL]") << std::endl;
+  if (!ok) ++failures;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static const TaskIntf::Class classes[] = {
+  TaskIntf::Class::RtModulation, TaskIntf::Class::Control, TaskIntf::Class::Network, TaskIntf::Class::Background
+};
+
+static bool samePlacement(const TaskIntf::Placement& a, const TaskIntf::Placement& b) {
+  return a.core == b.core && a.priority == b.priority && a.realtime == b.realtime;
+}
+
+// Lateness of a 5 ms periodic loop, in ms, sorted
+static std::vector<double> periodicLateness(int periods) {
+  std::vector<double> late;
+  late.reserve(periods);
+  auto due = Clock::now();
+  for (int i = 0; i < periods; ++i) {
+    due += std::chrono::milliseconds(5);
+    std::this_thread::sleep_until(due);
+    late.push_back(std::chrono::duration<double, std::milli>(Clock::now() - due).count());
+  }
+  std::sort(late.begin(), late.end());
+  return late;
+}
+
+int main() {
+  std::cout << "Starting Task Placement Tests..." << std::endl;
+
+  std::cout << "\n--- Test Case 1: Placement by Class ---" << std::endl;
+  {
+    Task tasks;
+    TaskIntf::Placement placed[4];
+    bool agrees = true;
+    for (int i = 0; i < 4; ++i) {
+      // What the thread sees from inside must be what start() reported
+      TaskIntf::Placement seen;
+      TaskIntf::Task* task = tasks.start(TaskIntf::className(classes[i]), classes[i], [&]() {
+        seen = tasks.getPlacement(nullptr);
+      });
+      placed[i] = tasks.getPlacement(task);
+      tasks.destroy(task);
+      agrees &= samePlacement(seen, placed[i]);
+      std::printf("  %-13s core %2d, priority %3d%s\n", TaskIntf::className(classes[i]), placed[i].core,
+                  placed[i].priority, placed[i].realtime ? ", real-time" : "");
+    }
+    const bool realtimeAllowed = placed[0].realtime;
+    const unsigned cpus = std::thread::hardware_concurrency();
+
+    check("Effective placement is what the thread runs with", agrees);
+    check("rt-modulation has a core to itself when there is more than one",
+          cpus < 2 || (placed[0].core >= 0 && placed[1].core != placed[0].core && placed[2].core != placed[0].core &&
+                       placed[3].core != placed[0].core));
+    check("Real-time only for rt-modulation and control",
+          placed[0].realtime == placed[1].realtime && !placed[2].realtime && !placed[3].realtime);
+    check("rt-modulation outranks control when real-time is allowed",
+          !realtimeAllowed || placed[0].priority > placed[1].priority);
+    check("Background ranks below network", placed[3].priority < placed[2].priority);
+    if (!realtimeAllowed) {
+      std::cout << "  (SCHED_FIFO not permitted here; real-time classes run as ordinary threads)" << std::endl;
+    }
+  }
+
+  std::cout << "\n--- Test Case 2: Symbol Timing Under Load ---" << std::endl;
+  {
+    // Background threads spin on every CPU they may use while a 5 ms
+    // periodic loop runs, first as network and then as rt-modulation.
+    // Lateness depends on the machine, so it is reported, not checked.
+    Task tasks;
+    std::atomic<bool> spinning(true);
+    std::vector<TaskIntf::Task*> load;
+    const unsigned spinners = std::max(2u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < spinners; ++i) {
+      load.push_back(tasks.start("load", TaskIntf::Class::Background, [&]() {
+        while (spinning) {}
+      }));
+    }
+
+    std::vector<double> late[2];
+    const TaskIntf::Class measured[2] = {TaskIntf::Class::Network, TaskIntf::Class::RtModulation};
+    for (int i = 0; i < 2; ++i) {
+      TaskIntf::Task* task = tasks.start("periodic", measured[i], [&, i]() { late[i] = periodicLateness(200); });
+      tasks.destroy(task);
+    }
+    spinning = false;
+    for (TaskIntf::Task* task : load) tasks.destroy(task);
+
+    const auto at = [](const std::vector<double>& v, double q) { return v[(size_t) (q * (v.size() - 1))]; };
+    for (int i = 0; i < 2; ++i) {
+      std::printf("  %-13s lateness median %.3f ms, p99 %.3f ms, max %.3f ms\n", TaskIntf::className(measured[i]),
+                  at(late[i], 0.5), at(late[i], 0.99), at(late[i], 1.0));
+    }
+  }
+
+  std::cout << "\nTask Placement Tests " << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -58,6 +58,7 @@ class CalibrationManager {
         
         this.elements.correctionValue.addEventListener('change', () => {
             this.correctionPPM = parseFloat(this.elements.correctionValue.value);
+            this.sendCorrectionPreview();
         });
     }
     
@@ -173,6 +174,24 @@ class CalibrationManager {
         }
     }
     
+    async sendCorrectionPreview() {
+        if (!this.testActive) return;
+        
+        try {
+            await fetch('/api/calibration/preview', {
+                method: 'POST',
+                headers: {
+                    'Content-Type': 'application/json'
+                },
+                body: JSON.stringify({
+                    ppb: Math.round(this.correctionPPM * 1000)
+                })
+            });
+        } catch (error) {
+            console.error('Error previewing correction:', error);
+        }
+    }
+    
     async applyCorrection() {
         try {
             const response = await fetch('/api/calibration/correction', {